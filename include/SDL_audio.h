@@ -634,6 +634,66 @@ extern DECLSPEC int SDLCALL SDL_AudioStreamFlush(SDL_AudioStream *stream);
  */
 extern DECLSPEC void SDLCALL SDL_AudioStreamClear(SDL_AudioStream *stream);
 
+/**
+ *  Get a buffer to write audio data into, to add it to the stream without
+ *  copying it from a buffer of your own first.
+ *
+ *  Write up to the returned number of bytes to the buffer and then call
+ *  SDL_AudioStreamCommitPut(). The buffer belongs to the stream, and is only
+ *  valid until the next call to another function on this stream.
+ *
+ *  \param stream The stream the audio data is being added to
+ *  \param buf Filled in with a pointer to the buffer
+ *  \param len The number of bytes you want to write
+ *  \return The number of bytes that fit in the buffer, a whole number of
+ *          sample frames no larger than len, or -1 on error.
+ *
+ *  \sa SDL_AudioStreamCommitPut
+ *  \sa SDL_AudioStreamPut
+ */
+extern DECLSPEC int SDLCALL SDL_AudioStreamPeekPut(SDL_AudioStream *stream, void **buf, int len);
+
+/**
+ *  Add data written to the buffer from SDL_AudioStreamPeekPut() to the stream
+ *
+ *  \param stream The stream the audio data is being added to
+ *  \param len The number of bytes written, no more than SDL_AudioStreamPeekPut() returned
+ *  \return 0 on success, or -1 on error.
+ *
+ *  \sa SDL_AudioStreamPeekPut
+ */
+extern DECLSPEC int SDLCALL SDL_AudioStreamCommitPut(SDL_AudioStream *stream, int len);
+
+/**
+ *  Get a pointer to converted/resampled data in the stream without copying it
+ *
+ *  This only returns data that's stored contiguously, so it may be less than
+ *  SDL_AudioStreamAvailable() reports. Once you're done with the data, call
+ *  SDL_AudioStreamCommitGet() to remove it from the stream, after which you
+ *  can peek at the rest. The pointer is only valid until the next call to
+ *  another function on this stream.
+ *
+ *  \param stream The stream the audio is being requested from
+ *  \param buf Filled in with a pointer to the data, or NULL if there is none
+ *  \return The number of bytes available at buf, a whole number of sample
+ *          frames, or -1 on error.
+ *
+ *  \sa SDL_AudioStreamCommitGet
+ *  \sa SDL_AudioStreamGet
+ */
+extern DECLSPEC int SDLCALL SDL_AudioStreamPeekGet(SDL_AudioStream *stream, const void **buf);
+
+/**
+ *  Remove converted/resampled data from the stream without copying it
+ *
+ *  \param stream The stream the audio is being requested from
+ *  \param len The number of bytes to remove
+ *  \return 0 on success, or -1 on error.
+ *
+ *  \sa SDL_AudioStreamPeekGet
+ */
+extern DECLSPEC int SDLCALL SDL_AudioStreamCommitGet(SDL_AudioStream *stream, int len);
+
 /**
  * Free an audio stream
  *
@@ -667,6 +727,45 @@ extern DECLSPEC void SDLCALL SDL_MixAudioFormat(Uint8 * dst,
                                                 SDL_AudioFormat format,
                                                 Uint32 len, int volume);
 
+/**
+ *  One source buffer for SDL_MixAudioSources().
+ */
+typedef struct SDL_AudioMixSource
+{
+    const Uint8 *src;   /**< Audio data, in the format given to SDL_MixAudioSources() */
+    int volume;         /**< 0 to ::SDL_MIX_MAXVOLUME, larger values amplify */
+    const float *pan;   /**< One gain per channel (1.0f is unchanged), or NULL */
+} SDL_AudioMixSource;
+
+/**
+ *  Mix several audio buffers together in one pass.
+ *
+ *  The sources are added up as floating point, and the sum is clipped to
+ *  [-1.0, 1.0] (for float formats too) and converted to (format) only once,
+ *  at the end. So this touches (dst) a single time however many sources
+ *  there are, and loud sources don't clip each other on the way. Sources
+ *  that are NULL or have a volume of 0 are skipped.
+ *
+ *  Unlike SDL_MixAudioFormat(), this replaces the contents of (dst) rather
+ *  than adding to them. To keep what's already there, pass (dst) as one of
+ *  the sources; that's allowed, but sources must not otherwise overlap (dst).
+ *
+ *  \param dst Where to write the mixed audio, (len) bytes.
+ *  \param sources The buffers to mix, each (len) bytes of audio.
+ *  \param num_sources The number of entries in (sources).
+ *  \param format The audio format of (dst) and of every source.
+ *  \param channels The number of interleaved channels, 1 to 8.
+ *  \param len The number of bytes to mix; must be a whole number of frames.
+ *  \return 0 on success, or -1 on error.
+ *
+ *  \sa SDL_MixAudioFormat
+ */
+extern DECLSPEC int SDLCALL SDL_MixAudioSources(Uint8 * dst,
+                                                const SDL_AudioMixSource * sources,
+                                                int num_sources,
+                                                SDL_AudioFormat format,
+                                                int channels, Uint32 len);
+
 /**
  *  Queue more audio on non-callback devices.
  *
@@ -689,7 +788,9 @@ extern DECLSPEC void SDLCALL SDL_MixAudioFormat(Uint8 * dst,
  *  This function copies the supplied data, so you are safe to free it when
  *  the function returns. This function is thread-safe, but queueing to the
  *  same device from two threads at once does not promise which buffer will
- *  be queued first.
+ *  be queued first. If the device was opened with SDL_HINT_AUDIO_QUEUE_LOCKFREE
+ *  set, this never blocks the audio thread (or waits on it), but then only
+ *  one thread may queue audio to the device at a time.
  *
  *  You may not queue audio on a device that is using an application-supplied
  *  callback; doing so returns an error. You have to use the audio callback
@@ -735,7 +836,10 @@ extern DECLSPEC int SDLCALL SDL_QueueAudio(SDL_AudioDeviceID dev, const void *da
  *
  *  This function is thread-safe, but dequeueing from the same device from
  *  two threads at once does not promise which thread will dequeued data
- *  first.
+ *  first. If the device was opened with
+ *  SDL_HINT_AUDIO_QUEUE_LOCKFREE set, this never blocks the audio thread (or
+ *  waits on it), but then only one thread may dequeue from the device at a
+ *  time.
  *
  *  You may not dequeue audio from a device that is using an
  *  application-supplied callback; doing so returns an error. You have to use
@@ -153,6 +153,65 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_VSYNC               "SDL_RENDER_VSYNC"
 
+/**
+ *  \brief  A variable controlling how many threads the software renderer rasterizes with.
+ *
+ *  This variable can be set to the following values:
+ *    "0" or "1" - Render on the thread that calls the render API
+ *    "N"        - Split the target into tiles and render them on N threads
+ *
+ *  Clears, filled rectangles, points and unscaled copies are rendered in
+ *  parallel; other commands still run on a single thread. The output is the
+ *  same either way. This hint is checked when the renderer is created.
+ *
+ *  By default the software renderer uses a single thread.
+ */
+#define SDL_HINT_RENDER_SOFTWARE_THREADS    "SDL_RENDER_SOFTWARE_THREADS"
+
+/**
+ *  \brief  A variable controlling whether small static textures are packed into shared atlas textures.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Every texture gets its own texture in the render backend
+ *    "1"       - Static textures up to 256x256 share larger atlas textures
+ *
+ *  Copies from textures on the same atlas can be drawn together, so scenes
+ *  made of many small sprites need far fewer draw calls. Textures in an
+ *  atlas can't be used with SDL_GL_BindTexture(). This hint is checked when
+ *  the renderer is created.
+ *
+ *  By default textures are not packed into an atlas.
+ */
+#define SDL_HINT_RENDER_ATLAS               "SDL_RENDER_ATLAS"
+
+/**
+ *  \brief  A variable naming a file to write a trace of the renderer's work to.
+ *
+ *  Every flush of queued rendering commands to the render backend, and every
+ *  SDL_RenderPresent(), is written as an event in the Chrome trace event JSON
+ *  format, which chrome://tracing and similar viewers can load. This hint is
+ *  checked when the renderer is created.
+ *
+ *  By default no trace is written.
+ */
+#define SDL_HINT_RENDER_TRACE               "SDL_RENDER_TRACE"
+
+/**
+ *  \brief  A variable controlling how many threads pixel format conversions use.
+ *
+ *  This variable can be set to the following values:
+ *    "0" or "1" - Convert on the thread that calls the conversion function
+ *    "N"        - Split large images into bands of rows and convert them on N threads
+ *
+ *  This covers SDL_ConvertPixels(), including conversions to and from YUV
+ *  formats, and SDL_ConvertSurface(). The output is the same either way.
+ *  The threads are created on the first conversion that uses them and this
+ *  hint is checked on every conversion.
+ *
+ *  By default conversions use a single thread.
+ */
+#define SDL_HINT_VIDEO_CONVERT_THREADS      "SDL_VIDEO_CONVERT_THREADS"
+
 /**
  *  \brief  A variable controlling whether the screensaver is enabled. 
  *
@@ -1375,6 +1434,28 @@ extern "C" {
  */
 #define SDL_HINT_PREFERRED_LOCALES "SDL_PREFERRED_LOCALES"
 
+/**
+ *  \brief  A variable controlling whether audio devices opened without a callback use a lock-free queue.
+ *
+ *  By default, SDL_QueueAudio() and SDL_DequeueAudio() share a lock with the
+ *  audio thread, so an app thread queueing audio can hold up the audio
+ *  device (and the other way around).
+ *
+ *  With this hint set, the queue is a single-producer/single-consumer queue
+ *  that neither side ever has to wait for. The catch is that only one thread
+ *  may call SDL_QueueAudio() (or SDL_DequeueAudio(), for capture devices) on
+ *  a given device at a time. SDL_ClearQueuedAudio() still takes the device
+ *  lock.
+ *
+ *  This variable can be set to the following values:
+ *
+ *    "0"       - Use the locked queue (default)
+ *    "1"       - Use the lock-free single-producer/single-consumer queue
+ *
+ *  This hint is checked when an audio device is opened.
+ */
+#define SDL_HINT_AUDIO_QUEUE_LOCKFREE "SDL_AUDIO_QUEUE_LOCKFREE"
+
 
 /**
  *  \brief  An enumeration of hint priorities
@@ -125,6 +125,57 @@ typedef enum
     SDL_FLIP_VERTICAL = 0x00000002     /**< flip vertically */
 } SDL_RendererFlip;
 
+/**
+ *  \brief A sprite drawn by SDL_RenderCopySprites()
+ */
+typedef struct SDL_RenderSprite
+{
+    SDL_Rect srcrect;           /**< The part of the texture to draw, or an empty rect for all of it */
+    SDL_FRect dstrect;          /**< Where to draw it on the rendering target */
+    double angle;               /**< Clockwise rotation in degrees, around the center of dstrect */
+    SDL_RendererFlip flip;      /**< Flipping to apply to the texture */
+    SDL_Color color;            /**< Color and alpha modulation, used instead of the texture's */
+} SDL_RenderSprite;
+
+/**
+ *  \brief Why queued rendering commands were sent to the render backend
+ */
+typedef enum
+{
+    SDL_RENDER_FLUSH_PRESENT,       /**< SDL_RenderPresent() */
+    SDL_RENDER_FLUSH_EXPLICIT,      /**< SDL_RenderFlush() */
+    SDL_RENDER_FLUSH_TEXTURE,       /**< A texture used by queued commands was changed or destroyed */
+    SDL_RENDER_FLUSH_TARGET,        /**< SDL_SetRenderTarget() */
+    SDL_RENDER_FLUSH_READ_PIXELS,   /**< SDL_RenderReadPixels() */
+    SDL_RENDER_FLUSH_NOT_BATCHING,  /**< Batching is off, so every call is sent right away */
+    SDL_RENDER_FLUSH_OTHER,         /**< Anything else, like destroying the renderer */
+    SDL_NUM_RENDER_FLUSH_REASONS
+} SDL_RenderFlushReason;
+
+/**
+ *  \brief Statistics for one frame of a renderer, see SDL_GetRenderStats()
+ */
+typedef struct SDL_RenderStats
+{
+    Uint32 commands;            /**< Commands sent to the render backend */
+    Uint32 commands_saved;      /**< Commands dropped or merged before reaching the backend */
+    Uint32 viewports;           /**< Viewport changes sent */
+    Uint32 cliprects;           /**< Clip rect changes sent */
+    Uint32 draw_colors;         /**< Draw color changes sent */
+    Uint32 clears;              /**< Clears sent */
+    Uint32 draw_points;         /**< Point draws sent */
+    Uint32 draw_lines;          /**< Line draws sent */
+    Uint32 fill_rects;          /**< Rect fills sent */
+    Uint32 copies;              /**< Texture copies sent */
+    Uint32 copies_ex;           /**< Rotated or flipped texture copies sent */
+    Uint32 flushes;             /**< Times queued commands were sent to the backend */
+    Uint32 flush_reasons[SDL_NUM_RENDER_FLUSH_REASONS];  /**< Flushes, by SDL_RenderFlushReason */
+    Uint64 vertex_bytes;        /**< Bytes of vertex data sent with the commands */
+    Uint32 texture_uploads;     /**< Texture updates and unlocks passed to the backend */
+    Uint64 texture_upload_bytes;  /**< Bytes of pixel data in those uploads */
+    Uint32 run_time_us;         /**< Microseconds the backend spent running commands */
+} SDL_RenderStats;
+
 /**
  *  \brief A structure representing rendering state
  */
@@ -137,6 +188,19 @@ typedef struct SDL_Renderer SDL_Renderer;
 struct SDL_Texture;
 typedef struct SDL_Texture SDL_Texture;
 
+/**
+ *  \brief The function called when an update queued by SDL_UpdateTextureAsync()
+ *         is done with its pixel data.
+ *
+ *  \param userdata The pointer passed to SDL_UpdateTextureAsync()
+ *  \param texture  The texture that was updated
+ *  \param status   0 if the texture was updated, or -1 if it failed or the
+ *                  texture was destroyed first
+ */
+typedef void (SDLCALL * SDL_TextureUploadCallback) (void *userdata,
+                                                    SDL_Texture * texture,
+                                                    int status);
+
 
 /* Function prototypes */
 
@@ -425,6 +489,39 @@ extern DECLSPEC int SDLCALL SDL_UpdateTexture(SDL_Texture * texture,
                                               const SDL_Rect * rect,
                                               const void *pixels, int pitch);
 
+/**
+ *  \brief Queue an update of the given texture rectangle, without waiting for it.
+ *
+ *  \param texture   The texture to update
+ *  \param rect      A pointer to the rectangle of pixels to update, or NULL to
+ *                   update the entire texture.
+ *  \param pixels    The raw pixel data in the format of the texture.
+ *  \param pitch     The number of bytes in a row of pixel data, including padding between lines.
+ *  \param callback  A function called once the pixel data isn't needed anymore,
+ *                   or NULL.
+ *  \param userdata  A pointer passed to the callback.
+ *
+ *  The update happens the next time the renderer sends its queued commands
+ *  to the GPU, for example in SDL_RenderPresent(), and rendering queued after
+ *  this call sees the new pixels. The pixel data must stay valid until the
+ *  callback is called, which happens on the thread doing the rendering.
+ *  Render backends that can do so hand the data to the GPU through staging
+ *  buffers, so the update doesn't wait for the GPU either.
+ *
+ *  The rectangle is clipped to the texture when the update is queued. If
+ *  nothing is left, the callback is called right away.
+ *
+ *  \return 0 if the update was queued, or -1 if the texture or the update
+ *          is not valid.
+ *
+ *  \sa SDL_UpdateTexture()
+ */
+extern DECLSPEC int SDLCALL SDL_UpdateTextureAsync(SDL_Texture * texture,
+                                                   const SDL_Rect * rect,
+                                                   const void *pixels, int pitch,
+                                                   SDL_TextureUploadCallback callback,
+                                                   void *userdata);
+
 /**
  *  \brief Update a rectangle within a planar YV12 or IYUV texture with new pixel data.
  *
@@ -1037,6 +1134,30 @@ extern DECLSPEC int SDLCALL SDL_RenderCopyExF(SDL_Renderer * renderer,
                                             const SDL_FPoint *center,
                                             const SDL_RendererFlip flip);
 
+/**
+ *  \brief Copy many sprites from the same texture to the current rendering target.
+ *
+ *  \param renderer The renderer which should copy parts of a texture.
+ *  \param texture The source texture.
+ *  \param sprites An array of sprites, each with its own source and
+ *                 destination rectangle, rotation, flip and color modulation.
+ *  \param count The number of sprites.
+ *
+ *  This draws the same as calling SDL_RenderCopyExF() for every sprite, with
+ *  the texture's color and alpha modulation set to the sprite's color, but
+ *  sprites that aren't rotated or flipped and share a color are queued as a
+ *  single draw where the renderer supports it. The texture's blend mode is
+ *  used for all of them.
+ *
+ *  \return 0 on success, or -1 on error
+ *
+ *  \sa SDL_RenderCopyExF()
+ */
+extern DECLSPEC int SDLCALL SDL_RenderCopySprites(SDL_Renderer * renderer,
+                                                  SDL_Texture * texture,
+                                                  const SDL_RenderSprite * sprites,
+                                                  int count);
+
 /**
  *  \brief Read pixels from the current rendering target.
  *
@@ -1103,6 +1224,23 @@ extern DECLSPEC void SDLCALL SDL_DestroyRenderer(SDL_Renderer * renderer);
  */
 extern DECLSPEC int SDLCALL SDL_RenderFlush(SDL_Renderer * renderer);
 
+/**
+ *  \brief Get statistics for the last frame the renderer presented.
+ *
+ *  \param renderer The renderer to query.
+ *  \param stats    A pointer filled in with what happened between the last
+ *                  two calls to SDL_RenderPresent().
+ *
+ *  \return 0 on success, or -1 if the renderer is invalid.
+ *
+ *  Setting SDL_HINT_RENDER_TRACE also writes each flush to a file that can
+ *  be loaded in a trace viewer.
+ *
+ *  \sa SDL_RenderPresent()
+ */
+extern DECLSPEC int SDLCALL SDL_GetRenderStats(SDL_Renderer * renderer,
+                                               SDL_RenderStats * stats);
+
 
 /**
  *  \brief Bind the texture to the current OpenGL/ES/ES2 context for use with
@@ -510,6 +510,21 @@ extern DECLSPEC int SDLCALL SDL_SoftStretch(SDL_Surface * src,
                                             SDL_Surface * dst,
                                             const SDL_Rect * dstrect);
 
+/**
+ *  \brief Perform a filtered stretch blit between two surfaces of the same
+ *         pixel format.
+ *
+ *  Pixels are bilinearly filtered, or averaged over the source pixels they
+ *  cover when shrinking to half the size or less in both directions.
+ *
+ *  \note Only 32-bit formats with 8-bit channels, ::SDL_PIXELFORMAT_RGB565
+ *        and ::SDL_PIXELFORMAT_BGR565 are supported.
+ */
+extern DECLSPEC int SDLCALL SDL_SoftStretchLinear(SDL_Surface * src,
+                                                  const SDL_Rect * srcrect,
+                                                  SDL_Surface * dst,
+                                                  const SDL_Rect * dstrect);
+
 #define SDL_BlitScaled SDL_UpperBlitScaled
 
 /**
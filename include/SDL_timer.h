@@ -103,6 +103,31 @@ extern DECLSPEC SDL_TimerID SDLCALL SDL_AddTimer(Uint32 interval,
  */
 extern DECLSPEC SDL_bool SDLCALL SDL_RemoveTimer(SDL_TimerID id);
 
+/**
+ *  Function prototype for the high resolution timer callback function.
+ *
+ *  The callback function is passed the current timer interval in nanoseconds
+ *  and returns the next timer interval.  The next deadline is the previous
+ *  deadline plus the returned interval, so a periodic timer doesn't drift no
+ *  matter how late its callback runs.  Periods that are missed entirely are
+ *  skipped.  If the callback returns 0, the periodic alarm is cancelled.
+ */
+typedef Uint64 (SDLCALL * SDL_NSTimerCallback) (Uint64 interval, void *param);
+
+/**
+ * \brief Add a new high resolution timer to the pool of timers already running.
+ *
+ * The timer is measured with SDL_GetPerformanceCounter() and runs on the same
+ * thread as timers added with SDL_AddTimer().  Remove it with SDL_RemoveTimer().
+ *
+ * \param interval The time until the first call, in nanoseconds.
+ *
+ * \return A timer ID, or 0 when an error occurs.
+ */
+extern DECLSPEC SDL_TimerID SDLCALL SDL_AddTimerNS(Uint64 interval,
+                                                   SDL_NSTimerCallback callback,
+                                                   void *param);
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
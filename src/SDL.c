@@ -42,6 +42,7 @@
 #include "haptic/SDL_haptic_c.h"
 #include "joystick/SDL_joystick_c.h"
 #include "sensor/SDL_sensor_c.h"
+#include "video/SDL_blit.h"
 
 /* Initialization/Cleanup routines */
 #if !SDL_TIMERS_DISABLED
@@ -421,6 +422,7 @@ SDL_Quit(void)
     SDL_TicksQuit();
 #endif
 
+    SDL_QuitRowBands();
     SDL_ClearHints();
     SDL_AssertionsQuit();
     SDL_LogResetPriorities();
@@ -19,36 +19,201 @@
   3. This notice may not be removed or altered from any source distribution.
 */
 
+/* The mirrored ring needs mremap(), which glibc only declares for GNU code. */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE 1
+#endif
+
 #include "./SDL_internal.h"
 #include "SDL.h"
 #include "./SDL_dataqueue.h"
 #include "SDL_assert.h"
 
-typedef struct SDL_DataQueuePacket
-{
-    size_t datalen;  /* bytes currently in use in this packet. */
-    size_t startpos;  /* bytes currently consumed in this packet. */
-    struct SDL_DataQueuePacket *next;  /* next item in linked list. */
-    Uint8 data[SDL_VARIABLE_LENGTH_ARRAY];  /* packet data */
-} SDL_DataQueuePacket;
+#if defined(__LINUX__) && HAVE_MPROTECT
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(MREMAP_FIXED) && defined(MREMAP_MAYMOVE) && defined(MAP_ANONYMOUS)
+#define SDL_DATAQUEUE_MIRRORING 1
+#endif
+#endif
+
+/* The queue is a single power-of-two ring buffer. head and tail are free
+   running byte counters (the amount ever read and ever written), so the
+   queued byte count is always (tail - head) and a position in the buffer is
+   the counter masked with (capacity - 1).
+
+   Where the OS lets us, the buffer is mapped twice back to back in virtual
+   memory, so anything in the ring is contiguous when viewed from its start
+   position, no matter where it wraps. Otherwise reads and writes that wrap
+   are split into two memcpy() calls, and SDL_PeekDataQueueBuffer() copies a
+   packet that wraps into a separate buffer allocated with the queue. */
+
+#define SDL_DATAQUEUE_MIN_CAPACITY 4096
+
+/* SDL_ClearDataQueue() won't bother shrinking a ring smaller than this.
+   Reallocating (and, when mirrored, remapping and faulting in) the ring
+   costs far more than the memory saved, and apps that clear a queue
+   usually refill it to about the same level right away. */
+#define SDL_DATAQUEUE_KEEP_CAPACITY (1024 * 1024)
 
 struct SDL_DataQueue
 {
-    SDL_DataQueuePacket *head; /* device fed from here. */
-    SDL_DataQueuePacket *tail; /* queue fills to here. */
-    SDL_DataQueuePacket *pool; /* these are unused packets. */
-    size_t packet_size;   /* size of new packets */
-    size_t queued_bytes;  /* number of bytes of data in the queue. */
+    Uint8 *buffer;        /* ring storage, (capacity * 2) bytes of address space if mirrored. */
+    size_t capacity;      /* size of the ring, always a power of two. */
+    size_t head;          /* total bytes ever consumed; device fed from here. */
+    size_t tail;          /* total bytes ever queued; queue fills to here. */
+    size_t packet_size;   /* largest block we promise to hand out contiguously. */
+    SDL_bool mirrored;    /* SDL_TRUE if buffer is mapped twice in a row. */
+    Uint8 *linear;        /* packet_size bytes to peek at wrapped data, if not mirrored. */
 };
 
+static size_t
+SDL_DataQueueCapacityFor(size_t len)
+{
+    size_t capacity = SDL_DATAQUEUE_MIN_CAPACITY;
+    while (capacity < len) {
+        if (capacity > (((size_t) -1) >> 2)) {
+            return 0;  /* absurdly large, refuse. */
+        }
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+#if SDL_DATAQUEUE_MIRRORING
+/* Map a shared anonymous block, then alias its first half over its second
+   half: with old_size == 0, mremap() of a shared mapping creates a second
+   mapping of the same pages instead of moving them. */
+static Uint8 *
+SDL_AllocMirroredRing(const size_t size)
+{
+    const long pagesize = sysconf(_SC_PAGESIZE);
+    Uint8 *buffer;
+    void *mirror;
+
+    /* every capacity we use is then a multiple of the page size. */
+    if ((pagesize <= 0) || (pagesize > SDL_DATAQUEUE_MIN_CAPACITY) || ((pagesize & (pagesize - 1)) != 0)) {
+        return NULL;
+    }
+
+    buffer = (Uint8 *) mmap(NULL, size * 2, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (buffer == (Uint8 *) MAP_FAILED) {
+        return NULL;
+    }
+
+    mirror = mremap(buffer, 0, size, MREMAP_MAYMOVE | MREMAP_FIXED, buffer + size);
+    if (mirror != (void *) (buffer + size)) {
+        munmap(buffer, size * 2);
+        return NULL;
+    }
+
+    return buffer;
+}
+#endif
+
+static Uint8 *
+SDL_AllocRing(const size_t capacity, SDL_bool *mirrored)
+{
+#if SDL_DATAQUEUE_MIRRORING
+    Uint8 *buffer = SDL_AllocMirroredRing(capacity);
+    if (buffer) {
+        *mirrored = SDL_TRUE;
+        return buffer;
+    }
+#endif
+    *mirrored = SDL_FALSE;
+    return (Uint8 *) SDL_malloc(capacity);
+}
+
 static void
-SDL_FreeDataQueueList(SDL_DataQueuePacket *packet)
+SDL_FreeRing(Uint8 *buffer, const size_t capacity, const SDL_bool mirrored)
+{
+    if (!buffer) {
+        return;
+    }
+#if SDL_DATAQUEUE_MIRRORING
+    if (mirrored) {
+        munmap(buffer, capacity * 2);
+        return;
+    }
+#endif
+    SDL_free(buffer);
+}
+
+/* Copies len bytes starting at ring position pos out to buf. */
+static void
+SDL_CopyFromRing(const SDL_DataQueue *queue, Uint8 *buf, const size_t pos, const size_t len)
+{
+    const size_t offset = pos & (queue->capacity - 1);
+    const size_t first = queue->capacity - offset;
+
+    if (queue->mirrored || (len <= first)) {
+        SDL_memcpy(buf, queue->buffer + offset, len);
+    } else {
+        SDL_memcpy(buf, queue->buffer + offset, first);
+        SDL_memcpy(buf + first, queue->buffer, len - first);
+    }
+}
+
+/* Copies len bytes from data into the ring at position pos. */
+static void
+SDL_CopyToRing(SDL_DataQueue *queue, const Uint8 *data, const size_t pos, const size_t len)
+{
+    const size_t offset = pos & (queue->capacity - 1);
+    const size_t first = queue->capacity - offset;
+
+    if (queue->mirrored || (len <= first)) {
+        SDL_memcpy(queue->buffer + offset, data, len);
+    } else {
+        SDL_memcpy(queue->buffer + offset, data, first);
+        SDL_memcpy(queue->buffer, data + first, len - first);
+    }
+}
+
+/* Moves the queued data to the start of a new ring of the given capacity. */
+static int
+SDL_ResizeDataQueue(SDL_DataQueue *queue, const size_t capacity)
+{
+    const size_t queued = queue->tail - queue->head;
+    SDL_bool mirrored;
+    Uint8 *buffer;
+
+    SDL_assert(capacity >= queued);
+
+    buffer = SDL_AllocRing(capacity, &mirrored);
+    if (!buffer) {
+        return SDL_OutOfMemory();
+    }
+
+    if (queued) {
+        SDL_CopyFromRing(queue, buffer, queue->head, queued);
+    }
+
+    SDL_FreeRing(queue->buffer, queue->capacity, queue->mirrored);
+    queue->buffer = buffer;
+    queue->capacity = capacity;
+    queue->mirrored = mirrored;
+    queue->head = 0;
+    queue->tail = queued;
+    return 0;
+}
+
+/* Makes room for at least len more bytes. */
+static int
+SDL_GrowDataQueue(SDL_DataQueue *queue, const size_t len)
 {
-    while (packet) {
-        SDL_DataQueuePacket *next = packet->next;
-        SDL_free(packet);
-        packet = next;
+    const size_t queued = queue->tail - queue->head;
+    size_t capacity;
+
+    if (queue->buffer && (len <= (queue->capacity - queued))) {
+        return 0;  /* already fits. */
     }
+
+    capacity = (len <= (((size_t) -1) - queued)) ? SDL_DataQueueCapacityFor(queued + len) : 0;
+    if (!capacity) {
+        return SDL_OutOfMemory();
+    }
+    return SDL_ResizeDataQueue(queue, capacity);
 }
 
 
@@ -64,20 +229,23 @@ SDL_NewDataQueue(const size_t _packetlen, const size_t initialslack)
         return NULL;
     } else {
         const size_t packetlen = _packetlen ? _packetlen : 1024;
-        const size_t wantpackets = (initialslack + (packetlen - 1)) / packetlen;
-        size_t i;
 
         SDL_zerop(queue);
         queue->packet_size = packetlen;
 
-        for (i = 0; i < wantpackets; i++) {
-            SDL_DataQueuePacket *packet = (SDL_DataQueuePacket *) SDL_malloc(sizeof (SDL_DataQueuePacket) + packetlen);
-            if (packet) { /* don't care if this fails, we'll deal later. */
-                packet->datalen = 0;
-                packet->startpos = 0;
-                packet->next = queue->pool;
-                queue->pool = packet;
-            }
+        /* don't care if this fails, we'll deal later. */
+        queue->capacity = SDL_DataQueueCapacityFor(SDL_max(packetlen, initialslack));
+        if (queue->capacity) {
+            queue->buffer = SDL_AllocRing(queue->capacity, &queue->mirrored);
+        }
+        if (!queue->buffer) {
+            queue->capacity = 0;
+        }
+
+        /* Peeking at data that wraps has to copy it somewhere, so allocate
+           that now instead of on whatever thread is reading. */
+        if (!queue->mirrored) {
+            queue->linear = (Uint8 *) SDL_malloc(packetlen);
         }
     }
 
@@ -88,8 +256,8 @@ void
 SDL_FreeDataQueue(SDL_DataQueue *queue)
 {
     if (queue) {
-        SDL_FreeDataQueueList(queue->head);
-        SDL_FreeDataQueueList(queue->pool);
+        SDL_FreeRing(queue->buffer, queue->capacity, queue->mirrored);
+        SDL_free(queue->linear);
         SDL_free(queue);
     }
 }
@@ -97,243 +265,405 @@ SDL_FreeDataQueue(SDL_DataQueue *queue)
 void
 SDL_ClearDataQueue(SDL_DataQueue *queue, const size_t slack)
 {
-    const size_t packet_size = queue ? queue->packet_size : 1;
-    const size_t slackpackets = (slack + (packet_size-1)) / packet_size;
-    SDL_DataQueuePacket *packet;
-    SDL_DataQueuePacket *prev = NULL;
-    size_t i;
+    size_t capacity;
 
     if (!queue) {
         return;
     }
 
-    packet = queue->head;
+    queue->head = 0;
+    queue->tail = 0;
 
-    /* merge the available pool and the current queue into one list. */
-    if (packet) {
-        queue->tail->next = queue->pool;
-    } else {
-        packet = queue->pool;
+    /* Optionally keep some slack to reduce malloc pressure, give back the rest. */
+    if (slack == 0) {
+        SDL_FreeRing(queue->buffer, queue->capacity, queue->mirrored);
+        queue->buffer = NULL;
+        queue->capacity = 0;
+        queue->mirrored = SDL_FALSE;
+        return;
     }
 
-    /* Remove the queued packets from the device. */
-    queue->tail = NULL;
-    queue->head = NULL;
-    queue->queued_bytes = 0;
-    queue->pool = packet;
+    capacity = SDL_DataQueueCapacityFor(SDL_max(slack, SDL_DATAQUEUE_KEEP_CAPACITY));
+    if (queue->buffer && capacity && (capacity < queue->capacity)) {
+        SDL_ResizeDataQueue(queue, capacity);  /* if this fails, we just keep the bigger buffer. */
+    }
+}
 
-    /* Optionally keep some slack in the pool to reduce malloc pressure. */
-    for (i = 0; packet && (i < slackpackets); i++) {
-        prev = packet;
-        packet = packet->next;
+int
+SDL_WriteToDataQueue(SDL_DataQueue *queue, const void *data, const size_t len)
+{
+    if (!queue) {
+        return SDL_InvalidParamError("queue");
     }
 
-    if (prev) {
-        prev->next = NULL;
-    } else {
-        queue->pool = NULL;
+    if (len == 0) {
+        return 0;
+    }
+
+    if (SDL_GrowDataQueue(queue, len) < 0) {
+        return -1;  /* queue is untouched on failure. */
     }
 
-    SDL_FreeDataQueueList(packet);  /* free extra packets */
+    SDL_CopyToRing(queue, (const Uint8 *) data, queue->tail, len);
+    queue->tail += len;
+    return 0;
 }
 
-static SDL_DataQueuePacket *
-AllocateDataQueuePacket(SDL_DataQueue *queue)
+size_t
+SDL_PeekIntoDataQueue(SDL_DataQueue *queue, void *buf, const size_t len)
 {
-    SDL_DataQueuePacket *packet;
-
-    SDL_assert(queue != NULL);
+    size_t cpy;
 
-    packet = queue->pool;
-    if (packet != NULL) {
-        /* we have one available in the pool. */
-        queue->pool = packet->next;
-    } else {
-        /* Have to allocate a new one! */
-        packet = (SDL_DataQueuePacket *) SDL_malloc(sizeof (SDL_DataQueuePacket) + queue->packet_size);
-        if (packet == NULL) {
-            return NULL;
-        }
+    if (!queue) {
+        return 0;
     }
 
-    packet->datalen = 0;
-    packet->startpos = 0;
-    packet->next = NULL;
-                
-    SDL_assert((queue->head != NULL) == (queue->queued_bytes != 0));
-    if (queue->tail == NULL) {
-        queue->head = packet;
-    } else {
-        queue->tail->next = packet;
+    cpy = SDL_min(len, queue->tail - queue->head);
+    if (cpy) {
+        SDL_CopyFromRing(queue, (Uint8 *) buf, queue->head, cpy);
     }
-    queue->tail = packet;
-    return packet;
+    return cpy;
 }
 
+/* Consumes up to len bytes, copying them to buf if it isn't NULL */
+static size_t
+SDL_ConsumeDataQueue(SDL_DataQueue *queue, Uint8 *buf, const size_t len)
+{
+    const size_t cpy = SDL_min(len, queue->tail - queue->head);
 
-int
-SDL_WriteToDataQueue(SDL_DataQueue *queue, const void *_data, const size_t _len)
+    if (buf && cpy) {
+        SDL_CopyFromRing(queue, buf, queue->head, cpy);
+    }
+    queue->head += cpy;
+
+    if (queue->head == queue->tail) {
+        /* drained the queue entirely; restart at the front so later data stays contiguous. */
+        queue->head = 0;
+        queue->tail = 0;
+    }
+
+    return cpy;
+}
+
+size_t
+SDL_ReadFromDataQueue(SDL_DataQueue *queue, void *buf, const size_t len)
 {
-    size_t len = _len;
-    const Uint8 *data = (const Uint8 *) _data;
-    const size_t packet_size = queue ? queue->packet_size : 0;
-    SDL_DataQueuePacket *orighead;
-    SDL_DataQueuePacket *origtail;
-    size_t origlen;
-    size_t datalen;
+    if (!queue) {
+        return 0;
+    }
 
+    return SDL_ConsumeDataQueue(queue, (Uint8 *) buf, len);
+}
+
+size_t
+SDL_DiscardFromDataQueue(SDL_DataQueue *queue, const size_t len)
+{
     if (!queue) {
-        return SDL_InvalidParamError("queue");
+        return 0;
     }
 
-    orighead = queue->head;
-    origtail = queue->tail;
-    origlen = origtail ? origtail->datalen : 0;
+    return SDL_ConsumeDataQueue(queue, NULL, len);
+}
 
-    while (len > 0) {
-        SDL_DataQueuePacket *packet = queue->tail;
-        SDL_assert(!packet || (packet->datalen <= packet_size));
-        if (!packet || (packet->datalen >= packet_size)) {
-            /* tail packet missing or completely full; we need a new packet. */
-            packet = AllocateDataQueuePacket(queue);
-            if (!packet) {
-                /* uhoh, reset so we've queued nothing new, free what we can. */
-                if (!origtail) {
-                    packet = queue->head;  /* whole queue. */
-                } else {
-                    packet = origtail->next;  /* what we added to existing queue. */
-                    origtail->next = NULL;
-                    origtail->datalen = origlen;
-                }
-                queue->head = orighead;
-                queue->tail = origtail;
-                queue->pool = NULL;
-
-                SDL_FreeDataQueueList(packet);  /* give back what we can. */
-                return SDL_OutOfMemory();
-            }
+const void *
+SDL_PeekDataQueueBuffer(SDL_DataQueue *queue, size_t *len)
+{
+    size_t queued, offset, avail;
+
+    if (!queue || (queue->head == queue->tail)) {
+        *len = 0;
+        return NULL;
+    }
+
+    queued = queue->tail - queue->head;
+    offset = queue->head & (queue->capacity - 1);
+    avail = queue->mirrored ? queued : SDL_min(queued, queue->capacity - offset);
+
+    /* Without mirroring, the data can wrap around the end of the ring. Callers
+       rely on getting at least a packet's worth in one piece, so copy that
+       out when the wrap point cuts into it. The copy stays valid until the
+       queue is next written to or read from, just like the ring would. */
+    if (avail < SDL_min(queued, queue->packet_size)) {
+        if (queue->linear) {
+            *len = SDL_min(queued, queue->packet_size);
+            SDL_CopyFromRing(queue, queue->linear, queue->head, *len);
+            return queue->linear;
         }
 
-        datalen = SDL_min(len, packet_size - packet->datalen);
-        SDL_memcpy(packet->data + packet->datalen, data, datalen);
-        data += datalen;
-        len -= datalen;
-        packet->datalen += datalen;
-        queue->queued_bytes += datalen;
+        /* Couldn't allocate that at creation, straighten out the ring instead */
+        if (SDL_ResizeDataQueue(queue, queue->capacity) == 0) {
+            offset = 0;
+            avail = queued;
+        }
     }
 
-    return 0;
+    *len = avail;
+    return queue->buffer + offset;
 }
 
 size_t
-SDL_PeekIntoDataQueue(SDL_DataQueue *queue, void *_buf, const size_t _len)
+SDL_CountDataQueue(SDL_DataQueue *queue)
 {
-    size_t len = _len;
-    Uint8 *buf = (Uint8 *) _buf;
-    Uint8 *ptr = buf;
-    SDL_DataQueuePacket *packet;
+    return queue ? (queue->tail - queue->head) : 0;
+}
+
+/* Single-producer/single-consumer queue.
+
+   This is a chain of ring buffers. Each one has its own read and write
+   counters, which only the consumer and the producer, respectively, ever
+   change. When the newest ring fills up, the producer links a bigger one
+   after it and keeps writing there; once the consumer has drained a ring
+   that has a successor, it moves on and never looks back. The producer
+   frees every ring that comes before the one the consumer is reading from.
+
+   The counters are 32-bit and free running, so a single ring has to stay
+   well under 4 gigabytes. */
+
+#define SDL_SPSCDATAQUEUE_MAX_CAPACITY (1024 * 1024 * 1024)
+
+typedef struct SDL_SPSCDataQueueRing
+{
+    SDL_atomic_t head;  /* bytes ever consumed from this ring; consumer changes this. */
+    SDL_atomic_t tail;  /* bytes ever written to this ring; producer changes this. */
+    struct SDL_SPSCDataQueueRing *next;  /* set once by the producer when this ring is full. */
+    size_t capacity;  /* always a power of two. */
+    Uint8 data[SDL_VARIABLE_LENGTH_ARRAY];
+} SDL_SPSCDataQueueRing;
+
+struct SDL_SPSCDataQueue
+{
+    SDL_SPSCDataQueueRing *oldest;   /* producer only: first ring not freed yet. */
+    SDL_SPSCDataQueueRing *writing;  /* producer only: ring we're filling. */
+    SDL_SPSCDataQueueRing *reading;  /* consumer's ring; producer reads it to know what to free. */
+    SDL_atomic_t queued;  /* bytes queued overall, for SDL_CountSPSCDataQueue(). */
+};
+
+static SDL_SPSCDataQueueRing *
+SDL_NewSPSCDataQueueRing(const size_t len)
+{
+    const size_t capacity = SDL_DataQueueCapacityFor(len);
+    SDL_SPSCDataQueueRing *ring;
+
+    if (!capacity || (capacity > SDL_SPSCDATAQUEUE_MAX_CAPACITY)) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    ring = (SDL_SPSCDataQueueRing *) SDL_malloc(sizeof (SDL_SPSCDataQueueRing) + capacity);
+    if (!ring) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    SDL_AtomicSet(&ring->head, 0);
+    SDL_AtomicSet(&ring->tail, 0);
+    ring->next = NULL;
+    ring->capacity = capacity;
+    return ring;
+}
+
+static void
+SDL_FreeSPSCDataQueueRings(SDL_SPSCDataQueueRing *ring, SDL_SPSCDataQueueRing *stop)
+{
+    while (ring != stop) {
+        SDL_SPSCDataQueueRing *next = ring->next;
+        SDL_free(ring);
+        ring = next;
+    }
+}
+
+SDL_SPSCDataQueue *
+SDL_NewSPSCDataQueue(const size_t initialslack)
+{
+    SDL_SPSCDataQueue *queue = (SDL_SPSCDataQueue *) SDL_malloc(sizeof (SDL_SPSCDataQueue));
 
     if (!queue) {
-        return 0;
+        SDL_OutOfMemory();
+        return NULL;
     }
 
-    for (packet = queue->head; len && packet; packet = packet->next) {
-        const size_t avail = packet->datalen - packet->startpos;
-        const size_t cpy = SDL_min(len, avail);
-        SDL_assert(queue->queued_bytes >= avail);
+    SDL_zerop(queue);
+    queue->writing = SDL_NewSPSCDataQueueRing(initialslack);
+    if (!queue->writing) {
+        SDL_free(queue);
+        return NULL;
+    }
 
-        SDL_memcpy(ptr, packet->data + packet->startpos, cpy);
-        ptr += cpy;
-        len -= cpy;
+    queue->oldest = queue->reading = queue->writing;
+    SDL_AtomicSet(&queue->queued, 0);
+    return queue;
+}
+
+void
+SDL_FreeSPSCDataQueue(SDL_SPSCDataQueue *queue)
+{
+    if (queue) {
+        SDL_FreeSPSCDataQueueRings(queue->oldest, NULL);
+        SDL_free(queue);
+    }
+}
+
+void
+SDL_ClearSPSCDataQueue(SDL_SPSCDataQueue *queue, const size_t slack)
+{
+    SDL_SPSCDataQueueRing *ring;
+
+    if (!queue) {
+        return;
+    }
+
+    /* nobody else is running, so we can rebuild everything around the newest (biggest) ring. */
+    ring = queue->writing;
+    SDL_FreeSPSCDataQueueRings(queue->oldest, ring);
+
+    if (ring->capacity > SDL_DataQueueCapacityFor(SDL_max(slack, SDL_DATAQUEUE_KEEP_CAPACITY))) {
+        SDL_SPSCDataQueueRing *smaller = SDL_NewSPSCDataQueueRing(slack);
+        if (smaller) {  /* if this fails, we just keep the bigger ring. */
+            SDL_free(ring);
+            ring = smaller;
+        }
     }
 
-    return (size_t) (ptr - buf);
+    SDL_AtomicSet(&ring->head, 0);
+    SDL_AtomicSet(&ring->tail, 0);
+    queue->oldest = queue->writing = ring;
+    SDL_AtomicSetPtr((void **) &queue->reading, ring);
+    SDL_AtomicSet(&queue->queued, 0);
 }
 
-size_t
-SDL_ReadFromDataQueue(SDL_DataQueue *queue, void *_buf, const size_t _len)
+/* Copies len bytes into ring at the write position; the caller publishes the new tail. */
+static void
+SDL_CopyToSPSCDataQueueRing(SDL_SPSCDataQueueRing *ring, const Uint32 tail, const Uint8 *data, const size_t len)
 {
-    size_t len = _len;
-    Uint8 *buf = (Uint8 *) _buf;
-    Uint8 *ptr = buf;
-    SDL_DataQueuePacket *packet;
+    const size_t offset = tail & (ring->capacity - 1);
+    const size_t first = SDL_min(len, ring->capacity - offset);
+
+    SDL_memcpy(ring->data + offset, data, first);
+    if (first < len) {
+        SDL_memcpy(ring->data, data + first, len - first);
+    }
+}
+
+int
+SDL_WriteToSPSCDataQueue(SDL_SPSCDataQueue *queue, const void *_data, const size_t len)
+{
+    const Uint8 *data = (const Uint8 *) _data;
+    SDL_SPSCDataQueueRing *ring;
+    SDL_SPSCDataQueueRing *newring = NULL;
+    Uint32 tail;
+    size_t avail;
+    size_t cpy;
 
     if (!queue) {
-        return 0;
+        return SDL_InvalidParamError("queue");
     }
 
-    while ((len > 0) && ((packet = queue->head) != NULL)) {
-        const size_t avail = packet->datalen - packet->startpos;
-        const size_t cpy = SDL_min(len, avail);
-        SDL_assert(queue->queued_bytes >= avail);
+    /* anything before the consumer's ring is ours to free now. */
+    ring = (SDL_SPSCDataQueueRing *) SDL_AtomicGetPtr((void **) &queue->reading);
+    SDL_MemoryBarrierAcquire();  /* the consumer is done with the rings before it. */
+    SDL_FreeSPSCDataQueueRings(queue->oldest, ring);
+    queue->oldest = ring;
 
-        SDL_memcpy(ptr, packet->data + packet->startpos, cpy);
-        packet->startpos += cpy;
-        ptr += cpy;
-        queue->queued_bytes -= cpy;
-        len -= cpy;
+    if (len == 0) {
+        return 0;
+    } else if (len > (size_t) (SDL_MAX_SINT32 - SDL_AtomicGet(&queue->queued))) {
+        return SDL_SetError("Data queue is full");
+    }
+
+    ring = queue->writing;
+    tail = (Uint32) SDL_AtomicGet(&ring->tail);
+    avail = ring->capacity - (size_t) (tail - (Uint32) SDL_AtomicGet(&ring->head));
+    SDL_MemoryBarrierAcquire();  /* don't overwrite bytes until the consumer has finished reading them. */
 
-        if (packet->startpos == packet->datalen) {  /* packet is done, put it in the pool. */
-            queue->head = packet->next;
-            SDL_assert((packet->next != NULL) || (packet == queue->tail));
-            packet->next = queue->pool;
-            queue->pool = packet;
+    /* get the next ring ready before we touch anything, so failing leaves the queue as it was. */
+    if (len > avail) {
+        newring = SDL_NewSPSCDataQueueRing(SDL_max(ring->capacity * 2, len - avail));
+        if (!newring) {
+            return -1;
         }
     }
 
-    SDL_assert((queue->head != NULL) == (queue->queued_bytes != 0));
+    /* count it first, so the consumer never takes away more than we've added. */
+    SDL_AtomicAdd(&queue->queued, (int) len);
 
-    if (queue->head == NULL) {
-        queue->tail = NULL;  /* in case we drained the queue entirely. */
+    cpy = SDL_min(len, avail);
+    if (cpy) {
+        SDL_CopyToSPSCDataQueueRing(ring, tail, data, cpy);
+        SDL_MemoryBarrierRelease();  /* SDL_AtomicSet only orders what comes after it. */
+        SDL_AtomicSet(&ring->tail, (int) (tail + (Uint32) cpy));
     }
 
-    return (size_t) (ptr - buf);
-}
+    if (newring) {
+        SDL_CopyToSPSCDataQueueRing(newring, 0, data + cpy, len - cpy);
+        SDL_AtomicSet(&newring->tail, (int) (len - cpy));
+        SDL_MemoryBarrierRelease();
+        SDL_AtomicSetPtr((void **) &ring->next, newring);  /* publish it; we never write to ring again. */
+        queue->writing = newring;
+    }
 
-size_t
-SDL_CountDataQueue(SDL_DataQueue *queue)
-{
-    return queue ? queue->queued_bytes : 0;
+    return 0;
 }
 
-void *
-SDL_ReserveSpaceInDataQueue(SDL_DataQueue *queue, const size_t len)
+size_t
+SDL_ReadFromSPSCDataQueue(SDL_SPSCDataQueue *queue, void *_buf, const size_t _len)
 {
-    SDL_DataQueuePacket *packet;
+    Uint8 *buf = (Uint8 *) _buf;
+    size_t len = _len;
+    size_t total = 0;
+    SDL_SPSCDataQueueRing *ring;
 
     if (!queue) {
-        SDL_InvalidParamError("queue");
-        return NULL;
-    } else if (len == 0) {
-        SDL_InvalidParamError("len");
-        return NULL;
-    } else if (len > queue->packet_size) {
-        SDL_SetError("len is larger than packet size");
-        return NULL;
+        return 0;
     }
 
-    packet = queue->head;
-    if (packet) {
-        const size_t avail = queue->packet_size - packet->datalen;
-        if (len <= avail) {  /* we can use the space at end of this packet. */
-            void *retval = packet->data + packet->datalen;
-            packet->datalen += len;
-            queue->queued_bytes += len;
-            return retval;
+    ring = queue->reading;
+    while (len > 0) {
+        const Uint32 head = (Uint32) SDL_AtomicGet(&ring->head);
+        const size_t avail = (size_t) ((Uint32) SDL_AtomicGet(&ring->tail) - head);
+        size_t offset, first, cpy;
+
+        SDL_MemoryBarrierAcquire();  /* see the data the producer wrote before publishing tail. */
+
+        if (avail == 0) {
+            SDL_SPSCDataQueueRing *next = (SDL_SPSCDataQueueRing *) SDL_AtomicGetPtr((void **) &ring->next);
+            SDL_MemoryBarrierAcquire();
+            if (!next) {
+                break;  /* drained everything there is. */
+            } else if ((Uint32) SDL_AtomicGet(&ring->tail) != head) {
+                continue;  /* more was written before the next ring was linked in. */
+            }
+            ring = next;
+            SDL_MemoryBarrierRelease();
+            SDL_AtomicSetPtr((void **) &queue->reading, ring);  /* producer can free the old one now. */
+            continue;
+        }
+
+        cpy = SDL_min(len, avail);
+        offset = head & (ring->capacity - 1);
+        first = SDL_min(cpy, ring->capacity - offset);
+        SDL_memcpy(buf, ring->data + offset, first);
+        if (first < cpy) {
+            SDL_memcpy(buf + first, ring->data, cpy - first);
         }
+        SDL_MemoryBarrierRelease();  /* finish reading before the producer may reuse the space. */
+        SDL_AtomicSet(&ring->head, (int) (head + (Uint32) cpy));
+
+        buf += cpy;
+        len -= cpy;
+        total += cpy;
     }
 
-    /* Need a fresh packet. */
-    packet = AllocateDataQueuePacket(queue);
-    if (!packet) {
-        SDL_OutOfMemory();
-        return NULL;
+    if (total) {
+        SDL_AtomicAdd(&queue->queued, -((int) total));
     }
 
-    packet->datalen = len;
-    queue->queued_bytes += len;
-    return packet->data;
+    return total;
 }
 
-/* vi: set ts=4 sw=4 expandtab: */
+size_t
+SDL_CountSPSCDataQueue(SDL_SPSCDataQueue *queue)
+{
+    return queue ? (size_t) SDL_AtomicGet(&queue->queued) : 0;
+}
 
+/* vi: set ts=4 sw=4 expandtab: */
@@ -34,20 +34,37 @@ size_t SDL_ReadFromDataQueue(SDL_DataQueue *queue, void *buf, const size_t len);
 size_t SDL_PeekIntoDataQueue(SDL_DataQueue *queue, void *buf, const size_t len);
 size_t SDL_CountDataQueue(SDL_DataQueue *queue);
 
-/* this sets a section of the data queue aside (possibly allocating memory for it)
-   as if it's been written to, but returns a pointer to that space. You may write
-   to this space until a read would consume it. Writes (and other calls to this
-   function) will safely append their data after this reserved space and can
-   be in flight at the same time. There is no thread safety.
-   If there isn't an existing block of memory that can contain the reserved
-   space, one will be allocated for it. You can not (currently) allocate
-   a space larger than the packetlen requested in SDL_NewDataQueue.
-   Returned buffer is uninitialized.
-   This lets you avoid an extra copy in some cases, but it's safer to use
-   SDL_WriteToDataQueue() unless you know what you're doing.
-   Returns pointer to buffer of at least (len) bytes, NULL on error.
-*/
-void *SDL_ReserveSpaceInDataQueue(SDL_DataQueue *queue, const size_t len);
+/* this returns a pointer to the data at the front of the queue without
+   consuming it, and sets (*len) to the number of bytes available there. That
+   can be less than SDL_CountDataQueue() if the data wraps around the end of
+   the ring buffer, but is never less than a packet (or everything queued,
+   if that's smaller).
+   Use SDL_DiscardFromDataQueue() to consume the data once you're done with it.
+   Returns NULL if the queue is empty. */
+const void *SDL_PeekDataQueueBuffer(SDL_DataQueue *queue, size_t *len);
+
+/* this consumes up to (len) bytes from the front of the queue without
+   copying them anywhere. Returns the number of bytes consumed. */
+size_t SDL_DiscardFromDataQueue(SDL_DataQueue *queue, const size_t len);
+
+
+/* A single-producer/single-consumer variant of the data queue. One thread
+   writes, one other thread reads, and neither ever blocks or waits on the
+   other. It grows like SDL_DataQueue does, by chaining on bigger buffers;
+   memory is only ever allocated and freed on the writing side.
+
+   SDL_CountSPSCDataQueue() is safe from any thread. SDL_ClearSPSCDataQueue()
+   and SDL_FreeSPSCDataQueue() need both sides to be stopped, so the caller
+   has to lock out the other thread for those. */
+struct SDL_SPSCDataQueue;
+typedef struct SDL_SPSCDataQueue SDL_SPSCDataQueue;
+
+SDL_SPSCDataQueue *SDL_NewSPSCDataQueue(const size_t initialslack);
+void SDL_FreeSPSCDataQueue(SDL_SPSCDataQueue *queue);
+void SDL_ClearSPSCDataQueue(SDL_SPSCDataQueue *queue, const size_t slack);
+int SDL_WriteToSPSCDataQueue(SDL_SPSCDataQueue *queue, const void *data, const size_t len);
+size_t SDL_ReadFromSPSCDataQueue(SDL_SPSCDataQueue *queue, void *buf, const size_t len);
+size_t SDL_CountSPSCDataQueue(SDL_SPSCDataQueue *queue);
 
 #endif /* SDL_dataqueue_h_ */
 
@@ -53,6 +53,19 @@
 
 #include "SDL_config.h"
 
+/* Code for instruction sets newer than the build's baseline is compiled with
+   per-function target attributes and chosen at runtime with SDL_HasAVX2() etc. */
+#if defined(HAVE_IMMINTRIN_H) && !defined(SDL_DISABLE_IMMINTRIN_H) && (defined(__i386__) || defined(__x86_64__)) && \
+    (defined(__clang__) || (__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define SDL_SSE4_1_INTRINSICS 1
+#define SDL_AVX2_INTRINSICS 1
+#define SDL_TARGETING(x) __attribute__((target(x)))
+#elif defined(_MSC_VER) && (_MSC_VER >= 1800) && (defined(_M_IX86) || defined(_M_X64)) && !defined(__clang__)
+#define SDL_SSE4_1_INTRINSICS 1
+#define SDL_AVX2_INTRINSICS 1
+#define SDL_TARGETING(x)
+#endif
+
 /* A few #defines to reduce SDL2 footprint.
    Only effective when library is statically linked.
    You have to manually edit this file. */
@@ -571,12 +571,16 @@ SDL_BufferQueueDrainCallback(void *userdata, Uint8 *stream, int len)
     SDL_assert(!device->iscapture);  /* this shouldn't ever happen, right?! */
     SDL_assert(len >= 0);  /* this shouldn't ever happen, right?! */
 
-    dequeued = SDL_ReadFromDataQueue(device->buffer_queue, stream, len);
+    if (device->spsc_queue) {
+        dequeued = SDL_ReadFromSPSCDataQueue(device->spsc_queue, stream, len);
+    } else {
+        dequeued = SDL_ReadFromDataQueue(device->buffer_queue, stream, len);
+    }
     stream += dequeued;
     len -= (int) dequeued;
 
     if (len > 0) {  /* fill any remaining space in the stream with silence. */
-        SDL_assert(SDL_CountDataQueue(device->buffer_queue) == 0);
+        SDL_assert(device->spsc_queue || (SDL_CountDataQueue(device->buffer_queue) == 0));
         SDL_memset(stream, device->spec.silence, len);
     }
 }
@@ -594,7 +598,11 @@ SDL_BufferQueueFillCallback(void *userdata, Uint8 *stream, int len)
     /* note that if this needs to allocate more space and run out of memory,
        we have no choice but to quietly drop the data and hope it works out
        later, but you probably have bigger problems in this case anyhow. */
-    SDL_WriteToDataQueue(device->buffer_queue, stream, len);
+    if (device->spsc_queue) {
+        SDL_WriteToSPSCDataQueue(device->spsc_queue, stream, len);
+    } else {
+        SDL_WriteToDataQueue(device->buffer_queue, stream, len);
+    }
 }
 
 int
@@ -611,7 +619,12 @@ SDL_QueueAudio(SDL_AudioDeviceID devid, const void *data, Uint32 len)
         return SDL_SetError("Audio device has a callback, queueing not allowed");
     }
 
-    if (len > 0) {
+    if (len == 0) {
+        /* nothing to do. */
+    } else if (device->spsc_queue) {
+        /* the audio thread reads without the lock, so we don't need it either. */
+        rc = SDL_WriteToSPSCDataQueue(device->spsc_queue, data, len);
+    } else {
         current_audio.impl.LockDevice(device);
         rc = SDL_WriteToDataQueue(device->buffer_queue, data, len);
         current_audio.impl.UnlockDevice(device);
@@ -633,6 +646,10 @@ SDL_DequeueAudio(SDL_AudioDeviceID devid, void *data, Uint32 len)
         return 0;  /* just report zero bytes dequeued. */
     }
 
+    if (device->spsc_queue) {
+        return (Uint32) SDL_ReadFromSPSCDataQueue(device->spsc_queue, data, len);
+    }
+
     current_audio.impl.LockDevice(device);
     rc = (Uint32) SDL_ReadFromDataQueue(device->buffer_queue, data, len);
     current_audio.impl.UnlockDevice(device);
@@ -650,8 +667,10 @@ SDL_GetQueuedAudioSize(SDL_AudioDeviceID devid)
     }
 
     /* Nothing to do unless we're set up for queueing. */
-    if (device->callbackspec.callback == SDL_BufferQueueDrainCallback ||
-        device->callbackspec.callback == SDL_BufferQueueFillCallback)
+    if (device->spsc_queue) {
+        retval = (Uint32) SDL_CountSPSCDataQueue(device->spsc_queue);
+    } else if (device->callbackspec.callback == SDL_BufferQueueDrainCallback ||
+               device->callbackspec.callback == SDL_BufferQueueFillCallback)
     {
         current_audio.impl.LockDevice(device);
         retval = (Uint32) SDL_CountDataQueue(device->buffer_queue);
@@ -676,6 +695,10 @@ SDL_ClearQueuedAudio(SDL_AudioDeviceID devid)
     /* Keep up to two packets in the pool to reduce future malloc pressure. */
     SDL_ClearDataQueue(device->buffer_queue, SDL_AUDIOBUFFERQUEUE_PACKETLEN * 2);
 
+    /* Holding the lock keeps the audio thread out of the lock-free queue, too;
+       the app is the other side, so nobody else can be touching it. */
+    SDL_ClearSPSCDataQueue(device->spsc_queue, SDL_AUDIOBUFFERQUEUE_PACKETLEN * 2);
+
     current_audio.impl.UnlockDevice(device);
 }
 
@@ -726,6 +749,14 @@ SDL_RunAudio(void *devicep)
             data = NULL;
         }
 
+        if (data == NULL && device->stream) {
+            /* Have the callback write straight into the stream, if it can take all of it. */
+            void *streambuf = NULL;
+            if (SDL_AudioStreamPeekPut(device->stream, &streambuf, data_len) == data_len) {
+                data = (Uint8 *) streambuf;
+            }
+        }
+
         if (data == NULL) {
             data = device->work_buffer;
         }
@@ -742,7 +773,11 @@ SDL_RunAudio(void *devicep)
         if (device->stream) {
             /* Stream available audio to device, converting/resampling. */
             /* if this fails...oh well. We'll play silence here. */
-            SDL_AudioStreamPut(device->stream, data, data_len);
+            if (data == device->work_buffer) {
+                SDL_AudioStreamPut(device->stream, data, data_len);
+            } else {
+                SDL_AudioStreamCommitPut(device->stream, data_len);
+            }
 
             while (SDL_AudioStreamAvailable(device->stream) >= ((int) device->spec.size)) {
                 int got;
@@ -1147,6 +1182,7 @@ close_audio_device(SDL_AudioDevice * device)
     }
 
     SDL_FreeDataQueue(device->buffer_queue);
+    SDL_FreeSPSCDataQueue(device->spsc_queue);
 
     SDL_free(device);
 }
@@ -1412,8 +1448,12 @@ open_audio_device(const char *devname, int iscapture,
 
     if (device->spec.callback == NULL) {  /* use buffer queueing? */
         /* pool a few packets to start. Enough for two callbacks. */
-        device->buffer_queue = SDL_NewDataQueue(SDL_AUDIOBUFFERQUEUE_PACKETLEN, obtained->size * 2);
-        if (!device->buffer_queue) {
+        if (SDL_GetHintBoolean(SDL_HINT_AUDIO_QUEUE_LOCKFREE, SDL_FALSE)) {
+            device->spsc_queue = SDL_NewSPSCDataQueue(obtained->size * 2);
+        } else {
+            device->buffer_queue = SDL_NewDataQueue(SDL_AUDIOBUFFERQUEUE_PACKETLEN, obtained->size * 2);
+        }
+        if (!device->buffer_queue && !device->spsc_queue) {
             close_audio_device(device);
             SDL_SetError("Couldn't create audio buffer queue");
             return 0;
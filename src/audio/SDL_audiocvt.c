@@ -40,6 +40,129 @@
 #define HAVE_SSE3_INTRINSICS 1
 #endif
 
+#ifdef __SSE2__
+#define HAVE_SSE2_INTRINSICS 1
+#endif
+
+#ifdef __ARM_NEON
+#define HAVE_NEON_INTRINSICS 1
+#endif
+
+/* Single-frame channel conversions. The scalar converters are loops over
+   these, and the SIMD converters use them for the frames they can't do a
+   block at a time. Each one reads the whole source frame before writing, so
+   they work in place whether the buffer is growing or shrinking. */
+
+static SDL_INLINE void
+SDL_ConvertStereoToMonoFrame(const float *src, float *dst)
+{
+    dst[0] = (src[0] + src[1]) * 0.5f;
+}
+
+/* Average left and right, distribute center, discard LFE. */
+static SDL_INLINE void
+SDL_Convert51ToStereoFrame(const float *src, float *dst)
+{
+    /* SDL's 5.1 layout: FL+FR+FC+LFE+BL+BR */
+    const float front_center_distributed = src[2] * 0.5f;
+    const float left = (src[0] + front_center_distributed + src[4]) / 2.5f;
+    const float right = (src[1] + front_center_distributed + src[5]) / 2.5f;
+    dst[0] = left;
+    dst[1] = right;
+}
+
+static SDL_INLINE void
+SDL_ConvertQuadToStereoFrame(const float *src, float *dst)
+{
+    const float left = (src[0] + src[2]) * 0.5f;
+    const float right = (src[1] + src[3]) * 0.5f;
+    dst[0] = left;
+    dst[1] = right;
+}
+
+/* Distribute sides across front and back. */
+static SDL_INLINE void
+SDL_Convert71To51Frame(const float *src, float *dst)
+{
+    const float surround_left_distributed = src[6] * 0.5f;
+    const float surround_right_distributed = src[7] * 0.5f;
+    const float fl = (src[0] + surround_left_distributed) / 1.5f;
+    const float fr = (src[1] + surround_right_distributed) / 1.5f;
+    const float cc = src[2] / 1.5f;
+    const float lfe = src[3] / 1.5f;
+    const float bl = (src[4] + surround_left_distributed) / 1.5f;
+    const float br = (src[5] + surround_right_distributed) / 1.5f;
+    dst[0] = fl;
+    dst[1] = fr;
+    dst[2] = cc;
+    dst[3] = lfe;
+    dst[4] = bl;
+    dst[5] = br;
+}
+
+static SDL_INLINE void
+SDL_ConvertMonoToStereoFrame(const float *src, float *dst)
+{
+    const float sample = src[0];
+    dst[0] = dst[1] = sample;
+}
+
+static SDL_INLINE void
+SDL_ConvertStereoTo51Frame(const float *src, float *dst)
+{
+    const float lf = src[0];
+    const float rf = src[1];
+    const float ce = (lf + rf) * 0.5f;
+    /* !!! FIXME: FL and FR may clip */
+    dst[0] = lf + (lf - ce);  /* FL */
+    dst[1] = rf + (rf - ce);  /* FR */
+    dst[2] = ce;  /* FC */
+    dst[3] = 0;   /* LFE (only meant for special LFE effects) */
+    dst[4] = lf;  /* BL */
+    dst[5] = rf;  /* BR */
+}
+
+static SDL_INLINE void
+SDL_Convert51To71Frame(const float *src, float *dst)
+{
+    float lf = src[0];
+    float rf = src[1];
+    const float fc = src[2];
+    const float lfe = src[3];
+    float lb = src[4];
+    float rb = src[5];
+    const float ls = (lf + lb) * 0.5f;
+    const float rs = (rf + rb) * 0.5f;
+    /* !!! FIXME: these four may clip */
+    lf += lf - ls;
+    rf += rf - ls;
+    lb += lb - ls;
+    rb += rb - ls;
+    dst[0] = lf;  /* FL */
+    dst[1] = rf;  /* FR */
+    dst[2] = fc;  /* FC */
+    dst[3] = lfe;  /* LFE */
+    dst[4] = lb;  /* BL */
+    dst[5] = rb;  /* BR */
+    dst[6] = ls; /* SL */
+    dst[7] = rs; /* SR */
+}
+
+/* How many frames to convert one at a time, stepping (step) floats each,
+   before dst is aligned to (mask + 1) bytes. Returns 0 if that never happens
+   in a few frames; the SIMD loops use unaligned stores either way. */
+static SDL_INLINE int
+SDL_ChannelAlignmentFrames(const float *dst, const int step, const int frames, const size_t mask)
+{
+    int i;
+    for (i = 0; (i < 8) && (i <= frames); i++) {
+        if ((((size_t) (dst + (i * step))) & mask) == 0) {
+            return i;
+        }
+    }
+    return 0;
+}
+
 #if HAVE_SSE3_INTRINSICS
 /* Convert from stereo to mono. Average left and right. */
 static void SDLCALL
@@ -65,7 +188,7 @@ SDL_ConvertStereoToMono_SSE3(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 
     /* Finish off any leftovers with scalar operations. */
     while (i) {
-        *dst = (src[0] + src[1]) * 0.5f;
+        SDL_ConvertStereoToMonoFrame(src, dst);
         dst++; i--; src += 2;
     }
 
@@ -78,7 +201,7 @@ SDL_ConvertStereoToMono_SSE3(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 
 /* Convert from stereo to mono. Average left and right. */
 static void SDLCALL
-SDL_ConvertStereoToMono(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+SDL_ConvertStereoToMono_Scalar(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 {
     float *dst = (float *) cvt->buf;
     const float *src = dst;
@@ -87,8 +210,8 @@ SDL_ConvertStereoToMono(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     LOG_DEBUG_CONVERT("stereo", "mono");
     SDL_assert(format == AUDIO_F32SYS);
 
-    for (i = cvt->len_cvt / 8; i; --i, src += 2) {
-        *(dst++) = (src[0] + src[1]) * 0.5f;
+    for (i = cvt->len_cvt / 8; i; --i, src += 2, dst++) {
+        SDL_ConvertStereoToMonoFrame(src, dst);
     }
 
     cvt->len_cvt /= 2;
@@ -100,7 +223,7 @@ SDL_ConvertStereoToMono(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 
 /* Convert from 5.1 to stereo. Average left and right, distribute center, discard LFE. */
 static void SDLCALL
-SDL_Convert51ToStereo(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+SDL_Convert51ToStereo_Scalar(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 {
     float *dst = (float *) cvt->buf;
     const float *src = dst;
@@ -109,11 +232,8 @@ SDL_Convert51ToStereo(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     LOG_DEBUG_CONVERT("5.1", "stereo");
     SDL_assert(format == AUDIO_F32SYS);
 
-    /* SDL's 5.1 layout: FL+FR+FC+LFE+BL+BR */
     for (i = cvt->len_cvt / (sizeof (float) * 6); i; --i, src += 6, dst += 2) {
-        const float front_center_distributed = src[2] * 0.5f;
-        dst[0] = (src[0] + front_center_distributed + src[4]) / 2.5f;  /* left */
-        dst[1] = (src[1] + front_center_distributed + src[5]) / 2.5f;  /* right */
+        SDL_Convert51ToStereoFrame(src, dst);
     }
 
     cvt->len_cvt /= 3;
@@ -125,7 +245,7 @@ SDL_Convert51ToStereo(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 
 /* Convert from quad to stereo. Average left and right. */
 static void SDLCALL
-SDL_ConvertQuadToStereo(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+SDL_ConvertQuadToStereo_Scalar(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 {
     float *dst = (float *) cvt->buf;
     const float *src = dst;
@@ -135,8 +255,7 @@ SDL_ConvertQuadToStereo(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     SDL_assert(format == AUDIO_F32SYS);
 
     for (i = cvt->len_cvt / (sizeof (float) * 4); i; --i, src += 4, dst += 2) {
-        dst[0] = (src[0] + src[2]) * 0.5f; /* left */
-        dst[1] = (src[1] + src[3]) * 0.5f; /* right */
+        SDL_ConvertQuadToStereoFrame(src, dst);
     }
 
     cvt->len_cvt /= 2;
@@ -148,7 +267,7 @@ SDL_ConvertQuadToStereo(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 
 /* Convert from 7.1 to 5.1. Distribute sides across front and back. */
 static void SDLCALL
-SDL_Convert71To51(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+SDL_Convert71To51_Scalar(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 {
     float *dst = (float *) cvt->buf;
     const float *src = dst;
@@ -158,14 +277,7 @@ SDL_Convert71To51(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     SDL_assert(format == AUDIO_F32SYS);
 
     for (i = cvt->len_cvt / (sizeof (float) * 8); i; --i, src += 8, dst += 6) {
-        const float surround_left_distributed = src[6] * 0.5f;
-        const float surround_right_distributed = src[7] * 0.5f;
-        dst[0] = (src[0] + surround_left_distributed) / 1.5f;  /* FL */
-        dst[1] = (src[1] + surround_right_distributed) / 1.5f;  /* FR */
-        dst[2] = src[2] / 1.5f; /* CC */
-        dst[3] = src[3] / 1.5f; /* LFE */
-        dst[4] = (src[4] + surround_left_distributed) / 1.5f;  /* BL */
-        dst[5] = (src[5] + surround_right_distributed) / 1.5f;  /* BR */
+        SDL_Convert71To51Frame(src, dst);
     }
 
     cvt->len_cvt /= 8;
@@ -207,7 +319,7 @@ SDL_Convert51ToQuad(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 
 /* Upmix mono to stereo (by duplication) */
 static void SDLCALL
-SDL_ConvertMonoToStereo(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+SDL_ConvertMonoToStereo_Scalar(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 {
     const float *src = (const float *) (cvt->buf + cvt->len_cvt);
     float *dst = (float *) (cvt->buf + cvt->len_cvt * 2);
@@ -219,7 +331,7 @@ SDL_ConvertMonoToStereo(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     for (i = cvt->len_cvt / sizeof (float); i; --i) {
         src--;
         dst -= 2;
-        dst[0] = dst[1] = *src;
+        SDL_ConvertMonoToStereoFrame(src, dst);
     }
 
     cvt->len_cvt *= 2;
@@ -231,10 +343,9 @@ SDL_ConvertMonoToStereo(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 
 /* Upmix stereo to a pseudo-5.1 stream */
 static void SDLCALL
-SDL_ConvertStereoTo51(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+SDL_ConvertStereoTo51_Scalar(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 {
     int i;
-    float lf, rf, ce;
     const float *src = (const float *) (cvt->buf + cvt->len_cvt);
     float *dst = (float *) (cvt->buf + cvt->len_cvt * 3);
 
@@ -244,16 +355,7 @@ SDL_ConvertStereoTo51(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     for (i = cvt->len_cvt / (sizeof(float) * 2); i; --i) {
         dst -= 6;
         src -= 2;
-        lf = src[0];
-        rf = src[1];
-        ce = (lf + rf) * 0.5f;
-        /* !!! FIXME: FL and FR may clip */
-        dst[0] = lf + (lf - ce);  /* FL */
-        dst[1] = rf + (rf - ce);  /* FR */
-        dst[2] = ce;  /* FC */
-        dst[3] = 0;   /* LFE (only meant for special LFE effects) */
-        dst[4] = lf;  /* BL */
-        dst[5] = rf;  /* BR */
+        SDL_ConvertStereoTo51Frame(src, dst);
     }
 
     cvt->len_cvt *= 3;
@@ -332,9 +434,8 @@ SDL_ConvertStereoToQuad(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 
 /* Upmix 5.1 to 7.1 */
 static void SDLCALL
-SDL_Convert51To71(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+SDL_Convert51To71_Scalar(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 {
-    float lf, rf, lb, rb, ls, rs;
     int i;
     const float *src = (const float *) (cvt->buf + cvt->len_cvt);
     float *dst = (float *) (cvt->buf + cvt->len_cvt * 4 / 3);
@@ -346,33 +447,937 @@ SDL_Convert51To71(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     for (i = cvt->len_cvt / (sizeof(float) * 6); i; --i) {
         dst -= 8;
         src -= 6;
-        lf = src[0];
-        rf = src[1];
-        lb = src[4];
-        rb = src[5];
-        ls = (lf + lb) * 0.5f;
-        rs = (rf + rb) * 0.5f;
-        /* !!! FIXME: these four may clip */
-        lf += lf - ls;
-        rf += rf - ls;
-        lb += lb - ls;
-        rb += rb - ls;
-        dst[3] = src[3];  /* LFE */
-        dst[2] = src[2];  /* FC */
-        dst[7] = rs; /* SR */
-        dst[6] = ls; /* SL */
-        dst[5] = rb;  /* BR */
-        dst[4] = lb;  /* BL */
-        dst[1] = rf;  /* FR */
-        dst[0] = lf;  /* FL */
+        SDL_Convert51To71Frame(src, dst);
+    }
+
+    cvt->len_cvt = cvt->len_cvt * 4 / 3;
+
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index] (cvt, format);
+    }
+}
+
+/* The SIMD channel converters do a small block of frames per iteration: a
+   whole number of frames that fills a whole number of vectors on both sides.
+   Downmixes walk forward and upmixes walk backward, like the scalar versions,
+   and each block is fully loaded before it's stored, so they work in place.
+   They use the same operations in the same order as the scalar code, so the
+   results are bit-identical whichever one runs. */
+
+#if HAVE_SSE2_INTRINSICS
+static void SDLCALL
+SDL_Convert51ToStereo_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    float *dst = (float *) cvt->buf;
+    const float *src = dst;
+    int i = cvt->len_cvt / (sizeof (float) * 6);
+    int head = SDL_ChannelAlignmentFrames(dst, 2, i, 15);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 divisor = _mm_set1_ps(2.5f);
+
+    LOG_DEBUG_CONVERT("5.1", "stereo (using SSE2)");
+    SDL_assert(format == AUDIO_F32SYS);
+
+    for (i -= head; head; --head, src += 6, dst += 2) {
+        SDL_Convert51ToStereoFrame(src, dst);
+    }
+
+    /* two frames: FL0 FR0 FC0 LFE0 | BL0 BR0 FL1 FR1 | FC1 LFE1 BL1 BR1 */
+    for (; i >= 2; i -= 2, src += 12, dst += 4) {
+        const __m128 a = _mm_loadu_ps(src);
+        const __m128 b = _mm_loadu_ps(src + 4);
+        const __m128 c = _mm_loadu_ps(src + 8);
+        const __m128 front = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 2, 1, 0));
+        const __m128 center = _mm_shuffle_ps(a, c, _MM_SHUFFLE(0, 0, 2, 2));
+        const __m128 back = _mm_shuffle_ps(b, c, _MM_SHUFFLE(3, 2, 1, 0));
+        _mm_storeu_ps(dst, _mm_div_ps(_mm_add_ps(_mm_add_ps(front, _mm_mul_ps(center, half)), back), divisor));
+    }
+
+    for (; i; --i, src += 6, dst += 2) {
+        SDL_Convert51ToStereoFrame(src, dst);
+    }
+
+    cvt->len_cvt /= 3;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index] (cvt, format);
+    }
+}
+
+static void SDLCALL
+SDL_ConvertQuadToStereo_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    float *dst = (float *) cvt->buf;
+    const float *src = dst;
+    int i = cvt->len_cvt / (sizeof (float) * 4);
+    int head = SDL_ChannelAlignmentFrames(dst, 2, i, 15);
+    const __m128 half = _mm_set1_ps(0.5f);
+
+    LOG_DEBUG_CONVERT("quad", "stereo (using SSE2)");
+    SDL_assert(format == AUDIO_F32SYS);
+
+    for (i -= head; head; --head, src += 4, dst += 2) {
+        SDL_ConvertQuadToStereoFrame(src, dst);
+    }
+
+    /* two frames: FL0 FR0 BL0 BR0 | FL1 FR1 BL1 BR1 */
+    for (; i >= 2; i -= 2, src += 8, dst += 4) {
+        const __m128 a = _mm_loadu_ps(src);
+        const __m128 b = _mm_loadu_ps(src + 4);
+        _mm_storeu_ps(dst, _mm_mul_ps(_mm_add_ps(_mm_movelh_ps(a, b), _mm_movehl_ps(b, a)), half));
+    }
+
+    for (; i; --i, src += 4, dst += 2) {
+        SDL_ConvertQuadToStereoFrame(src, dst);
+    }
+
+    cvt->len_cvt /= 2;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index] (cvt, format);
+    }
+}
+
+static void SDLCALL
+SDL_Convert71To51_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    float *dst = (float *) cvt->buf;
+    const float *src = dst;
+    int i = cvt->len_cvt / (sizeof (float) * 8);
+    int head = SDL_ChannelAlignmentFrames(dst, 6, i, 15);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 divisor = _mm_set1_ps(1.5f);
+
+    LOG_DEBUG_CONVERT("7.1", "5.1 (using SSE2)");
+    SDL_assert(format == AUDIO_F32SYS);
+
+    for (i -= head; head; --head, src += 8, dst += 6) {
+        SDL_Convert71To51Frame(src, dst);
+    }
+
+    /* two frames: FL0 FR0 FC0 LFE0 | BL0 BR0 SL0 SR0 | (frame 1 likewise) */
+    for (; i >= 2; i -= 2, src += 16, dst += 12) {
+        const __m128 a0 = _mm_loadu_ps(src);
+        const __m128 b0 = _mm_loadu_ps(src + 4);
+        const __m128 a1 = _mm_loadu_ps(src + 8);
+        const __m128 b1 = _mm_loadu_ps(src + 12);
+        const __m128 sides0 = _mm_mul_ps(_mm_shuffle_ps(b0, b0, _MM_SHUFFLE(3, 2, 3, 2)), half);
+        const __m128 sides1 = _mm_mul_ps(_mm_shuffle_ps(b1, b1, _MM_SHUFFLE(3, 2, 3, 2)), half);
+        /* center and LFE don't get anything added, not even zero, to keep -0.0f intact. */
+        const __m128 front0 = _mm_div_ps(_mm_shuffle_ps(_mm_add_ps(a0, sides0), a0, _MM_SHUFFLE(3, 2, 1, 0)), divisor);
+        const __m128 front1 = _mm_div_ps(_mm_shuffle_ps(_mm_add_ps(a1, sides1), a1, _MM_SHUFFLE(3, 2, 1, 0)), divisor);
+        const __m128 back0 = _mm_div_ps(_mm_add_ps(b0, sides0), divisor);
+        const __m128 back1 = _mm_div_ps(_mm_add_ps(b1, sides1), divisor);
+        _mm_storeu_ps(dst, front0);
+        _mm_storeu_ps(dst + 4, _mm_movelh_ps(back0, front1));
+        _mm_storeu_ps(dst + 8, _mm_shuffle_ps(front1, back1, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+
+    for (; i; --i, src += 8, dst += 6) {
+        SDL_Convert71To51Frame(src, dst);
+    }
+
+    cvt->len_cvt /= 8;
+    cvt->len_cvt *= 6;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index] (cvt, format);
+    }
+}
+
+static void SDLCALL
+SDL_ConvertMonoToStereo_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    const float *src = (const float *) (cvt->buf + cvt->len_cvt);
+    float *dst = (float *) (cvt->buf + cvt->len_cvt * 2);
+    int i = cvt->len_cvt / sizeof (float);
+    int tail = SDL_ChannelAlignmentFrames(dst, -2, i, 15);
+
+    LOG_DEBUG_CONVERT("mono", "stereo (using SSE2)");
+    SDL_assert(format == AUDIO_F32SYS);
+
+    for (i -= tail; tail; --tail) {
+        src--;
+        dst -= 2;
+        SDL_ConvertMonoToStereoFrame(src, dst);
+    }
+
+    for (; i >= 4; i -= 4) {
+        __m128 v;
+        src -= 4;
+        dst -= 8;
+        v = _mm_loadu_ps(src);
+        _mm_storeu_ps(dst, _mm_unpacklo_ps(v, v));
+        _mm_storeu_ps(dst + 4, _mm_unpackhi_ps(v, v));
+    }
+
+    for (; i; --i) {
+        src--;
+        dst -= 2;
+        SDL_ConvertMonoToStereoFrame(src, dst);
+    }
+
+    cvt->len_cvt *= 2;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index] (cvt, format);
+    }
+}
+
+static void SDLCALL
+SDL_ConvertStereoTo51_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    const float *src = (const float *) (cvt->buf + cvt->len_cvt);
+    float *dst = (float *) (cvt->buf + cvt->len_cvt * 3);
+    int i = cvt->len_cvt / (sizeof (float) * 2);
+    int tail = SDL_ChannelAlignmentFrames(dst, -6, i, 15);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 zero = _mm_setzero_ps();
+
+    LOG_DEBUG_CONVERT("stereo", "5.1 (using SSE2)");
+    SDL_assert(format == AUDIO_F32SYS);
+
+    for (i -= tail; tail; --tail) {
+        dst -= 6;
+        src -= 2;
+        SDL_ConvertStereoTo51Frame(src, dst);
+    }
+
+    /* two frames in: L0 R0 L1 R1, out: FL0 FR0 FC0 LFE0 | BL0 BR0 FL1 FR1 | FC1 LFE1 BL1 BR1 */
+    for (; i >= 2; i -= 2) {
+        __m128 v, ce, front, ce0, ce1;
+        dst -= 12;
+        src -= 4;
+        v = _mm_loadu_ps(src);
+        ce = _mm_mul_ps(_mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1))), half);
+        front = _mm_add_ps(v, _mm_sub_ps(v, ce));
+        ce0 = _mm_unpacklo_ps(ce, zero);  /* FC0 0 FC0 0 */
+        ce1 = _mm_unpackhi_ps(ce, zero);  /* FC1 0 FC1 0 */
+        _mm_storeu_ps(dst, _mm_shuffle_ps(front, ce0, _MM_SHUFFLE(1, 0, 1, 0)));
+        _mm_storeu_ps(dst + 4, _mm_shuffle_ps(v, front, _MM_SHUFFLE(3, 2, 1, 0)));
+        _mm_storeu_ps(dst + 8, _mm_shuffle_ps(ce1, v, _MM_SHUFFLE(3, 2, 1, 0)));
+    }
+
+    for (; i; --i) {
+        dst -= 6;
+        src -= 2;
+        SDL_ConvertStereoTo51Frame(src, dst);
+    }
+
+    cvt->len_cvt *= 3;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index] (cvt, format);
+    }
+}
+
+static void SDLCALL
+SDL_Convert51To71_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    const float *src = (const float *) (cvt->buf + cvt->len_cvt);
+    float *dst = (float *) (cvt->buf + cvt->len_cvt * 4 / 3);
+    int i = cvt->len_cvt / (sizeof (float) * 6);
+    int tail = SDL_ChannelAlignmentFrames(dst, -8, i, 15);
+    const __m128 half = _mm_set1_ps(0.5f);
+
+    LOG_DEBUG_CONVERT("5.1", "7.1 (using SSE2)");
+    SDL_assert(format == AUDIO_F32SYS);
+    SDL_assert(cvt->len_cvt % (sizeof(float) * 6) == 0);
+
+    for (i -= tail; tail; --tail) {
+        dst -= 8;
+        src -= 6;
+        SDL_Convert51To71Frame(src, dst);
+    }
+
+    /* two frames in: FL0 FR0 FC0 LFE0 | BL0 BR0 FL1 FR1 | FC1 LFE1 BL1 BR1 */
+    for (; i >= 2; i -= 2) {
+        __m128 a, b, c, front, back, sides, left;
+        dst -= 16;
+        src -= 12;
+        a = _mm_loadu_ps(src);
+        b = _mm_loadu_ps(src + 4);
+        c = _mm_loadu_ps(src + 8);
+        front = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 2, 1, 0));
+        back = _mm_shuffle_ps(b, c, _MM_SHUFFLE(3, 2, 1, 0));
+        sides = _mm_mul_ps(_mm_add_ps(front, back), half);  /* SL0 SR0 SL1 SR1 */
+        left = _mm_shuffle_ps(sides, sides, _MM_SHUFFLE(2, 2, 0, 0));  /* the scalar code takes the left side for both */
+        front = _mm_add_ps(front, _mm_sub_ps(front, left));
+        back = _mm_add_ps(back, _mm_sub_ps(back, left));
+        _mm_storeu_ps(dst, _mm_shuffle_ps(front, a, _MM_SHUFFLE(3, 2, 1, 0)));
+        _mm_storeu_ps(dst + 4, _mm_movelh_ps(back, sides));
+        _mm_storeu_ps(dst + 8, _mm_shuffle_ps(front, c, _MM_SHUFFLE(1, 0, 3, 2)));
+        _mm_storeu_ps(dst + 12, _mm_movehl_ps(sides, back));
+    }
+
+    for (; i; --i) {
+        dst -= 8;
+        src -= 6;
+        SDL_Convert51To71Frame(src, dst);
     }
 
     cvt->len_cvt = cvt->len_cvt * 4 / 3;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index] (cvt, format);
+    }
+}
+#endif
+
+#if SDL_AVX2_INTRINSICS
+/* These only cover the conversions where two SSE-sized blocks side by side
+   still come out in order, one per 128-bit lane. */
+SDL_TARGETING("avx2") static void SDLCALL
+SDL_Convert51ToStereo_AVX2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    float *dst = (float *) cvt->buf;
+    const float *src = dst;
+    int i = cvt->len_cvt / (sizeof (float) * 6);
+    int head = SDL_ChannelAlignmentFrames(dst, 2, i, 31);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 divisor = _mm256_set1_ps(2.5f);
 
+    LOG_DEBUG_CONVERT("5.1", "stereo (using AVX2)");
+    SDL_assert(format == AUDIO_F32SYS);
+
+    for (i -= head; head; --head, src += 6, dst += 2) {
+        SDL_Convert51ToStereoFrame(src, dst);
+    }
+
+    /* four frames, regrouped so each lane holds the SSE2 version's two-frame block */
+    for (; i >= 4; i -= 4, src += 24, dst += 8) {
+        const __m256 v0 = _mm256_loadu_ps(src);
+        const __m256 v1 = _mm256_loadu_ps(src + 8);
+        const __m256 v2 = _mm256_loadu_ps(src + 16);
+        const __m256 a = _mm256_permute2f128_ps(v0, v1, 0x30);
+        const __m256 b = _mm256_permute2f128_ps(v0, v2, 0x21);
+        const __m256 c = _mm256_permute2f128_ps(v1, v2, 0x30);
+        const __m256 front = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 2, 1, 0));
+        const __m256 center = _mm256_shuffle_ps(a, c, _MM_SHUFFLE(0, 0, 2, 2));
+        const __m256 back = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(3, 2, 1, 0));
+        _mm256_storeu_ps(dst, _mm256_div_ps(_mm256_add_ps(_mm256_add_ps(front, _mm256_mul_ps(center, half)), back), divisor));
+    }
+
+    for (; i; --i, src += 6, dst += 2) {
+        SDL_Convert51ToStereoFrame(src, dst);
+    }
+
+    cvt->len_cvt /= 3;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index] (cvt, format);
+    }
+}
+
+SDL_TARGETING("avx2") static void SDLCALL
+SDL_ConvertQuadToStereo_AVX2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    float *dst = (float *) cvt->buf;
+    const float *src = dst;
+    int i = cvt->len_cvt / (sizeof (float) * 4);
+    int head = SDL_ChannelAlignmentFrames(dst, 2, i, 31);
+    const __m256 half = _mm256_set1_ps(0.5f);
+
+    LOG_DEBUG_CONVERT("quad", "stereo (using AVX2)");
+    SDL_assert(format == AUDIO_F32SYS);
+
+    for (i -= head; head; --head, src += 4, dst += 2) {
+        SDL_ConvertQuadToStereoFrame(src, dst);
+    }
+
+    for (; i >= 4; i -= 4, src += 16, dst += 8) {
+        const __m256 v0 = _mm256_loadu_ps(src);
+        const __m256 v1 = _mm256_loadu_ps(src + 8);
+        const __m256 a = _mm256_permute2f128_ps(v0, v1, 0x20);  /* frames 0 and 2 */
+        const __m256 b = _mm256_permute2f128_ps(v0, v1, 0x31);  /* frames 1 and 3 */
+        const __m256 front = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m256 back = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 2, 3, 2));
+        _mm256_storeu_ps(dst, _mm256_mul_ps(_mm256_add_ps(front, back), half));
+    }
+
+    for (; i; --i, src += 4, dst += 2) {
+        SDL_ConvertQuadToStereoFrame(src, dst);
+    }
+
+    cvt->len_cvt /= 2;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index] (cvt, format);
+    }
+}
+
+SDL_TARGETING("avx2") static void SDLCALL
+SDL_ConvertMonoToStereo_AVX2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    const float *src = (const float *) (cvt->buf + cvt->len_cvt);
+    float *dst = (float *) (cvt->buf + cvt->len_cvt * 2);
+    int i = cvt->len_cvt / sizeof (float);
+    int tail = SDL_ChannelAlignmentFrames(dst, -2, i, 31);
+
+    LOG_DEBUG_CONVERT("mono", "stereo (using AVX2)");
+    SDL_assert(format == AUDIO_F32SYS);
+
+    for (i -= tail; tail; --tail) {
+        src--;
+        dst -= 2;
+        SDL_ConvertMonoToStereoFrame(src, dst);
+    }
+
+    for (; i >= 8; i -= 8) {
+        __m256 v, lo, hi;
+        src -= 8;
+        dst -= 16;
+        v = _mm256_loadu_ps(src);
+        lo = _mm256_unpacklo_ps(v, v);
+        hi = _mm256_unpackhi_ps(v, v);
+        _mm256_storeu_ps(dst, _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(dst + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+
+    for (; i; --i) {
+        src--;
+        dst -= 2;
+        SDL_ConvertMonoToStereoFrame(src, dst);
+    }
+
+    cvt->len_cvt *= 2;
     if (cvt->filters[++cvt->filter_index]) {
         cvt->filters[cvt->filter_index] (cvt, format);
     }
 }
+#endif
+
+#if HAVE_NEON_INTRINSICS
+static void SDLCALL
+SDL_ConvertQuadToStereo_NEON(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    float *dst = (float *) cvt->buf;
+    const float *src = dst;
+    int i = cvt->len_cvt / (sizeof (float) * 4);
+    int head = SDL_ChannelAlignmentFrames(dst, 2, i, 15);
+    const float32x4_t half = vdupq_n_f32(0.5f);
+
+    LOG_DEBUG_CONVERT("quad", "stereo (using NEON)");
+    SDL_assert(format == AUDIO_F32SYS);
+
+    for (i -= head; head; --head, src += 4, dst += 2) {
+        SDL_ConvertQuadToStereoFrame(src, dst);
+    }
+
+    for (; i >= 4; i -= 4, src += 16, dst += 8) {
+        const float32x4x4_t in = vld4q_f32(src);  /* deinterleaves to FL, FR, BL, BR */
+        float32x4x2_t out;
+        out.val[0] = vmulq_f32(vaddq_f32(in.val[0], in.val[2]), half);
+        out.val[1] = vmulq_f32(vaddq_f32(in.val[1], in.val[3]), half);
+        vst2q_f32(dst, out);
+    }
+
+    for (; i; --i, src += 4, dst += 2) {
+        SDL_ConvertQuadToStereoFrame(src, dst);
+    }
+
+    cvt->len_cvt /= 2;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index] (cvt, format);
+    }
+}
+
+static void SDLCALL
+SDL_ConvertMonoToStereo_NEON(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    const float *src = (const float *) (cvt->buf + cvt->len_cvt);
+    float *dst = (float *) (cvt->buf + cvt->len_cvt * 2);
+    int i = cvt->len_cvt / sizeof (float);
+    int tail = SDL_ChannelAlignmentFrames(dst, -2, i, 15);
+
+    LOG_DEBUG_CONVERT("mono", "stereo (using NEON)");
+    SDL_assert(format == AUDIO_F32SYS);
+
+    for (i -= tail; tail; --tail) {
+        src--;
+        dst -= 2;
+        SDL_ConvertMonoToStereoFrame(src, dst);
+    }
+
+    for (; i >= 4; i -= 4) {
+        float32x4x2_t out;
+        src -= 4;
+        dst -= 8;
+        out.val[0] = out.val[1] = vld1q_f32(src);
+        vst2q_f32(dst, out);
+    }
+
+    for (; i; --i) {
+        src--;
+        dst -= 2;
+        SDL_ConvertMonoToStereoFrame(src, dst);
+    }
+
+    cvt->len_cvt *= 2;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index] (cvt, format);
+    }
+}
+
+static void SDLCALL
+SDL_Convert51To71_NEON(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    const float *src = (const float *) (cvt->buf + cvt->len_cvt);
+    float *dst = (float *) (cvt->buf + cvt->len_cvt * 4 / 3);
+    int i = cvt->len_cvt / (sizeof (float) * 6);
+    int tail = SDL_ChannelAlignmentFrames(dst, -8, i, 15);
+    const float32x4_t half = vdupq_n_f32(0.5f);
+
+    LOG_DEBUG_CONVERT("5.1", "7.1 (using NEON)");
+    SDL_assert(format == AUDIO_F32SYS);
+    SDL_assert(cvt->len_cvt % (sizeof(float) * 6) == 0);
+
+    for (i -= tail; tail; --tail) {
+        dst -= 8;
+        src -= 6;
+        SDL_Convert51To71Frame(src, dst);
+    }
+
+    /* two frames in: FL0 FR0 FC0 LFE0 | BL0 BR0 FL1 FR1 | FC1 LFE1 BL1 BR1 */
+    for (; i >= 2; i -= 2) {
+        float32x4_t a, b, c, front, back, sides, left;
+        dst -= 16;
+        src -= 12;
+        a = vld1q_f32(src);
+        b = vld1q_f32(src + 4);
+        c = vld1q_f32(src + 8);
+        front = vcombine_f32(vget_low_f32(a), vget_high_f32(b));
+        back = vcombine_f32(vget_low_f32(b), vget_high_f32(c));
+        sides = vmulq_f32(vaddq_f32(front, back), half);
+        /* the scalar code takes the left side for both */
+        left = vcombine_f32(vdup_lane_f32(vget_low_f32(sides), 0), vdup_lane_f32(vget_high_f32(sides), 0));
+        front = vaddq_f32(front, vsubq_f32(front, left));
+        back = vaddq_f32(back, vsubq_f32(back, left));
+        vst1q_f32(dst, vcombine_f32(vget_low_f32(front), vget_high_f32(a)));
+        vst1q_f32(dst + 4, vcombine_f32(vget_low_f32(back), vget_low_f32(sides)));
+        vst1q_f32(dst + 8, vcombine_f32(vget_high_f32(front), vget_low_f32(c)));
+        vst1q_f32(dst + 12, vcombine_f32(vget_high_f32(back), vget_high_f32(sides)));
+    }
+
+    for (; i; --i) {
+        dst -= 8;
+        src -= 6;
+        SDL_Convert51To71Frame(src, dst);
+    }
+
+    cvt->len_cvt = cvt->len_cvt * 4 / 3;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index] (cvt, format);
+    }
+}
+#endif
+
+static SDL_AudioFilter SDL_ConvertStereoToMono = NULL;
+static SDL_AudioFilter SDL_Convert51ToStereo = NULL;
+static SDL_AudioFilter SDL_ConvertQuadToStereo = NULL;
+static SDL_AudioFilter SDL_Convert71To51 = NULL;
+static SDL_AudioFilter SDL_ConvertMonoToStereo = NULL;
+static SDL_AudioFilter SDL_ConvertStereoTo51 = NULL;
+static SDL_AudioFilter SDL_Convert51To71 = NULL;
+
+/* Conversions that would take more than one of the filters above are done
+   in a single pass through a mixing matrix instead. The matrix is built by
+   running the usual chain of filters over one frame per input channel, with
+   just that channel at full scale, so the result is the same mix. */
+typedef struct
+{
+    Uint8 src_channels;
+    Uint8 dst_channels;
+    SDL_bool prepared;
+    float rows[8 * 8];  /* rows[(in * 8) + out] is how much of each input goes to each output */
+    float columns[8 * 8];  /* columns[(out * 8) + in], the same thing transposed */
+} SDL_ChannelMatrix;
+
+/* Mixes (frames) frames from src to dst, which don't overlap. dst may be
+   written up to 8 floats past the end of the last frame. */
+typedef void (*SDL_ChannelMatrixFunc)(const float *src, float *dst, const SDL_ChannelMatrix *mix, const int frames);
+static SDL_ChannelMatrixFunc SDL_MixChannelMatrix = NULL;
+
+static SDL_INLINE void
+SDL_MixChannelRows_Scalar(const float *src, const int srcchans, float *dst, const int dstchans, const float *rows, const int frames)
+{
+    int i, j, k;
+
+    for (i = 0; i < frames; i++, src += srcchans, dst += dstchans) {
+        for (k = 0; k < dstchans; k++) {
+            float sample = 0.0f;
+            for (j = 0; j < srcchans; j++) {
+                sample += src[j] * rows[(j * 8) + k];
+            }
+            dst[k] = sample;
+        }
+    }
+}
+
+static void
+SDL_MixChannelMatrix_Scalar(const float *src, float *dst, const SDL_ChannelMatrix *mix, const int frames)
+{
+    SDL_MixChannelRows_Scalar(src, mix->src_channels, dst, mix->dst_channels, mix->rows, frames);
+}
+
+/* The SIMD versions get the channel counts as constants, so that the loops
+   over channels unroll. Upmixes broadcast each input sample and add in its
+   row. Downmixes to 4 channels or fewer take the dot product of an input
+   frame with each column and transpose those into whole output vectors. */
+#define CHANNEL_MATRIX_CASE(s, d, func) case (((s) << 4) | (d)): done = func; break;
+
+#if HAVE_SSE2_INTRINSICS
+SDL_FORCE_INLINE int
+SDL_MixChannelRows_SSE2(const float *src, const int srcchans, float *dst, const int dstchans, const float *rows, const int frames)
+{
+    __m128 rowlo[8], rowhi[8];
+    int i, j;
+
+    for (j = 0; j < srcchans; j++) {
+        rowlo[j] = _mm_loadu_ps(rows + (j * 8));
+        rowhi[j] = _mm_loadu_ps(rows + (j * 8) + 4);
+    }
+
+    for (i = 0; i < frames; i++, src += srcchans, dst += dstchans) {
+        __m128 lo = _mm_setzero_ps();
+        __m128 hi = _mm_setzero_ps();
+        for (j = 0; j < srcchans; j++) {
+            const __m128 sample = _mm_set1_ps(src[j]);
+            lo = _mm_add_ps(lo, _mm_mul_ps(sample, rowlo[j]));
+            if (dstchans > 4) {
+                hi = _mm_add_ps(hi, _mm_mul_ps(sample, rowhi[j]));
+            }
+        }
+        _mm_storeu_ps(dst, lo);
+        if (dstchans > 4) {
+            _mm_storeu_ps(dst + 4, hi);
+        }
+    }
+    return frames;
+}
+
+/* needs srcchans >= 4 and dstchans dividing 4; returns how many frames it did. */
+SDL_FORCE_INLINE int
+SDL_MixChannelColumns_SSE2(const float *src, const int srcchans, float *dst, const int dstchans, const float *columns, const int frames)
+{
+    const int step = 4 / dstchans;  /* frames per output vector */
+    __m128 collo[4], colhi[4];
+    int i, k;
+
+    for (k = 0; k < dstchans; k++) {
+        collo[k] = _mm_loadu_ps(columns + (k * 8));
+        colhi[k] = _mm_loadu_ps(columns + (k * 8) + 4);
+    }
+
+    for (i = 0; (i + step) <= frames; i += step, src += step * srcchans, dst += 4) {
+        __m128 p[4];
+        for (k = 0; k < 4; k++) {
+            const float *frame = src + ((k / dstchans) * srcchans);
+            p[k] = _mm_mul_ps(_mm_loadu_ps(frame), collo[k % dstchans]);
+            if (srcchans == 8) {
+                p[k] = _mm_add_ps(p[k], _mm_mul_ps(_mm_loadu_ps(frame + 4), colhi[k % dstchans]));
+            } else if (srcchans == 6) {  /* don't read past the frame */
+                p[k] = _mm_add_ps(p[k], _mm_mul_ps(_mm_castpd_ps(_mm_load_sd((const double *) (frame + 4))), colhi[k % dstchans]));
+            }
+        }
+        _MM_TRANSPOSE4_PS(p[0], p[1], p[2], p[3]);
+        _mm_storeu_ps(dst, _mm_add_ps(_mm_add_ps(p[0], p[1]), _mm_add_ps(p[2], p[3])));
+    }
+    return i;
+}
+
+static void
+SDL_MixChannelMatrix_SSE2(const float *src, float *dst, const SDL_ChannelMatrix *mix, const int frames)
+{
+    const int srcchans = mix->src_channels;
+    const int dstchans = mix->dst_channels;
+    int done = 0;
+
+    switch ((srcchans << 4) | dstchans) {
+        CHANNEL_MATRIX_CASE(1, 4, SDL_MixChannelRows_SSE2(src, 1, dst, 4, mix->rows, frames))
+        CHANNEL_MATRIX_CASE(1, 6, SDL_MixChannelRows_SSE2(src, 1, dst, 6, mix->rows, frames))
+        CHANNEL_MATRIX_CASE(1, 8, SDL_MixChannelRows_SSE2(src, 1, dst, 8, mix->rows, frames))
+        CHANNEL_MATRIX_CASE(2, 8, SDL_MixChannelRows_SSE2(src, 2, dst, 8, mix->rows, frames))
+        CHANNEL_MATRIX_CASE(4, 8, SDL_MixChannelRows_SSE2(src, 4, dst, 8, mix->rows, frames))
+        CHANNEL_MATRIX_CASE(4, 1, SDL_MixChannelColumns_SSE2(src, 4, dst, 1, mix->columns, frames))
+        CHANNEL_MATRIX_CASE(6, 1, SDL_MixChannelColumns_SSE2(src, 6, dst, 1, mix->columns, frames))
+        CHANNEL_MATRIX_CASE(8, 1, SDL_MixChannelColumns_SSE2(src, 8, dst, 1, mix->columns, frames))
+        CHANNEL_MATRIX_CASE(8, 2, SDL_MixChannelColumns_SSE2(src, 8, dst, 2, mix->columns, frames))
+        CHANNEL_MATRIX_CASE(8, 4, SDL_MixChannelColumns_SSE2(src, 8, dst, 4, mix->columns, frames))
+        default: break;
+    }
+
+    SDL_MixChannelRows_Scalar(src + (done * srcchans), srcchans, dst + (done * dstchans), dstchans, mix->rows, frames - done);
+}
+#endif
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2") SDL_FORCE_INLINE int
+SDL_MixChannelRows_AVX2(const float *src, const int srcchans, float *dst, const int dstchans, const float *rows, const int frames)
+{
+    __m256 row[8];
+    int i, j;
+
+    for (j = 0; j < srcchans; j++) {
+        row[j] = _mm256_loadu_ps(rows + (j * 8));
+    }
+
+    for (i = 0; i < frames; i++, src += srcchans, dst += dstchans) {
+        __m256 sum = _mm256_setzero_ps();
+        for (j = 0; j < srcchans; j++) {
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(src[j]), row[j]));
+        }
+        _mm256_storeu_ps(dst, sum);
+    }
+    return frames;
+}
+
+/* 7.1 input only, one frame per load. hadd sums within 128-bit lanes, so
+   adding the two lanes at the end finishes all eight dot products. */
+SDL_TARGETING("avx2") SDL_FORCE_INLINE int
+SDL_MixChannelColumns71_AVX2(const float *src, float *dst, const int dstchans, const float *columns, const int frames)
+{
+    const int step = 8 / dstchans;
+    __m256 col[4];
+    int i, k;
+
+    for (k = 0; k < dstchans; k++) {
+        col[k] = _mm256_loadu_ps(columns + (k * 8));
+    }
+
+    for (i = 0; (i + step) <= frames; i += step, src += step * 8, dst += 8) {
+        __m256 p[8];
+        for (k = 0; k < 8; k++) {
+            p[k] = _mm256_mul_ps(_mm256_loadu_ps(src + ((k / dstchans) * 8)), col[k % dstchans]);
+        }
+        p[0] = _mm256_hadd_ps(_mm256_hadd_ps(p[0], p[1]), _mm256_hadd_ps(p[2], p[3]));
+        p[4] = _mm256_hadd_ps(_mm256_hadd_ps(p[4], p[5]), _mm256_hadd_ps(p[6], p[7]));
+        _mm256_storeu_ps(dst, _mm256_add_ps(_mm256_permute2f128_ps(p[0], p[4], 0x20), _mm256_permute2f128_ps(p[0], p[4], 0x31)));
+    }
+    return i;
+}
+
+SDL_TARGETING("avx2") static void
+SDL_MixChannelMatrix_AVX2(const float *src, float *dst, const SDL_ChannelMatrix *mix, const int frames)
+{
+    const int srcchans = mix->src_channels;
+    const int dstchans = mix->dst_channels;
+    int done = 0;
+
+    switch ((srcchans << 4) | dstchans) {
+        CHANNEL_MATRIX_CASE(1, 6, SDL_MixChannelRows_AVX2(src, 1, dst, 6, mix->rows, frames))
+        CHANNEL_MATRIX_CASE(1, 8, SDL_MixChannelRows_AVX2(src, 1, dst, 8, mix->rows, frames))
+        CHANNEL_MATRIX_CASE(2, 8, SDL_MixChannelRows_AVX2(src, 2, dst, 8, mix->rows, frames))
+        CHANNEL_MATRIX_CASE(4, 8, SDL_MixChannelRows_AVX2(src, 4, dst, 8, mix->rows, frames))
+        CHANNEL_MATRIX_CASE(8, 1, SDL_MixChannelColumns71_AVX2(src, dst, 1, mix->columns, frames))
+        CHANNEL_MATRIX_CASE(8, 2, SDL_MixChannelColumns71_AVX2(src, dst, 2, mix->columns, frames))
+        CHANNEL_MATRIX_CASE(8, 4, SDL_MixChannelColumns71_AVX2(src, dst, 4, mix->columns, frames))
+        default:
+#if HAVE_SSE2_INTRINSICS
+            SDL_MixChannelMatrix_SSE2(src, dst, mix, frames);
+            return;
+#else
+            break;
+#endif
+    }
+
+    SDL_MixChannelRows_Scalar(src + (done * srcchans), srcchans, dst + (done * dstchans), dstchans, mix->rows, frames - done);
+}
+#endif
+
+#if HAVE_NEON_INTRINSICS
+static void
+SDL_MixChannelMatrix_NEON(const float *src, float *dst, const SDL_ChannelMatrix *mix, const int frames)
+{
+    const int srcchans = mix->src_channels;
+    const int dstchans = mix->dst_channels;
+    int i, j;
+
+    for (i = 0; i < frames; i++, src += srcchans, dst += dstchans) {
+        float32x4_t lo = vdupq_n_f32(0.0f);
+        float32x4_t hi = vdupq_n_f32(0.0f);
+        for (j = 0; j < srcchans; j++) {
+            lo = vmlaq_n_f32(lo, vld1q_f32(mix->rows + (j * 8)), src[j]);
+            hi = vmlaq_n_f32(hi, vld1q_f32(mix->rows + (j * 8) + 4), src[j]);
+        }
+        vst1q_f32(dst, lo);
+        vst1q_f32(dst + 4, hi);
+    }
+}
+#endif
+
+#undef CHANNEL_MATRIX_CASE
+
+static void
+SDL_ChooseChannelConverters(void)
+{
+    static SDL_bool converters_chosen = SDL_FALSE;
+
+    if (converters_chosen) {
+        return;
+    }
+
+    SDL_ConvertStereoToMono = SDL_ConvertStereoToMono_Scalar;
+    SDL_Convert51ToStereo = SDL_Convert51ToStereo_Scalar;
+    SDL_ConvertQuadToStereo = SDL_ConvertQuadToStereo_Scalar;
+    SDL_Convert71To51 = SDL_Convert71To51_Scalar;
+    SDL_ConvertMonoToStereo = SDL_ConvertMonoToStereo_Scalar;
+    SDL_ConvertStereoTo51 = SDL_ConvertStereoTo51_Scalar;
+    SDL_Convert51To71 = SDL_Convert51To71_Scalar;
+    SDL_MixChannelMatrix = SDL_MixChannelMatrix_Scalar;
+
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        SDL_Convert51ToStereo = SDL_Convert51ToStereo_SSE2;
+        SDL_ConvertQuadToStereo = SDL_ConvertQuadToStereo_SSE2;
+        SDL_Convert71To51 = SDL_Convert71To51_SSE2;
+        SDL_ConvertMonoToStereo = SDL_ConvertMonoToStereo_SSE2;
+        SDL_ConvertStereoTo51 = SDL_ConvertStereoTo51_SSE2;
+        SDL_Convert51To71 = SDL_Convert51To71_SSE2;
+        SDL_MixChannelMatrix = SDL_MixChannelMatrix_SSE2;
+    }
+#endif
+#if HAVE_SSE3_INTRINSICS
+    if (SDL_HasSSE3()) {
+        SDL_ConvertStereoToMono = SDL_ConvertStereoToMono_SSE3;
+    }
+#endif
+#if SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        SDL_Convert51ToStereo = SDL_Convert51ToStereo_AVX2;
+        SDL_ConvertQuadToStereo = SDL_ConvertQuadToStereo_AVX2;
+        SDL_ConvertMonoToStereo = SDL_ConvertMonoToStereo_AVX2;
+        SDL_MixChannelMatrix = SDL_MixChannelMatrix_AVX2;
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        SDL_ConvertQuadToStereo = SDL_ConvertQuadToStereo_NEON;
+        SDL_ConvertMonoToStereo = SDL_ConvertMonoToStereo_NEON;
+        SDL_Convert51To71 = SDL_Convert51To71_NEON;
+        SDL_MixChannelMatrix = SDL_MixChannelMatrix_NEON;
+    }
+#endif
+
+    converters_chosen = SDL_TRUE;
+}
+
+/* Frames mixed per block; 4K of output scratch at most, which stays in L1. */
+#define CHANNEL_MATRIX_BLOCK_FRAMES 128
+
+static SDL_ChannelMatrix ChannelMatrices[] = {
+    { 1, 4 }, { 1, 6 }, { 1, 8 }, { 2, 8 }, { 4, 8 },
+    { 4, 1 }, { 6, 1 }, { 8, 1 }, { 8, 2 }, { 8, 4 }
+};
+static SDL_SpinLock ChannelMatrixSpinlock = 0;
+
+static void
+SDL_ConvertChannelMatrix(SDL_AudioCVT * cvt, SDL_AudioFormat format, const SDL_ChannelMatrix *mix)
+{
+    const int srcchans = mix->src_channels;
+    const int dstchans = mix->dst_channels;
+    const int frames = cvt->len_cvt / (sizeof (float) * srcchans);
+    float *buf = (float *) cvt->buf;
+    float block[(CHANNEL_MATRIX_BLOCK_FRAMES * 8) + 8];
+    int start, count;
+
+    LOG_DEBUG_CONVERT("channels", "channels (using matrix)");
+    SDL_assert(format == AUDIO_F32SYS);
+
+    /* Each block is mixed into a scratch buffer and copied back, walking
+       forward when shrinking and backward when growing, so the copy never
+       lands on input that hasn't been read yet. */
+    if (dstchans < srcchans) {
+        for (start = 0; start < frames; start += count) {
+            count = SDL_min(frames - start, CHANNEL_MATRIX_BLOCK_FRAMES);
+            SDL_MixChannelMatrix(buf + (start * srcchans), block, mix, count);
+            SDL_memcpy(buf + (start * dstchans), block, count * dstchans * sizeof (float));
+        }
+    } else {
+        for (start = frames; start > 0; start -= count) {
+            count = SDL_min(start, CHANNEL_MATRIX_BLOCK_FRAMES);
+            SDL_MixChannelMatrix(buf + ((start - count) * srcchans), block, mix, count);
+            SDL_memcpy(buf + ((start - count) * dstchans), block, count * dstchans * sizeof (float));
+        }
+    }
+
+    cvt->len_cvt = frames * dstchans * sizeof (float);
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index] (cvt, format);
+    }
+}
+
+/* Same macro salsa as the resampler: SDL_AudioCVT has nowhere to keep a
+   pointer to the matrix, so each one gets its own entry point. */
+#define CHANNEL_MATRIX_FUNCS(index) \
+    static void SDLCALL \
+    SDL_ConvertChannelMatrix_m##index(SDL_AudioCVT *cvt, SDL_AudioFormat format) { \
+        SDL_ConvertChannelMatrix(cvt, format, &ChannelMatrices[index]); \
+    }
+CHANNEL_MATRIX_FUNCS(0)
+CHANNEL_MATRIX_FUNCS(1)
+CHANNEL_MATRIX_FUNCS(2)
+CHANNEL_MATRIX_FUNCS(3)
+CHANNEL_MATRIX_FUNCS(4)
+CHANNEL_MATRIX_FUNCS(5)
+CHANNEL_MATRIX_FUNCS(6)
+CHANNEL_MATRIX_FUNCS(7)
+CHANNEL_MATRIX_FUNCS(8)
+CHANNEL_MATRIX_FUNCS(9)
+#undef CHANNEL_MATRIX_FUNCS
+
+static const SDL_AudioFilter ChannelMatrixFilters[SDL_arraysize(ChannelMatrices)] = {
+    SDL_ConvertChannelMatrix_m0, SDL_ConvertChannelMatrix_m1,
+    SDL_ConvertChannelMatrix_m2, SDL_ConvertChannelMatrix_m3,
+    SDL_ConvertChannelMatrix_m4, SDL_ConvertChannelMatrix_m5,
+    SDL_ConvertChannelMatrix_m6, SDL_ConvertChannelMatrix_m7,
+    SDL_ConvertChannelMatrix_m8, SDL_ConvertChannelMatrix_m9
+};
+
+/* Returns the single filter that does the work of the channel filters that
+   (chain) ends with, starting at (first_filter) and going from (src_channels)
+   to (dst_channels), or NULL if there's no matrix for that conversion. */
+static SDL_AudioFilter
+SDL_GetChannelMatrixFilter(const int src_channels, const int dst_channels,
+                           const SDL_AudioCVT *chain, const int first_filter)
+{
+    SDL_ChannelMatrix *mix = NULL;
+    int i, j, k;
+
+    for (i = 0; i < SDL_arraysize(ChannelMatrices); i++) {
+        if ((ChannelMatrices[i].src_channels == src_channels) && (ChannelMatrices[i].dst_channels == dst_channels)) {
+            mix = &ChannelMatrices[i];
+            break;
+        }
+    }
+
+    if (!mix) {
+        return NULL;
+    }
+
+    SDL_AtomicLock(&ChannelMatrixSpinlock);
+    if (!mix->prepared) {
+        float frames[8 * 8];  /* (src_channels) frames, each up to 8 channels along the way */
+        SDL_AudioCVT cvt;
+
+        SDL_zero(cvt);
+        SDL_zeroa(frames);
+        for (j = first_filter; j < chain->filter_index; j++) {
+            cvt.filters[j - first_filter] = chain->filters[j];
+        }
+        for (j = 0; j < src_channels; j++) {
+            frames[(j * src_channels) + j] = 1.0f;
+        }
+        cvt.buf = (Uint8 *) frames;
+        cvt.len = cvt.len_cvt = src_channels * src_channels * (int) sizeof (float);
+        cvt.filters[0](&cvt, AUDIO_F32SYS);
+        SDL_assert(cvt.len_cvt == (int) (src_channels * dst_channels * sizeof (float)));
+
+        SDL_zeroa(mix->rows);
+        SDL_zeroa(mix->columns);
+        for (j = 0; j < src_channels; j++) {
+            for (k = 0; k < dst_channels; k++) {
+                mix->rows[(j * 8) + k] = mix->columns[(k * 8) + j] = frames[(j * dst_channels) + k];
+            }
+        }
+        mix->prepared = SDL_TRUE;
+    }
+    SDL_AtomicUnlock(&ChannelMatrixSpinlock);
+
+    return ChannelMatrixFilters[i];
+}
 
 /* SDL's resampler uses a "bandlimited interpolation" algorithm:
      https://ccrma.stanford.edu/~jos/resample/ */
@@ -396,40 +1401,277 @@ bessel(const double x)
         if (diff < 1.0e-21f) {
             break;
         }
-        i0 += diff;
-        i++;
-        f *= (double) i;
+        i0 += diff;
+        i++;
+        f *= (double) i;
+    }
+
+    return i0;
+}
+
+/* build kaiser table with cardinal sine applied to it, and array of differences between elements. */
+static void
+kaiser_and_sinc(float *table, float *diffs, const int tablelen, const double beta)
+{
+    const int lenm1 = tablelen - 1;
+    const int lenm1div2 = lenm1 / 2;
+    int i;
+
+    table[0] = 1.0f;
+    for (i = 1; i < tablelen; i++) {
+        const double kaiser = bessel(beta * SDL_sqrt(1.0 - SDL_pow(((i - lenm1) / 2.0) / lenm1div2, 2.0))) / bessel(beta);
+        table[tablelen - i] = (float) kaiser;
+    }
+
+    for (i = 1; i < tablelen; i++) {
+        const float x = (((float) i) / ((float) RESAMPLER_SAMPLES_PER_ZERO_CROSSING)) * ((float) M_PI);
+        table[i] *= SDL_sinf(x) / x;
+        diffs[i - 1] = table[i] - table[i - 1];
+    }
+    diffs[lenm1] = 0.0f;
+}
+
+
+/* Each output frame is a weighted sum of the source frames from
+   (srcindex - RESAMPLER_ZERO_CROSSINGS) to (srcindex + RESAMPLER_ZERO_CROSSINGS + 1),
+   the left wing of the filter covers the first half and the right wing the second. */
+#define RESAMPLER_TAPS ((RESAMPLER_ZERO_CROSSINGS + 1) * 2)
+
+/* The SIMD code works on the taps four at a time */
+SDL_COMPILE_TIME_ASSERT(resampler_taps, (RESAMPLER_TAPS % 4) == 0);
+
+/* Rate pairs that reduce to at most this many output frames per cycle get a
+   precomputed table of filter coefficients, one row for each phase. */
+#define RESAMPLER_MAX_PHASES 1024
+
+/* Computes the weighted sum of RESAMPLER_TAPS consecutive frames starting at src. */
+typedef void (*SDL_ResampleFrameFunc)(const float *src, const float *coeffs, float *dst, const int chans);
+
+/* A polyphase filter table for a reduced rate pair. These are shared between
+   streams and live until SDL_FreeResampleFilter(). */
+typedef struct SDL_ResamplerTable
+{
+    int instep;
+    int outstep;
+    float *coeffs;
+    struct SDL_ResamplerTable *next;
+} SDL_ResamplerTable;
+
+static SDL_SpinLock ResampleFilterSpinlock = 0;
+static float *ResamplerFilter = NULL;
+static float *ResamplerFilterDifference = NULL;
+static SDL_ResamplerTable *ResamplerTables = NULL;
+static SDL_ResampleFrameFunc SDL_ResampleFrame = NULL;
+
+static void
+SDL_ResampleFrame_Scalar(const float *src, const float *coeffs, float *dst, const int chans)
+{
+    int i, chan;
+
+    for (chan = 0; chan < chans; chan++) {
+        float outsample = 0.0f;
+        for (i = 0; i < RESAMPLER_TAPS; i++) {
+            outsample += src[(i * chans) + chan] * coeffs[i];
+        }
+        dst[chan] = outsample;
+    }
+}
+
+#if HAVE_SSE2_INTRINSICS
+static void
+SDL_ResampleFrame_SSE2(const float *src, const float *coeffs, float *dst, const int chans)
+{
+    int i, chan;
+
+    if (chans == 1) {
+        __m128 sum = _mm_setzero_ps();
+        for (i = 0; i < RESAMPLER_TAPS; i += 4) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src + i), _mm_loadu_ps(coeffs + i)));
+        }
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+        _mm_store_ss(dst, sum);
+    } else if (chans == 2) {
+        /* Interleaved stereo, so pair up the coefficients */
+        __m128 sum = _mm_setzero_ps();
+        for (i = 0; i < RESAMPLER_TAPS; i += 4) {
+            const __m128 c = _mm_loadu_ps(coeffs + i);
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src + (i * 2)), _mm_unpacklo_ps(c, c)));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src + (i * 2) + 4), _mm_unpackhi_ps(c, c)));
+        }
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        _mm_storel_pi((__m64 *) dst, sum);
+    } else {
+        /* Work across four channels at a time */
+        for (chan = 0; (chan + 4) <= chans; chan += 4) {
+            __m128 sum = _mm_setzero_ps();
+            for (i = 0; i < RESAMPLER_TAPS; i++) {
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src + (i * chans) + chan), _mm_set1_ps(coeffs[i])));
+            }
+            _mm_storeu_ps(dst + chan, sum);
+        }
+        for ( ; chan < chans; chan++) {
+            float outsample = 0.0f;
+            for (i = 0; i < RESAMPLER_TAPS; i++) {
+                outsample += src[(i * chans) + chan] * coeffs[i];
+            }
+            dst[chan] = outsample;
+        }
+    }
+}
+#endif
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2") static void
+SDL_ResampleFrame_AVX2(const float *src, const float *coeffs, float *dst, const int chans)
+{
+    int i, chan;
+
+    if (chans == 1) {
+        __m256 sum8 = _mm256_mul_ps(_mm256_loadu_ps(src), _mm256_loadu_ps(coeffs));
+        __m128 sum = _mm_add_ps(_mm256_castps256_ps128(sum8), _mm256_extractf128_ps(sum8, 1));
+        for (i = 8; i < RESAMPLER_TAPS; i += 4) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src + i), _mm_loadu_ps(coeffs + i)));
+        }
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+        _mm_store_ss(dst, sum);
+    } else if (chans == 2 || chans == 4) {
+        /* Spread four coefficients over the eight lanes to match the channel interleaving */
+        const __m256i spread = (chans == 2) ? _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3) : _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+        const int step = 8 / chans;
+        __m256 sum8 = _mm256_setzero_ps();
+        __m128 sum;
+        for (i = 0; i < RESAMPLER_TAPS; i += step) {
+            const __m128 c4 = (chans == 2) ? _mm_loadu_ps(coeffs + i) : _mm_castpd_ps(_mm_load_sd((const double *) (coeffs + i)));
+            const __m256 c = _mm256_permutevar8x32_ps(_mm256_castps128_ps256(c4), spread);
+            sum8 = _mm256_add_ps(sum8, _mm256_mul_ps(_mm256_loadu_ps(src + (i * chans)), c));
+        }
+        sum = _mm_add_ps(_mm256_castps256_ps128(sum8), _mm256_extractf128_ps(sum8, 1));
+        if (chans == 2) {
+            sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+            _mm_storel_pi((__m64 *) dst, sum);
+        } else {
+            _mm_storeu_ps(dst, sum);
+        }
+    } else {
+        /* Work across eight channels at a time, then four */
+        for (chan = 0; (chan + 8) <= chans; chan += 8) {
+            __m256 sum = _mm256_setzero_ps();
+            for (i = 0; i < RESAMPLER_TAPS; i++) {
+                sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(src + (i * chans) + chan), _mm256_set1_ps(coeffs[i])));
+            }
+            _mm256_storeu_ps(dst + chan, sum);
+        }
+        for ( ; (chan + 4) <= chans; chan += 4) {
+            __m128 sum = _mm_setzero_ps();
+            for (i = 0; i < RESAMPLER_TAPS; i++) {
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src + (i * chans) + chan), _mm_set1_ps(coeffs[i])));
+            }
+            _mm_storeu_ps(dst + chan, sum);
+        }
+        for ( ; chan < chans; chan++) {
+            float outsample = 0.0f;
+            for (i = 0; i < RESAMPLER_TAPS; i++) {
+                outsample += src[(i * chans) + chan] * coeffs[i];
+            }
+            dst[chan] = outsample;
+        }
     }
-
-    return i0;
 }
+#endif
 
-/* build kaiser table with cardinal sine applied to it, and array of differences between elements. */
+#if HAVE_NEON_INTRINSICS
 static void
-kaiser_and_sinc(float *table, float *diffs, const int tablelen, const double beta)
+SDL_ResampleFrame_NEON(const float *src, const float *coeffs, float *dst, const int chans)
 {
-    const int lenm1 = tablelen - 1;
-    const int lenm1div2 = lenm1 / 2;
-    int i;
+    int i, chan;
 
-    table[0] = 1.0f;
-    for (i = 1; i < tablelen; i++) {
-        const double kaiser = bessel(beta * SDL_sqrt(1.0 - SDL_pow(((i - lenm1) / 2.0) / lenm1div2, 2.0))) / bessel(beta);
-        table[tablelen - i] = (float) kaiser;
+    if (chans == 1) {
+        float32x4_t sum = vdupq_n_f32(0.0f);
+        float32x2_t sum2;
+        for (i = 0; i < RESAMPLER_TAPS; i += 4) {
+            sum = vmlaq_f32(sum, vld1q_f32(src + i), vld1q_f32(coeffs + i));
+        }
+        sum2 = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+        sum2 = vpadd_f32(sum2, sum2);
+        vst1_lane_f32(dst, sum2, 0);
+    } else if (chans == 2) {
+        /* Interleaved stereo, so pair up the coefficients */
+        float32x4_t sum = vdupq_n_f32(0.0f);
+        for (i = 0; i < RESAMPLER_TAPS; i += 4) {
+            const float32x4_t c = vld1q_f32(coeffs + i);
+            const float32x4x2_t pairs = vzipq_f32(c, c);
+            sum = vmlaq_f32(sum, vld1q_f32(src + (i * 2)), pairs.val[0]);
+            sum = vmlaq_f32(sum, vld1q_f32(src + (i * 2) + 4), pairs.val[1]);
+        }
+        vst1_f32(dst, vadd_f32(vget_low_f32(sum), vget_high_f32(sum)));
+    } else {
+        /* Work across four channels at a time */
+        for (chan = 0; (chan + 4) <= chans; chan += 4) {
+            float32x4_t sum = vdupq_n_f32(0.0f);
+            for (i = 0; i < RESAMPLER_TAPS; i++) {
+                sum = vmlaq_n_f32(sum, vld1q_f32(src + (i * chans) + chan), coeffs[i]);
+            }
+            vst1q_f32(dst + chan, sum);
+        }
+        for ( ; chan < chans; chan++) {
+            float outsample = 0.0f;
+            for (i = 0; i < RESAMPLER_TAPS; i++) {
+                outsample += src[(i * chans) + chan] * coeffs[i];
+            }
+            dst[chan] = outsample;
+        }
     }
+}
+#endif
 
-    for (i = 1; i < tablelen; i++) {
-        const float x = (((float) i) / ((float) RESAMPLER_SAMPLES_PER_ZERO_CROSSING)) * ((float) M_PI);
-        table[i] *= SDL_sinf(x) / x;
-        diffs[i - 1] = table[i] - table[i - 1];
+static void
+SDL_ChooseResampleFrameFunc(void)
+{
+#if SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        SDL_ResampleFrame = SDL_ResampleFrame_AVX2;
+        return;
     }
-    diffs[lenm1] = 0.0f;
+#endif
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        SDL_ResampleFrame = SDL_ResampleFrame_SSE2;
+        return;
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        SDL_ResampleFrame = SDL_ResampleFrame_NEON;
+        return;
+    }
+#endif
+    SDL_ResampleFrame = SDL_ResampleFrame_Scalar;
 }
 
-
-static SDL_SpinLock ResampleFilterSpinlock = 0;
-static float *ResamplerFilter = NULL;
-static float *ResamplerFilterDifference = NULL;
+/* Fill in the RESAMPLER_TAPS coefficients for an output frame that falls
+   (interpolation1) of the way from one source frame to the next. Filter
+   values between table entries are interpolated linearly. */
+static void
+ResamplerCoefficients(const double interpolation1, float *coeffs)
+{
+    const double filterpos1 = interpolation1 * RESAMPLER_SAMPLES_PER_ZERO_CROSSING;
+    const int filterindex1 = (int) filterpos1;
+    const double filterfrac1 = filterpos1 - filterindex1;
+    const double filterpos2 = (1.0 - interpolation1) * RESAMPLER_SAMPLES_PER_ZERO_CROSSING;
+    const int filterindex2 = (int) filterpos2;
+    const double filterfrac2 = filterpos2 - filterindex2;
+    int j;
+
+    /* The left wing runs backwards from the source frame, the right wing forwards from the next one */
+    for (j = 0; j <= RESAMPLER_ZERO_CROSSINGS; j++) {
+        const int index1 = filterindex1 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING);
+        const int index2 = filterindex2 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING);
+        coeffs[RESAMPLER_ZERO_CROSSINGS - j] = (index1 < RESAMPLER_FILTER_SIZE) ? (float) (ResamplerFilter[index1] + (filterfrac1 * ResamplerFilterDifference[index1])) : 0.0f;
+        coeffs[RESAMPLER_ZERO_CROSSINGS + 1 + j] = (index2 < RESAMPLER_FILTER_SIZE) ? (float) (ResamplerFilter[index2] + (filterfrac2 * ResamplerFilterDifference[index2])) : 0.0f;
+    }
+}
 
 int
 SDL_PrepareResampleFilter(void)
@@ -455,14 +1697,78 @@ SDL_PrepareResampleFilter(void)
             return SDL_OutOfMemory();
         }
         kaiser_and_sinc(ResamplerFilter, ResamplerFilterDifference, RESAMPLER_FILTER_SIZE, beta);
+        SDL_ChooseResampleFrameFunc();
     }
     SDL_AtomicUnlock(&ResampleFilterSpinlock);
     return 0;
 }
 
+static int
+ResamplerGCD(int a, int b)
+{
+    while (b) {
+        const int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/* Returns the polyphase table for this rate pair, or NULL if the rates don't
+   reduce to a small enough ratio (or we're out of memory), in which case the
+   coefficients are calculated for each frame instead.
+   SDL_PrepareResampleFilter() must have been called first. */
+static const SDL_ResamplerTable *
+SDL_GetResamplerTable(const int inrate, const int outrate)
+{
+    const int gcd = ResamplerGCD(inrate, outrate);
+    const int instep = inrate / gcd;
+    const int outstep = outrate / gcd;
+    SDL_ResamplerTable *table;
+    int phase;
+
+    if (outstep > RESAMPLER_MAX_PHASES) {
+        return NULL;
+    }
+
+    SDL_AtomicLock(&ResampleFilterSpinlock);
+    for (table = ResamplerTables; table; table = table->next) {
+        if (table->instep == instep && table->outstep == outstep) {
+            break;
+        }
+    }
+    if (!table) {
+        table = (SDL_ResamplerTable *) SDL_malloc(sizeof (*table));
+        if (table) {
+            table->coeffs = (float *) SDL_malloc(outstep * RESAMPLER_TAPS * sizeof (float));
+            if (!table->coeffs) {
+                SDL_free(table);
+                table = NULL;
+            }
+        }
+        if (table) {
+            table->instep = instep;
+            table->outstep = outstep;
+            for (phase = 0; phase < outstep; phase++) {
+                ResamplerCoefficients(((double) phase) / ((double) outstep), &table->coeffs[phase * RESAMPLER_TAPS]);
+            }
+            table->next = ResamplerTables;
+            ResamplerTables = table;
+        }
+    }
+    SDL_AtomicUnlock(&ResampleFilterSpinlock);
+    return table;
+}
+
 void
 SDL_FreeResampleFilter(void)
 {
+    while (ResamplerTables) {
+        SDL_ResamplerTable *next = ResamplerTables->next;
+        SDL_free(ResamplerTables->coeffs);
+        SDL_free(ResamplerTables);
+        ResamplerTables = next;
+    }
     SDL_free(ResamplerFilter);
     SDL_free(ResamplerFilterDifference);
     ResamplerFilter = NULL;
@@ -480,9 +1786,16 @@ ResamplerPadding(const int inrate, const int outrate)
     return RESAMPLER_SAMPLES_PER_ZERO_CROSSING;
 }
 
-/* lpadding and rpadding are expected to be buffers of (ResamplePadding(inrate, outrate) * chans * sizeof (float)) bytes. */
+/* lpadding and rpadding are expected to be buffers of (ResamplePadding(inrate, outrate) * chans * sizeof (float)) bytes.
+
+   The coefficients for each output frame are computed once and shared by all
+   channels. With a polyphase table, source positions are exact fractions of
+   the rate ratio; otherwise the output time is accumulated in floating point.
+   Both agree to within 1e-6 for input in the range [-1, 1], as do the SIMD
+   and scalar frame functions. */
 static int
 SDL_ResampleAudio(const int chans, const int inrate, const int outrate,
+                        const SDL_ResamplerTable *table,
                         const float *lpadding, const float *rpadding,
                         const float *inbuf, const int inbuflen,
                         float *outbuf, const int outbuflen)
@@ -496,51 +1809,201 @@ SDL_ResampleAudio(const int chans, const int inrate, const int outrate,
     const int wantedoutframes = (int) ((inbuflen / framelen) * ratio);  /* outbuflen isn't total to write, it's total available. */
     const int maxoutframes = outbuflen / framelen;
     const int outframes = SDL_min(wantedoutframes, maxoutframes);
+    const SDL_ResampleFrameFunc resample_frame = SDL_ResampleFrame;
     float *dst = outbuf;
     double outtime = 0.0;
-    int i, j, chan;
+    int srcindex = 0;
+    int phase = 0;
+    float edgeframes[RESAMPLER_TAPS * 8];
+    float framecoeffs[RESAMPLER_TAPS];
+    int i, j;
+
+    SDL_assert(chans <= 8);
 
     for (i = 0; i < outframes; i++) {
-        const int srcindex = (int) (outtime * inrate);
-        const double intime = ((double) srcindex) / finrate;
-        const double innexttime = ((double) (srcindex + 1)) / finrate;
-        const double interpolation1 = 1.0 - ((innexttime - outtime) / (innexttime - intime));
-        const int filterindex1 = (int) (interpolation1 * RESAMPLER_SAMPLES_PER_ZERO_CROSSING);
-        const double interpolation2 = 1.0 - interpolation1;
-        const int filterindex2 = (int) (interpolation2 * RESAMPLER_SAMPLES_PER_ZERO_CROSSING);
-
-        for (chan = 0; chan < chans; chan++) {
-            float outsample = 0.0f;
+        const int firstframe = srcindex - RESAMPLER_ZERO_CROSSINGS;
+        const float *coeffs;
+        const float *src;
 
-            /* do this twice to calculate the sample, once for the "left wing" and then same for the right. */
-            /* !!! FIXME: do both wings in one loop */
-            for (j = 0; (filterindex1 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING)) < RESAMPLER_FILTER_SIZE; j++) {
-                const int srcframe = srcindex - j;
-                /* !!! FIXME: we can bubble this conditional out of here by doing a pre loop. */
-                const float insample = (srcframe < 0) ? lpadding[((paddinglen + srcframe) * chans) + chan] : inbuf[(srcframe * chans) + chan];
-                outsample += (float)(insample * (ResamplerFilter[filterindex1 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING)] + (interpolation1 * ResamplerFilterDifference[filterindex1 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING)])));
-            }
+        if (table) {
+            coeffs = &table->coeffs[phase * RESAMPLER_TAPS];
+        } else {
+            const double intime = ((double) srcindex) / finrate;
+            const double innexttime = ((double) (srcindex + 1)) / finrate;
+            ResamplerCoefficients(1.0 - ((innexttime - outtime) / (innexttime - intime)), framecoeffs);
+            coeffs = framecoeffs;
+        }
 
-            for (j = 0; (filterindex2 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING)) < RESAMPLER_FILTER_SIZE; j++) {
-                const int srcframe = srcindex + 1 + j;
-                /* !!! FIXME: we can bubble this conditional out of here by doing a post loop. */
-                const float insample = (srcframe >= inframes) ? rpadding[((srcframe - inframes) * chans) + chan] : inbuf[(srcframe * chans) + chan];
-                outsample += (float)(insample * (ResamplerFilter[filterindex2 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING)] + (interpolation2 * ResamplerFilterDifference[filterindex2 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING)])));
+        if ((firstframe >= 0) && ((firstframe + RESAMPLER_TAPS) <= inframes)) {
+            src = &inbuf[firstframe * chans];
+        } else {
+            /* Near the edges, gather the frames we need from the padding */
+            for (j = 0; j < RESAMPLER_TAPS; j++) {
+                const int srcframe = firstframe + j;
+                const float *frame;
+                if (srcframe < 0) {
+                    frame = &lpadding[(paddinglen + srcframe) * chans];
+                } else if (srcframe >= inframes) {
+                    frame = &rpadding[(srcframe - inframes) * chans];
+                } else {
+                    frame = &inbuf[srcframe * chans];
+                }
+                SDL_memcpy(&edgeframes[j * chans], frame, framelen);
             }
-            *(dst++) = outsample;
+            src = edgeframes;
         }
 
-        outtime += outtimeincr;
+        resample_frame(src, coeffs, dst, chans);
+        dst += chans;
+
+        if (table) {
+            phase += table->instep;
+            srcindex += phase / table->outstep;
+            phase %= table->outstep;
+        } else {
+            outtime += outtimeincr;
+            srcindex = (int) (outtime * inrate);
+        }
     }
 
     return outframes * chans * sizeof (float);
 }
 
+/* SDL_ConvertAudio() pushes the buffer through each run of filters between
+   resamplers a block at a time, so a block goes through the whole run while
+   it's still in cache instead of each filter streaming the entire buffer.
+   The resampler needs to see the whole buffer, so it still runs in place. */
+#define SDL_AUDIOCVT_BLOCK_BYTES (8 * 1024)
+
+/* Blocks are a multiple of this many samples, so they're always whole sample
+   frames for any supported channel count. */
+#define SDL_AUDIOCVT_BLOCK_SAMPLES 24
+
+static SDL_bool SDL_IsResamplerFilter(const SDL_AudioFilter filter);
+
+/* Goes at the end of a run of filters, just to note what format it left
+   the data in. */
+static void SDLCALL
+SDL_EndAudioCVTRun(SDL_AudioCVT *cvt, SDL_AudioFormat format)
+{
+    cvt->dst_format = format;
+}
+
+/* Runs (run) over len bytes at buf, in place. Returns the bytes it made. */
+static int
+SDL_RunAudioCVTFilters(SDL_AudioCVT *run, const int first, const SDL_AudioFormat format,
+                       Uint8 *buf, const int len)
+{
+    run->buf = buf;
+    run->len_cvt = len;
+    run->filter_index = first;
+    run->filters[first] (run, format);
+    return run->len_cvt;
+}
+
+/* Runs (run) over srclen bytes at src in scratch, and copies the results to
+   dst. Returns the number of bytes written. */
+static int
+SDL_ConvertAudioBlock(SDL_AudioCVT *run, const int first, const SDL_AudioFormat format,
+                      Uint8 *scratch, const Uint8 *src, const int srclen, Uint8 *dst)
+{
+    int len;
+    SDL_memcpy(scratch, src, srclen);
+    len = SDL_RunAudioCVTFilters(run, first, format, scratch, srclen);
+    SDL_memcpy(dst, scratch, len);
+    return len;
+}
+
+/* Runs filters [first, last) over (*len) bytes of cvt->buf, which are in
+   (*format). Returns SDL_FALSE without touching anything if a block
+   wouldn't fit in the scratch space. */
+static SDL_bool
+SDL_ConvertAudioBlocked(SDL_AudioCVT *cvt, const int first, const int last,
+                        SDL_AudioFormat *format, int *len)
+{
+    float scratch[SDL_AUDIOCVT_BLOCK_BYTES / sizeof (float)];
+    const int unitlen = SDL_AUDIOCVT_BLOCK_SAMPLES * (SDL_AUDIO_BITSIZE(*format) / 8);
+    SDL_AudioFormat unitformat = *format;
+    Uint8 *buf = cvt->buf;
+    SDL_AudioCVT run;
+    int unitpeak = unitlen;
+    int unitout = unitlen;
+    int growth, blocklen, outblocklen;
+    int f;
+
+    /* Every filter here works on whole frames, so running one unit of
+       silence through them one at a time tells us how big the data gets
+       along the way and how big it comes out. A unit is at most 24 frames,
+       and no frame is bigger than 8 channels of 32-bit samples, so this
+       always fits in the scratch space. */
+    run = *cvt;
+    SDL_memset(scratch, '\0', unitlen);
+    for (f = first; f < last; f++) {
+        run.filters[f + 1] = SDL_EndAudioCVTRun;
+        unitout = SDL_RunAudioCVTFilters(&run, f, unitformat, (Uint8 *) scratch, unitout);
+        run.filters[f + 1] = cvt->filters[f + 1];
+        unitformat = run.dst_format;
+        unitpeak = SDL_max(unitpeak, unitout);
+    }
+
+    growth = (unitpeak + unitlen - 1) / unitlen;
+    blocklen = ((SDL_AUDIOCVT_BLOCK_BYTES / growth) / unitlen) * unitlen;
+    if (blocklen == 0) {
+        return SDL_FALSE;
+    }
+
+    run.filters[last] = SDL_EndAudioCVTRun;
+
+    if (growth == 1) {
+        /* Nothing here ever needs more room than it started with, so convert
+           each block where it sits and slide it down after the last one. */
+        int in, out = 0;
+        for (in = 0; in < *len; in += blocklen) {
+            const int outlen = SDL_RunAudioCVTFilters(&run, first, *format, buf + in, SDL_min(*len - in, blocklen));
+            SDL_memmove(buf + out, buf + in, outlen);
+            out += outlen;
+        }
+        *len = out;
+        *format = run.dst_format;
+        return SDL_TRUE;
+    }
+
+    outblocklen = unitout * (blocklen / unitlen);
+
+    if (outblocklen <= blocklen) {
+        /* Shrinking: output never catches up with input we haven't read
+           yet, so go front to back. */
+        int in, out = 0;
+        for (in = 0; in < *len; in += blocklen) {
+            out += SDL_ConvertAudioBlock(&run, first, *format, (Uint8 *) scratch, buf + in, SDL_min(*len - in, blocklen), buf + out);
+        }
+        *len = out;
+    } else {
+        /* Growing: every block's output lands past its input, so go back to
+           front, starting with whatever's left over after the last whole block. */
+        const int blocks = *len / blocklen;
+        const int remainder = *len - (blocks * blocklen);
+        int out = blocks * outblocklen;
+        int i;
+        if (remainder > 0) {
+            out += SDL_ConvertAudioBlock(&run, first, *format, (Uint8 *) scratch, buf + (blocks * blocklen), remainder, buf + (blocks * outblocklen));
+        }
+        for (i = blocks - 1; i >= 0; i--) {
+            SDL_ConvertAudioBlock(&run, first, *format, (Uint8 *) scratch, buf + (i * blocklen), blocklen, buf + (i * outblocklen));
+        }
+        *len = out;
+    }
+
+    *format = run.dst_format;
+    return SDL_TRUE;
+}
+
 int
 SDL_ConvertAudio(SDL_AudioCVT * cvt)
 {
-    /* !!! FIXME: (cvt) should be const; stack-copy it here. */
-    /* !!! FIXME: (actually, we can't...len_cvt needs to be updated. Grr.) */
+    SDL_AudioFormat format;
+    int first, last;
+    int len;
 
     /* Make sure there's data to convert */
     if (cvt->buf == NULL) {
@@ -553,9 +2016,36 @@ SDL_ConvertAudio(SDL_AudioCVT * cvt)
         return 0;
     }
 
-    /* Set up the conversion and go! */
-    cvt->filter_index = 0;
-    cvt->filters[0] (cvt, cvt->src_format);
+    format = cvt->src_format;
+    len = cvt->len;
+    for (first = 0; cvt->filters[first] != NULL; first = last) {
+        for (last = first; cvt->filters[last] && !SDL_IsResamplerFilter(cvt->filters[last]); last++) {
+            /* find the end of the run. */
+        }
+
+        if ((last - first) < 2 || !SDL_ConvertAudioBlocked(cvt, first, last, &format, &len)) {
+            SDL_AudioCVT run;
+
+            if (last == first) {
+                last++;  /* a resampler on its own. */
+            }
+
+            /* The resampler keeps its rates past the end of the list. */
+            if (last >= (SDL_AUDIOCVT_MAX_FILTERS-1)) {
+                cvt->filter_index = first;
+                cvt->len_cvt = len;
+                cvt->filters[first] (cvt, format);
+                return 0;
+            }
+
+            run = *cvt;
+            run.filters[last] = SDL_EndAudioCVTRun;
+            len = SDL_RunAudioCVTFilters(&run, first, format, cvt->buf, len);
+            format = run.dst_format;
+        }
+    }
+
+    cvt->len_cvt = len;
     return 0;
 }
 
@@ -721,6 +2211,7 @@ SDL_ResampleCVT(SDL_AudioCVT *cvt, const int chans, const SDL_AudioFormat format
     const int requestedpadding = ResamplerPadding(inrate, outrate);
     int paddingsamples;
     float *padding;
+    const SDL_ResamplerTable *table;
 
     if (requestedpadding < SDL_MAX_SINT32 / chans) {
         paddingsamples = requestedpadding * chans;
@@ -736,7 +2227,8 @@ SDL_ResampleCVT(SDL_AudioCVT *cvt, const int chans, const SDL_AudioFormat format
         return;
     }
 
-    cvt->len_cvt = SDL_ResampleAudio(chans, inrate, outrate, padding, padding, src, srclen, dst, dstlen);
+    table = SDL_GetResamplerTable(inrate, outrate);
+    cvt->len_cvt = SDL_ResampleAudio(chans, inrate, outrate, table, padding, padding, src, srclen, dst, dstlen);
 
     SDL_free(padding);
 
@@ -778,6 +2270,14 @@ ChooseCVTResampler(const int dst_channels)
     return NULL;
 }
 
+static SDL_bool
+SDL_IsResamplerFilter(const SDL_AudioFilter filter)
+{
+    return ((filter == SDL_ResampleCVT_c1) || (filter == SDL_ResampleCVT_c2) ||
+            (filter == SDL_ResampleCVT_c4) || (filter == SDL_ResampleCVT_c6) ||
+            (filter == SDL_ResampleCVT_c8)) ? SDL_TRUE : SDL_FALSE;
+}
+
 static int
 SDL_BuildAudioResampleCVT(SDL_AudioCVT * cvt, const int dst_channels,
                           const int src_rate, const int dst_rate)
@@ -879,6 +2379,9 @@ SDL_BuildAudioCVT(SDL_AudioCVT * cvt,
                   SDL_AudioFormat src_fmt, Uint8 src_channels, int src_rate,
                   SDL_AudioFormat dst_fmt, Uint8 dst_channels, int dst_rate)
 {
+    int first_channel_filter;
+    Uint8 channel_filter_src;
+
     /* Sanity check target pointer */
     if (cvt == NULL) {
         return SDL_InvalidParamError("cvt");
@@ -922,6 +2425,7 @@ SDL_BuildAudioCVT(SDL_AudioCVT * cvt,
 
     /* Make sure we've chosen audio conversion functions (MMX, scalar, etc.) */
     SDL_ChooseAudioConverters();
+    SDL_ChooseChannelConverters();
 
     /* Type conversion goes like this now:
         - byteswap to CPU native format first if necessary.
@@ -931,9 +2435,9 @@ SDL_BuildAudioCVT(SDL_AudioCVT * cvt,
         - byteswap back to foreign format if necessary.
 
        The expectation is we can process data faster in float32
-       (possibly with SIMD), and making several passes over the same
-       buffer is likely to be CPU cache-friendly, avoiding the
-       biggest performance hit in modern times. Previously we had
+       (possibly with SIMD), and SDL_ConvertAudio() runs each block of
+       the buffer through all the passes while it's still in cache,
+       avoiding the biggest performance hit in modern times. Previously we had
        (script-generated) custom converters for every data type and
        it was a bloat on SDL compile times and final library size. */
 
@@ -959,6 +2463,8 @@ SDL_BuildAudioCVT(SDL_AudioCVT * cvt,
     }
 
     /* Channel conversion */
+    first_channel_filter = cvt->filter_index;
+    channel_filter_src = src_channels;
     if (src_channels < dst_channels) {
         /* Upmixing */
         /* Mono -> Stereo [-> ...] */
@@ -1045,19 +2551,7 @@ SDL_BuildAudioCVT(SDL_AudioCVT * cvt,
         }
         /* [... ->] Stereo -> Mono */
         if ((src_channels == 2) && (dst_channels == 1)) {
-            SDL_AudioFilter filter = NULL;
-
-            #if HAVE_SSE3_INTRINSICS
-            if (SDL_HasSSE3()) {
-                filter = SDL_ConvertStereoToMono_SSE3;
-            }
-            #endif
-
-            if (!filter) {
-                filter = SDL_ConvertStereoToMono;
-            }
-
-            if (SDL_AddAudioCVTFilter(cvt, filter) < 0) {
+            if (SDL_AddAudioCVTFilter(cvt, SDL_ConvertStereoToMono) < 0) {
                 return -1;
             }
 
@@ -1071,6 +2565,17 @@ SDL_BuildAudioCVT(SDL_AudioCVT * cvt,
            handled by now, but let's be defensive */
       return SDL_SetError("Invalid channel combination");
     }
+
+    /* More than one step? Do them all in one pass instead. */
+    if ((cvt->filter_index - first_channel_filter) > 1) {
+        const SDL_AudioFilter filter = SDL_GetChannelMatrixFilter(channel_filter_src, dst_channels, cvt, first_channel_filter);
+        if (filter) {
+            cvt->filter_index = first_channel_filter;
+            if (SDL_AddAudioCVTFilter(cvt, filter) < 0) {
+                return -1;
+            }
+        }
+    }
     
     /* Do rate conversion, if necessary. Updates (cvt). */
     if (SDL_BuildAudioResampleCVT(cvt, dst_channels, src_rate, dst_rate) < 0) {
@@ -1082,6 +2587,13 @@ SDL_BuildAudioCVT(SDL_AudioCVT * cvt,
         return -1;              /* shouldn't happen, but just in case... */
     }
 
+    /* Without a resampler, SDL_ConvertAudio() runs the whole chain through
+       its own scratch space a block at a time, so the caller's buffer only
+       has to hold the input and the output. */
+    if ((src_rate == dst_rate) && (cvt->filter_index > 1)) {
+        cvt->len_mult = (cvt->len_ratio > 1.0) ? (int) SDL_ceil(cvt->len_ratio) : 1;
+    }
+
     cvt->needed = (cvt->filter_index != 0);
     return (cvt->needed);
 }
@@ -1118,6 +2630,10 @@ struct _SDL_AudioStream
     SDL_ResampleAudioStreamFunc resampler_func;
     SDL_ResetAudioStreamResamplerFunc reset_resampler_func;
     SDL_CleanupAudioStreamResamplerFunc cleanup_resampler_func;
+    const SDL_ResamplerTable *resampler_table;
+    Uint8 *put_buffer;  /* handed out by SDL_AudioStreamPeekPut() */
+    int put_buffer_len;
+    SDL_bool put_buffer_staged;
 };
 
 static Uint8 *
@@ -1143,6 +2659,36 @@ EnsureStreamBufferSize(SDL_AudioStream *stream, const int newlen)
     return offset ? ptr + (16 - offset) : ptr;
 }
 
+/* How big the work buffer needs to be to convert buflen bytes of input */
+static int
+GetStreamWorkBufferLength(SDL_AudioStream *stream, const int buflen, int *resamplebuflen)
+{
+    int workbuflen = buflen;
+
+    if (stream->cvt_before_resampling.needed) {
+        workbuflen *= stream->cvt_before_resampling.len_mult;
+    }
+
+    *resamplebuflen = 0;
+    if (stream->dst_rate != stream->src_rate) {
+        /* resamples can't happen in place, so make space for second buf. */
+        const int framesize = stream->pre_resample_channels * sizeof (float);
+        const int frames = workbuflen / framesize;
+        *resamplebuflen = ((int) SDL_ceil(frames * stream->rate_incr)) * framesize;
+        #if DEBUG_AUDIOSTREAM
+        printf("AUDIOSTREAM: will resample %d bytes to %d (ratio=%.6f)\n", workbuflen, *resamplebuflen, stream->rate_incr);
+        #endif
+        workbuflen += *resamplebuflen;
+    }
+
+    if (stream->cvt_after_resampling.needed) {
+        /* !!! FIXME: buffer might be big enough already? */
+        workbuflen *= stream->cvt_after_resampling.len_mult;
+    }
+
+    return workbuflen + (stream->resampler_padding_samples * sizeof (float));
+}
+
 #ifdef HAVE_LIBSAMPLERATE_H
 static int
 SDL_ResampleAudioStream_SRC(SDL_AudioStream *stream, const void *_inbuf, const int inbuflen, void *_outbuf, const int outbuflen)
@@ -1244,7 +2790,7 @@ SDL_ResampleAudioStream(SDL_AudioStream *stream, const void *_inbuf, const int i
 
     SDL_assert(inbuf != ((const float *) outbuf));  /* SDL_AudioStreamPut() shouldn't allow in-place resamples. */
 
-    retval = SDL_ResampleAudio(chans, inrate, outrate, lpadding, rpadding, inbuf, inbuflen, outbuf, outbuflen);
+    retval = SDL_ResampleAudio(chans, inrate, outrate, stream->resampler_table, lpadding, rpadding, inbuf, inbuflen, outbuf, outbuflen);
 
     /* update our left padding with end of current input, for next run. */
     SDL_memcpy((lpadding + paddingsamples) - (cpy / sizeof (float)), inbufend - cpy, cpy);
@@ -1273,7 +2819,7 @@ SDL_NewAudioStream(const SDL_AudioFormat src_format,
                    const Uint8 dst_channels,
                    const int dst_rate)
 {
-    const int packetlen = 4096;  /* !!! FIXME: good enough for now. */
+    int packetlen = 4096;  /* !!! FIXME: good enough for now. */
     Uint8 pre_resample_channels;
     SDL_AudioStream *retval;
 
@@ -1298,6 +2844,12 @@ SDL_NewAudioStream(const SDL_AudioFormat src_format,
     retval->dst_channels = dst_channels;
     retval->dst_rate = dst_rate;
     retval->pre_resample_channels = pre_resample_channels;
+
+    /* Keep whole sample frames in each packet, so SDL_AudioStreamPeekGet()
+       never has to hand out a frame that's split between two packets. */
+    if (retval->dst_sample_frame_size > 0) {
+        packetlen -= packetlen % retval->dst_sample_frame_size;
+    }
     retval->packetlen = packetlen;
     retval->rate_incr = ((double) dst_rate) / ((double) src_rate);
     retval->resampler_padding_samples = ResamplerPadding(retval->src_rate, retval->dst_rate) * pre_resample_channels;
@@ -1353,6 +2905,9 @@ SDL_NewAudioStream(const SDL_AudioFormat src_format,
                 return NULL;
             }
 
+            /* Common rate pairs have a precomputed filter table, it's fine if this fails. */
+            retval->resampler_table = SDL_GetResamplerTable(src_rate, dst_rate);
+
             retval->resampler_func = SDL_ResampleAudioStream;
             retval->reset_resampler_func = SDL_ResetAudioStreamResampler;
             retval->cleanup_resampler_func = SDL_CleanupAudioStreamResampler;
@@ -1396,31 +2951,9 @@ SDL_AudioStreamPutInternal(SDL_AudioStream *stream, const void *buf, int len, in
     /* no padding prepended on first run. */
     neededpaddingbytes = stream->resampler_padding_samples * sizeof (float);
     paddingbytes = stream->first_run ? 0 : neededpaddingbytes;
-    stream->first_run = SDL_FALSE;
 
     /* Make sure the work buffer can hold all the data we need at once... */
-    workbuflen = buflen;
-    if (stream->cvt_before_resampling.needed) {
-        workbuflen *= stream->cvt_before_resampling.len_mult;
-    }
-
-    if (stream->dst_rate != stream->src_rate) {
-        /* resamples can't happen in place, so make space for second buf. */
-        const int framesize = stream->pre_resample_channels * sizeof (float);
-        const int frames = workbuflen / framesize;
-        resamplebuflen = ((int) SDL_ceil(frames * stream->rate_incr)) * framesize;
-        #if DEBUG_AUDIOSTREAM
-        printf("AUDIOSTREAM: will resample %d bytes to %d (ratio=%.6f)\n", workbuflen, resamplebuflen, stream->rate_incr);
-        #endif
-        workbuflen += resamplebuflen;
-    }
-
-    if (stream->cvt_after_resampling.needed) {
-        /* !!! FIXME: buffer might be big enough already? */
-        workbuflen *= stream->cvt_after_resampling.len_mult;
-    }
-
-    workbuflen += neededpaddingbytes;
+    workbuflen = GetStreamWorkBufferLength(stream, buflen, &resamplebuflen);
 
     #if DEBUG_AUDIOSTREAM
     printf("AUDIOSTREAM: Putting %d bytes of preconverted audio, need %d byte work buffer\n", buflen, workbuflen);
@@ -1430,10 +2963,14 @@ SDL_AudioStreamPutInternal(SDL_AudioStream *stream, const void *buf, int len, in
     if (!workbuf) {
         return -1;  /* probably out of memory. */
     }
+    stream->first_run = SDL_FALSE;
 
     resamplebuf = workbuf;  /* default if not resampling. */
 
-    SDL_memcpy(workbuf + paddingbytes, buf, buflen);
+    /* SDL_AudioStreamPeekPut() may have had the input written in place already. */
+    if (buf != workbuf + paddingbytes) {
+        SDL_memcpy(workbuf + paddingbytes, buf, buflen);
+    }
 
     if (stream->cvt_before_resampling.needed) {
         stream->cvt_before_resampling.buf = workbuf + paddingbytes;
@@ -1528,6 +3065,8 @@ SDL_AudioStreamPut(SDL_AudioStream *stream, const void *buf, int len)
         return SDL_SetError("Can't add partial sample frames");
     }
 
+    stream->put_buffer_len = 0;
+
     if (!stream->cvt_before_resampling.needed &&
         (stream->dst_rate == stream->src_rate) &&
         !stream->cvt_after_resampling.needed) {
@@ -1581,6 +3120,8 @@ int SDL_AudioStreamFlush(SDL_AudioStream *stream)
     /* shouldn't use a staging buffer if we're not resampling. */
     SDL_assert((stream->dst_rate != stream->src_rate) || (stream->staging_buffer_filled == 0));
 
+    stream->put_buffer_len = 0;
+
     if (stream->staging_buffer_filled > 0) {
         /* push the staging buffer + silence. We need to flush out not just
            the staging buffer, but the piece that the stream was saving off
@@ -1641,6 +3182,109 @@ SDL_AudioStreamGet(SDL_AudioStream *stream, void *buf, int len)
     return (int) SDL_ReadFromDataQueue(stream->queue, buf, len);
 }
 
+int
+SDL_AudioStreamPeekPut(SDL_AudioStream *stream, void **buf, int len)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (!buf) {
+        return SDL_InvalidParamError("buf");
+    } else if (len < 0) {
+        return SDL_InvalidParamError("len");
+    }
+
+    /* Round down to whole sample frames */
+    len -= len % stream->src_sample_frame_size;
+
+    if (stream->staging_buffer_filled || len < stream->staging_buffer_size) {
+        /* This would end up in the staging buffer anyhow, so write it there. */
+        len = SDL_min(len, stream->staging_buffer_size - stream->staging_buffer_filled);
+        stream->put_buffer = stream->staging_buffer + stream->staging_buffer_filled;
+        stream->put_buffer_staged = SDL_TRUE;
+    } else {
+        /* Otherwise it goes where SDL_AudioStreamPutInternal() would have copied it. */
+        const int paddingbytes = stream->first_run ? 0 : (stream->resampler_padding_samples * sizeof (float));
+        int resamplebuflen;
+        Uint8 *workbuf = EnsureStreamBufferSize(stream, GetStreamWorkBufferLength(stream, len, &resamplebuflen));
+        if (!workbuf) {
+            stream->put_buffer_len = 0;
+            return -1;  /* probably out of memory. */
+        }
+        stream->put_buffer = workbuf + paddingbytes;
+        stream->put_buffer_staged = SDL_FALSE;
+    }
+
+    stream->put_buffer_len = len;
+    *buf = stream->put_buffer;
+    return len;
+}
+
+int
+SDL_AudioStreamCommitPut(SDL_AudioStream *stream, int len)
+{
+    int retval = 0;
+
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (len < 0 || len > stream->put_buffer_len) {
+        return SDL_SetError("Committing more data than SDL_AudioStreamPeekPut() provided");
+    } else if ((len % stream->src_sample_frame_size) != 0) {
+        return SDL_SetError("Can't add partial sample frames");
+    }
+
+    stream->put_buffer_len = 0;
+    if (len == 0) {
+        return 0;  /* nothing to do. */
+    }
+
+    if (stream->put_buffer_staged) {
+        stream->staging_buffer_filled += len;
+        if (stream->staging_buffer_filled == stream->staging_buffer_size) {
+            stream->staging_buffer_filled = 0;
+            retval = SDL_AudioStreamPutInternal(stream, stream->staging_buffer, stream->staging_buffer_size, NULL);
+        }
+    } else if (!stream->cvt_before_resampling.needed &&
+               (stream->dst_rate == stream->src_rate) &&
+               !stream->cvt_after_resampling.needed) {
+        retval = SDL_WriteToDataQueue(stream->queue, stream->put_buffer, len);
+    } else {
+        retval = SDL_AudioStreamPutInternal(stream, stream->put_buffer, len, NULL);
+    }
+    return retval;
+}
+
+int
+SDL_AudioStreamPeekGet(SDL_AudioStream *stream, const void **buf)
+{
+    size_t len = 0;
+
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (!buf) {
+        return SDL_InvalidParamError("buf");
+    }
+
+    *buf = SDL_PeekDataQueueBuffer(stream->queue, &len);
+
+    /* The packets are sized so this should never split a frame, but be sure. */
+    return (int) (len - (len % stream->dst_sample_frame_size));
+}
+
+int
+SDL_AudioStreamCommitGet(SDL_AudioStream *stream, int len)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (len < 0 || len > (int) SDL_CountDataQueue(stream->queue)) {
+        return SDL_SetError("Committing more data than the stream has available");
+    } else if ((len % stream->dst_sample_frame_size) != 0) {
+        return SDL_SetError("Can't request partial sample frames");
+    }
+
+    SDL_DiscardFromDataQueue(stream->queue, len);
+    return 0;
+}
+
 /* number of converted/resampled bytes available */
 int
 SDL_AudioStreamAvailable(SDL_AudioStream *stream)
@@ -1660,6 +3304,7 @@ SDL_AudioStreamClear(SDL_AudioStream *stream)
         }
         stream->first_run = SDL_TRUE;
         stream->staging_buffer_filled = 0;
+        stream->put_buffer_len = 0;
     }
 }
 
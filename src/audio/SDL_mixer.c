@@ -22,11 +22,20 @@
 
 /* This provides the default mixing callback for the SDL audio routines */
 
+#include "SDL_atomic.h"
 #include "SDL_cpuinfo.h"
 #include "SDL_timer.h"
 #include "SDL_audio.h"
 #include "SDL_sysaudio.h"
 
+#ifdef __SSE2__
+#define HAVE_SSE2_INTRINSICS 1
+#endif
+
+#ifdef __ARM_NEON
+#define HAVE_NEON_INTRINSICS 1
+#endif
+
 /* This table is used to add two sound values together and pin
  * the value to avoid overflow.  (used with permission from ARDI)
  * Changed to use 0xFE instead of 0xFF for better sound quality.
@@ -85,15 +94,498 @@ static const Uint8 mix8[] = {
 #define ADJUST_VOLUME(s, v) (s = (s*v)/SDL_MIX_MAXVOLUME)
 #define ADJUST_VOLUME_U8(s, v)  (s = (((s-128)*v)/SDL_MIX_MAXVOLUME)+128)
 
+/* SIMD mixers for the common formats. Each one mixes as many whole vectors
+   as fit in len and returns the number of bytes it handled; the scalar code
+   below finishes off the rest. They give exactly the same results as the
+   scalar code: the volume multiply rounds toward zero like the C division
+   does, and sums saturate to the same limits. They expect 0 <= volume <= 128. */
+typedef Uint32 (*SDL_MixFunc)(Uint8 *dst, const Uint8 *src, Uint32 len, int volume);
+
+static SDL_MixFunc SDL_Mix_S16LSB = NULL;
+static SDL_MixFunc SDL_Mix_S16MSB = NULL;
+static SDL_MixFunc SDL_Mix_S32LSB = NULL;
+static SDL_MixFunc SDL_Mix_S32MSB = NULL;
+static SDL_MixFunc SDL_Mix_F32LSB = NULL;
+static SDL_MixFunc SDL_Mix_F32MSB = NULL;
+
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define MIX_SWAP_LSB SDL_FALSE
+#define MIX_SWAP_MSB SDL_TRUE
+#else
+#define MIX_SWAP_LSB SDL_TRUE
+#define MIX_SWAP_MSB SDL_FALSE
+#endif
+
+/* Generates the LSB and MSB entry points for a mixer that takes a byteswap flag. */
+#define MIX_FUNCS(fmt, fntype) \
+    static Uint32 SDL_Mix_##fmt##LSB_##fntype(Uint8 *dst, const Uint8 *src, Uint32 len, int volume) { \
+        return SDL_Mix_##fmt##_##fntype(dst, src, len, volume, MIX_SWAP_LSB); \
+    } \
+    static Uint32 SDL_Mix_##fmt##MSB_##fntype(Uint8 *dst, const Uint8 *src, Uint32 len, int volume) { \
+        return SDL_Mix_##fmt##_##fntype(dst, src, len, volume, MIX_SWAP_MSB); \
+    }
+
+#if HAVE_SSE2_INTRINSICS
+static SDL_INLINE __m128i
+SDL_Swap16_SSE2(const __m128i x)
+{
+    return _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+}
+
+static SDL_INLINE __m128i
+SDL_Swap32_SSE2(const __m128i x)
+{
+    const __m128i y = SDL_Swap16_SSE2(x);
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(y, 0xB1), 0xB1);
+}
+
+/* (x / 128) for 32-bit x, rounding toward zero. */
+static SDL_INLINE __m128i
+SDL_DivBy128_SSE2(const __m128i x)
+{
+    const __m128i bias = _mm_and_si128(_mm_srai_epi32(x, 31), _mm_set1_epi32(127));
+    return _mm_srai_epi32(_mm_add_epi32(x, bias), 7);
+}
+
+static SDL_INLINE Uint32
+SDL_Mix_S16_SSE2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, const SDL_bool swap)
+{
+    const __m128i vol = _mm_set1_epi16((Sint16) volume);
+    const Uint32 total = len & ~15;
+    Uint32 i;
+
+    for (i = 0; i < total; i += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i *) (src + i));
+        __m128i d = _mm_loadu_si128((const __m128i *) (dst + i));
+        __m128i lo, hi;
+        if (swap) {
+            s = SDL_Swap16_SSE2(s);
+            d = SDL_Swap16_SSE2(d);
+        }
+        lo = _mm_mullo_epi16(s, vol);
+        hi = _mm_mulhi_epi16(s, vol);
+        s = _mm_packs_epi32(SDL_DivBy128_SSE2(_mm_unpacklo_epi16(lo, hi)),
+                            SDL_DivBy128_SSE2(_mm_unpackhi_epi16(lo, hi)));
+        d = _mm_adds_epi16(s, d);
+        if (swap) {
+            d = SDL_Swap16_SSE2(d);
+        }
+        _mm_storeu_si128((__m128i *) (dst + i), d);
+    }
+    return total;
+}
+
+static SDL_INLINE Uint32
+SDL_Mix_S32_SSE2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, const SDL_bool swap)
+{
+    const __m128i vol = _mm_set1_epi32(volume);
+    const __m128i mask7 = _mm_set1_epi32(127);
+    const __m128i maxval = _mm_set1_epi32(0x7FFFFFFF);
+    const __m128i zero = _mm_setzero_si128();
+    const Uint32 total = len & ~15;
+    Uint32 i;
+
+    for (i = 0; i < total; i += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i *) (src + i));
+        __m128i d = _mm_loadu_si128((const __m128i *) (dst + i));
+        __m128i hi, lo, even, odd, sum, overflow;
+        if (swap) {
+            s = SDL_Swap32_SSE2(s);
+            d = SDL_Swap32_SSE2(d);
+        }
+
+        /* s * volume / 128 without 64-bit products: split s into
+           (hi * 128 + lo), with lo in 0..127, and scale each part. */
+        lo = _mm_mullo_epi16(_mm_and_si128(s, mask7), vol);  /* fits in the low 16 bits. */
+        hi = _mm_srai_epi32(s, 7);
+        even = _mm_mul_epu32(hi, vol);  /* low 32 bits are the same for signed values. */
+        odd = _mm_mul_epu32(_mm_srli_epi64(hi, 32), vol);
+        hi = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, 0x08), _mm_shuffle_epi32(odd, 0x08));
+        hi = _mm_add_epi32(hi, _mm_srli_epi32(lo, 7));
+        /* that was rounded down; round negative, inexact results toward zero instead. */
+        s = _mm_sub_epi32(hi, _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(lo, mask7), zero), _mm_srai_epi32(s, 31)));
+
+        /* saturating add */
+        sum = _mm_add_epi32(s, d);
+        overflow = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(sum, s), _mm_xor_si128(sum, d)), 31);
+        d = _mm_or_si128(_mm_and_si128(overflow, _mm_xor_si128(_mm_srai_epi32(s, 31), maxval)),
+                         _mm_andnot_si128(overflow, sum));
+        if (swap) {
+            d = SDL_Swap32_SSE2(d);
+        }
+        _mm_storeu_si128((__m128i *) (dst + i), d);
+    }
+    return total;
+}
+
+static SDL_INLINE Uint32
+SDL_Mix_F32_SSE2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, const SDL_bool swap)
+{
+    const __m128 fvolume = _mm_set1_ps((float) volume);
+    const __m128 fmaxvolume = _mm_set1_ps(1.0f / ((float) SDL_MIX_MAXVOLUME));
+    const __m128 maxval = _mm_set1_ps(3.402823466e+38F);
+    const __m128 minval = _mm_set1_ps(-3.402823466e+38F);
+    const Uint32 total = len & ~15;
+    Uint32 i;
+
+    for (i = 0; i < total; i += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i *) (src + i));
+        __m128i d = _mm_loadu_si128((const __m128i *) (dst + i));
+        __m128 sum;
+        if (swap) {
+            s = SDL_Swap32_SSE2(s);
+            d = SDL_Swap32_SSE2(d);
+        }
+        sum = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_castsi128_ps(s), fvolume), fmaxvolume), _mm_castsi128_ps(d));
+        /* clamp infinities like the scalar code does; NaNs pass through. */
+        sum = _mm_min_ps(maxval, _mm_max_ps(minval, sum));
+        d = _mm_castps_si128(sum);
+        if (swap) {
+            d = SDL_Swap32_SSE2(d);
+        }
+        _mm_storeu_si128((__m128i *) (dst + i), d);
+    }
+    return total;
+}
+
+MIX_FUNCS(S16, SSE2)
+MIX_FUNCS(S32, SSE2)
+MIX_FUNCS(F32, SSE2)
+#endif
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2") static SDL_INLINE __m256i
+SDL_Swap16_AVX2(const __m256i x)
+{
+    return _mm256_or_si256(_mm256_slli_epi16(x, 8), _mm256_srli_epi16(x, 8));
+}
+
+SDL_TARGETING("avx2") static SDL_INLINE __m256i
+SDL_Swap32_AVX2(const __m256i x)
+{
+    const __m256i shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                             3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    return _mm256_shuffle_epi8(x, shuffle);
+}
+
+SDL_TARGETING("avx2") static SDL_INLINE __m256i
+SDL_DivBy128_AVX2(const __m256i x)
+{
+    const __m256i bias = _mm256_and_si256(_mm256_srai_epi32(x, 31), _mm256_set1_epi32(127));
+    return _mm256_srai_epi32(_mm256_add_epi32(x, bias), 7);
+}
+
+SDL_TARGETING("avx2") static SDL_INLINE Uint32
+SDL_Mix_S16_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, const SDL_bool swap)
+{
+    const __m256i vol = _mm256_set1_epi16((Sint16) volume);
+    const Uint32 total = len & ~31;
+    Uint32 i;
+
+    for (i = 0; i < total; i += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i *) (src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i *) (dst + i));
+        __m256i lo, hi;
+        if (swap) {
+            s = SDL_Swap16_AVX2(s);
+            d = SDL_Swap16_AVX2(d);
+        }
+        lo = _mm256_mullo_epi16(s, vol);
+        hi = _mm256_mulhi_epi16(s, vol);
+        /* unpack and pack both work within 128-bit lanes, so the order comes back out right. */
+        s = _mm256_packs_epi32(SDL_DivBy128_AVX2(_mm256_unpacklo_epi16(lo, hi)),
+                               SDL_DivBy128_AVX2(_mm256_unpackhi_epi16(lo, hi)));
+        d = _mm256_adds_epi16(s, d);
+        if (swap) {
+            d = SDL_Swap16_AVX2(d);
+        }
+        _mm256_storeu_si256((__m256i *) (dst + i), d);
+    }
+    return total;
+}
+
+SDL_TARGETING("avx2") static SDL_INLINE Uint32
+SDL_Mix_S32_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, const SDL_bool swap)
+{
+    const __m256i vol = _mm256_set1_epi32(volume);
+    const __m256i mask7 = _mm256_set1_epi32(127);
+    const __m256i maxval = _mm256_set1_epi32(0x7FFFFFFF);
+    const __m256i zero = _mm256_setzero_si256();
+    const Uint32 total = len & ~31;
+    Uint32 i;
+
+    for (i = 0; i < total; i += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i *) (src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i *) (dst + i));
+        __m256i hi, lo, sum, overflow;
+        if (swap) {
+            s = SDL_Swap32_AVX2(s);
+            d = SDL_Swap32_AVX2(d);
+        }
+
+        /* same split as the SSE2 version, see there. */
+        lo = _mm256_mullo_epi32(_mm256_and_si256(s, mask7), vol);
+        hi = _mm256_mullo_epi32(_mm256_srai_epi32(s, 7), vol);
+        hi = _mm256_add_epi32(hi, _mm256_srli_epi32(lo, 7));
+        s = _mm256_sub_epi32(hi, _mm256_andnot_si256(_mm256_cmpeq_epi32(_mm256_and_si256(lo, mask7), zero), _mm256_srai_epi32(s, 31)));
+
+        sum = _mm256_add_epi32(s, d);
+        overflow = _mm256_srai_epi32(_mm256_and_si256(_mm256_xor_si256(sum, s), _mm256_xor_si256(sum, d)), 31);
+        d = _mm256_blendv_epi8(sum, _mm256_xor_si256(_mm256_srai_epi32(s, 31), maxval), overflow);
+        if (swap) {
+            d = SDL_Swap32_AVX2(d);
+        }
+        _mm256_storeu_si256((__m256i *) (dst + i), d);
+    }
+    return total;
+}
+
+SDL_TARGETING("avx2") static SDL_INLINE Uint32
+SDL_Mix_F32_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, const SDL_bool swap)
+{
+    const __m256 fvolume = _mm256_set1_ps((float) volume);
+    const __m256 fmaxvolume = _mm256_set1_ps(1.0f / ((float) SDL_MIX_MAXVOLUME));
+    const __m256 maxval = _mm256_set1_ps(3.402823466e+38F);
+    const __m256 minval = _mm256_set1_ps(-3.402823466e+38F);
+    const Uint32 total = len & ~31;
+    Uint32 i;
+
+    for (i = 0; i < total; i += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i *) (src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i *) (dst + i));
+        __m256 sum;
+        if (swap) {
+            s = SDL_Swap32_AVX2(s);
+            d = SDL_Swap32_AVX2(d);
+        }
+        sum = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_castsi256_ps(s), fvolume), fmaxvolume), _mm256_castsi256_ps(d));
+        sum = _mm256_min_ps(maxval, _mm256_max_ps(minval, sum));
+        d = _mm256_castps_si256(sum);
+        if (swap) {
+            d = SDL_Swap32_AVX2(d);
+        }
+        _mm256_storeu_si256((__m256i *) (dst + i), d);
+    }
+    return total;
+}
+
+#define MIX_FUNCS_AVX2(fmt) \
+    SDL_TARGETING("avx2") static Uint32 SDL_Mix_##fmt##LSB_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume) { \
+        return SDL_Mix_##fmt##_AVX2(dst, src, len, volume, MIX_SWAP_LSB); \
+    } \
+    SDL_TARGETING("avx2") static Uint32 SDL_Mix_##fmt##MSB_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume) { \
+        return SDL_Mix_##fmt##_AVX2(dst, src, len, volume, MIX_SWAP_MSB); \
+    }
+
+MIX_FUNCS_AVX2(S16)
+MIX_FUNCS_AVX2(S32)
+MIX_FUNCS_AVX2(F32)
+#undef MIX_FUNCS_AVX2
+#endif
+
+#if HAVE_NEON_INTRINSICS
+static SDL_INLINE int32x4_t
+SDL_DivBy128_NEON(const int32x4_t x)
+{
+    const int32x4_t bias = vandq_s32(vshrq_n_s32(x, 31), vdupq_n_s32(127));
+    return vshrq_n_s32(vaddq_s32(x, bias), 7);
+}
+
+static SDL_INLINE Uint32
+SDL_Mix_S16_NEON(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, const SDL_bool swap)
+{
+    const int16x4_t vol = vdup_n_s16((Sint16) volume);
+    const Uint32 total = len & ~15;
+    Uint32 i;
+
+    for (i = 0; i < total; i += 16) {
+        uint8x16_t sbytes = vld1q_u8(src + i);
+        uint8x16_t dbytes = vld1q_u8(dst + i);
+        int16x8_t s, d;
+        if (swap) {
+            sbytes = vrev16q_u8(sbytes);
+            dbytes = vrev16q_u8(dbytes);
+        }
+        s = vreinterpretq_s16_u8(sbytes);
+        d = vreinterpretq_s16_u8(dbytes);
+        s = vcombine_s16(vqmovn_s32(SDL_DivBy128_NEON(vmull_s16(vget_low_s16(s), vol))),
+                         vqmovn_s32(SDL_DivBy128_NEON(vmull_s16(vget_high_s16(s), vol))));
+        dbytes = vreinterpretq_u8_s16(vqaddq_s16(s, d));
+        if (swap) {
+            dbytes = vrev16q_u8(dbytes);
+        }
+        vst1q_u8(dst + i, dbytes);
+    }
+    return total;
+}
+
+static SDL_INLINE Uint32
+SDL_Mix_S32_NEON(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, const SDL_bool swap)
+{
+    const int32x4_t mask7 = vdupq_n_s32(127);
+    const Uint32 total = len & ~15;
+    Uint32 i;
+
+    for (i = 0; i < total; i += 16) {
+        uint8x16_t sbytes = vld1q_u8(src + i);
+        uint8x16_t dbytes = vld1q_u8(dst + i);
+        int32x4_t s, hi, lo;
+        uint32x4_t inexact;
+        if (swap) {
+            sbytes = vrev32q_u8(sbytes);
+            dbytes = vrev32q_u8(dbytes);
+        }
+        s = vreinterpretq_s32_u8(sbytes);
+
+        /* same split as the SSE2 version, see there. */
+        lo = vmulq_n_s32(vandq_s32(s, mask7), volume);
+        hi = vmulq_n_s32(vshrq_n_s32(s, 7), volume);
+        hi = vaddq_s32(hi, vshrq_n_s32(lo, 7));
+        inexact = vtstq_s32(lo, mask7);
+        s = vsubq_s32(hi, vandq_s32(vreinterpretq_s32_u32(inexact), vshrq_n_s32(s, 31)));
+
+        dbytes = vreinterpretq_u8_s32(vqaddq_s32(s, vreinterpretq_s32_u8(dbytes)));
+        if (swap) {
+            dbytes = vrev32q_u8(dbytes);
+        }
+        vst1q_u8(dst + i, dbytes);
+    }
+    return total;
+}
+
+static SDL_INLINE Uint32
+SDL_Mix_F32_NEON(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, const SDL_bool swap)
+{
+    const float fvolume = (float) volume;
+    const float fmaxvolume = 1.0f / ((float) SDL_MIX_MAXVOLUME);
+    const float32x4_t maxval = vdupq_n_f32(3.402823466e+38F);
+    const float32x4_t minval = vdupq_n_f32(-3.402823466e+38F);
+    const Uint32 total = len & ~15;
+    Uint32 i;
+
+    for (i = 0; i < total; i += 16) {
+        uint8x16_t sbytes = vld1q_u8(src + i);
+        uint8x16_t dbytes = vld1q_u8(dst + i);
+        float32x4_t sum;
+        if (swap) {
+            sbytes = vrev32q_u8(sbytes);
+            dbytes = vrev32q_u8(dbytes);
+        }
+        /* separate multiplies and add, no fused ops, to round like the scalar code. */
+        sum = vmulq_n_f32(vmulq_n_f32(vreinterpretq_f32_u8(sbytes), fvolume), fmaxvolume);
+        sum = vaddq_f32(sum, vreinterpretq_f32_u8(dbytes));
+        sum = vminq_f32(maxval, vmaxq_f32(minval, sum));
+        dbytes = vreinterpretq_u8_f32(sum);
+        if (swap) {
+            dbytes = vrev32q_u8(dbytes);
+        }
+        vst1q_u8(dst + i, dbytes);
+    }
+    return total;
+}
+
+MIX_FUNCS(S16, NEON)
+MIX_FUNCS(S32, NEON)
+MIX_FUNCS(F32, NEON)
+#endif
+
+#undef MIX_FUNCS
+
+static void
+SDL_SelectAudioMixers(void)
+{
+#define SET_MIXER_FUNCS(fntype) \
+        SDL_Mix_S16LSB = SDL_Mix_S16LSB_##fntype; \
+        SDL_Mix_S16MSB = SDL_Mix_S16MSB_##fntype; \
+        SDL_Mix_S32LSB = SDL_Mix_S32LSB_##fntype; \
+        SDL_Mix_S32MSB = SDL_Mix_S32MSB_##fntype; \
+        SDL_Mix_F32LSB = SDL_Mix_F32LSB_##fntype; \
+        SDL_Mix_F32MSB = SDL_Mix_F32MSB_##fntype
+
+#if SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        SET_MIXER_FUNCS(AVX2);
+        return;
+    }
+#endif
+
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        SET_MIXER_FUNCS(SSE2);
+        return;
+    }
+#endif
+
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        SET_MIXER_FUNCS(NEON);
+        return;
+    }
+#endif
+
+#undef SET_MIXER_FUNCS
+
+    /* no SIMD available, the scalar code does everything. */
+}
+
+/* SDL_MixAudioFormat() can be called from any thread without the audio
+   subsystem, so the first caller picks the mixers and any others that race
+   it wait until the pointers are published. */
+static void
+SDL_ChooseAudioMixers(void)
+{
+    static SDL_atomic_t mixers_chosen;  /* 0: not yet, 1: choosing, 2: done */
+
+    if (SDL_AtomicGet(&mixers_chosen) == 2) {
+        return;
+    }
+
+    if (SDL_AtomicCAS(&mixers_chosen, 0, 1)) {
+        SDL_SelectAudioMixers();
+        SDL_MemoryBarrierRelease();
+        SDL_AtomicSet(&mixers_chosen, 2);
+    } else {
+        while (SDL_AtomicGet(&mixers_chosen) != 2) {
+            SDL_Delay(0);
+        }
+    }
+}
+
 
 void
 SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
                    Uint32 len, int volume)
 {
+    SDL_MixFunc mixer = NULL;
+
     if (volume == 0) {
         return;
     }
 
+    SDL_ChooseAudioMixers();
+
+    if ((volume > 0) && (volume <= SDL_MIX_MAXVOLUME)) {
+        switch (format) {
+        case AUDIO_S16LSB: mixer = SDL_Mix_S16LSB; break;
+        case AUDIO_S16MSB: mixer = SDL_Mix_S16MSB; break;
+        case AUDIO_S32LSB: mixer = SDL_Mix_S32LSB; break;
+        case AUDIO_S32MSB: mixer = SDL_Mix_S32MSB; break;
+        case AUDIO_F32LSB: mixer = SDL_Mix_F32LSB; break;
+        case AUDIO_F32MSB: mixer = SDL_Mix_F32MSB; break;
+        default: break;
+        }
+    }
+
+    if (mixer) {
+        const Uint32 mixed = mixer(dst, src, len, volume);
+        dst += mixed;
+        src += mixed;
+        len -= mixed;
+        if (len == 0) {
+            return;
+        }
+    }
+
     switch (format) {
 
     case AUDIO_U8:
@@ -366,4 +858,178 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
     }
 }
 
+/* Samples SDL_MixAudioSources() handles at a time, rounded down to whole
+   frames. The float sum and the conversion scratch are on the stack, and
+   audio callbacks may run on threads with small stacks, so they're kept to
+   2KB each. */
+#define MIX_BATCH_SAMPLES 512
+#define MIX_MAX_CHANNELS 8
+
+/* Get one block of a source as native floats. Native-endian integer formats
+   are done here in loops the compiler can vectorize; the rest go through the
+   regular converters. */
+static const float *
+SDL_MixSourceToFloat(float *scratch, const Uint8 *src, SDL_AudioFormat format,
+                     int count, SDL_AudioCVT *cvt)
+{
+    const float DIVBY32768 = 0.000030517578125f;
+    const float DIVBY2147483648 = 0.0000000004656612873077392578125f;
+    int i;
+
+    switch (format) {
+    case AUDIO_S16SYS:
+        for (i = 0; i < count; i++) {
+            scratch[i] = ((float) ((const Sint16 *) src)[i]) * DIVBY32768;
+        }
+        return scratch;
+    case AUDIO_S32SYS:
+        for (i = 0; i < count; i++) {
+            scratch[i] = ((float) ((const Sint32 *) src)[i]) * DIVBY2147483648;
+        }
+        return scratch;
+    case AUDIO_F32SYS:
+        return (const float *) src;
+    default:
+        break;
+    }
+
+    SDL_memcpy(scratch, src, count * (SDL_AUDIO_BITSIZE(format) / 8));
+    cvt->buf = (Uint8 *) scratch;
+    cvt->len = count * (SDL_AUDIO_BITSIZE(format) / 8);
+    SDL_ConvertAudio(cvt);
+    return scratch;
+}
+
+/* Convert and sum an unpanned source straight into the float sum, for the
+   native-endian formats where that can be done in one pass. */
+static SDL_bool
+SDL_MixSourceAccumulate(float *accum, const Uint8 *src, SDL_AudioFormat format,
+                        int count, float gain)
+{
+    int i;
+
+    switch (format) {
+    case AUDIO_S16SYS: {
+        const float scale = gain * 0.000030517578125f;
+        for (i = 0; i < count; i++) {
+            accum[i] += ((float) ((const Sint16 *) src)[i]) * scale;
+        }
+        return SDL_TRUE;
+    }
+    case AUDIO_S32SYS: {
+        const float scale = gain * 0.0000000004656612873077392578125f;
+        for (i = 0; i < count; i++) {
+            accum[i] += ((float) ((const Sint32 *) src)[i]) * scale;
+        }
+        return SDL_TRUE;
+    }
+    case AUDIO_F32SYS:
+        for (i = 0; i < count; i++) {
+            accum[i] += ((const float *) src)[i] * gain;
+        }
+        return SDL_TRUE;
+    default:
+        break;
+    }
+    return SDL_FALSE;
+}
+
+int
+SDL_MixAudioSources(Uint8 * dst, const SDL_AudioMixSource * sources,
+                    int num_sources, SDL_AudioFormat format,
+                    int channels, Uint32 len)
+{
+    float accum[MIX_BATCH_SAMPLES];
+    float scratch[MIX_BATCH_SAMPLES];  /* big enough for any format converted to float. */
+    float gains[MIX_MAX_CHANNELS];
+    SDL_AudioCVT tofloat, fromfloat;
+    Uint32 framesize, batchsize;
+    Uint32 offset = 0;
+    int i, j, k;
+
+    if (!dst) {
+        return SDL_InvalidParamError("dst");
+    } else if ((num_sources < 0) || ((num_sources > 0) && !sources)) {
+        return SDL_InvalidParamError("sources");
+    } else if ((channels < 1) || (channels > MIX_MAX_CHANNELS)) {
+        return SDL_InvalidParamError("channels");
+    }
+
+    /* This also rejects formats we don't know about. */
+    if ((SDL_BuildAudioCVT(&tofloat, format, 1, 48000, AUDIO_F32SYS, 1, 48000) < 0) ||
+        (SDL_BuildAudioCVT(&fromfloat, AUDIO_F32SYS, 1, 48000, format, 1, 48000) < 0)) {
+        return -1;
+    }
+
+    framesize = (SDL_AUDIO_BITSIZE(format) / 8) * channels;
+    if ((len % framesize) != 0) {
+        return SDL_SetError("len must be a multiple of the sample frame size");
+    }
+    batchsize = (MIX_BATCH_SAMPLES / channels) * framesize;
+
+    while (offset < len) {
+        const Uint32 bytes = SDL_min(len - offset, batchsize);
+        const int count = (int) (bytes / framesize) * channels;
+
+        SDL_memset(accum, '\0', count * sizeof (float));
+
+        for (i = 0; i < num_sources; i++) {
+            const SDL_AudioMixSource *source = &sources[i];
+            const float *samples;
+            float gain;
+
+            if (!source->src || (source->volume == 0)) {
+                continue;
+            }
+
+            gain = ((float) source->volume) / ((float) SDL_MIX_MAXVOLUME);
+            if (!source->pan && SDL_MixSourceAccumulate(accum, source->src + offset, format, count, gain)) {
+                continue;  /* converted and summed in one pass. */
+            }
+
+            samples = SDL_MixSourceToFloat(scratch, source->src + offset, format, count, &tofloat);
+            if (!source->pan) {
+                for (j = 0; j < count; j++) {
+                    accum[j] += samples[j] * gain;
+                }
+            } else if (channels == 2) {
+                const float left = gain * source->pan[0];
+                const float right = gain * source->pan[1];
+                for (j = 0; j < count; j += 2) {
+                    accum[j] += samples[j] * left;
+                    accum[j + 1] += samples[j + 1] * right;
+                }
+            } else {
+                for (k = 0; k < channels; k++) {
+                    gains[k] = gain * source->pan[k];
+                }
+                for (j = 0; j < count; j += channels) {
+                    for (k = 0; k < channels; k++) {
+                        accum[j + k] += samples[j + k] * gains[k];
+                    }
+                }
+            }
+        }
+
+        /* The integer converters clip on their own; float output doesn't. */
+        if (SDL_AUDIO_ISFLOAT(format)) {
+            for (j = 0; j < count; j++) {
+                accum[j] = SDL_max(-1.0f, SDL_min(1.0f, accum[j]));
+            }
+        }
+
+        /* every source has been read for this block, so dst may be one of them. */
+        if (fromfloat.needed) {
+            fromfloat.buf = (Uint8 *) accum;
+            fromfloat.len = count * (int) sizeof (float);
+            SDL_ConvertAudio(&fromfloat);
+        }
+        SDL_memcpy(dst + offset, accum, bytes);
+
+        offset += bytes;
+    }
+
+    return 0;
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
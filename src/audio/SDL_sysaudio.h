@@ -165,6 +165,9 @@ struct SDL_AudioDevice
     /* Queued buffers (if app not using callback). */
     SDL_DataQueue *buffer_queue;
 
+    /* Used instead of buffer_queue if SDL_HINT_AUDIO_QUEUE_LOCKFREE was set. */
+    SDL_SPSCDataQueue *spsc_queue;
+
     /* * * */
     /* Data private to this driver */
     struct SDL_PrivateAudioData *hidden;
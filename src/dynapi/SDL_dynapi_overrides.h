@@ -764,3 +764,13 @@
 #define SDL_trunc SDL_trunc_REAL
 #define SDL_truncf SDL_truncf_REAL
 #define SDL_GetPreferredLocales SDL_GetPreferredLocales_REAL
+#define SDL_AddTimerNS SDL_AddTimerNS_REAL
+#define SDL_AudioStreamPeekPut SDL_AudioStreamPeekPut_REAL
+#define SDL_AudioStreamCommitPut SDL_AudioStreamCommitPut_REAL
+#define SDL_AudioStreamPeekGet SDL_AudioStreamPeekGet_REAL
+#define SDL_AudioStreamCommitGet SDL_AudioStreamCommitGet_REAL
+#define SDL_MixAudioSources SDL_MixAudioSources_REAL
+#define SDL_RenderCopySprites SDL_RenderCopySprites_REAL
+#define SDL_GetRenderStats SDL_GetRenderStats_REAL
+#define SDL_UpdateTextureAsync SDL_UpdateTextureAsync_REAL
+#define SDL_SoftStretchLinear SDL_SoftStretchLinear_REAL
@@ -823,3 +823,13 @@ SDL_DYNAPI_PROC(void,SDL_Metal_GetDrawableSize,(SDL_Window *a, int *b, int *c),(
 SDL_DYNAPI_PROC(double,SDL_trunc,(double a),(a),return)
 SDL_DYNAPI_PROC(float,SDL_truncf,(float a),(a),return)
 SDL_DYNAPI_PROC(SDL_Locale *,SDL_GetPreferredLocales,(void),(),return)
+SDL_DYNAPI_PROC(SDL_TimerID,SDL_AddTimerNS,(Uint64 a, SDL_NSTimerCallback b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_AudioStreamPeekPut,(SDL_AudioStream *a, void **b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_AudioStreamCommitPut,(SDL_AudioStream *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_AudioStreamPeekGet,(SDL_AudioStream *a, const void **b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_AudioStreamCommitGet,(SDL_AudioStream *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_MixAudioSources,(Uint8 *a, const SDL_AudioMixSource *b, int c, SDL_AudioFormat d, int e, Uint32 f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_RenderCopySprites,(SDL_Renderer *a, SDL_Texture *b, const SDL_RenderSprite *c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_GetRenderStats,(SDL_Renderer *a, SDL_RenderStats *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_UpdateTextureAsync,(SDL_Texture *a, const SDL_Rect *b, const void *c, int d, SDL_TextureUploadCallback e, void *f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_SoftStretchLinear,(SDL_Surface *a, const SDL_Rect *b, SDL_Surface *c, const SDL_Rect *d),(a,b,c,d),return)
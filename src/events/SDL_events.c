@@ -43,6 +43,14 @@
 /* An arbitrary limit so we don't have unbounded growth */
 #define SDL_MAX_QUEUED_EVENTS   65535
 
+/* The number of lock-free slots in front of the queue, must be a power of 2 */
+#define SDL_EVENT_RING_SIZE     256
+#define SDL_EVENT_RING_MASK     (SDL_EVENT_RING_SIZE-1)
+
+/* Even when blocked waiting for events we pump this often (in ms), so signals
+   and device hotplug that are only noticed while pumping still get through */
+#define SDL_WAIT_PUMP_INTERVAL  100
+
 typedef struct SDL_EventWatcher {
     SDL_EventFilter callback;
     void *userdata;
@@ -78,18 +86,46 @@ typedef struct _SDL_SysWMEntry
     struct _SDL_SysWMEntry *next;
 } SDL_SysWMEntry;
 
+/* Events pushed from any thread land here without taking the queue lock,
+   and are moved into the locked list before anybody looks at the queue. */
+typedef struct
+{
+    SDL_atomic_t sequence;
+    SDL_Event event;
+    SDL_SysWMmsg msg;
+} SDL_EventRingEntry;
+
+typedef struct
+{
+    SDL_EventRingEntry entries[SDL_EVENT_RING_SIZE];
+
+    char cache_pad1[SDL_CACHELINE_SIZE-((sizeof(SDL_EventRingEntry)*SDL_EVENT_RING_SIZE)%SDL_CACHELINE_SIZE)];
+
+    SDL_atomic_t enqueue_pos;
+
+    char cache_pad2[SDL_CACHELINE_SIZE-sizeof(SDL_atomic_t)];
+
+    SDL_atomic_t dequeue_pos;
+
+    char cache_pad3[SDL_CACHELINE_SIZE-sizeof(SDL_atomic_t)];
+} SDL_EventRing;
+
 static struct
 {
     SDL_mutex *lock;
+    SDL_cond *wakeup;
+    SDL_atomic_t waiters;
     SDL_atomic_t active;
+    SDL_atomic_t callers;
     SDL_atomic_t count;
-    int max_events_seen;
+    SDL_atomic_t max_events_seen;
+    SDL_EventRing *ring;
     SDL_EventEntry *head;
     SDL_EventEntry *tail;
     SDL_EventEntry *free;
     SDL_SysWMEntry *wmmsg_used;
     SDL_SysWMEntry *wmmsg_free;
-} SDL_EventQ = { NULL, { 1 }, { 0 }, 0, NULL, NULL, NULL, NULL, NULL };
+} SDL_EventQ = { NULL, NULL, { 0 }, { 1 }, { 0 }, { 0 }, { 0 }, NULL, NULL, NULL, NULL, NULL, NULL };
 
 
 /* 0 (default) means no logging, 1 means logging, 2 means logging with mouse and finger motion */
@@ -351,15 +387,32 @@ SDL_StopEventLoop(void)
     SDL_EventEntry *entry;
     SDL_SysWMEntry *wmmsg;
 
+    /* Producers use the ring without the queue lock, so turn them away and
+       wait for the ones already inside before tearing anything down */
+    SDL_AtomicCAS(&SDL_EventQ.active, 1, 0);
     if (SDL_EventQ.lock) {
         SDL_LockMutex(SDL_EventQ.lock);
+        if (SDL_EventQ.wakeup) {
+            SDL_CondBroadcast(SDL_EventQ.wakeup);
+        }
+        SDL_UnlockMutex(SDL_EventQ.lock);
+    }
+    while (SDL_AtomicGet(&SDL_EventQ.callers) > 0) {
+        SDL_Delay(1);
     }
 
-    SDL_AtomicSet(&SDL_EventQ.active, 0);
+    if (SDL_EventQ.lock) {
+        SDL_LockMutex(SDL_EventQ.lock);
+    }
 
     if (report && SDL_atoi(report)) {
         SDL_Log("SDL EVENT QUEUE: Maximum events in-flight: %d\n",
-                SDL_EventQ.max_events_seen);
+                SDL_AtomicGet(&SDL_EventQ.max_events_seen));
+    }
+
+    if (SDL_EventQ.ring) {
+        SDL_free(SDL_EventQ.ring);
+        SDL_EventQ.ring = NULL;
     }
 
     /* Clean out EventQ */
@@ -385,7 +438,7 @@ SDL_StopEventLoop(void)
     }
 
     SDL_AtomicSet(&SDL_EventQ.count, 0);
-    SDL_EventQ.max_events_seen = 0;
+    SDL_AtomicSet(&SDL_EventQ.max_events_seen, 0);
     SDL_EventQ.head = NULL;
     SDL_EventQ.tail = NULL;
     SDL_EventQ.free = NULL;
@@ -409,6 +462,11 @@ SDL_StopEventLoop(void)
     }
     SDL_zero(SDL_EventOK);
 
+    if (SDL_EventQ.wakeup) {
+        SDL_DestroyCond(SDL_EventQ.wakeup);
+        SDL_EventQ.wakeup = NULL;
+    }
+
     if (SDL_EventQ.lock) {
         SDL_UnlockMutex(SDL_EventQ.lock);
         SDL_DestroyMutex(SDL_EventQ.lock);
@@ -441,6 +499,26 @@ SDL_StartEventLoop(void)
             return -1;
         }
     }
+
+    /* Without the condition variable, waiting for events falls back to polling */
+    if (!SDL_EventQ.wakeup) {
+        SDL_EventQ.wakeup = SDL_CreateCond();
+    }
+
+    /* Without the ring, events are simply added with the queue locked */
+    if (!SDL_EventQ.ring) {
+        SDL_EventRing *ring = (SDL_EventRing *)SDL_malloc(sizeof(*ring));
+        if (ring) {
+            int i;
+
+            for (i = 0; i < SDL_EVENT_RING_SIZE; ++i) {
+                SDL_AtomicSet(&ring->entries[i].sequence, i);
+            }
+            SDL_AtomicSet(&ring->enqueue_pos, 0);
+            SDL_AtomicSet(&ring->dequeue_pos, 0);
+            SDL_EventQ.ring = ring;
+        }
+    }
 #endif /* !SDL_THREADS_DISABLED */
 
     /* Process most event types */
@@ -458,36 +536,66 @@ SDL_StartEventLoop(void)
 }
 
 
-/* Add an event to the event queue -- called with the queue locked */
-static int
-SDL_AddEvent(SDL_Event * event)
+/* Keep the queue from being torn down while we use it, fails once the event loop has stopped */
+static SDL_bool
+SDL_EnterEventQueue(void)
 {
-    SDL_EventEntry *entry;
-    const int initial_count = SDL_AtomicGet(&SDL_EventQ.count);
-    int final_count;
-
-    if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
-        SDL_SetError("Event queue is full (%d events)", initial_count);
-        return 0;
+    SDL_AtomicIncRef(&SDL_EventQ.callers);
+    if (!SDL_AtomicGet(&SDL_EventQ.active)) {
+        SDL_AtomicAdd(&SDL_EventQ.callers, -1);
+        return SDL_FALSE;
     }
+    return SDL_TRUE;
+}
+
+static void
+SDL_LeaveEventQueue(void)
+{
+    SDL_AtomicAdd(&SDL_EventQ.callers, -1);
+}
+
+/* Count an event against SDL_MAX_QUEUED_EVENTS -- safe to call unlocked */
+static SDL_bool
+SDL_ReserveEvent(void)
+{
+    int initial_count, final_count, max_events_seen;
+
+    do {
+        initial_count = SDL_AtomicGet(&SDL_EventQ.count);
+        if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
+            SDL_SetError("Event queue is full (%d events)", initial_count);
+            return SDL_FALSE;
+        }
+        final_count = initial_count + 1;
+    } while (!SDL_AtomicCAS(&SDL_EventQ.count, initial_count, final_count));
+
+    do {
+        max_events_seen = SDL_AtomicGet(&SDL_EventQ.max_events_seen);
+    } while (final_count > max_events_seen &&
+             !SDL_AtomicCAS(&SDL_EventQ.max_events_seen, max_events_seen, final_count));
+
+    return SDL_TRUE;
+}
+
+/* Link an already counted event at the end of the queue -- called with the queue locked */
+static SDL_bool
+SDL_LinkEvent(const SDL_Event * event, const SDL_SysWMmsg * msg)
+{
+    SDL_EventEntry *entry;
 
     if (SDL_EventQ.free == NULL) {
         entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
         if (!entry) {
-            return 0;
+            return SDL_FALSE;
         }
     } else {
         entry = SDL_EventQ.free;
         SDL_EventQ.free = entry->next;
     }
 
-    if (SDL_DoEventLogging) {
-        SDL_LogEvent(event);
-    }
-
     entry->event = *event;
     if (event->type == SDL_SYSWMEVENT) {
-        entry->msg = *event->syswm.msg;
+        entry->msg = *msg;
         entry->event.syswm.msg = &entry->msg;
     }
 
@@ -503,11 +611,114 @@ SDL_AddEvent(SDL_Event * event)
         entry->prev = NULL;
         entry->next = NULL;
     }
+    return SDL_TRUE;
+}
+
+/* Move everything published to the ring into the queue -- called with the queue locked.
+   Returns the number of events moved, or -1 if we ran out of memory. */
+static int
+SDL_DrainEventRing(void)
+{
+    SDL_EventRing *ring = SDL_EventQ.ring;
+    SDL_EventRingEntry *entry;
+    unsigned queue_pos, start_pos;
+    int status = 0;
+
+    if (!ring) {
+        return 0;
+    }
+
+    /* We hold the queue lock, so we're the only consumer */
+    queue_pos = start_pos = (unsigned)SDL_AtomicGet(&ring->dequeue_pos);
+    for ( ; ; ) {
+        entry = &ring->entries[queue_pos & SDL_EVENT_RING_MASK];
+        if ((int)((unsigned)SDL_AtomicGet(&entry->sequence) - (queue_pos + 1)) < 0) {
+            /* Empty, or the producer hasn't finished filling this slot yet */
+            break;
+        }
+        SDL_MemoryBarrierAcquire();
+
+        if (!SDL_LinkEvent(&entry->event, &entry->msg)) {
+            /* Out of memory, leave the rest in the ring for next time */
+            status = -1;
+            break;
+        }
+        SDL_AtomicSet(&entry->sequence, (int)(queue_pos + SDL_EVENT_RING_SIZE));
+        ++queue_pos;
+    }
+    SDL_AtomicSet(&ring->dequeue_pos, (int)queue_pos);
+
+    if (status == 0) {
+        status = (int)(queue_pos - start_pos);
+    }
+    return status;
+}
+
+/* Add an event to the event queue -- called with the queue locked */
+static int
+SDL_AddEvent(SDL_Event * event)
+{
+    if (!SDL_ReserveEvent()) {
+        return 0;
+    }
 
-    final_count = SDL_AtomicAdd(&SDL_EventQ.count, 1) + 1;
-    if (final_count > SDL_EventQ.max_events_seen) {
-        SDL_EventQ.max_events_seen = final_count;
+    if (SDL_DoEventLogging) {
+        SDL_LogEvent(event);
+    }
+
+    if (!SDL_LinkEvent(event, event->syswm.msg)) {
+        SDL_AtomicAdd(&SDL_EventQ.count, -1);
+        return 0;
+    }
+    return 1;
+}
+
+/* Add an event to the ring without taking the queue lock.
+   Returns 1 if added, 0 on error and -1 if the ring is full.
+
+   A full ring has to be drained and retried rather than bypassed, since
+   the caller may still have earlier events sitting in it. */
+static int
+SDL_EnqueueEvent(SDL_EventRing *ring, SDL_Event * event)
+{
+    SDL_EventRingEntry *entry;
+    unsigned queue_pos;
+    int delta;
+
+    if (!SDL_ReserveEvent()) {
+        return 0;
+    }
+
+    queue_pos = (unsigned)SDL_AtomicGet(&ring->enqueue_pos);
+    for ( ; ; ) {
+        entry = &ring->entries[queue_pos & SDL_EVENT_RING_MASK];
+        delta = (int)((unsigned)SDL_AtomicGet(&entry->sequence) - queue_pos);
+        if (delta == 0) {
+            /* The entry and the queue position match, try to claim the entry */
+            if (SDL_AtomicCAS(&ring->enqueue_pos, (int)queue_pos, (int)(queue_pos + 1))) {
+                break;
+            }
+        } else if (delta < 0) {
+            /* The consumer hasn't caught up, let the caller take the slow path */
+            SDL_AtomicAdd(&SDL_EventQ.count, -1);
+            return -1;
+        } else {
+            /* Another producer got here first, get the new queue position */
+            queue_pos = (unsigned)SDL_AtomicGet(&ring->enqueue_pos);
+        }
+    }
+
+    if (SDL_DoEventLogging) {
+        SDL_LogEvent(event);
+    }
+
+    entry->event = *event;
+    if (event->type == SDL_SYSWMEVENT) {
+        entry->msg = *event->syswm.msg;
+        entry->event.syswm.msg = &entry->msg;
     }
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&entry->sequence, (int)(queue_pos + 1));
 
     return 1;
 }
@@ -538,23 +749,71 @@ SDL_CutEvent(SDL_EventEntry *entry)
     SDL_AtomicAdd(&SDL_EventQ.count, -1);
 }
 
+/* Wake up anybody blocked in SDL_WaitEventTimeout() -- called with the queue unlocked */
+static void
+SDL_SendWakeupEvent(void)
+{
+    SDL_VideoDevice *_this = SDL_GetVideoDevice();
+
+    if (SDL_AtomicGet(&SDL_EventQ.waiters) > 0) {
+        SDL_LockMutex(SDL_EventQ.lock);
+        SDL_CondBroadcast(SDL_EventQ.wakeup);
+        SDL_UnlockMutex(SDL_EventQ.lock);
+    }
+
+    /* The waiter sets this before checking the queue, so a stale NULL here
+       means it will see the event we just added */
+    if (_this && _this->wakeup_lock && _this->wakeup_window) {
+        SDL_LockMutex(_this->wakeup_lock);
+        if (_this->wakeup_window) {
+            _this->SendWakeupEvent(_this, _this->wakeup_window);
+
+            /* One wakeup is enough until the waiter goes back to sleep */
+            _this->wakeup_window = NULL;
+        }
+        SDL_UnlockMutex(_this->wakeup_lock);
+    }
+}
+
 /* Lock the event queue, take a peep at it, and unlock it */
-int
-SDL_PeepEvents(SDL_Event * events, int numevents, SDL_eventaction action,
-               Uint32 minType, Uint32 maxType)
+static int
+SDL_PeepEventsInternal(SDL_Event * events, int numevents, SDL_eventaction action,
+                       Uint32 minType, Uint32 maxType)
 {
     int i, used;
 
-    /* Don't look after we've quit */
-    if (!SDL_AtomicGet(&SDL_EventQ.active)) {
-        /* We get a few spurious events at shutdown, so don't warn then */
-        if (action != SDL_ADDEVENT) {
-            SDL_SetError("The event system has been shut down");
+    used = 0;
+
+    /* Producers only need the queue lock when the ring is full */
+    if (action == SDL_ADDEVENT && SDL_EventQ.ring) {
+        for (i = 0; i < numevents; ++i) {
+            int status;
+
+            while ((status = SDL_EnqueueEvent(SDL_EventQ.ring, &events[i])) < 0) {
+                int drained;
+
+                if (SDL_LockMutex(SDL_EventQ.lock) < 0) {
+                    return SDL_SetError("Couldn't lock event queue");
+                }
+                drained = SDL_DrainEventRing();
+                SDL_UnlockMutex(SDL_EventQ.lock);
+
+                if (drained < 0) {
+                    return used;
+                } else if (drained == 0) {
+                    /* Another producer is still filling the oldest slot */
+                    SDL_Delay(0);
+                }
+            }
+            used += status;
         }
-        return (-1);
+        if (used > 0) {
+            SDL_SendWakeupEvent();
+        }
+        return (used);
     }
+
     /* Lock the event queue */
-    used = 0;
     if (!SDL_EventQ.lock || SDL_LockMutex(SDL_EventQ.lock) == 0) {
         if (action == SDL_ADDEVENT) {
             for (i = 0; i < numevents; ++i) {
@@ -565,6 +824,8 @@ SDL_PeepEvents(SDL_Event * events, int numevents, SDL_eventaction action,
             SDL_SysWMEntry *wmmsg, *wmmsg_next;
             Uint32 type;
 
+            SDL_DrainEventRing();
+
             if (action == SDL_GETEVENT) {
                 /* Clean out any used wmmsg data
                    FIXME: Do we want to retain the data for some period of time?
@@ -614,9 +875,32 @@ SDL_PeepEvents(SDL_Event * events, int numevents, SDL_eventaction action,
     } else {
         return SDL_SetError("Couldn't lock event queue");
     }
+    if (action == SDL_ADDEVENT && used > 0) {
+        SDL_SendWakeupEvent();
+    }
     return (used);
 }
 
+int
+SDL_PeepEvents(SDL_Event * events, int numevents, SDL_eventaction action,
+               Uint32 minType, Uint32 maxType)
+{
+    int status;
+
+    /* Don't look after we've quit */
+    if (!SDL_EnterEventQueue()) {
+        /* We get a few spurious events at shutdown, so don't warn then */
+        if (action != SDL_ADDEVENT) {
+            SDL_SetError("The event system has been shut down");
+        }
+        return (-1);
+    }
+    status = SDL_PeepEventsInternal(events, numevents, action, minType, maxType);
+    SDL_LeaveEventQueue();
+
+    return status;
+}
+
 SDL_bool
 SDL_HasEvent(Uint32 type)
 {
@@ -643,7 +927,7 @@ SDL_FlushEvents(Uint32 minType, Uint32 maxType)
        app, but I don't know if this is the right place to do that. */
 
     /* Don't look after we've quit */
-    if (!SDL_AtomicGet(&SDL_EventQ.active)) {
+    if (!SDL_EnterEventQueue()) {
         return;
     }
 
@@ -659,6 +943,7 @@ SDL_FlushEvents(Uint32 minType, Uint32 maxType)
     if (!SDL_EventQ.lock || SDL_LockMutex(SDL_EventQ.lock) == 0) {
         SDL_EventEntry *entry, *next;
         Uint32 type;
+        SDL_DrainEventRing();
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             type = entry->event.type;
@@ -670,6 +955,7 @@ SDL_FlushEvents(Uint32 minType, Uint32 maxType)
             SDL_UnlockMutex(SDL_EventQ.lock);
         }
     }
+    SDL_LeaveEventQueue();
 }
 
 /* Run the system dependent event loops */
@@ -717,14 +1003,142 @@ SDL_WaitEvent(SDL_Event * event)
     return SDL_WaitEventTimeout(event, -1);
 }
 
+/* Opened joysticks and sensors only report changes when they're polled */
+static SDL_bool
+SDL_EventsNeedPolling(void)
+{
+    SDL_bool need_polling = SDL_FALSE;
+
+#if !SDL_JOYSTICK_DISABLED
+    need_polling = (!SDL_disabled_events[SDL_JOYAXISMOTION >> 8] || SDL_JoystickEventState(SDL_QUERY)) &&
+                   (SDL_NumJoysticks() > 0);
+#endif
+
+#if !SDL_SENSOR_DISABLED
+    need_polling = need_polling ||
+                   (!SDL_disabled_events[SDL_SENSORUPDATE >> 8] && (SDL_NumSensors() > 0));
+#endif
+
+    return need_polling;
+}
+
+/* How long the next wait may block, 0 if the timeout has expired */
+static int
+SDL_GetWaitInterval(Uint32 expiration, int timeout)
+{
+    if (timeout > 0) {
+        const Uint32 now = SDL_GetTicks();
+        if (SDL_TICKS_PASSED(now, expiration)) {
+            return 0;
+        }
+        return SDL_min((int)(expiration - now), SDL_WAIT_PUMP_INTERVAL);
+    }
+    return SDL_WAIT_PUMP_INTERVAL;
+}
+
+/* Sleep in the video driver until it has events or SDL_SendWakeupEvent() is called */
+static int
+SDL_WaitEventTimeout_Device(SDL_VideoDevice *_this, SDL_Window *wakeup_window,
+                            SDL_Event * event, Uint32 expiration, int timeout)
+{
+    for (;;) {
+        int status, interval;
+
+        /* Pump every time we wake up, the driver only tells us there's work */
+        SDL_PumpEvents();
+
+        /* Publish the window before looking at the queue, so an event added
+           after we looked will wake us up. The queue lock may be taken before
+           wakeup_lock, never the other way around, since events can be pushed
+           with the queue locked from inside SDL_FilterEvents(). */
+        SDL_LockMutex(_this->wakeup_lock);
+        _this->wakeup_window = wakeup_window;
+        SDL_UnlockMutex(_this->wakeup_lock);
+
+        status = SDL_PeepEvents(event, 1, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+        if (status != 0) {
+            /* A wakeup may already have been sent, the next wait just returns early */
+            SDL_LockMutex(_this->wakeup_lock);
+            _this->wakeup_window = NULL;
+            SDL_UnlockMutex(_this->wakeup_lock);
+            return (status > 0);
+        }
+
+        interval = SDL_GetWaitInterval(expiration, timeout);
+        if (interval > 0) {
+            _this->WaitEventTimeout(_this, interval);
+        }
+
+        SDL_LockMutex(_this->wakeup_lock);
+        _this->wakeup_window = NULL;
+        SDL_UnlockMutex(_this->wakeup_lock);
+
+        if (interval == 0) {
+            /* Timeout expired and no events */
+            return 0;
+        }
+    }
+}
+
+/* Sleep on the event queue until somebody adds an event */
+static int
+SDL_WaitEventTimeout_Queue(SDL_Event * event, Uint32 expiration, int timeout)
+{
+    /* SDL_StopEventLoop() wakes us up and waits for us before destroying the condition */
+    if (!SDL_EnterEventQueue()) {
+        return 0;
+    }
+
+    for (;;) {
+        int status, interval = 0;
+
+        SDL_PumpEvents();
+
+        SDL_LockMutex(SDL_EventQ.lock);
+        SDL_AtomicAdd(&SDL_EventQ.waiters, 1);
+        status = SDL_PeepEvents(event, 1, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+        if (status == 0) {
+            interval = SDL_GetWaitInterval(expiration, timeout);
+            if (interval > 0) {
+                SDL_CondWaitTimeout(SDL_EventQ.wakeup, SDL_EventQ.lock, interval);
+            }
+        }
+        SDL_AtomicAdd(&SDL_EventQ.waiters, -1);
+        SDL_UnlockMutex(SDL_EventQ.lock);
+
+        if (status != 0 || interval == 0) {
+            /* Got an event, the event loop stopped, or the timeout expired */
+            SDL_LeaveEventQueue();
+            return (status > 0);
+        }
+    }
+}
+
 int
 SDL_WaitEventTimeout(SDL_Event * event, int timeout)
 {
+    SDL_VideoDevice *_this = SDL_GetVideoDevice();
     Uint32 expiration = 0;
 
     if (timeout > 0)
         expiration = SDL_GetTicks() + timeout;
 
+    /* Block instead of polling when nothing needs to be pumped continuously */
+    if (timeout != 0 && SDL_AtomicGet(&SDL_EventQ.active) && !SDL_EventsNeedPolling()) {
+        if (_this && _this->wakeup_lock) {
+            SDL_Window *window;
+
+            /* The driver needs a window to deliver wakeup events to */
+            for (window = _this->windows; window; window = window->next) {
+                if (!window->is_destroying) {
+                    return SDL_WaitEventTimeout_Device(_this, window, event, expiration, timeout);
+                }
+            }
+        } else if (!_this && SDL_EventQ.wakeup) {
+            return SDL_WaitEventTimeout_Queue(event, expiration, timeout);
+        }
+    }
+
     for (;;) {
         SDL_PumpEvents();
         switch (SDL_PeepEvents(event, 1, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT)) {
@@ -897,6 +1311,7 @@ SDL_FilterEvents(SDL_EventFilter filter, void *userdata)
 {
     if (!SDL_EventQ.lock || SDL_LockMutex(SDL_EventQ.lock) == 0) {
         SDL_EventEntry *entry, *next;
+        SDL_DrainEventRing();
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             if (!filter(userdata, &entry->event)) {
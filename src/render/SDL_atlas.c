@@ -0,0 +1,371 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* This packs small static textures into shared atlas pages.
+
+   Each page is a regular texture that is filled with a skyline packer, using
+   the bottom-left heuristic.  Every texture gets a one texel gutter around it
+   holding a copy of its edge texels, so linear filtering at the edges of a
+   copy doesn't pick up its neighbours.  Space is never reclaimed while a page
+   is in use, the page is destroyed once the last texture on it goes away.
+ */
+
+#if !SDL_RENDER_DISABLED
+
+#include "SDL_assert.h"
+
+#include "SDL_atlas_c.h"
+
+#define SDL_ATLAS_PAGE_SIZE 1024
+#define SDL_ATLAS_GUTTER    1
+
+typedef struct
+{
+    int x, y, w;
+} SDL_AtlasSkyline;
+
+struct SDL_AtlasPage
+{
+    SDL_Texture *texture;
+    Uint32 format;
+    SDL_ScaleMode scaleMode;
+    int w, h;
+    int num_textures;
+
+    /* The skyline, ordered by x and covering the whole page width */
+    SDL_AtlasSkyline *skyline;
+    int num_skyline;
+
+    SDL_AtlasPage *next;
+};
+
+
+/* Move a texture to the end of the renderer texture list, so the renderer
+   destroys it after all the textures that live in it.
+ */
+static void
+SDL_MoveTextureToEnd(SDL_Renderer * renderer, SDL_Texture * texture)
+{
+    SDL_Texture *last;
+
+    if (!texture->next) {
+        return;
+    }
+
+    texture->next->prev = texture->prev;
+    if (texture->prev) {
+        texture->prev->next = texture->next;
+    } else {
+        renderer->textures = texture->next;
+    }
+
+    for (last = texture->next; last->next; last = last->next) {
+        continue;
+    }
+    last->next = texture;
+    texture->prev = last;
+    texture->next = NULL;
+}
+
+static SDL_AtlasPage *
+SDL_CreateAtlasPage(SDL_Renderer * renderer, Uint32 format, SDL_ScaleMode scaleMode)
+{
+    SDL_AtlasPage *page;
+    SDL_bool atlas;
+    int w = SDL_ATLAS_PAGE_SIZE;
+    int h = SDL_ATLAS_PAGE_SIZE;
+
+    if (renderer->info.max_texture_width && w > renderer->info.max_texture_width) {
+        w = renderer->info.max_texture_width;
+    }
+    if (renderer->info.max_texture_height && h > renderer->info.max_texture_height) {
+        h = renderer->info.max_texture_height;
+    }
+
+    page = (SDL_AtlasPage *) SDL_calloc(1, sizeof(*page));
+    if (!page) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    page->skyline = (SDL_AtlasSkyline *) SDL_malloc((w + 1) * sizeof(*page->skyline));
+    if (!page->skyline) {
+        SDL_free(page);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    page->skyline[0].x = 0;
+    page->skyline[0].y = 0;
+    page->skyline[0].w = w;
+    page->num_skyline = 1;
+
+    /* The page itself must never end up in an atlas */
+    atlas = renderer->atlas;
+    renderer->atlas = SDL_FALSE;
+    page->texture = SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_STATIC, w, h);
+    renderer->atlas = atlas;
+    if (!page->texture) {
+        SDL_free(page->skyline);
+        SDL_free(page);
+        return NULL;
+    }
+    if (page->texture->scaleMode != scaleMode) {
+        SDL_SetTextureScaleMode(page->texture, scaleMode);
+    }
+    SDL_MoveTextureToEnd(renderer, page->texture);
+    if (page->texture->native) {
+        SDL_MoveTextureToEnd(renderer, page->texture->native);
+    }
+
+    page->format = format;
+    page->scaleMode = scaleMode;
+    page->w = w;
+    page->h = h;
+    page->next = renderer->atlas_pages;
+    renderer->atlas_pages = page;
+    return page;
+}
+
+static void
+SDL_DestroyAtlasPage(SDL_Renderer * renderer, SDL_AtlasPage * page)
+{
+    SDL_AtlasPage *prev = NULL;
+    SDL_AtlasPage *curr;
+
+    for (curr = renderer->atlas_pages; curr; prev = curr, curr = curr->next) {
+        if (curr == page) {
+            if (prev) {
+                prev->next = page->next;
+            } else {
+                renderer->atlas_pages = page->next;
+            }
+            break;
+        }
+    }
+
+    SDL_DestroyTexture(page->texture);
+    SDL_free(page->skyline);
+    SDL_free(page);
+}
+
+/* Return the height the bottom of a w x h rect would sit at if placed at
+   skyline node i, or -1 if it doesn't fit there.
+ */
+static int
+SDL_FitSkyline(const SDL_AtlasPage * page, int i, int w, int h)
+{
+    const SDL_AtlasSkyline *skyline = page->skyline;
+    int x = skyline[i].x;
+    int y = 0;
+    int remaining = w;
+
+    if (x + w > page->w) {
+        return -1;
+    }
+    while (remaining > 0) {
+        if (skyline[i].y > y) {
+            y = skyline[i].y;
+        }
+        if (y + h > page->h) {
+            return -1;
+        }
+        remaining -= skyline[i].w;
+        ++i;
+    }
+    return y;
+}
+
+static SDL_bool
+SDL_PackSkyline(SDL_AtlasPage * page, int w, int h, int *x, int *y)
+{
+    SDL_AtlasSkyline *skyline = page->skyline;
+    int best = -1, best_bottom = 0, best_width = 0, best_y = 0;
+    int i;
+
+    for (i = 0; i < page->num_skyline; ++i) {
+        const int fit = SDL_FitSkyline(page, i, w, h);
+        if (fit >= 0) {
+            const int bottom = fit + h;
+            if (best < 0 || bottom < best_bottom ||
+                (bottom == best_bottom && skyline[i].w < best_width)) {
+                best = i;
+                best_bottom = bottom;
+                best_width = skyline[i].w;
+                best_y = fit;
+            }
+        }
+    }
+    if (best < 0) {
+        return SDL_FALSE;
+    }
+    *x = skyline[best].x;
+    *y = best_y;
+
+    /* Insert the new segment in front of the one it was placed on */
+    SDL_memmove(&skyline[best + 1], &skyline[best], (page->num_skyline - best) * sizeof(*skyline));
+    skyline[best].x = *x;
+    skyline[best].y = best_y + h;
+    skyline[best].w = w;
+    ++page->num_skyline;
+
+    /* Trim or drop the segments it now covers */
+    i = best + 1;
+    while (i < page->num_skyline) {
+        const int shrink = (skyline[i - 1].x + skyline[i - 1].w) - skyline[i].x;
+        if (shrink <= 0) {
+            break;
+        }
+        if (shrink < skyline[i].w) {
+            skyline[i].x += shrink;
+            skyline[i].w -= shrink;
+            break;
+        }
+        SDL_memmove(&skyline[i], &skyline[i + 1], (page->num_skyline - i - 1) * sizeof(*skyline));
+        --page->num_skyline;
+    }
+
+    /* Merge neighbouring segments at the same height */
+    i = 0;
+    while (i < page->num_skyline - 1) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].w += skyline[i + 1].w;
+            SDL_memmove(&skyline[i + 1], &skyline[i + 2], (page->num_skyline - i - 2) * sizeof(*skyline));
+            --page->num_skyline;
+        } else {
+            ++i;
+        }
+    }
+    return SDL_TRUE;
+}
+
+SDL_AtlasPage *
+SDL_AllocateAtlasRect(SDL_Renderer * renderer, Uint32 format,
+                      SDL_ScaleMode scaleMode, int w, int h, SDL_Rect * rect)
+{
+    const int padded_w = w + 2 * SDL_ATLAS_GUTTER;
+    const int padded_h = h + 2 * SDL_ATLAS_GUTTER;
+    SDL_AtlasPage *page;
+    int x, y;
+
+    for (page = renderer->atlas_pages; page; page = page->next) {
+        if (page->format == format && page->scaleMode == scaleMode &&
+            SDL_PackSkyline(page, padded_w, padded_h, &x, &y)) {
+            break;
+        }
+    }
+    if (!page) {
+        page = SDL_CreateAtlasPage(renderer, format, scaleMode);
+        if (!page) {
+            return NULL;
+        }
+        if (!SDL_PackSkyline(page, padded_w, padded_h, &x, &y)) {
+            /* Too big for a page on this renderer */
+            SDL_DestroyAtlasPage(renderer, page);
+            return NULL;
+        }
+    }
+
+    ++page->num_textures;
+    rect->x = x + SDL_ATLAS_GUTTER;
+    rect->y = y + SDL_ATLAS_GUTTER;
+    rect->w = w;
+    rect->h = h;
+    return page;
+}
+
+void
+SDL_FreeAtlasRect(SDL_Renderer * renderer, SDL_AtlasPage * page,
+                  const SDL_Rect * rect)
+{
+    (void) rect;
+
+    SDL_assert(page->num_textures > 0);
+    if (--page->num_textures == 0) {
+        SDL_DestroyAtlasPage(renderer, page);
+    }
+}
+
+int
+SDL_UpdateAtlasTexture(SDL_AtlasPage * page, const SDL_Rect * texrect,
+                       const SDL_Rect * rect, const void *pixels, int pitch)
+{
+    const int bpp = SDL_BYTESPERPIXEL(page->format);
+    const SDL_bool left = (rect->x == 0);
+    const SDL_bool right = (rect->x + rect->w == texrect->w);
+    SDL_Rect area;
+    Uint8 *temp;
+    int temp_pitch;
+    int y, retval;
+
+    /* Extend the area into the gutter on the sides it touches */
+    area = *rect;
+    if (left) {
+        area.x -= SDL_ATLAS_GUTTER;
+        area.w += SDL_ATLAS_GUTTER;
+    }
+    if (right) {
+        area.w += SDL_ATLAS_GUTTER;
+    }
+    if (area.y == 0) {
+        area.y -= SDL_ATLAS_GUTTER;
+        area.h += SDL_ATLAS_GUTTER;
+    }
+    if (rect->y + rect->h == texrect->h) {
+        area.h += SDL_ATLAS_GUTTER;
+    }
+
+    temp_pitch = area.w * bpp;
+    temp = (Uint8 *) SDL_malloc(temp_pitch * area.h);
+    if (!temp) {
+        return SDL_OutOfMemory();
+    }
+    for (y = 0; y < area.h; ++y) {
+        const int src_y = SDL_max(0, SDL_min(area.y + y, texrect->h - 1));
+        const Uint8 *src = (const Uint8 *) pixels + src_y * pitch;
+        Uint8 *dst = temp + y * temp_pitch;
+
+        if (left) {
+            SDL_memcpy(dst, src, bpp);
+            dst += bpp;
+        }
+        SDL_memcpy(dst, src + rect->x * bpp, rect->w * bpp);
+        dst += rect->w * bpp;
+        if (right) {
+            SDL_memcpy(dst, src + (texrect->w - 1) * bpp, bpp);
+        }
+    }
+
+    area.x += texrect->x;
+    area.y += texrect->y;
+    retval = SDL_UpdateTexture(page->texture, &area, temp, temp_pitch);
+    SDL_free(temp);
+    return retval;
+}
+
+SDL_Texture *
+SDL_GetAtlasPageTexture(SDL_AtlasPage * page)
+{
+    return page->texture;
+}
+
+#endif /* !SDL_RENDER_DISABLED */
+
+/* vi: set ts=4 sw=4 expandtab: */
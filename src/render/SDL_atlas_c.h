@@ -0,0 +1,61 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_atlas_c_h_
+#define SDL_atlas_c_h_
+
+#include "../SDL_internal.h"
+
+#include "SDL_sysrender.h"
+
+/* This packs small static textures into shared atlas pages so that copies
+   from many of them can be drawn with a single texture bound.
+ */
+
+/* Textures larger than this in either direction get a texture of their own */
+#define SDL_ATLAS_MAX_TEXTURE_SIZE  256
+
+/* Find room for a w x h texture of the given format and scale mode, creating
+   a new page if needed.  On success rect holds the location of the texels
+   in the page texture and the page is returned, otherwise NULL.
+ */
+SDL_AtlasPage *SDL_AllocateAtlasRect(SDL_Renderer * renderer, Uint32 format,
+                                     SDL_ScaleMode scaleMode, int w, int h,
+                                     SDL_Rect * rect);
+
+/* Release a rect returned by SDL_AllocateAtlasRect().  The page and its
+   texture are destroyed when the last rect on it is released.
+ */
+void SDL_FreeAtlasRect(SDL_Renderer * renderer, SDL_AtlasPage * page,
+                       const SDL_Rect * rect);
+
+/* Upload the area 'rect' of a texture that lives at 'texrect' in the page.
+   'pixels' and 'pitch' describe the whole texture, the edge texels are
+   also replicated into the gutter around it so filtering doesn't bleed.
+ */
+int SDL_UpdateAtlasTexture(SDL_AtlasPage * page, const SDL_Rect * texrect,
+                           const SDL_Rect * rect, const void *pixels, int pitch);
+
+SDL_Texture *SDL_GetAtlasPageTexture(SDL_AtlasPage * page);
+
+#endif /* SDL_atlas_c_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -23,9 +23,13 @@
 /* The SDL 2D rendering system */
 
 #include "SDL_assert.h"
+#include "SDL_atomic.h"
 #include "SDL_hints.h"
+#include "SDL_mutex.h"
 #include "SDL_render.h"
+#include "SDL_timer.h"
 #include "SDL_sysrender.h"
+#include "SDL_atlas_c.h"
 #include "software/SDL_render_sw_c.h"
 #include "../video/SDL_pixels_c.h"
 
@@ -208,11 +212,398 @@ DebugLogRenderCommands(const SDL_RenderCommand *cmd)
 #endif
 }
 
+static void
+CountRenderCommands(SDL_RenderStats *stats, const SDL_RenderCommand *cmd)
+{
+    for (; cmd != NULL; cmd = cmd->next) {
+        switch (cmd->command) {
+            case SDL_RENDERCMD_NO_OP:
+                continue;
+            case SDL_RENDERCMD_SETVIEWPORT:
+                stats->viewports++;
+                break;
+            case SDL_RENDERCMD_SETCLIPRECT:
+                stats->cliprects++;
+                break;
+            case SDL_RENDERCMD_SETDRAWCOLOR:
+                stats->draw_colors++;
+                break;
+            case SDL_RENDERCMD_CLEAR:
+                stats->clears++;
+                break;
+            case SDL_RENDERCMD_DRAW_POINTS:
+                stats->draw_points++;
+                break;
+            case SDL_RENDERCMD_DRAW_LINES:
+                stats->draw_lines++;
+                break;
+            case SDL_RENDERCMD_FILL_RECTS:
+                stats->fill_rects++;
+                break;
+            case SDL_RENDERCMD_COPY:
+                stats->copies++;
+                break;
+            case SDL_RENDERCMD_COPY_EX:
+                stats->copies_ex++;
+                break;
+        }
+        stats->commands++;
+    }
+}
+
+static void
+CountTextureUpload(SDL_Texture *texture, const SDL_Rect *rect)
+{
+    SDL_RenderStats *stats = &texture->renderer->stats;
+    Uint64 bytes = (Uint64) rect->w * rect->h * SDL_BYTESPERPIXEL(texture->format);
+
+    if (SDL_ISPIXELFORMAT_FOURCC(texture->format) && SDL_BYTESPERPIXEL(texture->format) == 1) {
+        bytes += bytes / 2;  /* planar YUV, plus two quarter size chroma planes */
+    }
+    stats->texture_uploads++;
+    stats->texture_upload_bytes += bytes;
+}
+
+static const char *
+GetRenderFlushReasonName(SDL_RenderFlushReason reason)
+{
+    switch (reason) {
+        case SDL_RENDER_FLUSH_PRESENT: return "present";
+        case SDL_RENDER_FLUSH_EXPLICIT: return "explicit";
+        case SDL_RENDER_FLUSH_TEXTURE: return "texture";
+        case SDL_RENDER_FLUSH_TARGET: return "target";
+        case SDL_RENDER_FLUSH_READ_PIXELS: return "read pixels";
+        case SDL_RENDER_FLUSH_NOT_BATCHING: return "not batching";
+        default: return "other";
+    }
+}
+
+/* The trace file is shared by all renderers, each drawn as its own track.
+   Renderers on different threads open, write and close it, so everything
+   here is done holding render_trace_lock. */
+static SDL_mutex *render_trace_lock = NULL;
+static SDL_RWops *render_trace = NULL;
+static int render_trace_refcount = 0;
+static int render_trace_next_id = 0;
+static Uint64 render_trace_start;
+static SDL_bool render_trace_empty;
+
+/* Made the first time a renderer is traced and kept after that, since
+   another renderer could be about to lock it when the trace closes. */
+static SDL_mutex *
+GetRenderTraceLock(void)
+{
+    SDL_mutex *lock = (SDL_mutex *) SDL_AtomicGetPtr((void **) &render_trace_lock);
+
+    if (!lock) {
+        lock = SDL_CreateMutex();
+        if (lock && !SDL_AtomicCASPtr((void **) &render_trace_lock, NULL, lock)) {
+            SDL_DestroyMutex(lock);
+            lock = (SDL_mutex *) SDL_AtomicGetPtr((void **) &render_trace_lock);
+        }
+    }
+    return lock;
+}
+
+static void
+OpenRenderTrace(SDL_Renderer *renderer)
+{
+    const char *path = SDL_GetHint(SDL_HINT_RENDER_TRACE);
+    SDL_mutex *lock;
+
+    if (!path || !*path) {
+        return;
+    }
+
+    lock = GetRenderTraceLock();
+    if (!lock) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "Couldn't open render trace: %s", SDL_GetError());
+        return;
+    }
+
+    SDL_LockMutex(lock);
+    if (!render_trace) {
+        render_trace = SDL_RWFromFile(path, "wb");
+        if (!render_trace) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "Couldn't open render trace: %s", SDL_GetError());
+            SDL_UnlockMutex(lock);
+            return;
+        }
+        SDL_RWwrite(render_trace, "[", 1, 1);
+        render_trace_start = SDL_GetPerformanceCounter();
+        render_trace_empty = SDL_TRUE;
+    }
+    ++render_trace_refcount;
+    renderer->trace_id = ++render_trace_next_id;
+    SDL_UnlockMutex(lock);
+}
+
+static void
+CloseRenderTrace(SDL_Renderer *renderer)
+{
+    if (renderer->trace_id == 0) {
+        return;
+    }
+
+    renderer->trace_id = 0;
+    SDL_LockMutex(render_trace_lock);
+    if (--render_trace_refcount == 0) {
+        SDL_RWwrite(render_trace, "\n]\n", 3, 1);
+        SDL_RWclose(render_trace);
+        render_trace = NULL;
+    }
+    SDL_UnlockMutex(render_trace_lock);
+}
+
+/* Writes one event in the Chrome trace event format. An end of 0 makes it an instant event. */
+static void
+WriteRenderTraceEvent(SDL_Renderer *renderer, const char *name, Uint64 start, Uint64 end, const char *args)
+{
+    const double scale = 1000000.0 / (double) SDL_GetPerformanceFrequency();
+    char event[512];
+    int len;
+
+    SDL_LockMutex(render_trace_lock);
+    if (end != 0) {
+        len = SDL_snprintf(event, sizeof (event),
+                           "%s\n{\"name\":\"%s\",\"cat\":\"render\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{%s}}",
+                           render_trace_empty ? "" : ",", name, renderer->trace_id,
+                           (double) (start - render_trace_start) * scale,
+                           (double) (end - start) * scale, args);
+    } else {
+        len = SDL_snprintf(event, sizeof (event),
+                           "%s\n{\"name\":\"%s\",\"cat\":\"render\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"args\":{%s}}",
+                           render_trace_empty ? "" : ",", name, renderer->trace_id,
+                           (double) (start - render_trace_start) * scale, args);
+    }
+    if (len > 0 && len < (int) sizeof (event)) {
+        SDL_RWwrite(render_trace, event, len, 1);
+        render_trace_empty = SDL_FALSE;
+    }
+    SDL_UnlockMutex(render_trace_lock);
+}
+
+/* Ends the frame's statistics at SDL_RenderPresent() */
+static void
+FinishRenderStats(SDL_Renderer *renderer)
+{
+    SDL_RenderStats *stats = &renderer->stats;
+
+    stats->run_time_us = (Uint32) ((renderer->run_ticks * 1000000) / SDL_GetPerformanceFrequency());
+
+    if (renderer->trace_id) {
+        char args[256];
+        SDL_snprintf(args, sizeof (args),
+                     "\"commands\":%u,\"commands_saved\":%u,\"flushes\":%u,\"texture_uploads\":%u,\"run_time_us\":%u",
+                     (unsigned int) stats->commands, (unsigned int) stats->commands_saved,
+                     (unsigned int) stats->flushes, (unsigned int) stats->texture_uploads,
+                     (unsigned int) stats->run_time_us);
+        WriteRenderTraceEvent(renderer, "present", SDL_GetPerformanceCounter(), 0, args);
+    }
+
+    SDL_memcpy(&renderer->last_stats, stats, sizeof (*stats));
+    SDL_zerop(stats);
+    renderer->run_ticks = 0;
+}
+
+/* Whether a draw can be folded into the one just before it in the queue */
+static SDL_bool
+CanMergeCmdDraw(const SDL_Renderer *renderer, const SDL_RenderCommand *last, const SDL_RenderCommand *cmd)
+{
+    if (last->command != cmd->command) {
+        return SDL_FALSE;
+    }
+
+    switch (cmd->command) {
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_FILL_RECTS:
+            break;
+
+        case SDL_RENDERCMD_COPY:
+            if (!renderer->merge_copies) {
+                return SDL_FALSE;
+            }
+            break;
+
+        default:
+            return SDL_FALSE;  /* line strips and rotated copies can't be joined */
+    }
+
+    /* The vertices have to follow on from the previous draw's for the
+       backend to walk them as one array. */
+    return (last->data.draw.texture == cmd->data.draw.texture &&
+            last->data.draw.r == cmd->data.draw.r &&
+            last->data.draw.g == cmd->data.draw.g &&
+            last->data.draw.b == cmd->data.draw.b &&
+            last->data.draw.a == cmd->data.draw.a &&
+            last->data.draw.blend == cmd->data.draw.blend &&
+            cmd->data.draw.first == last->data.draw.end) ? SDL_TRUE : SDL_FALSE;
+}
+
+static SDL_bool
+IsSameCmdState(const SDL_RenderCommand *a, const SDL_RenderCommand *b)
+{
+    switch (a->command) {
+        case SDL_RENDERCMD_SETVIEWPORT:
+            return (SDL_memcmp(&a->data.viewport.rect, &b->data.viewport.rect, sizeof (SDL_Rect)) == 0) ? SDL_TRUE : SDL_FALSE;
+
+        case SDL_RENDERCMD_SETCLIPRECT:
+            return (a->data.cliprect.enabled == b->data.cliprect.enabled &&
+                    SDL_memcmp(&a->data.cliprect.rect, &b->data.cliprect.rect, sizeof (SDL_Rect)) == 0) ? SDL_TRUE : SDL_FALSE;
+
+        case SDL_RENDERCMD_SETDRAWCOLOR:
+            return (a->data.color.r == b->data.color.r &&
+                    a->data.color.g == b->data.color.g &&
+                    a->data.color.b == b->data.color.b &&
+                    a->data.color.a == b->data.color.a) ? SDL_TRUE : SDL_FALSE;
+
+        default:
+            return SDL_FALSE;
+    }
+}
+
+/* Drop state changes that no draw sees, then merge the draws that end up
+   next to each other. Returns how many commands were taken off the queue. */
+static int
+OptimizeRenderCommands(SDL_Renderer *renderer)
+{
+    SDL_RenderCommand *pending[3] = { NULL, NULL, NULL };  /* viewport, cliprect, color queued since the last draw */
+    SDL_RenderCommand *current[3] = { NULL, NULL, NULL };  /* the ones the last draw saw */
+    SDL_RenderCommand *head = NULL;
+    SDL_RenderCommand *last = NULL;
+    SDL_RenderCommand *cmd;
+    SDL_RenderCommand *next;
+    int saved = 0;
+    int i;
+
+    for (cmd = renderer->render_commands; cmd != NULL; cmd = cmd->next) {
+        switch (cmd->command) {
+            case SDL_RENDERCMD_NO_OP:
+                continue;
+            case SDL_RENDERCMD_SETVIEWPORT:
+                i = 0;
+                break;
+            case SDL_RENDERCMD_SETCLIPRECT:
+                i = 1;
+                break;
+            case SDL_RENDERCMD_SETDRAWCOLOR:
+                i = 2;
+                break;
+            default:
+                i = -1;
+                break;
+        }
+
+        if (i >= 0) {
+            /* Replaced before anything was drawn with it */
+            if (pending[i] != NULL) {
+                pending[i]->command = SDL_RENDERCMD_NO_OP;
+            }
+            pending[i] = cmd;
+            continue;
+        }
+
+        for (i = 0; i < SDL_arraysize(pending); ++i) {
+            if (pending[i] == NULL) {
+                continue;
+            }
+            if (current[i] != NULL && IsSameCmdState(current[i], pending[i])) {
+                pending[i]->command = SDL_RENDERCMD_NO_OP;
+            } else {
+                current[i] = pending[i];
+                if (i == 0) {
+                    /* backends may place the clip rect relative to the viewport */
+                    current[1] = NULL;
+                }
+            }
+            pending[i] = NULL;
+        }
+    }
+
+    for (cmd = renderer->render_commands; cmd != NULL; cmd = next) {
+        next = cmd->next;
+        if (cmd->command == SDL_RENDERCMD_NO_OP) {
+            /* nothing to run */
+        } else if (last != NULL && CanMergeCmdDraw(renderer, last, cmd)) {
+            last->data.draw.count += cmd->data.draw.count;
+            last->data.draw.end = cmd->data.draw.end;
+        } else {
+            if (last != NULL) {
+                last->next = cmd;
+            } else {
+                head = cmd;
+            }
+            last = cmd;
+            continue;
+        }
+        cmd->next = renderer->render_commands_pool;
+        renderer->render_commands_pool = cmd;
+        ++saved;
+    }
+
+    if (last != NULL) {
+        last->next = NULL;
+    }
+    renderer->render_commands = head;
+    renderer->render_commands_tail = last;
+    return saved;
+}
+
+/* Run the updates queued by SDL_UpdateTextureAsync(), oldest first.
+   Rendering that needed the old texture contents was flushed when they
+   were queued, so this can happen any time before the next flush. */
+static void
+RunTextureUploads(SDL_Renderer *renderer)
+{
+    if (renderer->running_uploads) {
+        return;  /* an update of a wrapped texture calls back in here */
+    }
+
+    renderer->running_uploads = SDL_TRUE;
+    while (renderer->uploads != NULL) {
+        SDL_TextureUpload *upload = renderer->uploads;
+        SDL_Texture *texture = upload->texture;
+        int status;
+
+        renderer->uploads = upload->next;
+        if (renderer->uploads == NULL) {
+            renderer->uploads_tail = NULL;
+        }
+
+#if SDL_HAVE_YUV
+        if (texture->yuv) {
+            status = SDL_UpdateTexture(texture, &upload->rect, upload->pixels, upload->pitch);
+        } else
+#endif
+        if (texture->atlas || texture->native) {
+            status = SDL_UpdateTexture(texture, &upload->rect, upload->pixels, upload->pitch);
+        } else {
+            CountTextureUpload(texture, &upload->rect);
+            if (renderer->UpdateTextureAsync) {
+                status = renderer->UpdateTextureAsync(renderer, texture, &upload->rect, upload->pixels, upload->pitch);
+            } else {
+                status = renderer->UpdateTexture(renderer, texture, &upload->rect, upload->pixels, upload->pitch);
+            }
+        }
+
+        if (upload->callback) {
+            upload->callback(upload->userdata, texture, status);
+        }
+
+        upload->next = renderer->uploads_pool;
+        renderer->uploads_pool = upload;
+    }
+    renderer->running_uploads = SDL_FALSE;
+}
+
 static int
-FlushRenderCommands(SDL_Renderer *renderer)
+FlushRenderCommands(SDL_Renderer *renderer, SDL_RenderFlushReason reason)
 {
+    SDL_RenderStats *stats = &renderer->stats;
     int retval;
 
+    RunTextureUploads(renderer);
+
     SDL_assert((renderer->render_commands == NULL) == (renderer->render_commands_tail == NULL));
 
     if (renderer->render_commands == NULL) {  /* nothing to do! */
@@ -220,9 +611,34 @@ FlushRenderCommands(SDL_Renderer *renderer)
         return 0;
     }
 
+    stats->commands_saved += OptimizeRenderCommands(renderer);
+
     DebugLogRenderCommands(renderer->render_commands);
 
-    retval = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
+    if (renderer->render_commands != NULL) {
+        const Uint32 commands = stats->commands;
+        Uint64 start, end;
+
+        CountRenderCommands(stats, renderer->render_commands);
+        stats->flushes++;
+        stats->flush_reasons[reason]++;
+        stats->vertex_bytes += renderer->vertex_data_used;
+
+        start = SDL_GetPerformanceCounter();
+        retval = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
+        end = SDL_GetPerformanceCounter();
+        renderer->run_ticks += end - start;
+
+        if (renderer->trace_id) {
+            char args[128];
+            SDL_snprintf(args, sizeof (args), "\"reason\":\"%s\",\"commands\":%u,\"vertex_bytes\":%u",
+                         GetRenderFlushReasonName(reason), (unsigned int) (stats->commands - commands),
+                         (unsigned int) renderer->vertex_data_used);
+            WriteRenderTraceEvent(renderer, "flush", start, end, args);
+        }
+    } else {
+        retval = 0;  /* everything queued turned out to be a no-op */
+    }
 
     /* Move the whole render command queue to the unused pool so we can reuse them next time. */
     if (renderer->render_commands_tail != NULL) {
@@ -243,9 +659,12 @@ static int
 FlushRenderCommandsIfTextureNeeded(SDL_Texture *texture)
 {
     SDL_Renderer *renderer = texture->renderer;
+    if (renderer->running_uploads) {
+        return 0;  /* called from FlushRenderCommands(), which runs the queue next */
+    }
     if (texture->last_command_generation == renderer->render_command_generation) {
         /* the current command queue depends on this texture, flush the queue now before it changes */
-        return FlushRenderCommands(renderer);
+        return FlushRenderCommands(renderer, SDL_RENDER_FLUSH_TEXTURE);
     }
     return 0;
 }
@@ -253,13 +672,25 @@ FlushRenderCommandsIfTextureNeeded(SDL_Texture *texture)
 static SDL_INLINE int
 FlushRenderCommandsIfNotBatching(SDL_Renderer *renderer)
 {
-    return renderer->batching ? 0 : FlushRenderCommands(renderer);
+    return renderer->batching ? 0 : FlushRenderCommands(renderer, SDL_RENDER_FLUSH_NOT_BATCHING);
 }
 
 int
 SDL_RenderFlush(SDL_Renderer * renderer)
 {
-    return FlushRenderCommands(renderer);
+    return FlushRenderCommands(renderer, SDL_RENDER_FLUSH_EXPLICIT);
+}
+
+int
+SDL_GetRenderStats(SDL_Renderer * renderer, SDL_RenderStats * stats)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+    SDL_memcpy(stats, &renderer->last_stats, sizeof (*stats));
+    return 0;
 }
 
 void *
@@ -463,6 +894,8 @@ QueueCmdDrawPoints(SDL_Renderer *renderer, const SDL_FPoint * points, const int
         retval = renderer->QueueDrawPoints(renderer, cmd, points, count);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            cmd->data.draw.end = renderer->vertex_data_used;
         }
     }
     return retval;
@@ -477,6 +910,8 @@ QueueCmdDrawLines(SDL_Renderer *renderer, const SDL_FPoint * points, const int c
         retval = renderer->QueueDrawLines(renderer, cmd, points, count);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            cmd->data.draw.end = renderer->vertex_data_used;
         }
     }
     return retval;
@@ -491,26 +926,36 @@ QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect * rects, const int cou
         retval = renderer->QueueFillRects(renderer, cmd, rects, count);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            cmd->data.draw.end = renderer->vertex_data_used;
         }
     }
     return retval;
 }
 
 static SDL_RenderCommand *
-PrepQueueCmdDrawTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_RenderCommandType cmdtype)
+PrepQueueCmdDrawTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_RenderCommandType cmdtype, const SDL_Color *color)
 {
     /* !!! FIXME: drop this draw if viewport w or h is zero. */
     SDL_RenderCommand *cmd = NULL;
-    if (PrepQueueCmdDraw(renderer, texture->r, texture->g, texture->b, texture->a) == 0) {
+    SDL_Color texture_color;
+    if (!color) {
+        texture_color.r = texture->r;
+        texture_color.g = texture->g;
+        texture_color.b = texture->b;
+        texture_color.a = texture->a;
+        color = &texture_color;
+    }
+    if (PrepQueueCmdDraw(renderer, color->r, color->g, color->b, color->a) == 0) {
         cmd = AllocateRenderCommand(renderer);
         if (cmd != NULL) {
             cmd->command = cmdtype;
             cmd->data.draw.first = 0;  /* render backend will fill this in. */
             cmd->data.draw.count = 0;  /* render backend will fill this in. */
-            cmd->data.draw.r = texture->r;
-            cmd->data.draw.g = texture->g;
-            cmd->data.draw.b = texture->b;
-            cmd->data.draw.a = texture->a;
+            cmd->data.draw.r = color->r;
+            cmd->data.draw.g = color->g;
+            cmd->data.draw.b = color->b;
+            cmd->data.draw.a = color->a;
             cmd->data.draw.blend = texture->blendMode;
             cmd->data.draw.texture = texture;
         }
@@ -518,38 +963,130 @@ PrepQueueCmdDrawTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_
     return cmd;
 }
 
+/* Point a queued copy from an atlas texture at the atlas page instead */
+static SDL_Texture *
+PrepAtlasCopy(SDL_RenderCommand *cmd, SDL_Texture *texture, const SDL_Rect *srcrects, SDL_Rect *atlasrects, int count)
+{
+    SDL_Renderer *renderer = texture->renderer;
+    SDL_Texture *page = SDL_GetAtlasPageTexture(texture->atlas);
+    int i;
+
+    if (page->native) {
+        page = page->native;
+    }
+    page->last_command_generation = renderer->render_command_generation;
+    cmd->data.draw.texture = page;
+
+    for (i = 0; i < count; ++i) {
+        atlasrects[i].x = texture->atlas_rect.x + srcrects[i].x;
+        atlasrects[i].y = texture->atlas_rect.y + srcrects[i].y;
+        atlasrects[i].w = srcrects[i].w;
+        atlasrects[i].h = srcrects[i].h;
+    }
+    return page;
+}
+
+/* Fold a just queued copy into the one before it, if nothing else changed in between */
+static void
+MergeCmdCopy(SDL_Renderer *renderer, SDL_RenderCommand *last, SDL_RenderCommand *cmd)
+{
+    if (last && last->next == cmd && CanMergeCmdDraw(renderer, last, cmd)) {
+        /* The vertices follow on from the previous copy with the same
+           state, so draw them with it and give the command back. */
+        renderer->stats.commands_saved++;
+        last->data.draw.count += cmd->data.draw.count;
+        last->data.draw.end = cmd->data.draw.end;
+        last->next = NULL;
+        renderer->render_commands_tail = last;
+        cmd->next = renderer->render_commands_pool;
+        renderer->render_commands_pool = cmd;
+    }
+}
+
 static int
-QueueCmdCopy(SDL_Renderer *renderer, SDL_Texture * texture, const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+QueueCmdCopy(SDL_Renderer *renderer, SDL_Texture * texture, const SDL_Color *color,
+             const SDL_Rect * srcrect, const SDL_FRect * dstrect)
 {
-    SDL_RenderCommand *cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_COPY);
+    SDL_RenderCommand *last = renderer->render_commands_tail;
+    SDL_RenderCommand *cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_COPY, color);
+    SDL_Rect atlasrect;
     int retval = -1;
     if (cmd != NULL) {
+        if (texture->atlas) {
+            texture = PrepAtlasCopy(cmd, texture, srcrect, &atlasrect, 1);
+            srcrect = &atlasrect;
+        }
         retval = renderer->QueueCopy(renderer, cmd, texture, srcrect, dstrect);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            cmd->data.draw.end = renderer->vertex_data_used;
+            MergeCmdCopy(renderer, last, cmd);
+        }
+    }
+    return retval;
+}
+
+/* Queues several copies with the same state as one command. The source
+   rects are moved to the atlas page in place for textures in an atlas. */
+static int
+QueueCmdCopies(SDL_Renderer *renderer, SDL_Texture * texture, const SDL_Color *color,
+               SDL_Rect * srcrects, const SDL_FRect * dstrects, int count)
+{
+    SDL_RenderCommand *last;
+    SDL_RenderCommand *cmd;
+    int i, retval = -1;
+
+    if (!renderer->QueueCopies) {
+        for (i = 0; i < count; ++i) {
+            if (QueueCmdCopy(renderer, texture, color, &srcrects[i], &dstrects[i]) < 0) {
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    last = renderer->render_commands_tail;
+    cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_COPY, color);
+    if (cmd != NULL) {
+        if (texture->atlas) {
+            texture = PrepAtlasCopy(cmd, texture, srcrects, srcrects, count);
+        }
+        retval = renderer->QueueCopies(renderer, cmd, texture, srcrects, dstrects, count);
+        if (retval < 0) {
+            cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            cmd->data.draw.end = renderer->vertex_data_used;
+            MergeCmdCopy(renderer, last, cmd);
         }
     }
     return retval;
 }
 
 static int
-QueueCmdCopyEx(SDL_Renderer *renderer, SDL_Texture * texture,
+QueueCmdCopyEx(SDL_Renderer *renderer, SDL_Texture * texture, const SDL_Color *color,
                const SDL_Rect * srcquad, const SDL_FRect * dstrect,
                const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip)
 {
-    SDL_RenderCommand *cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_COPY_EX);
+    SDL_RenderCommand *cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_COPY_EX, color);
+    SDL_Rect atlasrect;
     int retval = -1;
     SDL_assert(renderer->QueueCopyEx != NULL);  /* should have caught at higher level. */
     if (cmd != NULL) {
+        if (texture->atlas) {
+            texture = PrepAtlasCopy(cmd, texture, srcquad, &atlasrect, 1);
+            srcquad = &atlasrect;
+        }
         retval = renderer->QueueCopyEx(renderer, cmd, texture, srcquad, dstrect, angle, center, flip);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            cmd->data.draw.end = renderer->vertex_data_used;
         }
     }
     return retval;
 }
 
-
 static int UpdateLogicalSize(SDL_Renderer *renderer);
 
 int
@@ -857,6 +1394,8 @@ SDL_CreateRenderer(SDL_Window * window, int index, Uint32 flags)
     }
 
     renderer->batching = batching;
+    renderer->atlas = SDL_GetHintBoolean(SDL_HINT_RENDER_ATLAS, SDL_FALSE);
+    OpenRenderTrace(renderer);
     renderer->magic = &renderer_magic;
     renderer->window = window;
     renderer->target_mutex = SDL_CreateMutex();
@@ -923,6 +1462,8 @@ SDL_CreateSoftwareRenderer(SDL_Surface * surface)
 
     if (renderer) {
         VerifyDrawQueueFunctions(renderer);
+        renderer->atlas = SDL_GetHintBoolean(SDL_HINT_RENDER_ATLAS, SDL_FALSE);
+        OpenRenderTrace(renderer);
         renderer->magic = &renderer_magic;
         renderer->target_mutex = SDL_CreateMutex();
         renderer->scale.x = 1.0f;
@@ -1078,6 +1619,23 @@ SDL_CreateTexture(SDL_Renderer * renderer, Uint32 format, int access, int w, int
         SDL_OutOfMemory();
         return NULL;
     }
+    if (renderer->atlas && access == SDL_TEXTUREACCESS_STATIC &&
+        !SDL_ISPIXELFORMAT_FOURCC(format) &&
+        w <= SDL_ATLAS_MAX_TEXTURE_SIZE && h <= SDL_ATLAS_MAX_TEXTURE_SIZE) {
+        /* Small static textures share a texture on an atlas page */
+        texture->atlas = SDL_AllocateAtlasRect(renderer, format, SDL_GetScaleMode(), w, h, &texture->atlas_rect);
+        if (texture->atlas) {
+            /* Keep a copy of the pixels to fill the gutter and move pages */
+            texture->pitch = w * SDL_BYTESPERPIXEL(format);
+            texture->pixels = SDL_calloc(1, texture->pitch * h);
+            if (!texture->pixels) {
+                SDL_FreeAtlasRect(renderer, texture->atlas, &texture->atlas_rect);
+                SDL_free(texture);
+                SDL_OutOfMemory();
+                return NULL;
+            }
+        }
+    }
     texture->magic = &texture_magic;
     texture->format = format;
     texture->access = access;
@@ -1095,7 +1653,9 @@ SDL_CreateTexture(SDL_Renderer * renderer, Uint32 format, int access, int w, int
     }
     renderer->textures = texture;
 
-    if (IsSupportedFormat(renderer, format)) {
+    if (texture->atlas) {
+        /* Nothing to create, the texture lives in the atlas page */
+    } else if (IsSupportedFormat(renderer, format)) {
         if (renderer->CreateTexture(renderer, texture) < 0) {
             SDL_DestroyTexture(texture);
             return NULL;
@@ -1404,6 +1964,38 @@ SDL_GetTextureBlendMode(SDL_Texture * texture, SDL_BlendMode *blendMode)
     return 0;
 }
 
+/* Atlas pages have a single scale mode, so move the texture to another page */
+static int
+SDL_SetAtlasTextureScaleMode(SDL_Texture * texture, SDL_ScaleMode scaleMode)
+{
+    SDL_Renderer *renderer = texture->renderer;
+    SDL_AtlasPage *page;
+    SDL_Rect rect, full_rect;
+
+    if (scaleMode == texture->scaleMode) {
+        return 0;
+    }
+
+    page = SDL_AllocateAtlasRect(renderer, texture->format, scaleMode, texture->w, texture->h, &rect);
+    if (!page) {
+        return -1;
+    }
+    full_rect.x = 0;
+    full_rect.y = 0;
+    full_rect.w = texture->w;
+    full_rect.h = texture->h;
+    if (SDL_UpdateAtlasTexture(page, &rect, &full_rect, texture->pixels, texture->pitch) < 0) {
+        SDL_FreeAtlasRect(renderer, page, &rect);
+        return -1;
+    }
+
+    SDL_FreeAtlasRect(renderer, texture->atlas, &texture->atlas_rect);
+    texture->atlas = page;
+    texture->atlas_rect = rect;
+    texture->scaleMode = scaleMode;
+    return 0;
+}
+
 int
 SDL_SetTextureScaleMode(SDL_Texture * texture, SDL_ScaleMode scaleMode)
 {
@@ -1412,6 +2004,9 @@ SDL_SetTextureScaleMode(SDL_Texture * texture, SDL_ScaleMode scaleMode)
     CHECK_TEXTURE_MAGIC(texture, -1);
 
     renderer = texture->renderer;
+    if (texture->atlas) {
+        return SDL_SetAtlasTextureScaleMode(texture, scaleMode);
+    }
     renderer->SetTextureScaleMode(renderer, texture, scaleMode);
     texture->scaleMode = scaleMode;
     if (texture->native) {
@@ -1520,11 +2115,70 @@ SDL_UpdateTextureNative(SDL_Texture * texture, const SDL_Rect * rect,
     return 0;
 }
 
+static int
+SDL_UpdateTextureAtlas(SDL_Texture * texture, const SDL_Rect * rect,
+                       const void *pixels, int pitch)
+{
+    const size_t bpp = SDL_BYTESPERPIXEL(texture->format);
+    SDL_Rect real_rect;
+    const Uint8 *src;
+    Uint8 *dst;
+    int row;
+
+    real_rect.x = 0;
+    real_rect.y = 0;
+    real_rect.w = texture->w;
+    real_rect.h = texture->h;
+    if (!SDL_IntersectRect(rect, &real_rect, &real_rect)) {
+        return 0;
+    }
+
+    src = (const Uint8 *) pixels;
+    src += (real_rect.y - rect->y) * pitch + (real_rect.x - rect->x) * bpp;
+    dst = (Uint8 *) texture->pixels;
+    dst += real_rect.y * texture->pitch + real_rect.x * bpp;
+    for (row = 0; row < real_rect.h; ++row) {
+        SDL_memcpy(dst, src, real_rect.w * bpp);
+        src += pitch;
+        dst += texture->pitch;
+    }
+
+    return SDL_UpdateAtlasTexture(texture->atlas, &texture->atlas_rect, &real_rect,
+                                  texture->pixels, texture->pitch);
+}
+
+/* Clips (*rect) to the texture and moves (*pixels) to match. Returns 1 if
+   there's anything left to update, 0 if not, or -1 on error. */
+static int
+ClipTextureUpdate(SDL_Texture * texture, SDL_Rect * rect, const void **pixels, int pitch)
+{
+    SDL_Rect real_rect;
+
+    real_rect.x = 0;
+    real_rect.y = 0;
+    real_rect.w = texture->w;
+    real_rect.h = texture->h;
+    if (!SDL_IntersectRect(rect, &real_rect, &real_rect)) {
+        return 0;
+    }
+
+    if ((real_rect.x != rect->x) || (real_rect.y != rect->y)) {
+        if (SDL_ISPIXELFORMAT_FOURCC(texture->format)) {
+            return SDL_SetError("Can't clip the left or top of a YUV texture update");
+        }
+        *pixels = (const Uint8 *) *pixels + (real_rect.y - rect->y) * pitch +
+                  (real_rect.x - rect->x) * SDL_BYTESPERPIXEL(texture->format);
+    }
+    *rect = real_rect;
+    return 1;
+}
+
 int
 SDL_UpdateTexture(SDL_Texture * texture, const SDL_Rect * rect,
                   const void *pixels, int pitch)
 {
-    SDL_Rect full_rect;
+    SDL_Rect real_rect;
+    int status;
 
     CHECK_TEXTURE_MAGIC(texture, -1);
 
@@ -1535,20 +2189,28 @@ SDL_UpdateTexture(SDL_Texture * texture, const SDL_Rect * rect,
         return SDL_InvalidParamError("pitch");
     }
 
-    if (!rect) {
-        full_rect.x = 0;
-        full_rect.y = 0;
-        full_rect.w = texture->w;
-        full_rect.h = texture->h;
-        rect = &full_rect;
+    if (rect) {
+        real_rect = *rect;
+    } else {
+        real_rect.x = 0;
+        real_rect.y = 0;
+        real_rect.w = texture->w;
+        real_rect.h = texture->h;
     }
 
-    if ((rect->w == 0) || (rect->h == 0)) {
-        return 0;  /* nothing to do. */
+    /* Earlier asynchronous updates have to land first */
+    RunTextureUploads(texture->renderer);
+
+    status = ClipTextureUpdate(texture, &real_rect, &pixels, pitch);
+    rect = &real_rect;
+    if (status <= 0) {
+        return status;  /* nothing to do, or an error. */
 #if SDL_HAVE_YUV
     } else if (texture->yuv) {
         return SDL_UpdateTextureYUV(texture, rect, pixels, pitch);
 #endif
+    } else if (texture->atlas) {
+        return SDL_UpdateTextureAtlas(texture, rect, pixels, pitch);
     } else if (texture->native) {
         return SDL_UpdateTextureNative(texture, rect, pixels, pitch);
     } else {
@@ -1556,10 +2218,89 @@ SDL_UpdateTexture(SDL_Texture * texture, const SDL_Rect * rect,
         if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
             return -1;
         }
+        CountTextureUpload(texture, rect);
         return renderer->UpdateTexture(renderer, texture, rect, pixels, pitch);
     }
 }
 
+int
+SDL_UpdateTextureAsync(SDL_Texture * texture, const SDL_Rect * rect,
+                       const void *pixels, int pitch,
+                       SDL_TextureUploadCallback callback, void *userdata)
+{
+    SDL_Renderer *renderer;
+    SDL_TextureUpload *upload;
+    SDL_Rect real_rect;
+    int status;
+
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (!pixels) {
+        return SDL_InvalidParamError("pixels");
+    }
+    if (!pitch) {
+        return SDL_InvalidParamError("pitch");
+    }
+
+    if (rect) {
+        real_rect = *rect;
+    } else {
+        real_rect.x = 0;
+        real_rect.y = 0;
+        real_rect.w = texture->w;
+        real_rect.h = texture->h;
+    }
+
+    /* Check the update now, so errors go to the caller and not the callback */
+    status = ClipTextureUpdate(texture, &real_rect, &pixels, pitch);
+    if (status < 0) {
+        return -1;
+    } else if (status == 0) {
+        if (callback) {
+            callback(userdata, texture, 0);  /* nothing to do, the pixels aren't needed. */
+        }
+        return 0;
+    }
+
+    renderer = texture->renderer;
+
+    /* Rendering already queued has to see the old contents */
+    if (texture == renderer->target) {
+        if (FlushRenderCommands(renderer, SDL_RENDER_FLUSH_TEXTURE) < 0) {
+            return -1;
+        }
+    } else if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
+        return -1;
+    }
+
+    upload = renderer->uploads_pool;
+    if (upload != NULL) {
+        renderer->uploads_pool = upload->next;
+    } else {
+        upload = (SDL_TextureUpload *) SDL_malloc(sizeof (*upload));
+        if (!upload) {
+            return SDL_OutOfMemory();
+        }
+    }
+
+    upload->texture = texture;
+    upload->rect = real_rect;
+    upload->pixels = pixels;
+    upload->pitch = pitch;
+    upload->callback = callback;
+    upload->userdata = userdata;
+    upload->next = NULL;
+
+    if (renderer->uploads_tail != NULL) {
+        renderer->uploads_tail->next = upload;
+    } else {
+        renderer->uploads = upload;
+    }
+    renderer->uploads_tail = upload;
+
+    return 0;
+}
+
 #if SDL_HAVE_YUV
 static int
 SDL_UpdateTextureYUVPlanar(SDL_Texture * texture, const SDL_Rect * rect,
@@ -1661,6 +2402,8 @@ int SDL_UpdateYUVTexture(SDL_Texture * texture, const SDL_Rect * rect,
         return 0;  /* nothing to do. */
     }
 
+    RunTextureUploads(texture->renderer);
+
     if (texture->yuv) {
         return SDL_UpdateTextureYUVPlanar(texture, rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch);
     } else {
@@ -1671,6 +2414,7 @@ int SDL_UpdateYUVTexture(SDL_Texture * texture, const SDL_Rect * rect,
             if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
                 return -1;
             }
+            CountTextureUpload(texture, rect);
             return renderer->UpdateTextureYUV(renderer, texture, rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch);
         } else {
             return SDL_Unsupported();
@@ -1722,6 +2466,8 @@ SDL_LockTexture(SDL_Texture * texture, const SDL_Rect * rect,
         rect = &full_rect;
     }
 
+    RunTextureUploads(texture->renderer);
+
 #if SDL_HAVE_YUV
     if (texture->yuv) {
         if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
@@ -1738,6 +2484,7 @@ SDL_LockTexture(SDL_Texture * texture, const SDL_Rect * rect,
         if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
             return -1;
         }
+        texture->locked_rect = *rect;  /* for the upload statistics */
         return renderer->LockTexture(renderer, texture, rect, pixels, pitch);
     }
 }
@@ -1840,6 +2587,7 @@ SDL_UnlockTexture(SDL_Texture * texture)
         SDL_UnlockTextureNative(texture);
     } else {
         SDL_Renderer *renderer = texture->renderer;
+        CountTextureUpload(texture, &texture->locked_rect);
         renderer->UnlockTexture(renderer, texture);
     }
 
@@ -1867,7 +2615,7 @@ SDL_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
         return 0;
     }
 
-    FlushRenderCommands(renderer);  /* time to send everything to the GPU! */
+    FlushRenderCommands(renderer, SDL_RENDER_FLUSH_TARGET);  /* time to send everything to the GPU! */
 
     /* texture == NULL is valid and means reset the target to the window */
     if (texture) {
@@ -3002,7 +3750,7 @@ SDL_RenderCopyF(SDL_Renderer * renderer, SDL_Texture * texture,
 
     texture->last_command_generation = renderer->render_command_generation;
 
-    retval = QueueCmdCopy(renderer, texture, &real_srcrect, &real_dstrect);
+    retval = QueueCmdCopy(renderer, texture, NULL, &real_srcrect, &real_dstrect);
     return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
 }
 
@@ -3106,7 +3854,117 @@ SDL_RenderCopyExF(SDL_Renderer * renderer, SDL_Texture * texture,
 
     texture->last_command_generation = renderer->render_command_generation;
 
-    retval = QueueCmdCopyEx(renderer, texture, &real_srcrect, &real_dstrect, angle, &real_center, flip);
+    retval = QueueCmdCopyEx(renderer, texture, NULL, &real_srcrect, &real_dstrect, angle, &real_center, flip);
+    return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
+}
+
+/* Sprites are batched up on the stack this many at a time */
+#define SDL_RENDER_SPRITE_BATCH 128
+
+int
+SDL_RenderCopySprites(SDL_Renderer * renderer, SDL_Texture * texture,
+                      const SDL_RenderSprite * sprites, int count)
+{
+    SDL_Rect srcrects[SDL_RENDER_SPRITE_BATCH];
+    SDL_FRect dstrects[SDL_RENDER_SPRITE_BATCH];
+    SDL_Color color;
+    SDL_Rect texrect;
+    SDL_FRect viewport;
+    SDL_Rect r;
+    int i, batched = 0;
+    int retval = 0;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (renderer != texture->renderer) {
+        return SDL_SetError("Texture was not created with this renderer");
+    }
+    if (!sprites) {
+        return SDL_SetError("SDL_RenderCopySprites(): Passed NULL sprites");
+    }
+    if (count < 1) {
+        return 0;
+    }
+
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+
+    texrect.x = 0;
+    texrect.y = 0;
+    texrect.w = texture->w;
+    texrect.h = texture->h;
+
+    SDL_zero(r);
+    SDL_RenderGetViewport(renderer, &r);
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.w = (float) r.w;
+    viewport.h = (float) r.h;
+
+    if (texture->native) {
+        texture = texture->native;
+    }
+
+    texture->last_command_generation = renderer->render_command_generation;
+
+    SDL_zero(color);
+    for (i = 0; i < count && retval == 0; ++i) {
+        const SDL_RenderSprite *sprite = &sprites[i];
+        SDL_Rect real_srcrect = texrect;
+        SDL_FRect real_dstrect = sprite->dstrect;
+
+        if (!SDL_RectEmpty(&sprite->srcrect) &&
+            !SDL_IntersectRect(&sprite->srcrect, &texrect, &real_srcrect)) {
+            continue;
+        }
+
+        real_dstrect.x *= renderer->scale.x;
+        real_dstrect.y *= renderer->scale.y;
+        real_dstrect.w *= renderer->scale.x;
+        real_dstrect.h *= renderer->scale.y;
+
+        if (sprite->flip != SDL_FLIP_NONE || (int)(sprite->angle/360) != sprite->angle/360) {
+            /* Rotated sprites go through RenderCopyEx, one at a time */
+            SDL_FPoint real_center;
+
+            if (!renderer->QueueCopyEx) {
+                retval = SDL_SetError("Renderer does not support RenderCopyEx");
+                break;
+            }
+            if (batched > 0) {
+                retval = QueueCmdCopies(renderer, texture, &color, srcrects, dstrects, batched);
+                batched = 0;
+            }
+            real_center.x = real_dstrect.w / 2.0f;
+            real_center.y = real_dstrect.h / 2.0f;
+            if (retval == 0) {
+                retval = QueueCmdCopyEx(renderer, texture, &sprite->color, &real_srcrect, &real_dstrect,
+                                        sprite->angle, &real_center, sprite->flip);
+            }
+            continue;
+        }
+
+        if (!SDL_HasIntersectionF(&sprite->dstrect, &viewport)) {
+            continue;
+        }
+
+        if (batched > 0 &&
+            (batched == SDL_RENDER_SPRITE_BATCH ||
+             SDL_memcmp(&color, &sprite->color, sizeof (color)) != 0)) {
+            retval = QueueCmdCopies(renderer, texture, &color, srcrects, dstrects, batched);
+            batched = 0;
+        }
+        color = sprite->color;
+        srcrects[batched] = real_srcrect;
+        dstrects[batched] = real_dstrect;
+        ++batched;
+    }
+    if (retval == 0 && batched > 0) {
+        retval = QueueCmdCopies(renderer, texture, &color, srcrects, dstrects, batched);
+    }
     return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
 }
 
@@ -3122,7 +3980,7 @@ SDL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
         return SDL_Unsupported();
     }
 
-    FlushRenderCommands(renderer);  /* we need to render before we read the results. */
+    FlushRenderCommands(renderer, SDL_RENDER_FLUSH_READ_PIXELS);  /* we need to render before we read the results. */
 
     if (!format) {
         format = SDL_GetWindowPixelFormat(renderer->window);
@@ -3154,7 +4012,8 @@ SDL_RenderPresent(SDL_Renderer * renderer)
 {
     CHECK_RENDERER_MAGIC(renderer, );
 
-    FlushRenderCommands(renderer);  /* time to send everything to the GPU! */
+    FlushRenderCommands(renderer, SDL_RENDER_FLUSH_PRESENT);  /* time to send everything to the GPU! */
+    FinishRenderStats(renderer);
 
     /* Don't present while we're hidden */
     if (renderer->hidden) {
@@ -3163,6 +4022,36 @@ SDL_RenderPresent(SDL_Renderer * renderer)
     renderer->RenderPresent(renderer);
 }
 
+static void
+CancelTextureUploads(SDL_Texture * texture)
+{
+    SDL_Renderer *renderer = texture->renderer;
+    SDL_TextureUpload *upload = renderer->uploads;
+    SDL_TextureUpload *prev = NULL;
+
+    while (upload != NULL) {
+        SDL_TextureUpload *next = upload->next;
+        if (upload->texture == texture) {
+            if (prev) {
+                prev->next = next;
+            } else {
+                renderer->uploads = next;
+            }
+            if (renderer->uploads_tail == upload) {
+                renderer->uploads_tail = prev;
+            }
+            if (upload->callback) {
+                upload->callback(upload->userdata, texture, -1);
+            }
+            upload->next = renderer->uploads_pool;
+            renderer->uploads_pool = upload;
+        } else {
+            prev = upload;
+        }
+        upload = next;
+    }
+}
+
 void
 SDL_DestroyTexture(SDL_Texture * texture)
 {
@@ -3177,6 +4066,8 @@ SDL_DestroyTexture(SDL_Texture * texture)
         FlushRenderCommandsIfTextureNeeded(texture);
     }
 
+    CancelTextureUploads(texture);
+
     texture->magic = NULL;
 
     if (texture->next) {
@@ -3198,7 +4089,11 @@ SDL_DestroyTexture(SDL_Texture * texture)
 #endif
     SDL_free(texture->pixels);
 
-    renderer->DestroyTexture(renderer, texture);
+    if (texture->atlas) {
+        SDL_FreeAtlasRect(renderer, texture->atlas, &texture->atlas_rect);
+    } else {
+        renderer->DestroyTexture(renderer, texture);
+    }
 
     SDL_FreeSurface(texture->locked_surface);
     texture->locked_surface = NULL;
@@ -3241,10 +4136,19 @@ SDL_DestroyRenderer(SDL_Renderer * renderer)
         SDL_assert(tex != renderer->textures);  /* satisfy static analysis. */
     }
 
+    SDL_assert(renderer->uploads == NULL);
+    while (renderer->uploads_pool) {
+        SDL_TextureUpload *next = renderer->uploads_pool->next;
+        SDL_free(renderer->uploads_pool);
+        renderer->uploads_pool = next;
+    }
+
     if (renderer->window) {
         SDL_SetWindowData(renderer->window, SDL_WINDOWRENDERDATA, NULL);
     }
 
+    CloseRenderTrace(renderer);
+
     /* It's no longer magical... */
     renderer->magic = NULL;
 
@@ -3262,7 +4166,9 @@ int SDL_GL_BindTexture(SDL_Texture *texture, float *texw, float *texh)
 
     CHECK_TEXTURE_MAGIC(texture, -1);
     renderer = texture->renderer;
-    if (texture->native) {
+    if (texture->atlas) {
+        return SDL_SetError("Texture is packed into an atlas, see SDL_HINT_RENDER_ATLAS");
+    } else if (texture->native) {
         return SDL_GL_BindTexture(texture->native, texw, texh);
     } else if (renderer && renderer->GL_BindTexture) {
         FlushRenderCommandsIfTextureNeeded(texture);  /* in case the app is going to mess with it. */
@@ -3278,7 +4184,9 @@ int SDL_GL_UnbindTexture(SDL_Texture *texture)
 
     CHECK_TEXTURE_MAGIC(texture, -1);
     renderer = texture->renderer;
-    if (texture->native) {
+    if (texture->atlas) {
+        return SDL_SetError("Texture is packed into an atlas, see SDL_HINT_RENDER_ATLAS");
+    } else if (texture->native) {
         return SDL_GL_UnbindTexture(texture->native);
     } else if (renderer && renderer->GL_UnbindTexture) {
         FlushRenderCommandsIfTextureNeeded(texture);  /* in case the app messed with it. */
@@ -3294,7 +4202,7 @@ SDL_RenderGetMetalLayer(SDL_Renderer * renderer)
     CHECK_RENDERER_MAGIC(renderer, NULL);
 
     if (renderer->GetMetalLayer) {
-        FlushRenderCommands(renderer);  /* in case the app is going to mess with it. */
+        FlushRenderCommands(renderer, SDL_RENDER_FLUSH_OTHER);  /* in case the app is going to mess with it. */
         return renderer->GetMetalLayer(renderer);
     }
     return NULL;
@@ -3306,7 +4214,7 @@ SDL_RenderGetMetalCommandEncoder(SDL_Renderer * renderer)
     CHECK_RENDERER_MAGIC(renderer, NULL);
 
     if (renderer->GetMetalCommandEncoder) {
-        FlushRenderCommands(renderer);  /* in case the app is going to mess with it. */
+        FlushRenderCommands(renderer, SDL_RENDER_FLUSH_OTHER);  /* in case the app is going to mess with it. */
         return renderer->GetMetalCommandEncoder(renderer);
     }
     return NULL;
@@ -31,6 +31,7 @@
 /* The SDL 2D rendering system */
 
 typedef struct SDL_RenderDriver SDL_RenderDriver;
+typedef struct SDL_AtlasPage SDL_AtlasPage;
 
 /* Define the SDL texture structure */
 struct SDL_Texture
@@ -55,6 +56,10 @@ struct SDL_Texture
     SDL_Rect locked_rect;
     SDL_Surface *locked_surface;  /**< Locked region exposed as a SDL surface */
 
+    /* Support for small textures packed into a shared atlas page */
+    SDL_AtlasPage *atlas;
+    SDL_Rect atlas_rect;
+
     Uint32 last_command_generation; /* last command queue generation this texture was in. */
 
     void *driverdata;           /**< Driver specific texture representation */
@@ -63,6 +68,18 @@ struct SDL_Texture
     SDL_Texture *next;
 };
 
+/* A texture update queued by SDL_UpdateTextureAsync() */
+typedef struct SDL_TextureUpload
+{
+    SDL_Texture *texture;
+    SDL_Rect rect;
+    const void *pixels;
+    int pitch;
+    SDL_TextureUploadCallback callback;
+    void *userdata;
+    struct SDL_TextureUpload *next;
+} SDL_TextureUpload;
+
 typedef enum
 {
     SDL_RENDERCMD_NO_OP,
@@ -95,6 +112,7 @@ typedef struct SDL_RenderCommand
             Uint8 r, g, b, a;
             SDL_BlendMode blend;
             SDL_Texture *texture;
+            size_t end;  /* set by SDL_render.c: offset just past this command's vertex data */
         } draw;
         struct {
             size_t first;
@@ -124,6 +142,8 @@ struct SDL_Renderer
                             int count);
     int (*QueueCopy) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
                        const SDL_Rect * srcrect, const SDL_FRect * dstrect);
+    int (*QueueCopies) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                        const SDL_Rect * srcrects, const SDL_FRect * dstrects, int count);
     int (*QueueCopyEx) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
                         const SDL_Rect * srcquad, const SDL_FRect * dstrect,
                         const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip);
@@ -131,6 +151,10 @@ struct SDL_Renderer
     int (*UpdateTexture) (SDL_Renderer * renderer, SDL_Texture * texture,
                           const SDL_Rect * rect, const void *pixels,
                           int pitch);
+    /* Optional: like UpdateTexture, but may return once the pixels are copied */
+    int (*UpdateTextureAsync) (SDL_Renderer * renderer, SDL_Texture * texture,
+                               const SDL_Rect * rect, const void *pixels,
+                               int pitch);
     int (*UpdateTextureYUV) (SDL_Renderer * renderer, SDL_Texture * texture,
                             const SDL_Rect * rect,
                             const Uint8 *Yplane, int Ypitch,
@@ -218,6 +242,28 @@ struct SDL_Renderer
     SDL_bool viewport_queued;
     SDL_bool cliprect_queued;
 
+    /* Statistics for the frame being drawn and the last one presented */
+    SDL_RenderStats stats;
+    SDL_RenderStats last_stats;
+    Uint64 run_ticks;
+
+    /* Updates from SDL_UpdateTextureAsync(), run before the next flush */
+    SDL_TextureUpload *uploads;
+    SDL_TextureUpload *uploads_tail;
+    SDL_TextureUpload *uploads_pool;
+    SDL_bool running_uploads;
+
+    /* Track in the SDL_HINT_RENDER_TRACE file, or 0 if not tracing */
+    int trace_id;
+
+    /* Set by backends whose RunCommandQueue draws a COPY with count > 1 as
+       that many copies, so consecutive copies from one texture are merged */
+    SDL_bool merge_copies;
+
+    /* Atlas pages for small static textures, if enabled */
+    SDL_bool atlas;
+    SDL_AtlasPage *atlas_pages;
+
     void *vertex_data;
     size_t vertex_data_used;
     size_t vertex_data_allocation;
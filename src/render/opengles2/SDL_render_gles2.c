@@ -172,14 +172,30 @@ typedef struct GLES2_RenderData
     GLES2_ProgramCache program_cache;
     Uint8 clear_r, clear_g, clear_b, clear_a;
 
+    /* Optional, for writing vertices straight into a ring buffer, see GLES2_RunCommandQueue() */
+    void *(APIENTRY *glMapBufferRange)(GLenum, GLintptr, GLsizeiptr, GLbitfield);
+    GLboolean (APIENTRY *glUnmapBuffer)(GLenum);
+
     GLuint vertex_buffers[8];
     size_t vertex_buffer_size[8];
     int current_vertex_buffer;
+    size_t vertex_buffer_used;  /* ring position in vertex_buffers[0], when mapping */
+    size_t vertex_base;         /* where this flush's vertices start in the bound buffer */
     GLES2_DrawStateCache drawstate;
 } GLES2_RenderData;
 
 #define GLES2_MAX_CACHED_PROGRAMS 8
 
+/* Smallest size of the vertex ring buffer; it grows to fit several flushes */
+#define GLES2_VERTEX_BUFFER_SIZE (256 * 1024)
+
+/* Same values as the OpenGL ES 3.0 names, which some gl2ext.h lack */
+#ifndef GL_MAP_WRITE_BIT_EXT
+#define GL_MAP_WRITE_BIT_EXT                0x0002
+#define GL_MAP_INVALIDATE_RANGE_BIT_EXT     0x0004
+#define GL_MAP_UNSYNCHRONIZED_BIT_EXT       0x0020
+#endif
+
 static const float inv255f = 1.0f / 255.0f;
 
 
@@ -275,6 +291,31 @@ static int GLES2_LoadFunctions(GLES2_RenderData * data)
     return 0;
 }
 
+/* Mapping buffer ranges is core in OpenGL ES 3.0, and an extension before that */
+static void
+GLES2_LoadMapBufferFunctions(GLES2_RenderData * data)
+{
+#ifndef __SDL_NOGETPROCADDR__
+    const char *version = (const char *) data->glGetString(GL_VERSION);
+    int major = 0;
+
+    data->glMapBufferRange = NULL;
+    data->glUnmapBuffer = NULL;
+    if (version && SDL_sscanf(version, "OpenGL ES %d", &major) == 1 && major >= 3) {
+        data->glMapBufferRange = SDL_GL_GetProcAddress("glMapBufferRange");
+        data->glUnmapBuffer = SDL_GL_GetProcAddress("glUnmapBuffer");
+    } else if (SDL_GL_ExtensionSupported("GL_EXT_map_buffer_range") &&
+               SDL_GL_ExtensionSupported("GL_OES_mapbuffer")) {
+        data->glMapBufferRange = SDL_GL_GetProcAddress("glMapBufferRangeEXT");
+        data->glUnmapBuffer = SDL_GL_GetProcAddress("glUnmapBufferOES");
+    }
+    if (!data->glMapBufferRange || !data->glUnmapBuffer) {
+        data->glMapBufferRange = NULL;
+        data->glUnmapBuffer = NULL;
+    }
+#endif /* !__SDL_NOGETPROCADDR__ */
+}
+
 static GLES2_FBOList *
 GLES2_GetFBO(GLES2_RenderData *data, Uint32 w, Uint32 h)
 {
@@ -815,50 +856,73 @@ GLES2_QueueFillRects(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_
 }
 
 static int
-GLES2_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
-                          const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+GLES2_QueueCopies(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                  const SDL_Rect * srcrects, const SDL_FRect * dstrects, int count)
 {
-    GLfloat minx, miny, maxx, maxy;
-    GLfloat minu, maxu, minv, maxv;
-    GLfloat *verts = (GLfloat *) SDL_AllocateRenderVertices(renderer, 16 * sizeof (GLfloat), 0, &cmd->data.draw.first);
+    GLfloat *verts = (GLfloat *) SDL_AllocateRenderVertices(renderer, count * 24 * sizeof (GLfloat), 0, &cmd->data.draw.first);
+    int i;
 
     if (!verts) {
         return -1;
     }
 
-    cmd->data.draw.count = 1;
+    cmd->data.draw.count = count;
 
-    minx = dstrect->x;
-    miny = dstrect->y;
-    maxx = dstrect->x + dstrect->w;
-    maxy = dstrect->y + dstrect->h;
+    for (i = 0; i < count; i++) {
+        const SDL_Rect *srcrect = &srcrects[i];
+        const SDL_FRect *dstrect = &dstrects[i];
+        GLfloat minx, miny, maxx, maxy;
+        GLfloat minu, maxu, minv, maxv;
 
-    minu = (GLfloat) srcrect->x / texture->w;
-    maxu = (GLfloat) (srcrect->x + srcrect->w) / texture->w;
-    minv = (GLfloat) srcrect->y / texture->h;
-    maxv = (GLfloat) (srcrect->y + srcrect->h) / texture->h;
+        minx = dstrect->x;
+        miny = dstrect->y;
+        maxx = dstrect->x + dstrect->w;
+        maxy = dstrect->y + dstrect->h;
 
-    *(verts++) = minx;
-    *(verts++) = miny;
-    *(verts++) = maxx;
-    *(verts++) = miny;
-    *(verts++) = minx;
-    *(verts++) = maxy;
-    *(verts++) = maxx;
-    *(verts++) = maxy;
+        minu = (GLfloat) srcrect->x / texture->w;
+        maxu = (GLfloat) (srcrect->x + srcrect->w) / texture->w;
+        minv = (GLfloat) srcrect->y / texture->h;
+        maxv = (GLfloat) (srcrect->y + srcrect->h) / texture->h;
 
-    *(verts++) = minu;
-    *(verts++) = minv;
-    *(verts++) = maxu;
-    *(verts++) = minv;
-    *(verts++) = minu;
-    *(verts++) = maxv;
-    *(verts++) = maxu;
-    *(verts++) = maxv;
+        /* Two separate triangles with interleaved texture coordinates, so
+           consecutive copies can be drawn with a single draw call. */
+        *(verts++) = minx;
+        *(verts++) = miny;
+        *(verts++) = minu;
+        *(verts++) = minv;
+        *(verts++) = maxx;
+        *(verts++) = miny;
+        *(verts++) = maxu;
+        *(verts++) = minv;
+        *(verts++) = minx;
+        *(verts++) = maxy;
+        *(verts++) = minu;
+        *(verts++) = maxv;
+
+        *(verts++) = minx;
+        *(verts++) = maxy;
+        *(verts++) = minu;
+        *(verts++) = maxv;
+        *(verts++) = maxx;
+        *(verts++) = miny;
+        *(verts++) = maxu;
+        *(verts++) = minv;
+        *(verts++) = maxx;
+        *(verts++) = maxy;
+        *(verts++) = maxu;
+        *(verts++) = maxv;
+    }
 
     return 0;
 }
 
+static int
+GLES2_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                          const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+{
+    return GLES2_QueueCopies(renderer, cmd, texture, srcrect, dstrect, 1);
+}
+
 static int
 GLES2_QueueCopyEx(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
                         const SDL_Rect * srcquad, const SDL_FRect * dstrect,
@@ -1016,8 +1080,10 @@ SetDrawState(GLES2_RenderData *data, const SDL_RenderCommand *cmd, const GLES2_I
         data->drawstate.texture = texture;
     }
 
-    if (texture) {
-        data->glVertexAttribPointer(GLES2_ATTRIBUTE_TEXCOORD, 2, GL_FLOAT, GL_FALSE, 0, (const GLvoid *) (cmd->data.draw.first + (sizeof (GLfloat) * 8)));
+    if (texture && cmd->command == SDL_RENDERCMD_COPY) {
+        data->glVertexAttribPointer(GLES2_ATTRIBUTE_TEXCOORD, 2, GL_FLOAT, GL_FALSE, sizeof (GLfloat) * 4, (const GLvoid *) (data->vertex_base + cmd->data.draw.first + (sizeof (GLfloat) * 2)));
+    } else if (texture) {
+        data->glVertexAttribPointer(GLES2_ATTRIBUTE_TEXCOORD, 2, GL_FLOAT, GL_FALSE, 0, (const GLvoid *) (data->vertex_base + cmd->data.draw.first + (sizeof (GLfloat) * 8)));
     }
 
     if (GLES2_SelectProgram(data, imgsrc, texture ? texture->w : 0, texture ? texture->h : 0) < 0) {
@@ -1059,8 +1125,10 @@ SetDrawState(GLES2_RenderData *data, const SDL_RenderCommand *cmd, const GLES2_I
         data->drawstate.blend = blend;
     }
 
-    /* all drawing commands use this */
-    data->glVertexAttribPointer(GLES2_ATTRIBUTE_POSITION, 2, GL_FLOAT, GL_FALSE, 0, (const GLvoid *) cmd->data.draw.first);
+    /* all drawing commands use this, copies interleave it with the texture coordinates */
+    data->glVertexAttribPointer(GLES2_ATTRIBUTE_POSITION, 2, GL_FLOAT, GL_FALSE,
+                                (cmd->command == SDL_RENDERCMD_COPY) ? sizeof (GLfloat) * 4 : 0,
+                                (const GLvoid *) (data->vertex_base + cmd->data.draw.first));
 
     if (is_copy_ex != was_copy_ex) {
         if (is_copy_ex) {
@@ -1074,8 +1142,8 @@ SetDrawState(GLES2_RenderData *data, const SDL_RenderCommand *cmd, const GLES2_I
     }
 
     if (is_copy_ex) {
-        data->glVertexAttribPointer(GLES2_ATTRIBUTE_ANGLE, 2, GL_FLOAT, GL_FALSE, 0, (const GLvoid *) (cmd->data.draw.first + (sizeof (GLfloat) * 16)));
-        data->glVertexAttribPointer(GLES2_ATTRIBUTE_CENTER, 2, GL_FLOAT, GL_FALSE, 0, (const GLvoid *) (cmd->data.draw.first + (sizeof (GLfloat) * 24)));
+        data->glVertexAttribPointer(GLES2_ATTRIBUTE_ANGLE, 2, GL_FLOAT, GL_FALSE, 0, (const GLvoid *) (data->vertex_base + cmd->data.draw.first + (sizeof (GLfloat) * 16)));
+        data->glVertexAttribPointer(GLES2_ATTRIBUTE_CENTER, 2, GL_FLOAT, GL_FALSE, 0, (const GLvoid *) (data->vertex_base + cmd->data.draw.first + (sizeof (GLfloat) * 24)));
     }
 
     return 0;
@@ -1200,8 +1268,6 @@ GLES2_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *ver
 {
     GLES2_RenderData *data = (GLES2_RenderData *) renderer->driverdata;
     const SDL_bool colorswap = (renderer->target && (renderer->target->format == SDL_PIXELFORMAT_ARGB8888 || renderer->target->format == SDL_PIXELFORMAT_RGB888));
-    const int vboidx = data->current_vertex_buffer;
-    const GLuint vbo = data->vertex_buffers[vboidx];
     size_t i;
 
     if (GLES2_ActivateRenderer(renderer) < 0) {
@@ -1213,19 +1279,59 @@ GLES2_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *ver
         SDL_GL_GetDrawableSize(renderer->window, &data->drawstate.drawablew, &data->drawstate.drawableh);
     }
 
-    /* upload the new VBO data for this set of commands. */
-    data->glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    if (data->vertex_buffer_size[vboidx] < vertsize) {
-        data->glBufferData(GL_ARRAY_BUFFER, vertsize, vertices, GL_STREAM_DRAW);
-        data->vertex_buffer_size[vboidx] = vertsize;
+    if (data->glMapBufferRange) {
+        /* write the new VBO data for this set of commands into a ring buffer.
+           Each flush goes after the previous one, so nothing the GL may still
+           be drawing from is overwritten and the map doesn't have to wait for
+           it. When the ring wraps around the buffer is orphaned, and the
+           driver hands us fresh storage while the old one is still in use. */
+        const GLuint vbo = data->vertex_buffers[0];
+        size_t base;
+
+        data->glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        base = (data->vertex_buffer_used + 15) & ~15;
+        if (base + vertsize > data->vertex_buffer_size[0]) {
+            size_t size = SDL_max(data->vertex_buffer_size[0], GLES2_VERTEX_BUFFER_SIZE);
+            while (size < vertsize * 4) {
+                size *= 2;
+            }
+            data->glBufferData(GL_ARRAY_BUFFER, size, NULL, GL_STREAM_DRAW);
+            data->vertex_buffer_size[0] = size;
+            base = 0;
+        }
+        if (vertsize > 0) {
+            void *mapped = data->glMapBufferRange(GL_ARRAY_BUFFER, base, vertsize,
+                                                  GL_MAP_WRITE_BIT_EXT | GL_MAP_INVALIDATE_RANGE_BIT_EXT |
+                                                  GL_MAP_UNSYNCHRONIZED_BIT_EXT);
+            if (mapped) {
+                SDL_memcpy(mapped, vertices, vertsize);
+            }
+            if (!mapped || !data->glUnmapBuffer(GL_ARRAY_BUFFER)) {
+                /* the mapping failed or its contents were lost, upload it the slow way */
+                data->glBufferSubData(GL_ARRAY_BUFFER, base, vertsize, vertices);
+            }
+        }
+        data->vertex_buffer_used = base + vertsize;
+        data->vertex_base = base;
     } else {
-        data->glBufferSubData(GL_ARRAY_BUFFER, 0, vertsize, vertices);
-    }
+        const int vboidx = data->current_vertex_buffer;
+        const GLuint vbo = data->vertex_buffers[vboidx];
+
+        /* upload the new VBO data for this set of commands. */
+        data->glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        if (data->vertex_buffer_size[vboidx] < vertsize) {
+            data->glBufferData(GL_ARRAY_BUFFER, vertsize, vertices, GL_STREAM_DRAW);
+            data->vertex_buffer_size[vboidx] = vertsize;
+        } else {
+            data->glBufferSubData(GL_ARRAY_BUFFER, 0, vertsize, vertices);
+        }
+        data->vertex_base = 0;
 
-    /* cycle through a few VBOs so the GL has some time with the data before we replace it. */
-    data->current_vertex_buffer++;
-    if (data->current_vertex_buffer >= SDL_arraysize(data->vertex_buffers)) {
-        data->current_vertex_buffer = 0;
+        /* cycle through a few VBOs so the GL has some time with the data before we replace it. */
+        data->current_vertex_buffer++;
+        if (data->current_vertex_buffer >= SDL_arraysize(data->vertex_buffers)) {
+            data->current_vertex_buffer = 0;
+        }
     }
 
     while (cmd) {
@@ -1320,7 +1426,13 @@ GLES2_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *ver
                 break;
             }
 
-            case SDL_RENDERCMD_COPY:
+            case SDL_RENDERCMD_COPY: {
+                if (SetCopyState(renderer, cmd) == 0) {
+                    data->glDrawArrays(GL_TRIANGLES, 0, (GLsizei) (cmd->data.draw.count * 6));
+                }
+                break;
+            }
+
             case SDL_RENDERCMD_COPY_EX: {
                 if (SetCopyState(renderer, cmd) == 0) {
                     data->glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
@@ -2078,8 +2190,10 @@ GLES2_CreateRenderer(SDL_Window *window, Uint32 flags)
     }
 #endif /* ZUNE_HD */
 
-    /* we keep a few of these and cycle through them, so data can live for a few frames. */
+    /* we keep a few of these and cycle through them, so data can live for a few frames.
+       If the GL can map buffer ranges, the first one is used as a ring buffer instead. */
     data->glGenBuffers(SDL_arraysize(data->vertex_buffers), data->vertex_buffers);
+    GLES2_LoadMapBufferFunctions(data);
 
     data->framebuffers = NULL;
     data->glGetIntegerv(GL_FRAMEBUFFER_BINDING, &window_framebuffer);
@@ -2102,8 +2216,10 @@ GLES2_CreateRenderer(SDL_Window *window, Uint32 flags)
     renderer->QueueDrawLines      = GLES2_QueueDrawPoints;  /* lines and points queue vertices the same way. */
     renderer->QueueFillRects      = GLES2_QueueFillRects;
     renderer->QueueCopy           = GLES2_QueueCopy;
+    renderer->QueueCopies         = GLES2_QueueCopies;
     renderer->QueueCopyEx         = GLES2_QueueCopyEx;
     renderer->RunCommandQueue     = GLES2_RunCommandQueue;
+    renderer->merge_copies        = SDL_TRUE;
     renderer->RenderReadPixels    = GLES2_RenderReadPixels;
     renderer->RenderPresent       = GLES2_RenderPresent;
     renderer->DestroyTexture      = GLES2_DestroyTexture;
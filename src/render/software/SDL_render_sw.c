@@ -26,6 +26,7 @@
 #include "SDL_render_sw_c.h"
 #include "SDL_hints.h"
 #include "SDL_assert.h"
+#include "SDL_atomic.h"
 
 #include "SDL_draw.h"
 #include "SDL_blendfillrect.h"
@@ -34,6 +35,8 @@
 #include "SDL_drawline.h"
 #include "SDL_drawpoint.h"
 #include "SDL_rotate.h"
+#include "../../video/SDL_blit.h"
+#include "../../thread/SDL_threadpool_c.h"
 
 /* SDL surface based renderer implementation */
 
@@ -44,10 +47,59 @@ typedef struct
     SDL_bool surface_cliprect_dirty;
 } SW_DrawStateCache;
 
+/* Tiled rasterization, enabled with SDL_HINT_RENDER_SOFTWARE_THREADS.
+ *
+ * Runs of commands that can be clipped to a tile without changing a single
+ * output pixel (clears, fills, points and unscaled copies) are binned into
+ * screen tiles, and the tiles are rasterized in parallel. Each tile replays
+ * its commands in queue order. Anything else (lines, scaled or rotated
+ * copies) flushes the pending tiles and runs on the full surface as usual.
+ */
+#define SW_TILE_WIDTH   256
+#define SW_TILE_HEIGHT  128
+
+typedef struct
+{
+    SDL_RenderCommandType command;
+    SDL_Rect cliprect;          /* absolute clip rect, already intersected with the surface */
+    SDL_Rect bounds;            /* part of cliprect this command can actually touch */
+    const void *verts;
+    int count;
+    Uint32 color;               /* mapped draw color, for SDL_BLENDMODE_NONE */
+    Uint8 r, g, b, a;
+    SDL_BlendMode blend;
+    SDL_Surface *src;           /* texture surface, for SDL_RENDERCMD_COPY */
+} SW_TileCommand;
+
+typedef struct
+{
+    SDL_Surface *dst;           /* this worker's view of the target, so it can own the clip rect */
+    SDL_Surface *src;           /* scratch view of the texture being copied, reused across commands */
+} SW_TileWorker;
+
+typedef struct
+{
+    SDL_ThreadPool *pool;
+    SW_TileWorker *workers;
+    SW_TileCommand *commands;
+    int num_commands;
+    int max_commands;
+    int *bins;                  /* command indices, grouped by tile, in queue order */
+    int max_bins;
+    int *bin_start;             /* num_tiles + 1 offsets into bins */
+    int *bin_fill;
+    int max_tiles;
+    int tiles_x;
+    int tiles_y;
+    SDL_atomic_t next_tile;
+} SW_TileState;
+
 typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+    SW_TileState *tiles;        /* NULL unless rasterizing on more than one thread */
+    SDL_BlitScaledScratch scratch;  /* reused by filtered scaled copies */
 } SW_RenderData;
 
 
@@ -267,33 +319,43 @@ SW_QueueFillRects(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_FRe
 }
 
 static int
-SW_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
-             const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+SW_QueueCopies(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+               const SDL_Rect * srcrects, const SDL_FRect * dstrects, int count)
 {
-    SDL_Rect *verts = (SDL_Rect *) SDL_AllocateRenderVertices(renderer, 2 * sizeof (SDL_Rect), 0, &cmd->data.draw.first);
+    SDL_Rect *verts = (SDL_Rect *) SDL_AllocateRenderVertices(renderer, count * 2 * sizeof (SDL_Rect), 0, &cmd->data.draw.first);
+    const int x = renderer->viewport.x;
+    const int y = renderer->viewport.y;
+    int i;
 
     if (!verts) {
         return -1;
     }
 
-    cmd->data.draw.count = 1;
+    cmd->data.draw.count = count;
 
-    SDL_memcpy(verts, srcrect, sizeof (SDL_Rect));
-    verts++;
+    for (i = 0; i < count; i++) {
+        const SDL_FRect *dstrect = &dstrects[i];
 
-    if (renderer->viewport.x || renderer->viewport.y) {
-        verts->x = (int)(renderer->viewport.x + dstrect->x);
-        verts->y = (int)(renderer->viewport.y + dstrect->y);
-    } else {
-        verts->x = (int)dstrect->x;
-        verts->y = (int)dstrect->y;
+        SDL_memcpy(verts, &srcrects[i], sizeof (SDL_Rect));
+        verts++;
+
+        verts->x = (int)(x + dstrect->x);
+        verts->y = (int)(y + dstrect->y);
+        verts->w = (int)dstrect->w;
+        verts->h = (int)dstrect->h;
+        verts++;
     }
-    verts->w = (int)dstrect->w;
-    verts->h = (int)dstrect->h;
 
     return 0;
 }
 
+static int
+SW_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+             const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+{
+    return SW_QueueCopies(renderer, cmd, texture, srcrect, dstrect, 1);
+}
+
 typedef struct CopyExData
 {
     SDL_Rect srcrect;
@@ -339,6 +401,7 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * tex
                 const SDL_Rect * srcrect, const SDL_Rect * final_rect,
                 const double angle, const SDL_FPoint * center, const SDL_RendererFlip flip)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *src = (SDL_Surface *) texture->driverdata;
     SDL_Rect tmp_rect;
     SDL_Surface *src_clone, *src_rotated, *src_scaled;
@@ -435,7 +498,8 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * tex
             retval = -1;
         } else {
             SDL_SetSurfaceBlendMode(src_clone, SDL_BLENDMODE_NONE);
-            retval = SDL_BlitScaled(src_clone, srcrect, src_scaled, &scale_rect);
+            retval = SDL_PrivateUpperBlitScaled(src_clone, srcrect, src_scaled, &scale_rect, texture->scaleMode,
+                                                &data->scratch);
             SDL_FreeSurface(src_clone);
             src_clone = src_scaled;
             src_scaled = NULL;
@@ -608,111 +672,106 @@ SetDrawState(SDL_Surface *surface, SW_DrawStateCache *drawstate)
     }
 }
 
-static int
-SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+static void
+SW_RunCommand(SDL_Renderer * renderer, SDL_Surface *surface, SW_DrawStateCache *drawstate,
+              SDL_RenderCommand *cmd, void *vertices)
 {
-    SDL_Surface *surface = SW_ActivateRenderer(renderer);
-    SW_DrawStateCache drawstate;
+    switch (cmd->command) {
+        case SDL_RENDERCMD_SETDRAWCOLOR: {
+            break;  /* Not used in this backend. */
+        }
 
-    if (!surface) {
-        return -1;
-    }
+        case SDL_RENDERCMD_SETVIEWPORT: {
+            drawstate->viewport = &cmd->data.viewport.rect;
+            drawstate->surface_cliprect_dirty = SDL_TRUE;
+            break;
+        }
 
-    drawstate.viewport = NULL;
-    drawstate.cliprect = NULL;
-    drawstate.surface_cliprect_dirty = SDL_TRUE;
+        case SDL_RENDERCMD_SETCLIPRECT: {
+            drawstate->cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;                
+            drawstate->surface_cliprect_dirty = SDL_TRUE;
+            break;
+        }
 
-    while (cmd) {
-        switch (cmd->command) {
-            case SDL_RENDERCMD_SETDRAWCOLOR: {
-                break;  /* Not used in this backend. */
-            }
+        case SDL_RENDERCMD_CLEAR: {
+            const Uint8 r = cmd->data.color.r;
+            const Uint8 g = cmd->data.color.g;
+            const Uint8 b = cmd->data.color.b;
+            const Uint8 a = cmd->data.color.a;
+            /* By definition the clear ignores the clip rect */
+            SDL_SetClipRect(surface, NULL);
+            SDL_FillRect(surface, NULL, SDL_MapRGBA(surface->format, r, g, b, a));
+            drawstate->surface_cliprect_dirty = SDL_TRUE;
+            break;
+        }
 
-            case SDL_RENDERCMD_SETVIEWPORT: {
-                drawstate.viewport = &cmd->data.viewport.rect;
-                drawstate.surface_cliprect_dirty = SDL_TRUE;
-                break;
+        case SDL_RENDERCMD_DRAW_POINTS: {
+            const Uint8 r = cmd->data.draw.r;
+            const Uint8 g = cmd->data.draw.g;
+            const Uint8 b = cmd->data.draw.b;
+            const Uint8 a = cmd->data.draw.a;
+            const int count = (int) cmd->data.draw.count;
+            const SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            const SDL_BlendMode blend = cmd->data.draw.blend;
+            SetDrawState(surface, drawstate);
+            if (blend == SDL_BLENDMODE_NONE) {
+                SDL_DrawPoints(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
+            } else {
+                SDL_BlendPoints(surface, verts, count, blend, r, g, b, a);
             }
+            break;
+        }
 
-            case SDL_RENDERCMD_SETCLIPRECT: {
-                drawstate.cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;                
-                drawstate.surface_cliprect_dirty = SDL_TRUE;
-                break;
+        case SDL_RENDERCMD_DRAW_LINES: {
+            const Uint8 r = cmd->data.draw.r;
+            const Uint8 g = cmd->data.draw.g;
+            const Uint8 b = cmd->data.draw.b;
+            const Uint8 a = cmd->data.draw.a;
+            const int count = (int) cmd->data.draw.count;
+            const SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            const SDL_BlendMode blend = cmd->data.draw.blend;
+            SetDrawState(surface, drawstate);
+            if (blend == SDL_BLENDMODE_NONE) {
+                SDL_DrawLines(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
+            } else {
+                SDL_BlendLines(surface, verts, count, blend, r, g, b, a);
             }
+            break;
+        }
 
-            case SDL_RENDERCMD_CLEAR: {
-                const Uint8 r = cmd->data.color.r;
-                const Uint8 g = cmd->data.color.g;
-                const Uint8 b = cmd->data.color.b;
-                const Uint8 a = cmd->data.color.a;
-                /* By definition the clear ignores the clip rect */
-                SDL_SetClipRect(surface, NULL);
-                SDL_FillRect(surface, NULL, SDL_MapRGBA(surface->format, r, g, b, a));
-                drawstate.surface_cliprect_dirty = SDL_TRUE;
-                break;
+        case SDL_RENDERCMD_FILL_RECTS: {
+            const Uint8 r = cmd->data.draw.r;
+            const Uint8 g = cmd->data.draw.g;
+            const Uint8 b = cmd->data.draw.b;
+            const Uint8 a = cmd->data.draw.a;
+            const int count = (int) cmd->data.draw.count;
+            const SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            const SDL_BlendMode blend = cmd->data.draw.blend;
+            SetDrawState(surface, drawstate);
+            if (blend == SDL_BLENDMODE_NONE) {
+                SDL_FillRects(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
+            } else {
+                SDL_BlendFillRects(surface, verts, count, blend, r, g, b, a);
             }
+            break;
+        }
 
-            case SDL_RENDERCMD_DRAW_POINTS: {
-                const Uint8 r = cmd->data.draw.r;
-                const Uint8 g = cmd->data.draw.g;
-                const Uint8 b = cmd->data.draw.b;
-                const Uint8 a = cmd->data.draw.a;
-                const int count = (int) cmd->data.draw.count;
-                const SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                const SDL_BlendMode blend = cmd->data.draw.blend;
-                SetDrawState(surface, &drawstate);
-                if (blend == SDL_BLENDMODE_NONE) {
-                    SDL_DrawPoints(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
-                } else {
-                    SDL_BlendPoints(surface, verts, count, blend, r, g, b, a);
-                }
-                break;
-            }
+        case SDL_RENDERCMD_COPY: {
+            SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            const size_t count = cmd->data.draw.count;
+            SDL_Texture *texture = cmd->data.draw.texture;
+            SDL_Surface *src = (SDL_Surface *) texture->driverdata;
+            SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+            size_t i;
 
-            case SDL_RENDERCMD_DRAW_LINES: {
-                const Uint8 r = cmd->data.draw.r;
-                const Uint8 g = cmd->data.draw.g;
-                const Uint8 b = cmd->data.draw.b;
-                const Uint8 a = cmd->data.draw.a;
-                const int count = (int) cmd->data.draw.count;
-                const SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                const SDL_BlendMode blend = cmd->data.draw.blend;
-                SetDrawState(surface, &drawstate);
-                if (blend == SDL_BLENDMODE_NONE) {
-                    SDL_DrawLines(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
-                } else {
-                    SDL_BlendLines(surface, verts, count, blend, r, g, b, a);
-                }
-                break;
-            }
+            SetDrawState(surface, drawstate);
 
-            case SDL_RENDERCMD_FILL_RECTS: {
-                const Uint8 r = cmd->data.draw.r;
-                const Uint8 g = cmd->data.draw.g;
-                const Uint8 b = cmd->data.draw.b;
-                const Uint8 a = cmd->data.draw.a;
-                const int count = (int) cmd->data.draw.count;
-                const SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                const SDL_BlendMode blend = cmd->data.draw.blend;
-                SetDrawState(surface, &drawstate);
-                if (blend == SDL_BLENDMODE_NONE) {
-                    SDL_FillRects(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
-                } else {
-                    SDL_BlendFillRects(surface, verts, count, blend, r, g, b, a);
-                }
-                break;
-            }
+            PrepTextureForCopy(cmd);
 
-            case SDL_RENDERCMD_COPY: {
-                SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            /* Consecutive copies from the same texture are merged into one command */
+            for (i = 0; i < count; ++i, verts += 2) {
                 const SDL_Rect *srcrect = verts;
                 SDL_Rect *dstrect = verts + 1;
-                SDL_Texture *texture = cmd->data.draw.texture;
-                SDL_Surface *src = (SDL_Surface *) texture->driverdata;
-
-                SetDrawState(surface, &drawstate);
-
-                PrepTextureForCopy(cmd);
 
                 if ( srcrect->w == dstrect->w && srcrect->h == dstrect->h ) {
                     SDL_BlitSurface(src, srcrect, surface, dstrect);
@@ -721,24 +780,448 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                      * to avoid potentially frequent RLE encoding/decoding.
                      */
                     SDL_SetSurfaceRLE(surface, 0);
-                    SDL_BlitScaled(src, srcrect, surface, dstrect);
+                    SDL_PrivateUpperBlitScaled(src, srcrect, surface, dstrect, texture->scaleMode,
+                                               &data->scratch);
                 }
-                break;
             }
+            break;
+        }
 
-            case SDL_RENDERCMD_COPY_EX: {
-                const CopyExData *copydata = (CopyExData *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                SetDrawState(surface, &drawstate);
-                PrepTextureForCopy(cmd);
-                SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
-                                &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip);
-                break;
+        case SDL_RENDERCMD_COPY_EX: {
+            const CopyExData *copydata = (CopyExData *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            SetDrawState(surface, drawstate);
+            PrepTextureForCopy(cmd);
+            SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
+                            &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip);
+            break;
+        }
+
+        case SDL_RENDERCMD_NO_OP:
+            break;
+    }
+}
+
+static SDL_bool
+SW_GetTileClipRect(SDL_Surface *surface, const SW_DrawStateCache *drawstate, SDL_Rect *result)
+{
+    SDL_Rect bounds;
+
+    bounds.x = 0;
+    bounds.y = 0;
+    bounds.w = surface->w;
+    bounds.h = surface->h;
+
+    if (!drawstate->viewport) {
+        *result = bounds;
+    } else if (drawstate->cliprect) {
+        /* Same math as SetDrawState(). */
+        const SDL_Rect *viewport = drawstate->viewport;
+        SDL_Rect clip_rect;
+        clip_rect.x = drawstate->cliprect->x + viewport->x;
+        clip_rect.y = drawstate->cliprect->y + viewport->y;
+        clip_rect.w = drawstate->cliprect->w;
+        clip_rect.h = drawstate->cliprect->h;
+        if (!SDL_IntersectRect(viewport, &clip_rect, result)) {
+            return SDL_FALSE;
+        }
+    } else {
+        *result = *drawstate->viewport;
+    }
+    return SDL_IntersectRect(&bounds, result, result);
+}
+
+/* Converts a queued command into a tile command, or returns SDL_FALSE if it
+   has to run on the full surface to produce the same pixels. */
+static SDL_bool
+SW_PrepareTileCommand(SDL_Surface *surface, const SW_DrawStateCache *drawstate,
+                      const SDL_RenderCommand *cmd, void *vertices, SW_TileCommand *tcmd)
+{
+    SDL_Rect extent;
+    int i;
+
+    SDL_zerop(tcmd);
+    tcmd->command = cmd->command;
+
+    switch (cmd->command) {
+        case SDL_RENDERCMD_CLEAR: {
+            /* By definition the clear ignores the clip rect */
+            tcmd->cliprect.x = 0;
+            tcmd->cliprect.y = 0;
+            tcmd->cliprect.w = surface->w;
+            tcmd->cliprect.h = surface->h;
+            tcmd->bounds = tcmd->cliprect;
+            tcmd->color = SDL_MapRGBA(surface->format, cmd->data.color.r, cmd->data.color.g,
+                                      cmd->data.color.b, cmd->data.color.a);
+            return SDL_TRUE;
+        }
+
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_FILL_RECTS: {
+            const int count = (int) cmd->data.draw.count;
+            if (cmd->command == SDL_RENDERCMD_DRAW_POINTS) {
+                const SDL_Point *points = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
+                if (!SDL_EnclosePoints(points, count, NULL, &extent)) {
+                    extent.w = extent.h = 0;
+                }
+                tcmd->verts = points;
+            } else {
+                const SDL_Rect *rects = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
+                extent.x = extent.y = extent.w = extent.h = 0;
+                for (i = 0; i < count; ++i) {
+                    SDL_UnionRect(&extent, &rects[i], &extent);
+                }
+                tcmd->verts = rects;
+            }
+            tcmd->count = count;
+            tcmd->r = cmd->data.draw.r;
+            tcmd->g = cmd->data.draw.g;
+            tcmd->b = cmd->data.draw.b;
+            tcmd->a = cmd->data.draw.a;
+            tcmd->blend = cmd->data.draw.blend;
+            tcmd->color = SDL_MapRGBA(surface->format, tcmd->r, tcmd->g, tcmd->b, tcmd->a);
+            break;
+        }
+
+        case SDL_RENDERCMD_COPY: {
+            const SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            const int count = (int) cmd->data.draw.count;
+            SDL_Surface *src = (SDL_Surface *) cmd->data.draw.texture->driverdata;
+
+            /* Clipping a scaled blit changes where it samples from, and the
+               scratch source view can't share an RLE encoding or a palette. */
+            if (src->format->palette || (src->flags & SDL_RLEACCEL)) {
+                return SDL_FALSE;
+            }
+            extent.x = extent.y = extent.w = extent.h = 0;
+            for (i = 0; i < count; ++i) {
+                const SDL_Rect *srcrect = &verts[i * 2];
+                const SDL_Rect *dstrect = &verts[i * 2 + 1];
+                if (srcrect->w != dstrect->w || srcrect->h != dstrect->h) {
+                    return SDL_FALSE;
+                }
+                SDL_UnionRect(&extent, dstrect, &extent);
+            }
+            tcmd->verts = verts;
+            tcmd->count = count;
+            tcmd->r = cmd->data.draw.r;
+            tcmd->g = cmd->data.draw.g;
+            tcmd->b = cmd->data.draw.b;
+            tcmd->a = cmd->data.draw.a;
+            tcmd->blend = cmd->data.draw.blend;
+            tcmd->src = src;
+            break;
+        }
+
+        default:
+            return SDL_FALSE;
+    }
+
+    if (!SW_GetTileClipRect(surface, drawstate, &tcmd->cliprect) ||
+        !SDL_IntersectRect(&tcmd->cliprect, &extent, &tcmd->bounds)) {
+        tcmd->bounds.w = tcmd->bounds.h = 0;  /* draws nothing, gets no bins. */
+    }
+    return SDL_TRUE;
+}
+
+static SDL_Surface *
+SW_GetTileSource(SW_TileWorker *worker, SDL_Surface *src)
+{
+    SDL_Surface *view = worker->src;
+
+    if (!view || view->format->format != src->format->format) {
+        if (view) {
+            SDL_FreeSurface(view);
+        }
+        view = SDL_CreateRGBSurfaceWithFormatFrom(src->pixels, src->w, src->h, src->format->BitsPerPixel,
+                                                  src->pitch, src->format->format);
+        worker->src = view;
+        if (!view) {
+            return NULL;
+        }
+    }
+
+    /* Blits read pixels and pitch from the surface on every call, so the
+       scratch surface can simply be pointed at the next texture. */
+    view->pixels = src->pixels;
+    view->w = src->w;
+    view->h = src->h;
+    view->pitch = src->pitch;
+    SDL_SetClipRect(view, NULL);
+    return view;
+}
+
+static void
+SW_RunTileCommand(SW_TileWorker *worker, const SW_TileCommand *tcmd, const SDL_Rect *tile)
+{
+    SDL_Surface *dst = worker->dst;
+    SDL_Rect clip_rect;
+
+    if (!SDL_IntersectRect(&tcmd->cliprect, tile, &clip_rect)) {
+        return;
+    }
+    SDL_SetClipRect(dst, &clip_rect);
+
+    switch (tcmd->command) {
+        case SDL_RENDERCMD_CLEAR:
+            SDL_FillRect(dst, NULL, tcmd->color);
+            break;
+
+        case SDL_RENDERCMD_DRAW_POINTS:
+            if (tcmd->blend == SDL_BLENDMODE_NONE) {
+                SDL_DrawPoints(dst, (const SDL_Point *) tcmd->verts, tcmd->count, tcmd->color);
+            } else {
+                SDL_BlendPoints(dst, (const SDL_Point *) tcmd->verts, tcmd->count, tcmd->blend,
+                                tcmd->r, tcmd->g, tcmd->b, tcmd->a);
             }
+            break;
 
-            case SDL_RENDERCMD_NO_OP:
-                break;
+        case SDL_RENDERCMD_FILL_RECTS:
+            if (tcmd->blend == SDL_BLENDMODE_NONE) {
+                SDL_FillRects(dst, (const SDL_Rect *) tcmd->verts, tcmd->count, tcmd->color);
+            } else {
+                SDL_BlendFillRects(dst, (const SDL_Rect *) tcmd->verts, tcmd->count, tcmd->blend,
+                                   tcmd->r, tcmd->g, tcmd->b, tcmd->a);
+            }
+            break;
+
+        case SDL_RENDERCMD_COPY: {
+            const SDL_Rect *verts = (const SDL_Rect *) tcmd->verts;
+            SDL_Surface *src = SW_GetTileSource(worker, tcmd->src);
+            int i;
+            if (src) {
+                SDL_SetSurfaceColorMod(src, tcmd->r, tcmd->g, tcmd->b);
+                SDL_SetSurfaceAlphaMod(src, tcmd->a);
+                SDL_SetSurfaceBlendMode(src, tcmd->blend);
+                for (i = 0; i < tcmd->count; ++i, verts += 2) {
+                    SDL_Rect srcrect = verts[0];
+                    SDL_Rect dstrect = verts[1];
+                    SDL_BlitSurface(src, &srcrect, dst, &dstrect);
+                }
+            }
+            break;
         }
 
+        default:
+            break;
+    }
+}
+
+static void
+SW_RasterizeTiles(void *userdata, int index)
+{
+    SW_TileState *tiles = (SW_TileState *) userdata;
+    SW_TileWorker *worker = &tiles->workers[index];
+    const int num_tiles = tiles->tiles_x * tiles->tiles_y;
+    int tile;
+
+    while ((tile = SDL_AtomicAdd(&tiles->next_tile, 1)) < num_tiles) {
+        SDL_Rect rect;
+        int i;
+
+        rect.x = (tile % tiles->tiles_x) * SW_TILE_WIDTH;
+        rect.y = (tile / tiles->tiles_x) * SW_TILE_HEIGHT;
+        rect.w = SW_TILE_WIDTH;
+        rect.h = SW_TILE_HEIGHT;
+        for (i = tiles->bin_start[tile]; i < tiles->bin_start[tile + 1]; ++i) {
+            SW_RunTileCommand(worker, &tiles->commands[tiles->bins[i]], &rect);
+        }
+    }
+}
+
+static int
+SW_PrepareTileWorkers(SW_TileState *tiles, SDL_Surface *surface)
+{
+    const int num_workers = SDL_GetThreadPoolWorkers(tiles->pool);
+    int i;
+
+    for (i = 0; i < num_workers; ++i) {
+        SW_TileWorker *worker = &tiles->workers[i];
+        SDL_Surface *dst = worker->dst;
+        if (dst && dst->pixels == surface->pixels && dst->pitch == surface->pitch &&
+            dst->w == surface->w && dst->h == surface->h &&
+            dst->format->format == surface->format->format) {
+            continue;
+        }
+        if (dst) {
+            SDL_FreeSurface(dst);
+        }
+        if (worker->src) {
+            /* Its blit map would still point at the old view. */
+            SDL_FreeSurface(worker->src);
+            worker->src = NULL;
+        }
+        worker->dst = SDL_CreateRGBSurfaceWithFormatFrom(surface->pixels, surface->w, surface->h,
+                                                          surface->format->BitsPerPixel, surface->pitch,
+                                                          surface->format->format);
+        if (!worker->dst) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int
+SW_BinTileCommands(SW_TileState *tiles, SDL_Surface *surface)
+{
+    const int tiles_x = (surface->w + SW_TILE_WIDTH - 1) / SW_TILE_WIDTH;
+    const int tiles_y = (surface->h + SW_TILE_HEIGHT - 1) / SW_TILE_HEIGHT;
+    const int num_tiles = tiles_x * tiles_y;
+    int total = 0;
+    int i, t;
+
+    if (num_tiles + 1 > tiles->max_tiles) {
+        int *bin_start = (int *) SDL_realloc(tiles->bin_start, (num_tiles + 1) * sizeof (int));
+        int *bin_fill;
+        if (!bin_start) {
+            return SDL_OutOfMemory();
+        }
+        tiles->bin_start = bin_start;
+        bin_fill = (int *) SDL_realloc(tiles->bin_fill, (num_tiles + 1) * sizeof (int));
+        if (!bin_fill) {
+            return SDL_OutOfMemory();
+        }
+        tiles->bin_fill = bin_fill;
+        tiles->max_tiles = num_tiles + 1;
+    }
+    tiles->tiles_x = tiles_x;
+    tiles->tiles_y = tiles_y;
+
+    /* Count, then fill: a counting sort keeps each tile's commands in queue order. */
+    SDL_memset(tiles->bin_fill, 0, (num_tiles + 1) * sizeof (int));
+    for (i = 0; i < tiles->num_commands; ++i) {
+        const SDL_Rect *bounds = &tiles->commands[i].bounds;
+        int x, y;
+        if (SDL_RectEmpty(bounds)) {
+            continue;
+        }
+        for (y = bounds->y / SW_TILE_HEIGHT; y <= (bounds->y + bounds->h - 1) / SW_TILE_HEIGHT; ++y) {
+            for (x = bounds->x / SW_TILE_WIDTH; x <= (bounds->x + bounds->w - 1) / SW_TILE_WIDTH; ++x) {
+                tiles->bin_fill[y * tiles_x + x]++;
+            }
+        }
+    }
+    for (t = 0; t < num_tiles; ++t) {
+        tiles->bin_start[t] = total;
+        total += tiles->bin_fill[t];
+        tiles->bin_fill[t] = tiles->bin_start[t];
+    }
+    tiles->bin_start[num_tiles] = total;
+
+    if (total > tiles->max_bins) {
+        int *bins = (int *) SDL_realloc(tiles->bins, total * sizeof (int));
+        if (!bins) {
+            return SDL_OutOfMemory();
+        }
+        tiles->bins = bins;
+        tiles->max_bins = total;
+    }
+
+    for (i = 0; i < tiles->num_commands; ++i) {
+        const SDL_Rect *bounds = &tiles->commands[i].bounds;
+        int x, y;
+        if (SDL_RectEmpty(bounds)) {
+            continue;
+        }
+        for (y = bounds->y / SW_TILE_HEIGHT; y <= (bounds->y + bounds->h - 1) / SW_TILE_HEIGHT; ++y) {
+            for (x = bounds->x / SW_TILE_WIDTH; x <= (bounds->x + bounds->w - 1) / SW_TILE_WIDTH; ++x) {
+                tiles->bins[tiles->bin_fill[y * tiles_x + x]++] = i;
+            }
+        }
+    }
+    return 0;
+}
+
+static int
+SW_FlushTiles(SW_TileState *tiles, SDL_Surface *surface)
+{
+    int retval = 0;
+
+    if (tiles->num_commands == 0) {
+        return 0;
+    }
+
+    if (SW_PrepareTileWorkers(tiles, surface) < 0 || SW_BinTileCommands(tiles, surface) < 0) {
+        retval = -1;
+    } else {
+        SDL_AtomicSet(&tiles->next_tile, 0);
+        SDL_RunThreadPool(tiles->pool, SW_RasterizeTiles, tiles);
+    }
+
+    tiles->num_commands = 0;
+    return retval;
+}
+
+static int
+SW_RunCommandQueueTiled(SDL_Renderer * renderer, SDL_Surface *surface, SDL_RenderCommand *cmd, void *vertices)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    SW_TileState *tiles = data->tiles;
+    SW_DrawStateCache drawstate;
+
+    drawstate.viewport = NULL;
+    drawstate.cliprect = NULL;
+    drawstate.surface_cliprect_dirty = SDL_TRUE;
+
+    while (cmd) {
+        SW_TileCommand *tcmd;
+
+        if (tiles->num_commands >= tiles->max_commands) {
+            const int newmax = tiles->max_commands ? tiles->max_commands * 2 : 128;
+            SW_TileCommand *ptr = (SW_TileCommand *) SDL_realloc(tiles->commands, newmax * sizeof (SW_TileCommand));
+            if (!ptr) {
+                tiles->num_commands = 0;
+                return SDL_OutOfMemory();
+            }
+            tiles->commands = ptr;
+            tiles->max_commands = newmax;
+        }
+
+        tcmd = &tiles->commands[tiles->num_commands];
+        if (SW_PrepareTileCommand(surface, &drawstate, cmd, vertices, tcmd)) {
+            tiles->num_commands++;
+        } else {
+            /* State changes just update drawstate; everything else must see
+               the pixels of the commands before it, so draw those first. */
+            if (cmd->command != SDL_RENDERCMD_SETVIEWPORT &&
+                cmd->command != SDL_RENDERCMD_SETCLIPRECT &&
+                cmd->command != SDL_RENDERCMD_SETDRAWCOLOR &&
+                cmd->command != SDL_RENDERCMD_NO_OP) {
+                if (SW_FlushTiles(tiles, surface) < 0) {
+                    return -1;
+                }
+            }
+            SW_RunCommand(renderer, surface, &drawstate, cmd, vertices);
+        }
+
+        cmd = cmd->next;
+    }
+
+    return SW_FlushTiles(tiles, surface);
+}
+
+static int
+SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    SDL_Surface *surface = SW_ActivateRenderer(renderer);
+    SW_DrawStateCache drawstate;
+
+    if (!surface) {
+        return -1;
+    }
+
+    /* Worker views share the target's pixels, which rules out surfaces that
+       need locking; palettized targets aren't worth the trouble. */
+    if (data->tiles && !SDL_MUSTLOCK(surface) && !surface->format->palette) {
+        return SW_RunCommandQueueTiled(renderer, surface, cmd, vertices);
+    }
+
+    drawstate.viewport = NULL;
+    drawstate.cliprect = NULL;
+    drawstate.surface_cliprect_dirty = SDL_TRUE;
+
+    while (cmd) {
+        SW_RunCommand(renderer, surface, &drawstate, cmd, vertices);
         cmd = cmd->next;
     }
 
@@ -794,11 +1277,68 @@ SW_DestroyTexture(SDL_Renderer * renderer, SDL_Texture * texture)
     SDL_FreeSurface(surface);
 }
 
+static void
+SW_DestroyTileState(SW_TileState *tiles)
+{
+    int i;
+
+    if (!tiles) {
+        return;
+    }
+
+    if (tiles->workers) {
+        for (i = 0; i < SDL_GetThreadPoolWorkers(tiles->pool); ++i) {
+            if (tiles->workers[i].dst) {
+                SDL_FreeSurface(tiles->workers[i].dst);
+            }
+            if (tiles->workers[i].src) {
+                SDL_FreeSurface(tiles->workers[i].src);
+            }
+        }
+        SDL_free(tiles->workers);
+    }
+    SDL_DestroyThreadPool(tiles->pool);
+    SDL_free(tiles->commands);
+    SDL_free(tiles->bins);
+    SDL_free(tiles->bin_start);
+    SDL_free(tiles->bin_fill);
+    SDL_free(tiles);
+}
+
+static SW_TileState *
+SW_CreateTileState(int num_threads)
+{
+    SW_TileState *tiles = (SW_TileState *) SDL_calloc(1, sizeof(*tiles));
+
+    if (!tiles) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    tiles->pool = SDL_CreateThreadPool("SDLRenderSW", num_threads);
+    if (!tiles->pool) {
+        SW_DestroyTileState(tiles);
+        return NULL;
+    }
+
+    tiles->workers = (SW_TileWorker *) SDL_calloc(SDL_GetThreadPoolWorkers(tiles->pool), sizeof(SW_TileWorker));
+    if (!tiles->workers) {
+        SW_DestroyTileState(tiles);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    return tiles;
+}
+
 static void
 SW_DestroyRenderer(SDL_Renderer * renderer)
 {
     SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
 
+    if (data) {
+        SW_DestroyTileState(data->tiles);
+        SDL_FreeBlitScaledScratch(&data->scratch);
+    }
     SDL_free(data);
     SDL_free(renderer);
 }
@@ -808,6 +1348,7 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
 {
     SDL_Renderer *renderer;
     SW_RenderData *data;
+    const char *hint;
 
     if (!surface) {
         SDL_SetError("Can't create renderer for NULL surface");
@@ -829,6 +1370,15 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
     data->surface = surface;
     data->window = surface;
 
+    hint = SDL_GetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+    if (hint) {
+        const int num_threads = SDL_atoi(hint);
+        if (num_threads > 1) {
+            /* If the threads can't be created, just render on this one. */
+            data->tiles = SW_CreateTileState(num_threads);
+        }
+    }
+
     renderer->WindowEvent = SW_WindowEvent;
     renderer->GetOutputSize = SW_GetOutputSize;
     renderer->CreateTexture = SW_CreateTexture;
@@ -843,8 +1393,10 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
     renderer->QueueDrawLines = SW_QueueDrawPoints;  /* lines and points queue vertices the same way. */
     renderer->QueueFillRects = SW_QueueFillRects;
     renderer->QueueCopy = SW_QueueCopy;
+    renderer->QueueCopies = SW_QueueCopies;
     renderer->QueueCopyEx = SW_QueueCopyEx;
     renderer->RunCommandQueue = SW_RunCommandQueue;
+    renderer->merge_copies = SDL_TRUE;
     renderer->RenderReadPixels = SW_RenderReadPixels;
     renderer->RenderPresent = SW_RenderPresent;
     renderer->DestroyTexture = SW_DestroyTexture;
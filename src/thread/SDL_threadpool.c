@@ -0,0 +1,170 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#include "SDL_thread.h"
+#include "SDL_atomic.h"
+#include "SDL_threadpool_c.h"
+
+typedef struct SDL_ThreadPoolWorker
+{
+    SDL_ThreadPool *pool;
+    SDL_Thread *thread;
+    int index;
+} SDL_ThreadPoolWorker;
+
+struct SDL_ThreadPool
+{
+    int num_workers;                /* including the thread calling SDL_RunThreadPool */
+    SDL_ThreadPoolWorker *workers;  /* num_workers - 1 background threads */
+    SDL_sem *start;
+    SDL_sem *done;
+    SDL_atomic_t quit;
+    SDL_ThreadPoolTask task;
+    void *userdata;
+};
+
+static int SDLCALL
+SDL_ThreadPoolThread(void *data)
+{
+    SDL_ThreadPoolWorker *worker = (SDL_ThreadPoolWorker *) data;
+    SDL_ThreadPool *pool = worker->pool;
+
+    for (;;) {
+        SDL_SemWait(pool->start);
+        if (SDL_AtomicGet(&pool->quit)) {
+            break;
+        }
+        pool->task(pool->userdata, worker->index);
+        SDL_SemPost(pool->done);
+    }
+    return 0;
+}
+
+SDL_ThreadPool *
+SDL_CreateThreadPool(const char *name, int num_workers)
+{
+    SDL_ThreadPool *pool;
+    int i;
+
+    if (num_workers < 2) {
+        SDL_InvalidParamError("num_workers");
+        return NULL;
+    }
+
+    pool = (SDL_ThreadPool *) SDL_calloc(1, sizeof (*pool));
+    if (!pool) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    pool->workers = (SDL_ThreadPoolWorker *) SDL_calloc(num_workers - 1, sizeof (*pool->workers));
+    if (!pool->workers) {
+        SDL_free(pool);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    pool->start = SDL_CreateSemaphore(0);
+    pool->done = SDL_CreateSemaphore(0);
+    if (!pool->start || !pool->done) {
+        SDL_DestroyThreadPool(pool);
+        return NULL;
+    }
+
+    /* Worker 0 is whoever calls SDL_RunThreadPool(). */
+    pool->num_workers = 1;
+    for (i = 0; i < num_workers - 1; ++i) {
+        SDL_ThreadPoolWorker *worker = &pool->workers[i];
+        worker->pool = pool;
+        worker->index = i + 1;
+        worker->thread = SDL_CreateThread(SDL_ThreadPoolThread, name, worker);
+        if (!worker->thread) {
+            break;  /* run with what we got. */
+        }
+        pool->num_workers++;
+    }
+
+    if (pool->num_workers < 2) {
+        SDL_DestroyThreadPool(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+int
+SDL_GetThreadPoolWorkers(SDL_ThreadPool *pool)
+{
+    return pool ? pool->num_workers : 1;
+}
+
+void
+SDL_RunThreadPool(SDL_ThreadPool *pool, SDL_ThreadPoolTask task, void *userdata)
+{
+    int i;
+
+    if (!pool) {
+        task(userdata, 0);
+        return;
+    }
+
+    pool->task = task;
+    pool->userdata = userdata;
+    for (i = 1; i < pool->num_workers; ++i) {
+        SDL_SemPost(pool->start);
+    }
+
+    task(userdata, 0);
+
+    for (i = 1; i < pool->num_workers; ++i) {
+        SDL_SemWait(pool->done);
+    }
+    pool->task = NULL;
+    pool->userdata = NULL;
+}
+
+void
+SDL_DestroyThreadPool(SDL_ThreadPool *pool)
+{
+    int i;
+
+    if (!pool) {
+        return;
+    }
+
+    SDL_AtomicSet(&pool->quit, 1);
+    for (i = 1; i < pool->num_workers; ++i) {
+        SDL_SemPost(pool->start);
+    }
+    for (i = 1; i < pool->num_workers; ++i) {
+        SDL_WaitThread(pool->workers[i - 1].thread, NULL);
+    }
+
+    if (pool->start) {
+        SDL_DestroySemaphore(pool->start);
+    }
+    if (pool->done) {
+        SDL_DestroySemaphore(pool->done);
+    }
+    SDL_free(pool->workers);
+    SDL_free(pool);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
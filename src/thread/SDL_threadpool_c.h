@@ -0,0 +1,48 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#ifndef SDL_threadpool_c_h_
+#define SDL_threadpool_c_h_
+
+/* A small pool of worker threads for splitting one job across several cores.
+
+   SDL_RunThreadPool() calls the task once on every worker, with the calling
+   thread acting as worker 0, and returns when all of them are done. Tasks are
+   expected to hand out work items from a shared SDL_atomic_t counter, so a
+   worker that starts late simply finds less to do.
+
+   The pool itself is not reentrant: only one thread may run it at a time. */
+
+struct SDL_ThreadPool;
+typedef struct SDL_ThreadPool SDL_ThreadPool;
+
+typedef void (*SDL_ThreadPoolTask)(void *userdata, int worker);
+
+/* Returns NULL (with the error set) if the threads can't be created. */
+extern SDL_ThreadPool *SDL_CreateThreadPool(const char *name, int num_workers);
+extern int SDL_GetThreadPoolWorkers(SDL_ThreadPool *pool);
+extern void SDL_RunThreadPool(SDL_ThreadPool *pool, SDL_ThreadPoolTask task, void *userdata);
+extern void SDL_DestroyThreadPool(SDL_ThreadPool *pool);
+
+#endif /* SDL_threadpool_c_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -28,13 +28,23 @@
 
 /* #define DEBUG_TIMERS */
 
+#define SDL_NS_PER_SECOND   1000000000
+#define SDL_NS_PER_MS       1000000
+
+/* How long before a deadline the timer thread stops waiting on its semaphore
+   and sleeps precisely until the deadline instead */
+#define SDL_TIMER_PRECISE_NS    (2 * SDL_NS_PER_MS)
+
 typedef struct _SDL_Timer
 {
     int timerID;
     SDL_TimerCallback callback;
+    SDL_NSTimerCallback callback_ns;
     void *param;
     Uint32 interval;
-    Uint32 scheduled;
+    Uint64 interval_ns;
+    Uint64 scheduled;
+    Uint32 order;
     SDL_atomic_t canceled;
     struct _SDL_Timer *next;
 } SDL_Timer;
@@ -46,12 +56,18 @@ typedef struct _SDL_TimerMap
     struct _SDL_TimerMap *next;
 } SDL_TimerMap;
 
-/* The timers are kept in a sorted list */
+/* The number of timer map buckets, grown as needed, must be a power of 2 */
+#define SDL_TIMERMAP_MIN_SIZE   64
+
+/* The timers are kept in a binary min-heap ordered by scheduling time */
 typedef struct {
     /* Data used by the main thread */
     SDL_Thread *thread;
+    Uint64 frequency;
     SDL_atomic_t nextID;
-    SDL_TimerMap *timermap;
+    SDL_TimerMap **timermap;
+    int timermap_size;
+    int timermap_count;
     SDL_mutex *timermap_lock;
 
     /* Padding to separate cache lines between threads */
@@ -64,8 +80,11 @@ typedef struct {
     SDL_Timer *freelist;
     SDL_atomic_t active;
 
-    /* List of timers - this is only touched by the timer thread */
-    SDL_Timer *timers;
+    /* Heap of timers - this is only touched by the timer thread */
+    SDL_Timer **timers;
+    int num_timers;
+    int max_timers;
+    Uint32 next_order;
 } SDL_TimerData;
 
 static SDL_TimerData SDL_timer_data;
@@ -76,25 +95,141 @@ static SDL_TimerData SDL_timer_data;
  * Timers are removed by simply setting a canceled flag
  */
 
-static void
+/* Timers are scheduled in nanoseconds on the performance counter timeline */
+static Uint64
+SDL_GetTimerNS(const SDL_TimerData *data)
+{
+    const Uint64 counter = SDL_GetPerformanceCounter();
+    return (counter / data->frequency) * SDL_NS_PER_SECOND +
+           ((counter % data->frequency) * SDL_NS_PER_SECOND) / data->frequency;
+}
+
+static Uint64
+SDL_TimerNSToCounter(const SDL_TimerData *data, Uint64 ns)
+{
+    return (ns / SDL_NS_PER_SECOND) * data->frequency +
+           ((ns % SDL_NS_PER_SECOND) * data->frequency) / SDL_NS_PER_SECOND;
+}
+
+/* Timers scheduled for the same time run in the order they were queued */
+static SDL_INLINE SDL_bool
+SDL_TimerBefore(const SDL_Timer *a, const SDL_Timer *b)
+{
+    if (a->scheduled != b->scheduled) {
+        return (a->scheduled < b->scheduled);
+    }
+    return ((Sint32)(a->order - b->order) < 0);
+}
+
+static SDL_bool
 SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
 {
-    SDL_Timer *prev, *curr;
+    int i;
 
-    prev = NULL;
-    for (curr = data->timers; curr; prev = curr, curr = curr->next) {
-        if ((Sint32)(timer->scheduled-curr->scheduled) < 0) {
+    if (data->num_timers == data->max_timers) {
+        const int max_timers = data->max_timers ? (data->max_timers * 2) : 64;
+        SDL_Timer **timers = (SDL_Timer **)SDL_realloc(data->timers, max_timers * sizeof(*timers));
+        if (!timers) {
+            return SDL_FALSE;
+        }
+        data->timers = timers;
+        data->max_timers = max_timers;
+    }
+
+    timer->order = data->next_order++;
+
+    /* Sift up from the bottom of the heap */
+    for (i = data->num_timers++; i > 0; ) {
+        const int parent = (i - 1) / 2;
+        if (!SDL_TimerBefore(timer, data->timers[parent])) {
             break;
         }
+        data->timers[i] = data->timers[parent];
+        i = parent;
     }
+    data->timers[i] = timer;
+    return SDL_TRUE;
+}
 
-    /* Insert the timer here! */
-    if (prev) {
-        prev->next = timer;
-    } else {
-        data->timers = timer;
+static SDL_Timer *
+SDL_RemoveFirstTimer(SDL_TimerData *data)
+{
+    SDL_Timer *first = data->timers[0];
+    SDL_Timer *last = data->timers[--data->num_timers];
+    const int count = data->num_timers;
+    int i = 0;
+
+    /* Sift the last timer down from the top of the heap */
+    for ( ; ; ) {
+        int child = (2 * i) + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && SDL_TimerBefore(data->timers[child + 1], data->timers[child])) {
+            ++child;
+        }
+        if (!SDL_TimerBefore(data->timers[child], last)) {
+            break;
+        }
+        data->timers[i] = data->timers[child];
+        i = child;
     }
-    timer->next = curr;
+    if (count > 0) {
+        data->timers[i] = last;
+    }
+    return first;
+}
+
+/* Timer map functions -- called with the timer map locked */
+static SDL_bool
+SDL_GrowTimerMap(SDL_TimerData *data)
+{
+    const int size = data->timermap_size ? (data->timermap_size * 2) : SDL_TIMERMAP_MIN_SIZE;
+    SDL_TimerMap **timermap = (SDL_TimerMap **)SDL_calloc(size, sizeof(*timermap));
+    int i;
+
+    if (!timermap) {
+        return SDL_FALSE;
+    }
+
+    for (i = 0; i < data->timermap_size; ++i) {
+        SDL_TimerMap *entry = data->timermap[i];
+        while (entry) {
+            SDL_TimerMap *next = entry->next;
+            const int bucket = entry->timerID & (size - 1);
+            entry->next = timermap[bucket];
+            timermap[bucket] = entry;
+            entry = next;
+        }
+    }
+    SDL_free(data->timermap);
+    data->timermap = timermap;
+    data->timermap_size = size;
+    return SDL_TRUE;
+}
+
+static SDL_TimerMap *
+SDL_RemoveTimerMapEntry(SDL_TimerData *data, int timerID)
+{
+    SDL_TimerMap *prev, *entry;
+
+    if (!data->timermap) {
+        return NULL;
+    }
+
+    prev = NULL;
+    for (entry = data->timermap[timerID & (data->timermap_size - 1)]; entry; prev = entry, entry = entry->next) {
+        if (entry->timerID == timerID) {
+            if (prev) {
+                prev->next = entry->next;
+            } else {
+                data->timermap[timerID & (data->timermap_size - 1)] = entry->next;
+            }
+            --data->timermap_count;
+            break;
+        }
+    }
+    return entry;
 }
 
 static int SDLCALL
@@ -105,7 +240,9 @@ SDL_TimerThread(void *_data)
     SDL_Timer *current;
     SDL_Timer *freelist_head = NULL;
     SDL_Timer *freelist_tail = NULL;
-    Uint32 tick, now, interval, delay;
+    Uint64 tick, now, deadline;
+    Uint32 delay;
+    SDL_bool reschedule;
 
     /* Threaded timer loop:
      *  1. Queue timers added by other threads
@@ -128,48 +265,86 @@ SDL_TimerThread(void *_data)
         }
         SDL_AtomicUnlock(&data->lock);
 
-        /* Sort the pending timers into our list */
+        freelist_head = NULL;
+        freelist_tail = NULL;
+
+        /* Timers are added to the front of the pending list, so reverse it
+           to hand them to the heap in the order they were added */
+        if (pending) {
+            SDL_Timer *reversed = NULL;
+            while (pending) {
+                current = pending;
+                pending = pending->next;
+                current->next = reversed;
+                reversed = current;
+            }
+            pending = reversed;
+        }
+
+        /* Sort the pending timers into our heap */
         while (pending) {
             current = pending;
             pending = pending->next;
-            SDL_AddTimerInternal(data, current);
+            if (!SDL_AddTimerInternal(data, current)) {
+                /* Out of memory, the best we can do is drop the timer */
+                SDL_AtomicSet(&current->canceled, 1);
+                current->next = freelist_head;
+                freelist_head = current;
+                if (!freelist_tail) {
+                    freelist_tail = current;
+                }
+            }
         }
-        freelist_head = NULL;
-        freelist_tail = NULL;
 
         /* Check to see if we're still running, after maintenance */
         if (!SDL_AtomicGet(&data->active)) {
             break;
         }
 
-        /* Initial delay if there are no timers */
-        delay = SDL_MUTEX_MAXWAIT;
+        /* No deadline if there are no timers */
+        deadline = 0;
 
-        tick = SDL_GetTicks();
+        tick = SDL_GetTimerNS(data);
 
         /* Process all the pending timers for this tick */
-        while (data->timers) {
-            current = data->timers;
+        while (data->num_timers > 0) {
+            current = data->timers[0];
 
-            if ((Sint32)(tick-current->scheduled) < 0) {
+            if (current->scheduled > tick) {
                 /* Scheduled for the future, wait a bit */
-                delay = (current->scheduled - tick);
+                deadline = current->scheduled;
                 break;
             }
 
             /* We're going to do something with this timer */
-            data->timers = current->next;
+            SDL_RemoveFirstTimer(data);
 
+            reschedule = SDL_FALSE;
             if (SDL_AtomicGet(&current->canceled)) {
-                interval = 0;
+                /* Nothing to do */
+            } else if (current->callback_ns) {
+                const Uint64 interval = current->callback_ns(current->interval_ns, current->param);
+                if (interval > 0) {
+                    /* Keep to the original schedule, skipping any periods
+                       we've missed entirely rather than running them late */
+                    current->interval_ns = interval;
+                    current->scheduled += interval;
+                    if (current->scheduled <= tick) {
+                        current->scheduled += ((tick - current->scheduled) / interval + 1) * interval;
+                    }
+                    reschedule = SDL_TRUE;
+                }
             } else {
-                interval = current->callback(current->interval, current->param);
+                const Uint32 interval = current->callback(current->interval, current->param);
+                if (interval > 0) {
+                    current->interval = interval;
+                    current->scheduled = tick + (Uint64)interval * SDL_NS_PER_MS;
+                    reschedule = SDL_TRUE;
+                }
             }
 
-            if (interval > 0) {
-                /* Reschedule this timer */
-                current->interval = interval;
-                current->scheduled = tick + interval;
+            if (reschedule) {
+                /* Reschedule this timer, there's always room for it */
                 SDL_AddTimerInternal(data, current);
             } else {
                 if (!freelist_head) {
@@ -184,21 +359,40 @@ SDL_TimerThread(void *_data)
             }
         }
 
-        /* Adjust the delay based on processing time */
-        now = SDL_GetTicks();
-        interval = (now - tick);
-        if (interval > delay) {
-            delay = 0;
-        } else {
-            delay -= interval;
-        }
-
         /* Note that each time a timer is added, this will return
            immediately, but we process the timers added all at once.
            That's okay, it just means we run through the loop a few
            extra times.
          */
-        SDL_SemWaitTimeout(data->sem, delay);
+        if (!deadline) {
+            SDL_SemWaitTimeout(data->sem, SDL_MUTEX_MAXWAIT);
+            continue;
+        }
+
+        /* Adjust the delay based on processing time */
+        now = SDL_GetTimerNS(data);
+        if (now >= deadline) {
+            continue;
+        }
+
+        if ((deadline - now) > SDL_TIMER_PRECISE_NS) {
+            /* Wait on the semaphore until we're close to the deadline */
+            delay = (Uint32)((deadline - now - SDL_TIMER_PRECISE_NS) / SDL_NS_PER_MS);
+            if (delay > 0) {
+                SDL_SemWaitTimeout(data->sem, delay);
+                continue;
+            }
+        }
+
+        /* Sleep right up to the deadline if the platform supports it, a
+           timer added meanwhile has to wait, but only briefly. */
+        if (SDL_SemTryWait(data->sem) == 0) {
+            continue;
+        }
+        if (!SDL_DelayUntilCounter(SDL_TimerNSToCounter(data, deadline))) {
+            delay = (Uint32)((deadline - now + SDL_NS_PER_MS - 1) / SDL_NS_PER_MS);
+            SDL_SemWaitTimeout(data->sem, delay);
+        }
     }
     return 0;
 }
@@ -221,6 +415,8 @@ SDL_TimerInit(void)
             return -1;
         }
 
+        data->frequency = SDL_GetPerformanceFrequency();
+
         SDL_AtomicSet(&data->active, 1);
 
         /* Timer threads use a callback into the app, so we can't set a limited stack size here. */
@@ -241,6 +437,7 @@ SDL_TimerQuit(void)
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
     SDL_TimerMap *entry;
+    int i;
 
     if (SDL_AtomicCAS(&data->active, 1, 0)) {  /* active? Move to inactive. */
         /* Shutdown the timer thread */
@@ -254,29 +451,38 @@ SDL_TimerQuit(void)
         data->sem = NULL;
 
         /* Clean up the timer entries */
-        while (data->timers) {
-            timer = data->timers;
-            data->timers = timer->next;
-            SDL_free(timer);
+        for (i = 0; i < data->num_timers; ++i) {
+            SDL_free(data->timers[i]);
         }
+        SDL_free(data->timers);
+        data->timers = NULL;
+        data->num_timers = 0;
+        data->max_timers = 0;
         while (data->freelist) {
             timer = data->freelist;
             data->freelist = timer->next;
             SDL_free(timer);
         }
-        while (data->timermap) {
-            entry = data->timermap;
-            data->timermap = entry->next;
-            SDL_free(entry);
+        for (i = 0; i < data->timermap_size; ++i) {
+            while (data->timermap[i]) {
+                entry = data->timermap[i];
+                data->timermap[i] = entry->next;
+                SDL_free(entry);
+            }
         }
+        SDL_free(data->timermap);
+        data->timermap = NULL;
+        data->timermap_size = 0;
+        data->timermap_count = 0;
 
         SDL_DestroyMutex(data->timermap_lock);
         data->timermap_lock = NULL;
     }
 }
 
-SDL_TimerID
-SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
+static SDL_TimerID
+SDL_CreateTimer(Uint32 interval, SDL_TimerCallback callback,
+                Uint64 interval_ns, SDL_NSTimerCallback callback_ns, void *param)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
@@ -307,9 +513,15 @@ SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
     }
     timer->timerID = SDL_AtomicIncRef(&data->nextID);
     timer->callback = callback;
+    timer->callback_ns = callback_ns;
     timer->param = param;
     timer->interval = interval;
-    timer->scheduled = SDL_GetTicks() + interval;
+    timer->interval_ns = interval_ns;
+    if (callback_ns) {
+        timer->scheduled = SDL_GetTimerNS(data) + interval_ns;
+    } else {
+        timer->scheduled = SDL_GetTimerNS(data) + (Uint64)interval * SDL_NS_PER_MS;
+    }
     SDL_AtomicSet(&timer->canceled, 0);
 
     entry = (SDL_TimerMap *)SDL_malloc(sizeof(*entry));
@@ -322,8 +534,16 @@ SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
     entry->timerID = timer->timerID;
 
     SDL_LockMutex(data->timermap_lock);
-    entry->next = data->timermap;
-    data->timermap = entry;
+    if (data->timermap_count >= data->timermap_size && !SDL_GrowTimerMap(data)) {
+        SDL_UnlockMutex(data->timermap_lock);
+        SDL_free(entry);
+        SDL_free(timer);
+        SDL_OutOfMemory();
+        return 0;
+    }
+    entry->next = data->timermap[entry->timerID & (data->timermap_size - 1)];
+    data->timermap[entry->timerID & (data->timermap_size - 1)] = entry;
+    ++data->timermap_count;
     SDL_UnlockMutex(data->timermap_lock);
 
     /* Add the timer to the pending list for the timer thread */
@@ -338,26 +558,28 @@ SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
     return entry->timerID;
 }
 
+SDL_TimerID
+SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
+{
+    return SDL_CreateTimer(interval, callback, 0, NULL, param);
+}
+
+SDL_TimerID
+SDL_AddTimerNS(Uint64 interval, SDL_NSTimerCallback callback, void *param)
+{
+    return SDL_CreateTimer(0, NULL, interval, callback, param);
+}
+
 SDL_bool
 SDL_RemoveTimer(SDL_TimerID id)
 {
     SDL_TimerData *data = &SDL_timer_data;
-    SDL_TimerMap *prev, *entry;
+    SDL_TimerMap *entry;
     SDL_bool canceled = SDL_FALSE;
 
     /* Find the timer */
     SDL_LockMutex(data->timermap_lock);
-    prev = NULL;
-    for (entry = data->timermap; entry; prev = entry, entry = entry->next) {
-        if (entry->timerID == id) {
-            if (prev) {
-                prev->next = entry->next;
-            } else {
-                data->timermap = entry->next;
-            }
-            break;
-        }
-    }
+    entry = SDL_RemoveTimerMapEntry(data, id);
     SDL_UnlockMutex(data->timermap_lock);
 
     if (entry) {
@@ -32,6 +32,11 @@
 
 extern void SDL_TicksInit(void);
 extern void SDL_TicksQuit(void);
+
+/* Sleep until SDL_GetPerformanceCounter() reaches the given value, more
+   precisely than SDL_Delay() can. Returns SDL_FALSE if that isn't supported
+   and the caller needs to wait some other way. */
+extern SDL_bool SDL_DelayUntilCounter(Uint64 counter);
 extern int SDL_TimerInit(void);
 extern void SDL_TimerQuit(void);
 
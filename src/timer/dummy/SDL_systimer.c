@@ -70,6 +70,12 @@ SDL_Delay(Uint32 ms)
     SDL_Unsupported();
 }
 
+SDL_bool
+SDL_DelayUntilCounter(Uint64 counter)
+{
+    return SDL_FALSE;
+}
+
 #endif /* SDL_TIMER_DUMMY || SDL_TIMERS_DISABLED */
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -75,6 +75,12 @@ SDL_Delay(Uint32 ms)
     snooze(ms * 1000);
 }
 
+SDL_bool
+SDL_DelayUntilCounter(Uint64 counter)
+{
+    return SDL_FALSE;
+}
+
 #endif /* SDL_TIMER_HAIKU */
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -99,5 +99,11 @@ SDL_Delay(Uint32 ms)
     sys_timer_usleep(ms * 1000);
 }
 
+SDL_bool
+SDL_DelayUntilCounter(Uint64 counter)
+{
+    return SDL_FALSE;
+}
+
 #endif /* SDL_TIMER_PS3 */
 /* vi: set ts=4 sw=4 expandtab: */
@@ -85,6 +85,12 @@ void SDL_Delay(Uint32 ms)
     sceKernelDelayThreadCB(ms * 1000);
 }
 
+SDL_bool
+SDL_DelayUntilCounter(Uint64 counter)
+{
+    return SDL_FALSE;
+}
+
 #endif /* SDL_TIMERS_PSP */
 
 /* vim: ts=4 sw=4
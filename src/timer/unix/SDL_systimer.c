@@ -226,6 +226,50 @@ SDL_Delay(Uint32 ms)
     } while (was_error && (errno == EINTR));
 }
 
+SDL_bool
+SDL_DelayUntilCounter(Uint64 counter)
+{
+#if HAVE_CLOCK_GETTIME && defined(__LINUX__) && defined(TIMER_ABSTIME)
+    struct timespec deadline;
+    Uint64 now, delta;
+    int result;
+
+    if (!ticks_started) {
+        SDL_TicksInit();
+    }
+    if (!has_monotonic_time) {
+        return SDL_FALSE;
+    }
+
+    /* The counter may be CLOCK_MONOTONIC_RAW, which clock_nanosleep() won't
+       accept, so move the deadline over to CLOCK_MONOTONIC. Both tick at the
+       same rate over the short waits this is used for. */
+    now = SDL_GetPerformanceCounter();
+    if (counter <= now) {
+        return SDL_TRUE;
+    }
+    delta = counter - now;
+    if (clock_gettime(CLOCK_MONOTONIC, &deadline) != 0) {
+        return SDL_FALSE;
+    }
+    deadline.tv_sec += (time_t)(delta / 1000000000);
+    deadline.tv_nsec += (long)(delta % 1000000000);
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_nsec -= 1000000000;
+        ++deadline.tv_sec;
+    }
+
+    /* The deadline is absolute, so there's nothing to fix up after EINTR */
+    do {
+        result = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+    } while (result == EINTR);
+
+    return (result == 0);
+#else
+    return SDL_FALSE;
+#endif
+}
+
 #endif /* SDL_TIMER_UNIX */
 
 /* vi: set ts=4 sw=4 expandtab: */
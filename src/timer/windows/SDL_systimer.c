@@ -195,6 +195,12 @@ SDL_Delay(Uint32 ms)
 #endif
 }
 
+SDL_bool
+SDL_DelayUntilCounter(Uint64 counter)
+{
+    return SDL_FALSE;
+}
+
 #endif /* SDL_TIMER_WINDOWS */
 
 /* vi: set ts=4 sw=4 expandtab: */
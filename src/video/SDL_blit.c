@@ -20,6 +20,7 @@
 */
 #include "../SDL_internal.h"
 
+#include "SDL_mutex.h"
 #include "SDL_video.h"
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
@@ -28,11 +29,150 @@
 #include "SDL_blit_slow.h"
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
+#include "SDL_hints.h"
+#include "../thread/SDL_threadpool_c.h"
+
+/* Conversions of at least this many pixels are split into row bands when
+   SDL_HINT_VIDEO_CONVERT_THREADS asks for more than one thread. */
+#define SDL_ROW_BANDS_MIN_PIXELS    (256 * 256)
+#define SDL_ROW_BANDS_PER_WORKER    4
+
+static SDL_ThreadPool *SDL_row_bands_pool = NULL;
+static int SDL_row_bands_threads = 0;
+static SDL_mutex *SDL_row_bands_lock = NULL;
+
+typedef struct
+{
+    SDL_RowBandFunc func;
+    void *userdata;
+    int height;
+    int band_rows;
+    int num_bands;
+    SDL_atomic_t next_band;
+} SDL_RowBands;
+
+static void
+SDL_RunRowBandsTask(void *data, int worker)
+{
+    SDL_RowBands *bands = (SDL_RowBands *) data;
+    int band;
+
+    while ((band = SDL_AtomicAdd(&bands->next_band, 1)) < bands->num_bands) {
+        const int row = band * bands->band_rows;
+        bands->func(bands->userdata, row, SDL_min(bands->band_rows, bands->height - row));
+    }
+}
+
+/* Conversions can start on any thread before or without SDL_Init(), so the
+   lock is made by whichever one gets here first. */
+static SDL_mutex *
+SDL_GetRowBandsLock(void)
+{
+    SDL_mutex *lock = (SDL_mutex *) SDL_AtomicGetPtr((void **) &SDL_row_bands_lock);
+
+    if (!lock) {
+        lock = SDL_CreateMutex();
+        if (lock && !SDL_AtomicCASPtr((void **) &SDL_row_bands_lock, NULL, lock)) {
+            SDL_DestroyMutex(lock);
+            lock = (SDL_mutex *) SDL_AtomicGetPtr((void **) &SDL_row_bands_lock);
+        }
+    }
+    return lock;
+}
+
+void
+SDL_RunRowBands(int width, int height, int row_align, SDL_RowBandFunc func, void *userdata)
+{
+    SDL_RowBands bands;
+    SDL_mutex *lock;
+    const char *hint;
+    int num_threads;
+
+    if ((Sint64) width * height < SDL_ROW_BANDS_MIN_PIXELS) {
+        func(userdata, 0, height);
+        return;
+    }
+
+    /* The pool can only run one job at a time, so a conversion that finds
+       it busy, on another thread, just runs on the thread it was called on. */
+    lock = SDL_GetRowBandsLock();
+    if (!lock || SDL_TryLockMutex(lock) != 0) {
+        func(userdata, 0, height);
+        return;
+    }
+
+    hint = SDL_GetHint(SDL_HINT_VIDEO_CONVERT_THREADS);
+    num_threads = hint ? SDL_atoi(hint) : 0;
+    if (num_threads < 2) {
+        num_threads = 0;
+    }
+    if (num_threads != SDL_row_bands_threads) {
+        SDL_DestroyThreadPool(SDL_row_bands_pool);
+        SDL_row_bands_pool = NULL;
+        SDL_row_bands_threads = num_threads;
+        if (num_threads) {
+            /* If the threads can't be created, just convert on this one. */
+            SDL_row_bands_pool = SDL_CreateThreadPool("SDLConvert", num_threads);
+        }
+    }
+
+    if (!SDL_row_bands_pool) {
+        SDL_UnlockMutex(lock);
+        func(userdata, 0, height);
+        return;
+    }
+
+    bands.func = func;
+    bands.userdata = userdata;
+    bands.height = height;
+    bands.band_rows = height / (SDL_GetThreadPoolWorkers(SDL_row_bands_pool) * SDL_ROW_BANDS_PER_WORKER);
+    bands.band_rows = SDL_max(bands.band_rows, 1);
+    bands.band_rows = ((bands.band_rows + row_align - 1) / row_align) * row_align;
+    bands.num_bands = (height + bands.band_rows - 1) / bands.band_rows;
+    SDL_AtomicSet(&bands.next_band, 0);
+    SDL_RunThreadPool(SDL_row_bands_pool, SDL_RunRowBandsTask, &bands);
+
+    SDL_UnlockMutex(lock);
+}
+
+void
+SDL_QuitRowBands(void)
+{
+    SDL_mutex *lock = (SDL_mutex *) SDL_AtomicSetPtr((void **) &SDL_row_bands_lock, NULL);
+
+    if (lock) {
+        SDL_LockMutex(lock);
+        SDL_DestroyThreadPool(SDL_row_bands_pool);
+        SDL_row_bands_pool = NULL;
+        SDL_row_bands_threads = 0;
+        SDL_UnlockMutex(lock);
+        SDL_DestroyMutex(lock);
+    }
+}
+
+typedef struct
+{
+    SDL_BlitFunc blit;
+    const SDL_BlitInfo *info;
+} SDL_BlitRowBands;
+
+static void
+SDL_BlitRowBand(void *userdata, int row, int rows)
+{
+    const SDL_BlitRowBands *bands = (const SDL_BlitRowBands *) userdata;
+    SDL_BlitInfo info = *bands->info;
+
+    info.src += row * info.src_pitch;
+    info.dst += row * info.dst_pitch;
+    info.src_h = rows;
+    info.dst_h = rows;
+    bands->blit(&info);
+}
 
 /* The general purpose software blit routine */
-static int SDLCALL
-SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
-             SDL_Surface * dst, SDL_Rect * dstrect)
+static int
+SDL_SoftBlitRows(SDL_Surface * src, SDL_Rect * srcrect,
+                 SDL_Surface * dst, SDL_Rect * dstrect, SDL_bool threaded)
 {
     int okay;
     int src_locked;
@@ -85,7 +225,14 @@ SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
         RunBlit = (SDL_BlitFunc) src->map->data;
 
         /* Run the actual software blit */
-        RunBlit(info);
+        if (threaded && info->src_w == info->dst_w && info->src_h == info->dst_h) {
+            SDL_BlitRowBands bands;
+            bands.blit = RunBlit;
+            bands.info = info;
+            SDL_RunRowBands(info->dst_w, info->dst_h, 1, SDL_BlitRowBand, &bands);
+        } else {
+            RunBlit(info);
+        }
     }
 
     /* We need to unlock the surfaces if they're locked */
@@ -99,6 +246,23 @@ SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
     return (okay ? 0 : -1);
 }
 
+static int SDLCALL
+SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
+             SDL_Surface * dst, SDL_Rect * dstrect)
+{
+    return SDL_SoftBlitRows(src, srcrect, dst, dstrect, SDL_FALSE);
+}
+
+int
+SDL_ThreadedBlit(SDL_Surface * src, SDL_Rect * srcrect,
+                 SDL_Surface * dst, SDL_Rect * dstrect)
+{
+    if (src->map->blit == SDL_SoftBlit) {
+        return SDL_SoftBlitRows(src, srcrect, dst, dstrect, SDL_TRUE);
+    }
+    return src->map->blit(src, srcrect, dst, dstrect);
+}
+
 #if SDL_HAVE_BLIT_AUTO
 
 #ifdef __MACOSX__
@@ -126,44 +290,63 @@ SDL_UseAltivecPrefetch()
 }
 #endif /* __MACOSX__ */
 
-static SDL_BlitFunc
-SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
-                   SDL_BlitFuncEntry * entries)
+static int
+SDL_GetBlitCPUFeatures(void)
 {
-    int i, flagcheck = (flags & (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_COLORKEY | SDL_COPY_NEAREST));
-    static int features = 0x7fffffff;
+    static int cpu_features = 0x7fffffff;
+    const char *override;
+    int features;
 
     /* Get the available CPU features */
-    if (features == 0x7fffffff) {
-        const char *override = SDL_getenv("SDL_BLIT_CPU_FEATURES");
-
+    if (cpu_features == 0x7fffffff) {
         features = SDL_CPU_ANY;
-
-        /* Allow an override for testing .. */
-        if (override) {
-            SDL_sscanf(override, "%u", &features);
-        } else {
-            if (SDL_HasMMX()) {
-                features |= SDL_CPU_MMX;
-            }
-            if (SDL_Has3DNow()) {
-                features |= SDL_CPU_3DNOW;
-            }
-            if (SDL_HasSSE()) {
-                features |= SDL_CPU_SSE;
-            }
-            if (SDL_HasSSE2()) {
-                features |= SDL_CPU_SSE2;
-            }
-            if (SDL_HasAltiVec()) {
-                if (SDL_UseAltivecPrefetch()) {
-                    features |= SDL_CPU_ALTIVEC_PREFETCH;
-                } else {
-                    features |= SDL_CPU_ALTIVEC_NOPREFETCH;
-                }
+        if (SDL_HasMMX()) {
+            features |= SDL_CPU_MMX;
+        }
+        if (SDL_Has3DNow()) {
+            features |= SDL_CPU_3DNOW;
+        }
+        if (SDL_HasSSE()) {
+            features |= SDL_CPU_SSE;
+        }
+        if (SDL_HasSSE2()) {
+            features |= SDL_CPU_SSE2;
+        }
+        if (SDL_HasSSE41()) {
+            features |= SDL_CPU_SSE41;
+        }
+        if (SDL_HasAVX2()) {
+            features |= SDL_CPU_AVX2;
+        }
+        if (SDL_HasAltiVec()) {
+            if (SDL_UseAltivecPrefetch()) {
+                features |= SDL_CPU_ALTIVEC_PREFETCH;
+            } else {
+                features |= SDL_CPU_ALTIVEC_NOPREFETCH;
             }
         }
+        cpu_features = features;
+    }
+
+    /* Allow an override for testing, either from the environment or as a
+       hint, so tests can switch between blitters at runtime. An empty
+       value goes back to the detected features.
+     */
+    override = SDL_GetHint("SDL_BLIT_CPU_FEATURES");
+    if (override && *override) {
+        features = SDL_CPU_ANY;
+        SDL_sscanf(override, "%u", &features);
+        return features;
     }
+    return cpu_features;
+}
+
+static SDL_BlitFunc
+SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
+                   SDL_BlitFuncEntry * entries)
+{
+    int i, flagcheck = (flags & (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_COLORKEY | SDL_COPY_NEAREST));
+    const int features = SDL_GetBlitCPUFeatures();
 
     for (i = 0; entries[i].func; ++i) {
         /* Check for matching pixel formats */
@@ -178,6 +361,9 @@ SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
         if ((flagcheck & entries[i].flags) != flagcheck) {
             continue;
         }
+        if (entries[i].required && !(flagcheck & entries[i].required)) {
+            continue;
+        }
 
         /* Check CPU features */
         if ((entries[i].cpu & features) != entries[i].cpu) {
@@ -26,6 +26,7 @@
 #include "SDL_cpuinfo.h"
 #include "SDL_endian.h"
 #include "SDL_surface.h"
+#include "SDL_render.h"
 
 /* Table to do pixel byte expansion */
 extern Uint8* SDL_expand_byte[9];
@@ -52,6 +53,8 @@ extern Uint8* SDL_expand_byte[9];
 #define SDL_CPU_SSE2                0x00000008
 #define SDL_CPU_ALTIVEC_PREFETCH    0x00000010
 #define SDL_CPU_ALTIVEC_NOPREFETCH  0x00000020
+#define SDL_CPU_SSE41               0x00000040
+#define SDL_CPU_AVX2                0x00000080
 
 typedef struct
 {
@@ -79,6 +82,7 @@ typedef struct
     Uint32 src_format;
     Uint32 dst_format;
     int flags;
+    int required;   /* if non-zero, at least one of these flags must be set */
     int cpu;
     SDL_BlitFunc func;
 } SDL_BlitFuncEntry;
@@ -98,9 +102,44 @@ typedef struct SDL_BlitMap
     Uint32 src_palette_version;
 } SDL_BlitMap;
 
+/* Converts rows [row, row + rows) of a larger image */
+typedef void (*SDL_RowBandFunc) (void *userdata, int row, int rows);
+
 /* Functions found in SDL_blit.c */
 extern int SDL_CalculateBlit(SDL_Surface * surface);
 
+/* Runs func over all rows of a width x height image, split into bands that
+   start on a multiple of row_align and are converted on several threads if
+   SDL_HINT_VIDEO_CONVERT_THREADS is set.  Returns when every band is done. */
+extern void SDL_RunRowBands(int width, int height, int row_align, SDL_RowBandFunc func, void *userdata);
+extern void SDL_QuitRowBands(void);
+
+/* Like the surface's blit, with a software blit split into row bands.
+   The blit map must already be valid, as it is in SDL_LowerBlit(). */
+extern int SDL_ThreadedBlit(SDL_Surface * src, SDL_Rect * srcrect,
+                            SDL_Surface * dst, SDL_Rect * dstrect);
+
+/* Intermediate surfaces for filtered scaled blits that can't go straight to
+   the destination, kept by the caller and grown as needed between blits. */
+typedef struct SDL_BlitScaledScratch
+{
+    SDL_Surface *filtered;      /* source copied to ARGB8888 */
+    SDL_Surface *scaled;        /* filtered result, blitted to the destination */
+} SDL_BlitScaledScratch;
+
+/* Functions found in SDL_surface.c, SDL_BlitScaled() with a choice of filtering.
+   scratch may be NULL, in which case intermediate surfaces are freed after each blit. */
+extern int SDL_PrivateUpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
+                                      SDL_Surface * dst, SDL_Rect * dstrect, SDL_ScaleMode scaleMode,
+                                      SDL_BlitScaledScratch * scratch);
+extern int SDL_PrivateLowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
+                                      SDL_Surface * dst, SDL_Rect * dstrect, SDL_ScaleMode scaleMode,
+                                      SDL_BlitScaledScratch * scratch);
+extern void SDL_FreeBlitScaledScratch(SDL_BlitScaledScratch * scratch);
+
+/* Functions found in SDL_stretch.c */
+extern SDL_bool SDL_SoftStretchLinearSupported(Uint32 format);
+
 /* Functions found in SDL_blit_*.c */
 extern SDL_BlitFunc SDL_CalculateBlit0(SDL_Surface * surface);
 extern SDL_BlitFunc SDL_CalculateBlit1(SDL_Surface * surface);
@@ -7544,134 +7544,4682 @@ static void SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#if SDL_AVX2_INTRINSICS
+
+/* x / 255, rounded down, for 0 <= x <= 255 * 255 in each 16-bit lane */
+SDL_TARGETING("avx2")
+SDL_FORCE_INLINE __m256i SDL_Blit_Div255_AVX2(__m256i x)
+{
+    x = _mm256_add_epi16(x, _mm256_set1_epi16(1));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+/* Modulates pixels in destination channel order, with alpha in the top byte */
+SDL_TARGETING("avx2")
+SDL_FORCE_INLINE __m256i SDL_Blit_ModulatePixels_AVX2(__m256i s, __m256i modulate)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i lo = _mm256_unpacklo_epi8(s, zero);
+    __m256i hi = _mm256_unpackhi_epi8(s, zero);
+    lo = SDL_Blit_Div255_AVX2(_mm256_mullo_epi16(lo, modulate));
+    hi = SDL_Blit_Div255_AVX2(_mm256_mullo_epi16(hi, modulate));
+    return _mm256_packus_epi16(lo, hi);
+}
+
+/* Same math as the scalar blitters, for pixels in destination channel order */
+SDL_TARGETING("avx2")
+SDL_FORCE_INLINE __m256i SDL_Blit_BlendPixels_AVX2(__m256i s, __m256i d, int mode)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i full = _mm256_set1_epi16(255);
+    const __m256i alpha = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+    __m256i slo = _mm256_unpacklo_epi8(s, zero);
+    __m256i shi = _mm256_unpackhi_epi8(s, zero);
+    __m256i dlo = _mm256_unpacklo_epi8(d, zero);
+    __m256i dhi = _mm256_unpackhi_epi8(d, zero);
+    __m256i alo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(slo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    __m256i ahi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(shi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+    if (mode == SDL_COPY_MOD) {
+        dlo = SDL_Blit_Div255_AVX2(_mm256_mullo_epi16(slo, dlo));
+        dhi = SDL_Blit_Div255_AVX2(_mm256_mullo_epi16(shi, dhi));
+        return _mm256_blendv_epi8(_mm256_packus_epi16(dlo, dhi), d, alpha);
+    }
+
+    /* This goes away if we ever use premultiplied alpha */
+    slo = SDL_Blit_Div255_AVX2(_mm256_mullo_epi16(slo, _mm256_blend_epi16(alo, full, 0x88)));
+    shi = SDL_Blit_Div255_AVX2(_mm256_mullo_epi16(shi, _mm256_blend_epi16(ahi, full, 0x88)));
+
+    if (mode == SDL_COPY_ADD) {
+        return _mm256_blendv_epi8(_mm256_adds_epu8(_mm256_packus_epi16(slo, shi), d), d, alpha);
+    }
+
+    /* SDL_COPY_BLEND */
+    dlo = _mm256_add_epi16(slo, SDL_Blit_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(full, alo), dlo)));
+    dhi = _mm256_add_epi16(shi, SDL_Blit_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(full, ahi), dhi)));
+    return _mm256_packus_epi16(dlo, dhi);
+}
+
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+
+/* x / 255, rounded down, for 0 <= x <= 255 * 255 in each 16-bit lane */
+SDL_TARGETING("sse4.1")
+SDL_FORCE_INLINE __m128i SDL_Blit_Div255_SSE41(__m128i x)
+{
+    x = _mm_add_epi16(x, _mm_set1_epi16(1));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+/* Modulates pixels in destination channel order, with alpha in the top byte */
+SDL_TARGETING("sse4.1")
+SDL_FORCE_INLINE __m128i SDL_Blit_ModulatePixels_SSE41(__m128i s, __m128i modulate)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_unpacklo_epi8(s, zero);
+    __m128i hi = _mm_unpackhi_epi8(s, zero);
+    lo = SDL_Blit_Div255_SSE41(_mm_mullo_epi16(lo, modulate));
+    hi = SDL_Blit_Div255_SSE41(_mm_mullo_epi16(hi, modulate));
+    return _mm_packus_epi16(lo, hi);
+}
+
+/* Same math as the scalar blitters, for pixels in destination channel order */
+SDL_TARGETING("sse4.1")
+SDL_FORCE_INLINE __m128i SDL_Blit_BlendPixels_SSE41(__m128i s, __m128i d, int mode)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(255);
+    const __m128i alpha = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+    __m128i slo = _mm_unpacklo_epi8(s, zero);
+    __m128i shi = _mm_unpackhi_epi8(s, zero);
+    __m128i dlo = _mm_unpacklo_epi8(d, zero);
+    __m128i dhi = _mm_unpackhi_epi8(d, zero);
+    __m128i alo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(slo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    __m128i ahi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(shi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+    if (mode == SDL_COPY_MOD) {
+        dlo = SDL_Blit_Div255_SSE41(_mm_mullo_epi16(slo, dlo));
+        dhi = SDL_Blit_Div255_SSE41(_mm_mullo_epi16(shi, dhi));
+        return _mm_blendv_epi8(_mm_packus_epi16(dlo, dhi), d, alpha);
+    }
+
+    /* This goes away if we ever use premultiplied alpha */
+    slo = SDL_Blit_Div255_SSE41(_mm_mullo_epi16(slo, _mm_blend_epi16(alo, full, 0x88)));
+    shi = SDL_Blit_Div255_SSE41(_mm_mullo_epi16(shi, _mm_blend_epi16(ahi, full, 0x88)));
+
+    if (mode == SDL_COPY_ADD) {
+        return _mm_blendv_epi8(_mm_adds_epu8(_mm_packus_epi16(slo, shi), d), d, alpha);
+    }
+
+    /* SDL_COPY_BLEND */
+    dlo = _mm_add_epi16(slo, SDL_Blit_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(full, alo), dlo)));
+    dhi = _mm_add_epi16(shi, SDL_Blit_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(full, ahi), dhi)));
+    return _mm_packus_epi16(dlo, dhi);
+}
+
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_RGB888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i srcalpha = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = _mm256_or_si256(pixels, srcalpha);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGB888_RGB888_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_RGB888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const __m256i srcalpha = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = _mm256_or_si256(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGB888_RGB888_Modulate(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_RGB888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i srcalpha = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = _mm256_or_si256(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGB888_RGB888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_RGB888_RGB888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i srcalpha = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = _mm_or_si128(pixels, srcalpha);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGB888_RGB888_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_RGB888_RGB888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const __m128i srcalpha = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = _mm_or_si128(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGB888_RGB888_Modulate(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_RGB888_RGB888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i srcalpha = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = _mm_or_si128(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGB888_RGB888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_RGB888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i srcalpha = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = _mm256_or_si256(pixels, srcalpha);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGB888_BGR888_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_RGB888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const __m256i srcalpha = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = _mm256_or_si256(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGB888_BGR888_Modulate(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_RGB888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i srcalpha = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = _mm256_or_si256(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGB888_BGR888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_RGB888_BGR888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i srcalpha = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = _mm_or_si128(pixels, srcalpha);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGB888_BGR888_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_RGB888_BGR888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const __m128i srcalpha = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = _mm_or_si128(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGB888_BGR888_Modulate(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_RGB888_BGR888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i srcalpha = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = _mm_or_si128(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGB888_BGR888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_RGB888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i srcalpha = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = _mm256_or_si256(pixels, srcalpha);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGB888_ARGB8888_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_RGB888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const __m256i srcalpha = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = _mm256_or_si256(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGB888_ARGB8888_Modulate(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_RGB888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i srcalpha = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = _mm256_or_si256(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGB888_ARGB8888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_RGB888_ARGB8888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i srcalpha = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = _mm_or_si128(pixels, srcalpha);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGB888_ARGB8888_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_RGB888_ARGB8888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const __m128i srcalpha = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = _mm_or_si128(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGB888_ARGB8888_Modulate(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_RGB888_ARGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i srcalpha = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = _mm_or_si128(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGB888_ARGB8888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_BGR888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i srcalpha = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = _mm256_or_si256(pixels, srcalpha);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGR888_RGB888_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_BGR888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const __m256i srcalpha = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = _mm256_or_si256(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGR888_RGB888_Modulate(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_BGR888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i srcalpha = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = _mm256_or_si256(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGR888_RGB888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_BGR888_RGB888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i srcalpha = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = _mm_or_si128(pixels, srcalpha);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGR888_RGB888_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_BGR888_RGB888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const __m128i srcalpha = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = _mm_or_si128(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGR888_RGB888_Modulate(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_BGR888_RGB888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i srcalpha = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = _mm_or_si128(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGR888_RGB888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_BGR888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i srcalpha = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = _mm256_or_si256(pixels, srcalpha);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGR888_BGR888_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_BGR888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const __m256i srcalpha = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = _mm256_or_si256(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGR888_BGR888_Modulate(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_BGR888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i srcalpha = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = _mm256_or_si256(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGR888_BGR888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_BGR888_BGR888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i srcalpha = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = _mm_or_si128(pixels, srcalpha);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGR888_BGR888_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_BGR888_BGR888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const __m128i srcalpha = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = _mm_or_si128(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGR888_BGR888_Modulate(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_BGR888_BGR888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i srcalpha = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = _mm_or_si128(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGR888_BGR888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_BGR888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i srcalpha = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = _mm256_or_si256(pixels, srcalpha);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGR888_ARGB8888_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_BGR888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const __m256i srcalpha = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = _mm256_or_si256(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGR888_ARGB8888_Modulate(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_BGR888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i srcalpha = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), 24);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = _mm256_or_si256(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGR888_ARGB8888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_BGR888_ARGB8888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i srcalpha = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = _mm_or_si128(pixels, srcalpha);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGR888_ARGB8888_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_BGR888_ARGB8888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const __m128i srcalpha = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = _mm_or_si128(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGR888_ARGB8888_Modulate(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_BGR888_ARGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i srcalpha = _mm_slli_epi32(_mm_set1_epi32(0xFF), 24);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = _mm_or_si128(pixels, srcalpha);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGR888_ARGB8888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_ARGB8888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ARGB8888_RGB888_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_ARGB8888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ARGB8888_RGB888_Modulate(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_ARGB8888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ARGB8888_RGB888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_ARGB8888_RGB888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ARGB8888_RGB888_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_ARGB8888_RGB888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ARGB8888_RGB888_Modulate(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_ARGB8888_RGB888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ARGB8888_RGB888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_ARGB8888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ARGB8888_BGR888_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_ARGB8888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ARGB8888_BGR888_Modulate(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_ARGB8888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ARGB8888_BGR888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_ARGB8888_BGR888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ARGB8888_BGR888_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_ARGB8888_BGR888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ARGB8888_BGR888_Modulate(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_ARGB8888_BGR888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ARGB8888_BGR888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_ARGB8888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ARGB8888_ARGB8888_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_ARGB8888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ARGB8888_ARGB8888_Modulate(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_ARGB8888_ARGB8888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ARGB8888_ARGB8888_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_ARGB8888_ARGB8888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ARGB8888_ARGB8888_Modulate(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_RGBA8888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGBA8888_RGB888_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_RGBA8888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGBA8888_RGB888_Modulate(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_RGBA8888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGBA8888_RGB888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_RGBA8888_RGB888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGBA8888_RGB888_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_RGBA8888_RGB888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGBA8888_RGB888_Modulate(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_RGBA8888_RGB888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGBA8888_RGB888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_RGBA8888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGBA8888_BGR888_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_RGBA8888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGBA8888_BGR888_Modulate(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_RGBA8888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGBA8888_BGR888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_RGBA8888_BGR888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGBA8888_BGR888_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_RGBA8888_BGR888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGBA8888_BGR888_Modulate(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_RGBA8888_BGR888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGBA8888_BGR888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_RGBA8888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGBA8888_ARGB8888_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_RGBA8888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGBA8888_ARGB8888_Modulate(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_RGBA8888_ARGB8888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGBA8888_ARGB8888_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_RGBA8888_ARGB8888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGBA8888_ARGB8888_Modulate(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_ABGR8888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ABGR8888_RGB888_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_ABGR8888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ABGR8888_RGB888_Modulate(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_ABGR8888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ABGR8888_RGB888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_ABGR8888_RGB888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ABGR8888_RGB888_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_ABGR8888_RGB888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ABGR8888_RGB888_Modulate(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_ABGR8888_RGB888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ABGR8888_RGB888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_ABGR8888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ABGR8888_BGR888_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_ABGR8888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ABGR8888_BGR888_Modulate(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_ABGR8888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ABGR8888_BGR888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_ABGR8888_BGR888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ABGR8888_BGR888_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_ABGR8888_BGR888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ABGR8888_BGR888_Modulate(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_ABGR8888_BGR888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ABGR8888_BGR888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_ABGR8888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ABGR8888_ARGB8888_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_ABGR8888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ABGR8888_ARGB8888_Modulate(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_ABGR8888_ARGB8888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ABGR8888_ARGB8888_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_ABGR8888_ARGB8888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ABGR8888_ARGB8888_Modulate(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_BGRA8888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGRA8888_RGB888_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_BGRA8888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGRA8888_RGB888_Modulate(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_BGRA8888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGRA8888_RGB888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_BGRA8888_RGB888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGRA8888_RGB888_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_BGRA8888_RGB888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGRA8888_RGB888_Modulate(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_BGRA8888_RGB888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGRA8888_RGB888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_BGRA8888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGRA8888_BGR888_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_BGRA8888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGRA8888_BGR888_Modulate(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_BGRA8888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m256i dstmask = _mm256_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            pixels = _mm256_and_si256(pixels, dstmask);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGRA8888_BGR888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_BGRA8888_BGR888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGRA8888_BGR888_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_BGRA8888_BGR888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGRA8888_BGR888_Modulate(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_BGRA8888_BGR888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    const __m128i dstmask = _mm_set1_epi32(0x00FFFFFF);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            pixels = _mm_and_si128(pixels, dstmask);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGRA8888_BGR888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_BGRA8888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGRA8888_ARGB8888_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_BGRA8888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGRA8888_ARGB8888_Modulate(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~7;
+    const __m256i shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m256i *src = (const __m256i *)srcrow;
+        __m256i *dst = (__m256i *)dstrow;
+        int n;
+        for (n = width; n; n -= 8) {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_AVX2(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_AVX2(pixels, _mm256_loadu_si256(dst), mode);
+            _mm256_storeu_si256(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_BGRA8888_ARGB8888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGRA8888_ARGB8888_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_BGRA8888_ARGB8888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGRA8888_ARGB8888_Modulate(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("sse4.1")
+static void SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int width = info->dst_w & ~3;
+    const __m128i shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const __m128i *src = (const __m128i *)srcrow;
+        __m128i *dst = (__m128i *)dstrow;
+        int n;
+        for (n = width; n; n -= 4) {
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(src++), shuffle);
+            pixels = SDL_Blit_ModulatePixels_SSE41(pixels, modulate);
+            pixels = SDL_Blit_BlendPixels_SSE41(pixels, _mm_loadu_si128(dst), mode);
+            _mm_storeu_si128(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * 4;
+        info->dst += width * 4;
+        info->dst_w -= width;
+        SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend(info);
+    }
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
 SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
-    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Scale },
-    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Blend },
-    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Blend_Scale },
-    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Modulate },
-    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Modulate_Scale },
-    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Modulate_Blend },
-    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Modulate_Blend_Scale },
-    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_BGR888_Scale },
-    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGB888_BGR888_Blend },
-    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_BGR888_Blend_Scale },
-    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_RGB888_BGR888_Modulate },
-    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_BGR888_Modulate_Scale },
-    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGB888_BGR888_Modulate_Blend },
-    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_BGR888_Modulate_Blend_Scale },
-    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_ARGB8888_Scale },
-    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGB888_ARGB8888_Blend },
-    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_ARGB8888_Blend_Scale },
-    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_RGB888_ARGB8888_Modulate },
-    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_ARGB8888_Modulate_Scale },
-    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGB888_ARGB8888_Modulate_Blend },
-    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_ARGB8888_Modulate_Blend_Scale },
-    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_RGB888_Scale },
-    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGR888_RGB888_Blend },
-    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_RGB888_Blend_Scale },
-    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_BGR888_RGB888_Modulate },
-    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_RGB888_Modulate_Scale },
-    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGR888_RGB888_Modulate_Blend },
-    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_RGB888_Modulate_Blend_Scale },
-    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_BGR888_Scale },
-    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGR888_BGR888_Blend },
-    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_BGR888_Blend_Scale },
-    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_BGR888_BGR888_Modulate },
-    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_BGR888_Modulate_Scale },
-    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGR888_BGR888_Modulate_Blend },
-    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_BGR888_Modulate_Blend_Scale },
-    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_ARGB8888_Scale },
-    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGR888_ARGB8888_Blend },
-    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_ARGB8888_Blend_Scale },
-    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_BGR888_ARGB8888_Modulate },
-    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_ARGB8888_Modulate_Scale },
-    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGR888_ARGB8888_Modulate_Blend },
-    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_ARGB8888_Modulate_Blend_Scale },
-    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_RGB888_Scale },
-    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ARGB8888_RGB888_Blend },
-    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_RGB888_Blend_Scale },
-    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_ARGB8888_RGB888_Modulate },
-    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_RGB888_Modulate_Scale },
-    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ARGB8888_RGB888_Modulate_Blend },
-    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_RGB888_Modulate_Blend_Scale },
-    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_BGR888_Scale },
-    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ARGB8888_BGR888_Blend },
-    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_BGR888_Blend_Scale },
-    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_ARGB8888_BGR888_Modulate },
-    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_BGR888_Modulate_Scale },
-    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ARGB8888_BGR888_Modulate_Blend },
-    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_BGR888_Modulate_Blend_Scale },
-    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Scale },
-    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Blend },
-    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Blend_Scale },
-    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Modulate },
-    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Modulate_Scale },
-    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend },
-    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_Scale },
-    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_RGB888_Scale },
-    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGBA8888_RGB888_Blend },
-    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_RGB888_Blend_Scale },
-    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_RGBA8888_RGB888_Modulate },
-    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_RGB888_Modulate_Scale },
-    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGBA8888_RGB888_Modulate_Blend },
-    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_RGB888_Modulate_Blend_Scale },
-    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_BGR888_Scale },
-    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGBA8888_BGR888_Blend },
-    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_BGR888_Blend_Scale },
-    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_RGBA8888_BGR888_Modulate },
-    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_BGR888_Modulate_Scale },
-    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGBA8888_BGR888_Modulate_Blend },
-    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_BGR888_Modulate_Blend_Scale },
-    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Scale },
-    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Blend },
-    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Blend_Scale },
-    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Modulate },
-    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Modulate_Scale },
-    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend },
-    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_Scale },
-    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_RGB888_Scale },
-    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ABGR8888_RGB888_Blend },
-    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_RGB888_Blend_Scale },
-    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_ABGR8888_RGB888_Modulate },
-    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_RGB888_Modulate_Scale },
-    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ABGR8888_RGB888_Modulate_Blend },
-    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_RGB888_Modulate_Blend_Scale },
-    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_BGR888_Scale },
-    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ABGR8888_BGR888_Blend },
-    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_BGR888_Blend_Scale },
-    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_ABGR8888_BGR888_Modulate },
-    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_BGR888_Modulate_Scale },
-    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ABGR8888_BGR888_Modulate_Blend },
-    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_BGR888_Modulate_Blend_Scale },
-    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Scale },
-    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Blend },
-    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Blend_Scale },
-    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Modulate },
-    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Modulate_Scale },
-    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend },
-    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_Scale },
-    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_RGB888_Scale },
-    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGRA8888_RGB888_Blend },
-    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_RGB888_Blend_Scale },
-    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_BGRA8888_RGB888_Modulate },
-    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_RGB888_Modulate_Scale },
-    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGRA8888_RGB888_Modulate_Blend },
-    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_RGB888_Modulate_Blend_Scale },
-    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_BGR888_Scale },
-    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGRA8888_BGR888_Blend },
-    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_BGR888_Blend_Scale },
-    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_BGRA8888_BGR888_Modulate },
-    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_BGR888_Modulate_Scale },
-    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGRA8888_BGR888_Modulate_Blend },
-    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_BGR888_Modulate_Blend_Scale },
-    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Scale },
-    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Blend },
-    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Blend_Scale },
-    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Modulate },
-    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Modulate_Scale },
-    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend },
-    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_Scale },
-    { 0, 0, 0, 0, NULL }
+#if SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGB888_RGB888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGB888_RGB888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGB888_RGB888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGB888_BGR888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGB888_BGR888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGB888_BGR888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGB888_ARGB8888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGB888_ARGB8888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGB888_ARGB8888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGR888_RGB888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGR888_RGB888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGR888_RGB888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGR888_BGR888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGR888_BGR888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGR888_BGR888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGR888_ARGB8888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGR888_ARGB8888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGR888_ARGB8888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ARGB8888_RGB888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ARGB8888_RGB888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ARGB8888_RGB888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ARGB8888_BGR888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ARGB8888_BGR888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ARGB8888_BGR888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ARGB8888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ARGB8888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGBA8888_RGB888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGBA8888_RGB888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGBA8888_RGB888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGBA8888_BGR888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGBA8888_BGR888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGBA8888_BGR888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ARGB8888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ARGB8888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ABGR8888_RGB888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ABGR8888_RGB888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ABGR8888_RGB888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ABGR8888_BGR888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ABGR8888_BGR888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ABGR8888_BGR888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ARGB8888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ARGB8888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGRA8888_RGB888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGRA8888_RGB888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGRA8888_RGB888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGRA8888_BGR888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGRA8888_BGR888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGRA8888_BGR888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ARGB8888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ARGB8888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_AVX2 },
+#endif
+#if SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_RGB888_RGB888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_RGB888_RGB888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_RGB888_RGB888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_RGB888_BGR888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_RGB888_BGR888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_RGB888_BGR888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_RGB888_ARGB8888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_RGB888_ARGB8888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_RGB888_ARGB8888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_BGR888_RGB888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_BGR888_RGB888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_BGR888_RGB888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_BGR888_BGR888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_BGR888_BGR888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_BGR888_BGR888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_BGR888_ARGB8888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_BGR888_ARGB8888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_BGR888_ARGB8888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_ARGB8888_RGB888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_ARGB8888_RGB888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_ARGB8888_RGB888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_ARGB8888_BGR888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_ARGB8888_BGR888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_ARGB8888_BGR888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_ARGB8888_ARGB8888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_ARGB8888_ARGB8888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_RGBA8888_RGB888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_RGBA8888_RGB888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_RGBA8888_RGB888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_RGBA8888_BGR888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_RGBA8888_BGR888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_RGBA8888_BGR888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_RGBA8888_ARGB8888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_RGBA8888_ARGB8888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_ABGR8888_RGB888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_ABGR8888_RGB888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_ABGR8888_RGB888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_ABGR8888_BGR888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_ABGR8888_BGR888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_ABGR8888_BGR888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_ABGR8888_ARGB8888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_ABGR8888_ARGB8888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_BGRA8888_RGB888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_BGRA8888_RGB888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_BGRA8888_RGB888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_BGRA8888_BGR888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_BGRA8888_BGR888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_BGRA8888_BGR888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_BGRA8888_ARGB8888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_BGRA8888_ARGB8888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE41, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_SSE41 },
+#endif
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Scale },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Blend },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Blend_Scale },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), 0, SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Modulate },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Modulate_Scale },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Modulate_Blend },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Modulate_Blend_Scale },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGB888_BGR888_Scale },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_RGB888_BGR888_Blend },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGB888_BGR888_Blend_Scale },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), 0, SDL_CPU_ANY, SDL_Blit_RGB888_BGR888_Modulate },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGB888_BGR888_Modulate_Scale },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_RGB888_BGR888_Modulate_Blend },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGB888_BGR888_Modulate_Blend_Scale },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGB888_ARGB8888_Scale },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_RGB888_ARGB8888_Blend },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGB888_ARGB8888_Blend_Scale },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), 0, SDL_CPU_ANY, SDL_Blit_RGB888_ARGB8888_Modulate },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGB888_ARGB8888_Modulate_Scale },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_RGB888_ARGB8888_Modulate_Blend },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGB888_ARGB8888_Modulate_Blend_Scale },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGR888_RGB888_Scale },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_BGR888_RGB888_Blend },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGR888_RGB888_Blend_Scale },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), 0, SDL_CPU_ANY, SDL_Blit_BGR888_RGB888_Modulate },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGR888_RGB888_Modulate_Scale },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_BGR888_RGB888_Modulate_Blend },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGR888_RGB888_Modulate_Blend_Scale },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGR888_BGR888_Scale },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_BGR888_BGR888_Blend },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGR888_BGR888_Blend_Scale },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), 0, SDL_CPU_ANY, SDL_Blit_BGR888_BGR888_Modulate },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGR888_BGR888_Modulate_Scale },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_BGR888_BGR888_Modulate_Blend },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGR888_BGR888_Modulate_Blend_Scale },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGR888_ARGB8888_Scale },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_BGR888_ARGB8888_Blend },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGR888_ARGB8888_Blend_Scale },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), 0, SDL_CPU_ANY, SDL_Blit_BGR888_ARGB8888_Modulate },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGR888_ARGB8888_Modulate_Scale },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_BGR888_ARGB8888_Modulate_Blend },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGR888_ARGB8888_Modulate_Blend_Scale },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ARGB8888_RGB888_Scale },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_ARGB8888_RGB888_Blend },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ARGB8888_RGB888_Blend_Scale },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), 0, SDL_CPU_ANY, SDL_Blit_ARGB8888_RGB888_Modulate },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ARGB8888_RGB888_Modulate_Scale },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_ARGB8888_RGB888_Modulate_Blend },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ARGB8888_RGB888_Modulate_Blend_Scale },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ARGB8888_BGR888_Scale },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_ARGB8888_BGR888_Blend },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ARGB8888_BGR888_Blend_Scale },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), 0, SDL_CPU_ANY, SDL_Blit_ARGB8888_BGR888_Modulate },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ARGB8888_BGR888_Modulate_Scale },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_ARGB8888_BGR888_Modulate_Blend },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ARGB8888_BGR888_Modulate_Blend_Scale },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Scale },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Blend },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Blend_Scale },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), 0, SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Modulate },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Modulate_Scale },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_Scale },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGBA8888_RGB888_Scale },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_RGBA8888_RGB888_Blend },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGBA8888_RGB888_Blend_Scale },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), 0, SDL_CPU_ANY, SDL_Blit_RGBA8888_RGB888_Modulate },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGBA8888_RGB888_Modulate_Scale },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_RGBA8888_RGB888_Modulate_Blend },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGBA8888_RGB888_Modulate_Blend_Scale },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGBA8888_BGR888_Scale },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_RGBA8888_BGR888_Blend },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGBA8888_BGR888_Blend_Scale },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), 0, SDL_CPU_ANY, SDL_Blit_RGBA8888_BGR888_Modulate },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGBA8888_BGR888_Modulate_Scale },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_RGBA8888_BGR888_Modulate_Blend },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGBA8888_BGR888_Modulate_Blend_Scale },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Scale },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Blend },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Blend_Scale },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), 0, SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Modulate },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Modulate_Scale },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_Scale },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ABGR8888_RGB888_Scale },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_ABGR8888_RGB888_Blend },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ABGR8888_RGB888_Blend_Scale },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), 0, SDL_CPU_ANY, SDL_Blit_ABGR8888_RGB888_Modulate },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ABGR8888_RGB888_Modulate_Scale },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_ABGR8888_RGB888_Modulate_Blend },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ABGR8888_RGB888_Modulate_Blend_Scale },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ABGR8888_BGR888_Scale },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_ABGR8888_BGR888_Blend },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ABGR8888_BGR888_Blend_Scale },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), 0, SDL_CPU_ANY, SDL_Blit_ABGR8888_BGR888_Modulate },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ABGR8888_BGR888_Modulate_Scale },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_ABGR8888_BGR888_Modulate_Blend },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ABGR8888_BGR888_Modulate_Blend_Scale },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Scale },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Blend },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Blend_Scale },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), 0, SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Modulate },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Modulate_Scale },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_Scale },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGRA8888_RGB888_Scale },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_BGRA8888_RGB888_Blend },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGRA8888_RGB888_Blend_Scale },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), 0, SDL_CPU_ANY, SDL_Blit_BGRA8888_RGB888_Modulate },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGRA8888_RGB888_Modulate_Scale },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_BGRA8888_RGB888_Modulate_Blend },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGRA8888_RGB888_Modulate_Blend_Scale },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGRA8888_BGR888_Scale },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_BGRA8888_BGR888_Blend },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGRA8888_BGR888_Blend_Scale },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), 0, SDL_CPU_ANY, SDL_Blit_BGRA8888_BGR888_Modulate },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGRA8888_BGR888_Modulate_Scale },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_BGRA8888_BGR888_Modulate_Blend },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGRA8888_BGR888_Modulate_Blend_Scale },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Scale },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Blend },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Blend_Scale },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), 0, SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Modulate },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Modulate_Scale },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), 0, SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), 0, SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_Scale },
+    { 0, 0, 0, 0, 0, NULL }
 };
 
 /* *INDENT-ON* */
@@ -642,10 +642,54 @@ SDL_FreeFormat(SDL_PixelFormat *format)
     SDL_free(format);
 }
 
+/* SDL_Palette is public, so what SDL keeps about a palette is allocated along
+   with it. Callers can pass palettes of their own too, so palettes from
+   SDL_AllocPalette() are registered here, and only those are ever treated
+   as SDL_PaletteData. */
+typedef struct SDL_PaletteLookup SDL_PaletteLookup;
+
+typedef struct SDL_PaletteData
+{
+    SDL_Palette palette;
+    struct SDL_PaletteData *next;   /* next allocated palette in the same bucket */
+    SDL_atomic_t searches;      /* full scans since the last lookup was built */
+    void *lookups;              /* SDL_PaletteLookup list, see SDL_FindColor() */
+} SDL_PaletteData;
+
+#define PALETTE_BUCKETS 64
+
+static SDL_PaletteData *allocated_palettes[PALETTE_BUCKETS];
+static SDL_SpinLock palettes_lock = 0;
+
+static SDL_PaletteData **
+SDL_GetPaletteBucket(const SDL_Palette * palette)
+{
+    return &allocated_palettes[((uintptr_t) palette / sizeof(SDL_PaletteData)) % PALETTE_BUCKETS];
+}
+
+/* Get the data for a palette from SDL_AllocPalette(), or NULL for any other palette */
+static SDL_PaletteData *
+SDL_GetPaletteData(const SDL_Palette * palette)
+{
+    SDL_PaletteData *data;
+
+    SDL_AtomicLock(&palettes_lock);
+    for (data = *SDL_GetPaletteBucket(palette); data; data = data->next) {
+        if (&data->palette == palette) {
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&palettes_lock);
+    return data;
+}
+
+static void SDL_FreePaletteLookups(SDL_PaletteData * data);
+
 SDL_Palette *
 SDL_AllocPalette(int ncolors)
 {
     SDL_Palette *palette;
+    SDL_PaletteData **bucket;
 
     /* Input validation */
     if (ncolors < 1) {
@@ -653,7 +697,7 @@ SDL_AllocPalette(int ncolors)
       return NULL;
     }
 
-    palette = (SDL_Palette *) SDL_malloc(sizeof(*palette));
+    palette = (SDL_Palette *) SDL_calloc(1, sizeof(SDL_PaletteData));
     if (!palette) {
         SDL_OutOfMemory();
         return NULL;
@@ -670,6 +714,12 @@ SDL_AllocPalette(int ncolors)
 
     SDL_memset(palette->colors, 0xFF, ncolors * sizeof(*palette->colors));
 
+    SDL_AtomicLock(&palettes_lock);
+    bucket = SDL_GetPaletteBucket(palette);
+    ((SDL_PaletteData *) palette)->next = *bucket;
+    *bucket = (SDL_PaletteData *) palette;
+    SDL_AtomicUnlock(&palettes_lock);
+
     return palette;
 }
 
@@ -724,6 +774,7 @@ SDL_SetPaletteColors(SDL_Palette * palette, const SDL_Color * colors,
     if (!palette->version) {
         palette->version = 1;
     }
+    SDL_FreePaletteLookups(SDL_GetPaletteData(palette));
 
     return status;
 }
@@ -731,6 +782,9 @@ SDL_SetPaletteColors(SDL_Palette * palette, const SDL_Color * colors,
 void
 SDL_FreePalette(SDL_Palette * palette)
 {
+    SDL_PaletteData **link;
+    SDL_PaletteData *data = NULL;
+
     if (!palette) {
         SDL_InvalidParamError("palette");
         return;
@@ -738,6 +792,18 @@ SDL_FreePalette(SDL_Palette * palette)
     if (--palette->refcount > 0) {
         return;
     }
+
+    SDL_AtomicLock(&palettes_lock);
+    for (link = SDL_GetPaletteBucket(palette); *link; link = &(*link)->next) {
+        if (&(*link)->palette == palette) {
+            data = *link;
+            *link = data->next;
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&palettes_lock);
+    SDL_FreePaletteLookups(data);
+
     SDL_free(palette->colors);
     SDL_free(palette);
 }
@@ -773,8 +839,8 @@ SDL_DitherColors(SDL_Color * colors, int bpp)
 /*
  * Match an RGB value to a particular palette index
  */
-Uint8
-SDL_FindColor(SDL_Palette * pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+static Uint8
+FindColorLinear(const SDL_Color * colors, int ncolors, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
     /* Do colorspace distance matching */
     unsigned int smallest;
@@ -784,11 +850,11 @@ SDL_FindColor(SDL_Palette * pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
     Uint8 pixel = 0;
 
     smallest = ~0;
-    for (i = 0; i < pal->ncolors; ++i) {
-        rd = pal->colors[i].r - r;
-        gd = pal->colors[i].g - g;
-        bd = pal->colors[i].b - b;
-        ad = pal->colors[i].a - a;
+    for (i = 0; i < ncolors; ++i) {
+        rd = colors[i].r - r;
+        gd = colors[i].g - g;
+        bd = colors[i].b - b;
+        ad = colors[i].a - a;
         distance = (rd * rd) + (gd * gd) + (bd * bd) + (ad * ad);
         if (distance < smallest) {
             pixel = i;
@@ -801,6 +867,255 @@ SDL_FindColor(SDL_Palette * pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
     return (pixel);
 }
 
+/*
+ * Palettes with many colors get an inverse colormap once they have been
+ * searched often enough for it to pay off. The RGB cube is split into
+ * 8x8x8 cells, and each cell lists, in palette order, every entry that
+ * can be the closest match for a color inside it. A lookup only measures
+ * those entries, so it returns exactly what a full scan would.
+ *
+ * Each palette keeps one colormap per alpha value it is searched with, up
+ * to a few of them. They are only ever added while the palette is in use,
+ * and freed by SDL_SetPaletteColors() and SDL_FreePalette().
+ */
+#define PALETTE_LOOKUP_MIN_COLORS   32
+#define PALETTE_LOOKUP_MIN_SEARCHES 1024
+#define PALETTE_LOOKUP_MAX_TABLES   4
+#define PALETTE_LOOKUP_CELL_BITS    3
+#define PALETTE_LOOKUP_CELL_SHIFT   (8 - PALETTE_LOOKUP_CELL_BITS)
+#define PALETTE_LOOKUP_CELL_RANGES  (1 << PALETTE_LOOKUP_CELL_BITS)
+#define PALETTE_LOOKUP_CELLS        (1 << (3 * PALETTE_LOOKUP_CELL_BITS))
+
+struct SDL_PaletteLookup
+{
+    SDL_PaletteLookup *next;
+    Uint32 version;             /* the palette version the cells were built for */
+    int ncolors;
+    Uint8 alpha;                /* the alpha value the cells were built for */
+    Uint32 *cells;              /* PALETTE_LOOKUP_CELLS + 1 offsets into candidates */
+    Uint8 *candidates;
+};
+
+static SDL_PaletteLookup *
+SDL_CreatePaletteLookup(const SDL_Palette * pal, Uint8 alpha)
+{
+    const int ncolors = pal->ncolors;
+    SDL_PaletteLookup *lookup;
+    Uint32 *nearest, *farthest, *distances;
+    Uint8 *candidates;
+    int i, c, range, cell;
+
+    lookup = (SDL_PaletteLookup *) SDL_malloc(sizeof(*lookup) +
+                                              (PALETTE_LOOKUP_CELLS + 1) * sizeof(Uint32));
+    /* Squared distances from each color to the nearest and farthest value
+       of every cell range, per channel, with the alpha term added to red */
+    nearest = (Uint32 *) SDL_malloc(7 * PALETTE_LOOKUP_CELL_RANGES * ncolors * sizeof(Uint32));
+    candidates = (Uint8 *) SDL_malloc(PALETTE_LOOKUP_CELLS * ncolors);
+    if (!lookup || !nearest || !candidates) {
+        SDL_free(lookup);
+        SDL_free(nearest);
+        SDL_free(candidates);
+        return NULL;
+    }
+    farthest = nearest + 3 * PALETTE_LOOKUP_CELL_RANGES * ncolors;
+    distances = farthest + 3 * PALETTE_LOOKUP_CELL_RANGES * ncolors;
+
+    lookup->next = NULL;
+    lookup->version = pal->version;
+    lookup->ncolors = ncolors;
+    lookup->alpha = alpha;
+    lookup->cells = (Uint32 *) (lookup + 1);
+
+    for (i = 0; i < 3; ++i) {
+        for (range = 0; range < PALETTE_LOOKUP_CELL_RANGES; ++range) {
+            const int lo = range << PALETTE_LOOKUP_CELL_SHIFT;
+            const int hi = lo + (1 << PALETTE_LOOKUP_CELL_SHIFT) - 1;
+            Uint32 *n = &nearest[(i * PALETTE_LOOKUP_CELL_RANGES + range) * ncolors];
+            Uint32 *f = &farthest[(i * PALETTE_LOOKUP_CELL_RANGES + range) * ncolors];
+
+            for (c = 0; c < ncolors; ++c) {
+                const SDL_Color *color = &pal->colors[c];
+                const int value = (i == 0) ? color->r : (i == 1) ? color->g : color->b;
+                const int dn = (value < lo) ? (lo - value) : (value > hi) ? (value - hi) : 0;
+                const int df = SDL_max(SDL_abs(value - lo), SDL_abs(value - hi));
+                n[c] = dn * dn;
+                f[c] = df * df;
+                if (i == 0) {
+                    const int ad = color->a - alpha;
+                    n[c] += ad * ad;
+                    f[c] += ad * ad;
+                }
+            }
+        }
+    }
+
+    /* No color in a cell is farther from its closest match than the
+       smallest farthest distance, so only the entries that can come that
+       close to the cell are kept */
+    lookup->cells[0] = 0;
+    for (cell = 0; cell < PALETTE_LOOKUP_CELLS; ++cell) {
+        const int ranges[3] = {
+            cell >> (2 * PALETTE_LOOKUP_CELL_BITS),
+            (cell >> PALETTE_LOOKUP_CELL_BITS) & (PALETTE_LOOKUP_CELL_RANGES - 1),
+            cell & (PALETTE_LOOKUP_CELL_RANGES - 1)
+        };
+        const Uint32 *fr = &farthest[(0 * PALETTE_LOOKUP_CELL_RANGES + ranges[0]) * ncolors];
+        const Uint32 *fg = &farthest[(1 * PALETTE_LOOKUP_CELL_RANGES + ranges[1]) * ncolors];
+        const Uint32 *fb = &farthest[(2 * PALETTE_LOOKUP_CELL_RANGES + ranges[2]) * ncolors];
+        const Uint32 *nr = &nearest[(0 * PALETTE_LOOKUP_CELL_RANGES + ranges[0]) * ncolors];
+        const Uint32 *ng = &nearest[(1 * PALETTE_LOOKUP_CELL_RANGES + ranges[1]) * ncolors];
+        const Uint32 *nb = &nearest[(2 * PALETTE_LOOKUP_CELL_RANGES + ranges[2]) * ncolors];
+        Uint8 *candidate = &candidates[lookup->cells[cell]];
+        Uint32 bound = ~0u;
+
+        for (c = 0; c < ncolors; ++c) {
+            const Uint32 distance = fr[c] + fg[c] + fb[c];
+            bound = SDL_min(bound, distance);
+            distances[c] = nr[c] + ng[c] + nb[c];
+        }
+        for (c = 0; c < ncolors; ++c) {
+            if (distances[c] <= bound) {
+                *candidate++ = (Uint8) c;
+            }
+        }
+        lookup->cells[cell + 1] = (Uint32) (candidate - candidates);
+    }
+    SDL_free(nearest);
+
+    lookup->candidates = (Uint8 *) SDL_realloc(candidates, lookup->cells[PALETTE_LOOKUP_CELLS]);
+    if (!lookup->candidates) {
+        lookup->candidates = candidates;
+    }
+    return lookup;
+}
+
+static void
+SDL_FreePaletteLookups(SDL_PaletteData * data)
+{
+    SDL_PaletteLookup *lookup;
+
+    if (!data) {
+        return;
+    }
+
+    lookup = (SDL_PaletteLookup *) SDL_AtomicSetPtr(&data->lookups, NULL);
+
+    while (lookup) {
+        SDL_PaletteLookup *next = lookup->next;
+        SDL_free(lookup->candidates);
+        SDL_free(lookup);
+        lookup = next;
+    }
+    SDL_AtomicSet(&data->searches, 0);
+}
+
+/* Get the lookup for this palette and alpha, or NULL if it should be scanned */
+static SDL_PaletteLookup *
+SDL_GetPaletteLookup(SDL_Palette * pal, Uint8 alpha, int searches)
+{
+    SDL_PaletteData *data;
+    SDL_PaletteLookup *lookup, *head;
+    int tables = 0;
+
+    if (pal->ncolors < PALETTE_LOOKUP_MIN_COLORS || pal->ncolors > 256) {
+        return NULL;
+    }
+    data = SDL_GetPaletteData(pal);
+    if (!data) {
+        return NULL;    /* not ours, so there's nowhere to keep a lookup */
+    }
+
+    head = (SDL_PaletteLookup *) SDL_AtomicGetPtr(&data->lookups);
+    for (lookup = head; lookup; lookup = lookup->next) {
+        if (lookup->alpha == alpha && lookup->version == pal->version &&
+            lookup->ncolors == pal->ncolors) {
+            return lookup;
+        }
+        ++tables;
+    }
+    if (tables >= PALETTE_LOOKUP_MAX_TABLES ||
+        SDL_AtomicAdd(&data->searches, searches) + searches < PALETTE_LOOKUP_MIN_SEARCHES) {
+        return NULL;
+    }
+    SDL_AtomicSet(&data->searches, 0);
+
+    lookup = SDL_CreatePaletteLookup(pal, alpha);
+    if (lookup) {
+        do {
+            head = (SDL_PaletteLookup *) SDL_AtomicGetPtr(&data->lookups);
+            lookup->next = head;
+        } while (!SDL_AtomicCASPtr(&data->lookups, head, lookup));
+    }
+    return lookup;
+}
+
+static Uint8
+FindColorInLookup(const SDL_PaletteLookup * lookup, const SDL_Color * colors,
+                  Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    const int cell = ((r >> PALETTE_LOOKUP_CELL_SHIFT) << (2 * PALETTE_LOOKUP_CELL_BITS)) |
+                     ((g >> PALETTE_LOOKUP_CELL_SHIFT) << PALETTE_LOOKUP_CELL_BITS) |
+                     (b >> PALETTE_LOOKUP_CELL_SHIFT);
+    const Uint8 *candidate = &lookup->candidates[lookup->cells[cell]];
+    const Uint8 *end = &lookup->candidates[lookup->cells[cell + 1]];
+    unsigned int smallest = ~0u;
+    unsigned int distance;
+    int rd, gd, bd, ad;
+    Uint8 pixel = 0;
+
+    for (; candidate < end; ++candidate) {
+        const SDL_Color *color = &colors[*candidate];
+        rd = color->r - r;
+        gd = color->g - g;
+        bd = color->b - b;
+        ad = color->a - a;
+        distance = (rd * rd) + (gd * gd) + (bd * bd) + (ad * ad);
+        if (distance < smallest) {
+            pixel = *candidate;
+            if (distance == 0) {        /* Perfect match! */
+                break;
+            }
+            smallest = distance;
+        }
+    }
+    return (pixel);
+}
+
+Uint8
+SDL_FindColor(SDL_Palette * pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    const SDL_PaletteLookup *lookup = SDL_GetPaletteLookup(pal, a, 1);
+
+    if (lookup) {
+        return FindColorInLookup(lookup, pal->colors, r, g, b, a);
+    }
+    return FindColorLinear(pal->colors, pal->ncolors, r, g, b, a);
+}
+
+/*
+ * Match a run of colors to palette indices, as SDL_FindColor() would
+ */
+void
+SDL_FindColors(SDL_Palette * pal, const SDL_Color * colors, Uint8 * pixels, int count)
+{
+    const SDL_PaletteLookup *lookup;
+    int i;
+
+    if (count <= 0) {
+        return;
+    }
+
+    lookup = SDL_GetPaletteLookup(pal, colors[0].a, count);
+    for (i = 0; i < count; ++i) {
+        const SDL_Color *color = &colors[i];
+        if (lookup && color->a == lookup->alpha) {
+            pixels[i] = FindColorInLookup(lookup, pal->colors, color->r, color->g, color->b, color->a);
+        } else {
+            pixels[i] = FindColorLinear(pal->colors, pal->ncolors, color->r, color->g, color->b, color->a);
+        }
+    }
+}
+
 /* Tell whether palette is opaque, and if it has an alpha_channel */
 void
 SDL_DetectPalette(SDL_Palette *pal, SDL_bool *is_opaque, SDL_bool *has_alpha_channel)
@@ -931,7 +1246,6 @@ static Uint8 *
 Map1to1(SDL_Palette * src, SDL_Palette * dst, int *identical)
 {
     Uint8 *map;
-    int i;
 
     if (identical) {
         if (src->ncolors <= dst->ncolors) {
@@ -952,11 +1266,7 @@ Map1to1(SDL_Palette * src, SDL_Palette * dst, int *identical)
         SDL_OutOfMemory();
         return (NULL);
     }
-    for (i = 0; i < src->ncolors; ++i) {
-        map[i] = SDL_FindColor(dst,
-                               src->colors[i].r, src->colors[i].g,
-                               src->colors[i].b, src->colors[i].a);
-    }
+    SDL_FindColors(dst, src->colors, map, src->ncolors);
     return (map);
 }
 
@@ -27,203 +27,694 @@
 */
 
 #include "SDL_video.h"
+#include "SDL_render.h"
 #include "SDL_blit.h"
 
-/* This isn't ready for general consumption yet - it should be folded
-   into the general blitting mechanism.
-*/
-
-#if ((defined(_MSC_VER) && defined(_M_IX86))    || \
-     (defined(__WATCOMC__) && defined(__386__)) || \
-     (defined(__GNUC__) && defined(__i386__))) && SDL_ASSEMBLY_ROUTINES
-/* There's a bug with gcc 4.4.1 and -O2 where srcp doesn't get the correct
- * value after the first scanline.  FIXME? */
-/* #define USE_ASM_STRETCH */
+#ifdef __SSE2__
+#define HAVE_SSE2_INTRINSICS 1
 #endif
 
-#ifdef USE_ASM_STRETCH
-
-#ifdef HAVE_MPROTECT
-#include <sys/types.h>
-#include <sys/mman.h>
-#endif
-#ifdef __GNUC__
-#define PAGE_ALIGNED __attribute__((__aligned__(4096)))
-#else
-#define PAGE_ALIGNED
+#ifdef __ARM_NEON
+#define HAVE_NEON_INTRINSICS 1
 #endif
 
-#if defined(_M_IX86) || defined(__i386__) || defined(__386__)
-#define PREFIX16    0x66
-#define STORE_BYTE  0xAA
-#define STORE_WORD  0xAB
-#define LOAD_BYTE   0xAC
-#define LOAD_WORD   0xAD
-#define RETURN      0xC3
-#else
-#error Need assembly opcodes for this architecture
+#if SDL_SSE4_1_INTRINSICS
+#define HAVE_SHUFFLE_STRETCH 1
+#elif HAVE_NEON_INTRINSICS && defined(__aarch64__)
+#define HAVE_SHUFFLE_STRETCH 1
 #endif
 
-static unsigned char copy_row[4096] PAGE_ALIGNED;
+SDL_bool
+SDL_SoftStretchLinearSupported(Uint32 format)
+{
+    switch (format) {
+    case SDL_PIXELFORMAT_RGB565:
+    case SDL_PIXELFORMAT_BGR565:
+        return SDL_TRUE;
+    case SDL_PIXELFORMAT_ARGB2101010:
+        return SDL_FALSE;
+    default:
+        /* Each byte of a 32-bit pixel is filtered on its own */
+        return (SDL_BYTESPERPIXEL(format) == 4 && !SDL_ISPIXELFORMAT_FOURCC(format)) ? SDL_TRUE : SDL_FALSE;
+    }
+}
+
+/* Nearest neighbor stretching looks the source pixel of every column and row
+   up in a table, so the row kernels don't carry any per-pixel stepping. */
 
-static int
-generate_rowbytes(int src_w, int dst_w, int bpp)
+typedef enum
 {
-    static struct
-    {
-        int bpp;
-        int src_w;
-        int dst_w;
-        int status;
-    } last;
+    SDL_STRETCH_NEAREST_SCALAR,
+    SDL_STRETCH_NEAREST_SCALE,      /* exact 2x, 3x or 4x upscale */
+    SDL_STRETCH_NEAREST_SHUFFLE,    /* upscale, 16 bytes at a time */
+    SDL_STRETCH_NEAREST_GATHER      /* anything else with 32-bit pixels */
+} SDL_StretchNearestKernel;
 
+/* steps[i] = src_pos + floor(i * src_len / dst_len) */
+static void
+get_nearest_steps(int *steps, int src_pos, int src_len, int dst_len)
+{
+    const int inc = src_len / dst_len;
+    const int rem = src_len % dst_len;
+    int pos = src_pos;
+    int err = 0;
     int i;
-    int pos, inc;
-    unsigned char *eip, *fence;
-    unsigned char load, store;
 
-    /* See if we need to regenerate the copy buffer */
-    if ((src_w == last.src_w) && (dst_w == last.dst_w) && (bpp == last.bpp)) {
-        return (last.status);
+    for (i = 0; i < dst_len; ++i) {
+        steps[i] = pos;
+        pos += inc;
+        err += rem;
+        if (err >= dst_len) {
+            err -= dst_len;
+            ++pos;
+        }
     }
-    last.bpp = bpp;
-    last.src_w = src_w;
-    last.dst_w = dst_w;
-    last.status = -1;
+}
+
+static void
+stretch_row_nearest(const Uint8 *src, Uint8 *dst, const int *steps, int from, int dst_w, int bpp)
+{
+    int i;
 
     switch (bpp) {
     case 1:
-        load = LOAD_BYTE;
-        store = STORE_BYTE;
+        for (i = from; i < dst_w; ++i) {
+            dst[i] = src[steps[i]];
+        }
         break;
     case 2:
+        for (i = from; i < dst_w; ++i) {
+            ((Uint16 *) dst)[i] = ((const Uint16 *) src)[steps[i]];
+        }
+        break;
+    case 3:
+        for (i = from; i < dst_w; ++i) {
+            const Uint8 *pixel = src + steps[i] * 3;
+            dst[i * 3 + 0] = pixel[0];
+            dst[i * 3 + 1] = pixel[1];
+            dst[i * 3 + 2] = pixel[2];
+        }
+        break;
     case 4:
-        load = LOAD_WORD;
-        store = STORE_WORD;
+        for (i = from; i < dst_w; ++i) {
+            ((Uint32 *) dst)[i] = ((const Uint32 *) src)[steps[i]];
+        }
         break;
-    default:
-        return SDL_SetError("ASM stretch of %d bytes isn't supported", bpp);
     }
-#ifdef HAVE_MPROTECT
-    /* Make the code writeable */
-    if (mprotect(copy_row, sizeof(copy_row), PROT_READ | PROT_WRITE) < 0) {
-        return SDL_SetError("Couldn't make copy buffer writeable");
+}
+
+#if HAVE_SSE2_INTRINSICS
+/* Integer upscales of 32-bit pixels, for pixel art.  Returns the number of
+   destination pixels written, the rest are left to stretch_row_nearest(). */
+static int
+stretch_row_scale_8888_SSE2(const Uint8 *src, Uint8 *dst, int src_w, int scale)
+{
+    int i = 0;
+
+    switch (scale) {
+    case 2:
+        for (; i + 4 <= src_w; i += 4, dst += 32) {
+            const __m128i v = _mm_loadu_si128((const __m128i *) (src + i * 4));
+            _mm_storeu_si128((__m128i *) dst, _mm_unpacklo_epi32(v, v));
+            _mm_storeu_si128((__m128i *) (dst + 16), _mm_unpackhi_epi32(v, v));
+        }
+        break;
+    case 3:
+        for (; i + 4 <= src_w; i += 4, dst += 48) {
+            const __m128i v = _mm_loadu_si128((const __m128i *) (src + i * 4));
+            _mm_storeu_si128((__m128i *) dst, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 0, 0)));
+            _mm_storeu_si128((__m128i *) (dst + 16), _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 2, 1, 1)));
+            _mm_storeu_si128((__m128i *) (dst + 32), _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 2)));
+        }
+        break;
+    case 4:
+        for (; i + 4 <= src_w; i += 4, dst += 64) {
+            const __m128i v = _mm_loadu_si128((const __m128i *) (src + i * 4));
+            _mm_storeu_si128((__m128i *) dst, _mm_shuffle_epi32(v, 0x00));
+            _mm_storeu_si128((__m128i *) (dst + 16), _mm_shuffle_epi32(v, 0x55));
+            _mm_storeu_si128((__m128i *) (dst + 32), _mm_shuffle_epi32(v, 0xAA));
+            _mm_storeu_si128((__m128i *) (dst + 48), _mm_shuffle_epi32(v, 0xFF));
+        }
+        break;
     }
+    return i * scale;
+}
 #endif
-    pos = 0x10000;
-    inc = (src_w << 16) / dst_w;
-    eip = copy_row;
-    fence = copy_row + sizeof(copy_row)-2;
-    for (i = 0; i < dst_w; ++i) {
-        while (pos >= 0x10000L) {
-            if (eip == fence) {
-                return -1;
-            }
-            if (bpp == 2) {
-                *eip++ = PREFIX16;
+
+#if HAVE_SHUFFLE_STRETCH
+/* When upscaling, the source pixels of 16 destination bytes always fit in the
+   16 source bytes starting at the first one, so each block is one load and
+   one byte shuffle.  Returns the number of blocks that can be done this way. */
+static int
+get_nearest_shuffles(Uint8 *masks, int *bases, const int *steps, int dst_w, int bpp, int src_w)
+{
+    const int n = 16 / bpp;
+    int block, i, j;
+
+    for (block = 0; block < dst_w / n; ++block) {
+        const int *pos = steps + block * n;
+        /* don't read past the end of the source row */
+        if (pos[0] + n > src_w) {
+            break;
+        }
+        bases[block] = pos[0] * bpp;
+        for (i = 0; i < n; ++i) {
+            for (j = 0; j < bpp; ++j) {
+                masks[block * 16 + i * bpp + j] = (Uint8) ((pos[i] - pos[0]) * bpp + j);
             }
-            *eip++ = load;
-            pos -= 0x10000L;
         }
-        if (eip == fence) {
-            return -1;
+    }
+    return block;
+}
+
+#if SDL_SSE4_1_INTRINSICS
+SDL_TARGETING("ssse3")
+static void
+stretch_row_shuffle(const Uint8 *src, Uint8 *dst, const Uint8 *masks, const int *bases, int blocks)
+{
+    int i;
+
+    for (i = 0; i < blocks; ++i, dst += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i *) (src + bases[i]));
+        const __m128i mask = _mm_loadu_si128((const __m128i *) (masks + i * 16));
+        _mm_storeu_si128((__m128i *) dst, _mm_shuffle_epi8(v, mask));
+    }
+}
+
+static SDL_bool
+SDL_HasShuffleStretch(void)
+{
+    /* There's no separate SSSE3 check, but every CPU with SSE4.1 has it */
+    return SDL_HasSSE41();
+}
+#else
+static void
+stretch_row_shuffle(const Uint8 *src, Uint8 *dst, const Uint8 *masks, const int *bases, int blocks)
+{
+    int i;
+
+    for (i = 0; i < blocks; ++i, dst += 16) {
+        vst1q_u8(dst, vqtbl1q_u8(vld1q_u8(src + bases[i]), vld1q_u8(masks + i * 16)));
+    }
+}
+
+static SDL_bool
+SDL_HasShuffleStretch(void)
+{
+    return SDL_HasNEON();
+}
+#endif
+#endif /* HAVE_SHUFFLE_STRETCH */
+
+#if SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static int
+stretch_row_gather_8888_AVX2(const Uint8 *src, Uint8 *dst, const int *steps, int dst_w)
+{
+    int i;
+
+    for (i = 0; i + 8 <= dst_w; i += 8) {
+        const __m256i index = _mm256_loadu_si256((const __m256i *) (steps + i));
+        _mm256_storeu_si256((__m256i *) (dst + i * 4), _mm256_i32gather_epi32((const int *) src, index, 4));
+    }
+    return i;
+}
+#endif
+
+static int
+SDL_LowerSoftStretchNearest(SDL_Surface * src, const SDL_Rect * srcrect,
+                            SDL_Surface * dst, const SDL_Rect * dstrect)
+{
+    const int bpp = dst->format->BytesPerPixel;
+    const int src_w = srcrect->w;
+    const int dst_w = dstrect->w;
+    const int blocks_max = (bpp == 3) ? 0 : dst_w / (16 / bpp);
+    SDL_StretchNearestKernel kernel = SDL_STRETCH_NEAREST_SCALAR;
+    int *xsteps, *ysteps, *bases;
+    Uint8 *masks;
+    int scale = 0, blocks = 0;
+    int i;
+
+    xsteps = (int *) SDL_malloc((dst_w + dstrect->h + blocks_max) * sizeof (int) + blocks_max * 16);
+    if (!xsteps) {
+        return SDL_OutOfMemory();
+    }
+    ysteps = xsteps + dst_w;
+    bases = ysteps + dstrect->h;
+    masks = (Uint8 *) (bases + blocks_max);
+    get_nearest_steps(xsteps, srcrect->x, src_w, dst_w);
+    get_nearest_steps(ysteps, srcrect->y, srcrect->h, dstrect->h);
+
+#if HAVE_SSE2_INTRINSICS
+    if (bpp == 4 && (dst_w == src_w * 2 || dst_w == src_w * 3 || dst_w == src_w * 4) && SDL_HasSSE2()) {
+        kernel = SDL_STRETCH_NEAREST_SCALE;
+        scale = dst_w / src_w;
+    }
+#endif
+#if HAVE_SHUFFLE_STRETCH
+    if (kernel == SDL_STRETCH_NEAREST_SCALAR && blocks_max > 0 && src_w <= dst_w && SDL_HasShuffleStretch()) {
+        blocks = get_nearest_shuffles(masks, bases, xsteps, dst_w, bpp, src->w);
+        if (blocks > 0) {
+            kernel = SDL_STRETCH_NEAREST_SHUFFLE;
         }
-        if (bpp == 2) {
-            *eip++ = PREFIX16;
+    }
+#endif
+#if SDL_AVX2_INTRINSICS
+    if (kernel == SDL_STRETCH_NEAREST_SCALAR && bpp == 4 && SDL_HasAVX2()) {
+        kernel = SDL_STRETCH_NEAREST_GATHER;
+    }
+#endif
+
+    for (i = 0; i < dstrect->h; ++i) {
+        const Uint8 *srcp = (const Uint8 *) src->pixels + ysteps[i] * src->pitch;
+        Uint8 *dstp = (Uint8 *) dst->pixels + (dstrect->y + i) * dst->pitch + dstrect->x * bpp;
+        int done = 0;
+
+        /* Rows repeated by an upscale are copied from the one above */
+        if (i > 0 && ysteps[i] == ysteps[i - 1]) {
+            SDL_memcpy(dstp, dstp - dst->pitch, dst_w * bpp);
+            continue;
         }
-        *eip++ = store;
-        pos += inc;
+
+        switch (kernel) {
+#if HAVE_SSE2_INTRINSICS
+        case SDL_STRETCH_NEAREST_SCALE:
+            done = stretch_row_scale_8888_SSE2(srcp + srcrect->x * 4, dstp, src_w, scale);
+            break;
+#endif
+#if HAVE_SHUFFLE_STRETCH
+        case SDL_STRETCH_NEAREST_SHUFFLE:
+            stretch_row_shuffle(srcp, dstp, masks, bases, blocks);
+            done = blocks * (16 / bpp);
+            break;
+#endif
+#if SDL_AVX2_INTRINSICS
+        case SDL_STRETCH_NEAREST_GATHER:
+            done = stretch_row_gather_8888_AVX2(srcp, dstp, xsteps, dst_w);
+            break;
+#endif
+        default:
+            break;
+        }
+        stretch_row_nearest(srcp, dstp, xsteps, done, dst_w, bpp);
     }
-    *eip++ = RETURN;
 
-#ifdef HAVE_MPROTECT
-    /* Make the code executable but not writeable */
-    if (mprotect(copy_row, sizeof(copy_row), PROT_READ | PROT_EXEC) < 0) {
-        return SDL_SetError("Couldn't make copy buffer executable");
+    SDL_free(xsteps);
+    return 0;
+}
+
+/* Bilinear filtering, in 8-bit fixed point.  Both rows are blended first and
+   the two resulting columns after that, truncating each time, so the scalar
+   and SIMD versions produce the same pixels. */
+
+typedef struct
+{
+    int pos;    /* first of the two source pixels */
+    int next;   /* second source pixel, pos + 1 unless the source is 1 wide */
+    int frac;   /* weight of the second pixel, 0-256 */
+} SDL_LinearStep;
+
+/* Sample at pixel centers: src = (dst + 0.5) * src_len / dst_len - 0.5 */
+static void
+get_linear_steps(SDL_LinearStep *steps, int src_pos, int src_len, int dst_len)
+{
+    const Sint64 inc = ((Sint64) src_len << 16) / dst_len;
+    Sint64 pos = inc / 2 - 0x8000;
+    int i;
+
+    for (i = 0; i < dst_len; ++i, pos += inc) {
+        int p = 0, frac = 0;
+        if (pos > 0) {
+            p = (int) (pos >> 16);
+            frac = (int) ((pos >> 8) & 0xFF);
+        }
+        if (p >= src_len - 1) {
+            /* Stay inside the source, with all the weight on its last pixel */
+            p = SDL_max(src_len - 2, 0);
+            frac = (src_len >= 2) ? 256 : 0;
+        }
+        steps[i].pos = src_pos + p;
+        steps[i].next = src_pos + ((src_len >= 2) ? p + 1 : p);
+        steps[i].frac = frac;
+    }
+}
+
+static SDL_INLINE Uint32
+lerp_8888(Uint32 a, Uint32 b, int frac)
+{
+    const Uint32 rb = ((((a & 0x00FF00FF) * (256 - frac)) + ((b & 0x00FF00FF) * frac)) >> 8) & 0x00FF00FF;
+    const Uint32 ag = ((((a >> 8) & 0x00FF00FF) * (256 - frac)) + (((b >> 8) & 0x00FF00FF) * frac)) & 0xFF00FF00;
+    return rb | ag;
+}
+
+static void
+stretch_row_linear_8888(const Uint32 *row0, const Uint32 *row1, int fy,
+                        Uint32 *dst, const SDL_LinearStep *steps, int dst_w)
+{
+    int i;
+
+    for (i = 0; i < dst_w; ++i) {
+        const SDL_LinearStep *step = &steps[i];
+        const Uint32 left = lerp_8888(row0[step->pos], row1[step->pos], fy);
+        const Uint32 right = lerp_8888(row0[step->next], row1[step->next], fy);
+        dst[i] = lerp_8888(left, right, step->frac);
     }
+}
+
+#if HAVE_SSE2_INTRINSICS
+/* The two neighboring pixels of both rows are loaded together as 16-bit lanes */
+static void
+stretch_row_linear_8888_SSE2(const Uint32 *row0, const Uint32 *row1, int fy,
+                             Uint32 *dst, const SDL_LinearStep *steps, int dst_w)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i wy0 = _mm_set1_epi16((short) (256 - fy));
+    const __m128i wy1 = _mm_set1_epi16((short) fy);
+    int i;
+
+    for (i = 0; i < dst_w; ++i) {
+        const SDL_LinearStep *step = &steps[i];
+        const short fx = (short) step->frac;
+        const __m128i wx = _mm_set_epi16(fx, fx, fx, fx, 256 - fx, 256 - fx, 256 - fx, 256 - fx);
+        const __m128i top = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (row0 + step->pos)), zero);
+        const __m128i bottom = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (row1 + step->pos)), zero);
+        __m128i v, h;
+
+        /* left and right column in the low and high half */
+        v = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(top, wy0), _mm_mullo_epi16(bottom, wy1)), 8);
+        h = _mm_mullo_epi16(v, wx);
+        h = _mm_srli_epi16(_mm_add_epi16(h, _mm_srli_si128(h, 8)), 8);
+        dst[i] = (Uint32) _mm_cvtsi128_si32(_mm_packus_epi16(h, zero));
+    }
+}
 #endif
-    last.status = 0;
-    return (0);
+
+#if HAVE_NEON_INTRINSICS
+static void
+stretch_row_linear_8888_NEON(const Uint32 *row0, const Uint32 *row1, int fy,
+                             Uint32 *dst, const SDL_LinearStep *steps, int dst_w)
+{
+    const uint16_t wy0 = (uint16_t) (256 - fy);
+    const uint16_t wy1 = (uint16_t) fy;
+    int i;
+
+    for (i = 0; i < dst_w; ++i) {
+        const SDL_LinearStep *step = &steps[i];
+        const uint16x8_t wx = vcombine_u16(vdup_n_u16((uint16_t) (256 - step->frac)), vdup_n_u16((uint16_t) step->frac));
+        const uint16x8_t top = vmovl_u8(vld1_u8((const uint8_t *) (row0 + step->pos)));
+        const uint16x8_t bottom = vmovl_u8(vld1_u8((const uint8_t *) (row1 + step->pos)));
+        uint16x8_t v, h;
+        uint16x4_t sum;
+
+        /* left and right column in the low and high half */
+        v = vshrq_n_u16(vmlaq_n_u16(vmulq_n_u16(top, wy0), bottom, wy1), 8);
+        h = vmulq_u16(v, wx);
+        sum = vshr_n_u16(vadd_u16(vget_low_u16(h), vget_high_u16(h)), 8);
+        dst[i] = vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vcombine_u16(sum, sum))), 0);
+    }
 }
+#endif
 
-#endif /* USE_ASM_STRETCH */
-
-#define DEFINE_COPY_ROW(name, type)         \
-static void name(type *src, int src_w, type *dst, int dst_w)    \
-{                                           \
-    int i;                                  \
-    int pos, inc;                           \
-    type pixel = 0;                         \
-                                            \
-    pos = 0x10000;                          \
-    inc = (src_w << 16) / dst_w;            \
-    for ( i=dst_w; i>0; --i ) {             \
-        while ( pos >= 0x10000L ) {         \
-            pixel = *src++;                 \
-            pos -= 0x10000L;                \
-        }                                   \
-        *dst++ = pixel;                     \
-        pos += inc;                         \
-    }                                       \
+/* 565 pixels are spread out to 0x07E0F81F, leaving room for 5-bit weights */
+static SDL_INLINE Uint32
+spread_565(Uint16 pixel)
+{
+    return (pixel | ((Uint32) pixel << 16)) & 0x07E0F81F;
+}
+
+static SDL_INLINE Uint32
+lerp_565(Uint32 a, Uint32 b, int frac)
+{
+    return (((a * (32 - frac)) + (b * frac)) >> 5) & 0x07E0F81F;
 }
-/* *INDENT-OFF* */
-DEFINE_COPY_ROW(copy_row1, Uint8)
-DEFINE_COPY_ROW(copy_row2, Uint16)
-DEFINE_COPY_ROW(copy_row4, Uint32)
-/* *INDENT-ON* */
 
-/* The ASM code doesn't handle 24-bpp stretch blits */
 static void
-copy_row3(Uint8 * src, int src_w, Uint8 * dst, int dst_w)
+stretch_row_linear_565(const Uint16 *row0, const Uint16 *row1, int fy,
+                       Uint16 *dst, const SDL_LinearStep *steps, int dst_w)
+{
+    const int fy5 = fy >> 3;
+    int i;
+
+    for (i = 0; i < dst_w; ++i) {
+        const SDL_LinearStep *step = &steps[i];
+        const Uint32 left = lerp_565(spread_565(row0[step->pos]), spread_565(row1[step->pos]), fy5);
+        const Uint32 right = lerp_565(spread_565(row0[step->next]), spread_565(row1[step->next]), fy5);
+        const Uint32 pixel = lerp_565(left, right, step->frac >> 3);
+        dst[i] = (Uint16) (pixel | (pixel >> 16));
+    }
+}
+
+static int
+SDL_LowerSoftStretchBilinear(SDL_Surface * src, const SDL_Rect * srcrect,
+                             SDL_Surface * dst, const SDL_Rect * dstrect)
 {
+    const int bpp = dst->format->BytesPerPixel;
+    SDL_LinearStep *xsteps, *ysteps;
+    void (*stretch_row_8888)(const Uint32 *, const Uint32 *, int, Uint32 *, const SDL_LinearStep *, int) = stretch_row_linear_8888;
     int i;
-    int pos, inc;
-    Uint8 pixel[3] = { 0, 0, 0 };
-
-    pos = 0x10000;
-    inc = (src_w << 16) / dst_w;
-    for (i = dst_w; i > 0; --i) {
-        while (pos >= 0x10000L) {
-            pixel[0] = *src++;
-            pixel[1] = *src++;
-            pixel[2] = *src++;
-            pos -= 0x10000L;
+
+    xsteps = (SDL_LinearStep *) SDL_malloc((dstrect->w + dstrect->h) * sizeof (SDL_LinearStep));
+    if (!xsteps) {
+        return SDL_OutOfMemory();
+    }
+    ysteps = xsteps + dstrect->w;
+    get_linear_steps(xsteps, srcrect->x, srcrect->w, dstrect->w);
+    get_linear_steps(ysteps, srcrect->y, srcrect->h, dstrect->h);
+
+    /* The SIMD versions always load two neighboring pixels */
+    if (srcrect->w >= 2) {
+#if HAVE_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            stretch_row_8888 = stretch_row_linear_8888_SSE2;
         }
-        *dst++ = pixel[0];
-        *dst++ = pixel[1];
-        *dst++ = pixel[2];
-        pos += inc;
+#endif
+#if HAVE_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            stretch_row_8888 = stretch_row_linear_8888_NEON;
+        }
+#endif
     }
+
+    for (i = 0; i < dstrect->h; ++i) {
+        const Uint8 *row0 = (const Uint8 *) src->pixels + ysteps[i].pos * src->pitch;
+        const Uint8 *row1 = (const Uint8 *) src->pixels + ysteps[i].next * src->pitch;
+        Uint8 *dstp = (Uint8 *) dst->pixels + (dstrect->y + i) * dst->pitch + dstrect->x * bpp;
+
+        if (bpp == 4) {
+            stretch_row_8888((const Uint32 *) row0, (const Uint32 *) row1, ysteps[i].frac,
+                             (Uint32 *) dstp, xsteps, dstrect->w);
+        } else {
+            stretch_row_linear_565((const Uint16 *) row0, (const Uint16 *) row1, ysteps[i].frac,
+                                   (Uint16 *) dstp, xsteps, dstrect->w);
+        }
+    }
+
+    SDL_free(xsteps);
+    return 0;
 }
 
-/* Perform a stretch blit between two surfaces of the same format.
-   NOTE:  This function is not safe to call from multiple threads!
-*/
-int
-SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
-                SDL_Surface * dst, const SDL_Rect * dstrect)
+/* Box filtering, for shrinking by 2x or more where bilinear filtering would
+   skip source pixels.  Each destination pixel averages the source pixels it
+   covers, the boxes splitting the source rectangle evenly. */
+
+static SDL_INLINE int
+box_start(int src_pos, int src_len, int dst_len, int i)
+{
+    return src_pos + (int) (((Sint64) i * src_len) / dst_len);
+}
+
+static SDL_INLINE Uint32
+average_box_8888(const Uint32 sums[4], Uint32 count)
+{
+    return ((sums[0] + count / 2) / count) |
+           (((sums[1] + count / 2) / count) << 8) |
+           (((sums[2] + count / 2) / count) << 16) |
+           (((sums[3] + count / 2) / count) << 24);
+}
+
+static void
+stretch_row_box_8888(const SDL_Surface *src, int y0, int y1, Uint32 *dst,
+                     const SDL_Rect *srcrect, int dst_w)
+{
+    int i, x, y;
+
+    for (i = 0; i < dst_w; ++i) {
+        const int x0 = box_start(srcrect->x, srcrect->w, dst_w, i);
+        const int x1 = box_start(srcrect->x, srcrect->w, dst_w, i + 1);
+        Uint32 sums[4] = { 0, 0, 0, 0 };
+
+        for (y = y0; y < y1; ++y) {
+            const Uint32 *row = (const Uint32 *) ((const Uint8 *) src->pixels + y * src->pitch);
+            for (x = x0; x < x1; ++x) {
+                const Uint32 pixel = row[x];
+                sums[0] += pixel & 0xFF;
+                sums[1] += (pixel >> 8) & 0xFF;
+                sums[2] += (pixel >> 16) & 0xFF;
+                sums[3] += pixel >> 24;
+            }
+        }
+        dst[i] = average_box_8888(sums, (Uint32) ((x1 - x0) * (y1 - y0)));
+    }
+}
+
+/* The SIMD versions sum the channels of a box in 32-bit lanes, four source
+   pixels at a time, and share the rounding division with the scalar one. */
+#if HAVE_SSE2_INTRINSICS
+static void
+stretch_row_box_8888_SSE2(const SDL_Surface *src, int y0, int y1, Uint32 *dst,
+                          const SDL_Rect *srcrect, int dst_w)
+{
+    const __m128i zero = _mm_setzero_si128();
+    Uint32 sums[4];
+    int i, x, y;
+
+    for (i = 0; i < dst_w; ++i) {
+        const int x0 = box_start(srcrect->x, srcrect->w, dst_w, i);
+        const int x1 = box_start(srcrect->x, srcrect->w, dst_w, i + 1);
+        __m128i acc = zero;
+
+        for (y = y0; y < y1; ++y) {
+            const Uint32 *row = (const Uint32 *) ((const Uint8 *) src->pixels + y * src->pitch);
+            for (x = x0; x + 4 <= x1; x += 4) {
+                const __m128i pixels = _mm_loadu_si128((const __m128i *) (row + x));
+                /* Pixels 0+2 and 1+3 in 16-bit lanes, at most 510 each */
+                const __m128i pairs = _mm_add_epi16(_mm_unpacklo_epi8(pixels, zero), _mm_unpackhi_epi8(pixels, zero));
+                acc = _mm_add_epi32(acc, _mm_unpacklo_epi16(pairs, zero));
+                acc = _mm_add_epi32(acc, _mm_unpackhi_epi16(pairs, zero));
+            }
+            for (; x < x1; ++x) {
+                const __m128i pixel = _mm_cvtsi32_si128((int) row[x]);
+                acc = _mm_add_epi32(acc, _mm_unpacklo_epi16(_mm_unpacklo_epi8(pixel, zero), zero));
+            }
+        }
+        _mm_storeu_si128((__m128i *) sums, acc);
+        dst[i] = average_box_8888(sums, (Uint32) ((x1 - x0) * (y1 - y0)));
+    }
+}
+#endif
+
+#if HAVE_NEON_INTRINSICS
+static void
+stretch_row_box_8888_NEON(const SDL_Surface *src, int y0, int y1, Uint32 *dst,
+                          const SDL_Rect *srcrect, int dst_w)
+{
+    Uint32 sums[4];
+    int i, x, y;
+
+    for (i = 0; i < dst_w; ++i) {
+        const int x0 = box_start(srcrect->x, srcrect->w, dst_w, i);
+        const int x1 = box_start(srcrect->x, srcrect->w, dst_w, i + 1);
+        uint32x4_t acc = vdupq_n_u32(0);
+
+        for (y = y0; y < y1; ++y) {
+            const Uint32 *row = (const Uint32 *) ((const Uint8 *) src->pixels + y * src->pitch);
+            for (x = x0; x + 4 <= x1; x += 4) {
+                const uint8x16_t pixels = vld1q_u8((const uint8_t *) (row + x));
+                /* Pixels 0+2 and 1+3 in 16-bit lanes, at most 510 each */
+                const uint16x8_t pairs = vaddl_u8(vget_low_u8(pixels), vget_high_u8(pixels));
+                acc = vaddw_u16(acc, vget_low_u16(pairs));
+                acc = vaddw_u16(acc, vget_high_u16(pairs));
+            }
+            for (; x < x1; ++x) {
+                const uint8x8_t pixel = vreinterpret_u8_u32(vdup_n_u32(row[x]));
+                acc = vaddw_u16(acc, vget_low_u16(vmovl_u8(pixel)));
+            }
+        }
+        vst1q_u32(sums, acc);
+        dst[i] = average_box_8888(sums, (Uint32) ((x1 - x0) * (y1 - y0)));
+    }
+}
+#endif
+
+static void
+stretch_row_box_565(const SDL_Surface *src, int y0, int y1, Uint16 *dst,
+                    const SDL_Rect *srcrect, int dst_w)
+{
+    int i, x, y;
+
+    for (i = 0; i < dst_w; ++i) {
+        const int x0 = box_start(srcrect->x, srcrect->w, dst_w, i);
+        const int x1 = box_start(srcrect->x, srcrect->w, dst_w, i + 1);
+        const Uint32 count = (Uint32) ((x1 - x0) * (y1 - y0));
+        Uint32 sum0 = 0, sum1 = 0, sum2 = 0;
+
+        for (y = y0; y < y1; ++y) {
+            const Uint16 *row = (const Uint16 *) ((const Uint8 *) src->pixels + y * src->pitch);
+            for (x = x0; x < x1; ++x) {
+                const Uint16 pixel = row[x];
+                sum0 += pixel & 0x1F;
+                sum1 += (pixel >> 5) & 0x3F;
+                sum2 += pixel >> 11;
+            }
+        }
+        dst[i] = (Uint16) (((sum0 + count / 2) / count) |
+                           (((sum1 + count / 2) / count) << 5) |
+                           (((sum2 + count / 2) / count) << 11));
+    }
+}
+
+static int
+SDL_LowerSoftStretchBox(SDL_Surface * src, const SDL_Rect * srcrect,
+                        SDL_Surface * dst, const SDL_Rect * dstrect)
 {
+    const int bpp = dst->format->BytesPerPixel;
+    void (*stretch_row_8888)(const SDL_Surface *, int, int, Uint32 *, const SDL_Rect *, int) = stretch_row_box_8888;
+    int i;
+
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        stretch_row_8888 = stretch_row_box_8888_SSE2;
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        stretch_row_8888 = stretch_row_box_8888_NEON;
+    }
+#endif
+
+    for (i = 0; i < dstrect->h; ++i) {
+        const int y0 = box_start(srcrect->y, srcrect->h, dstrect->h, i);
+        const int y1 = box_start(srcrect->y, srcrect->h, dstrect->h, i + 1);
+        Uint8 *dstp = (Uint8 *) dst->pixels + (dstrect->y + i) * dst->pitch + dstrect->x * bpp;
+
+        if (bpp == 4) {
+            stretch_row_8888(src, y0, y1, (Uint32 *) dstp, srcrect, dstrect->w);
+        } else {
+            stretch_row_box_565(src, y0, y1, (Uint16 *) dstp, srcrect, dstrect->w);
+        }
+    }
+    return 0;
+}
+
+static int
+SDL_LowerSoftStretchLinear(SDL_Surface * src, const SDL_Rect * srcrect,
+                           SDL_Surface * dst, const SDL_Rect * dstrect)
+{
+    if (srcrect->w >= 2 * dstrect->w && srcrect->h >= 2 * dstrect->h) {
+        return SDL_LowerSoftStretchBox(src, srcrect, dst, dstrect);
+    }
+    return SDL_LowerSoftStretchBilinear(src, srcrect, dst, dstrect);
+}
+
+static int
+SDL_UpperSoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
+                     SDL_Surface * dst, const SDL_Rect * dstrect,
+                     SDL_ScaleMode scaleMode)
+{
+    int ret;
     int src_locked;
     int dst_locked;
-    int pos, inc;
-    int dst_maxrow;
-    int src_row, dst_row;
-    Uint8 *srcp = NULL;
-    Uint8 *dstp;
     SDL_Rect full_src;
     SDL_Rect full_dst;
-#ifdef USE_ASM_STRETCH
-    SDL_bool use_asm = SDL_TRUE;
-#ifdef __GNUC__
-    int u1, u2;
-#endif
-#endif /* USE_ASM_STRETCH */
-    const int bpp = dst->format->BytesPerPixel;
 
     if (src->format->format != dst->format->format) {
         return SDL_SetError("Only works with same format surfaces");
     }
 
+    if (scaleMode != SDL_ScaleModeNearest && !SDL_SoftStretchLinearSupported(src->format->format)) {
+        return SDL_SetError("Unsupported pixel format for linear filtering");
+    }
+
     /* Verify the blit rectangles */
     if (srcrect) {
         if ((srcrect->x < 0) || (srcrect->y < 0) ||
@@ -252,6 +743,10 @@ SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
         dstrect = &full_dst;
     }
 
+    if (srcrect->w <= 0 || srcrect->h <= 0 || dstrect->w <= 0 || dstrect->h <= 0) {
+        return 0;  /* nothing to do. */
+    }
+
     /* Lock the destination if it's in hardware */
     dst_locked = 0;
     if (SDL_MUSTLOCK(dst)) {
@@ -272,72 +767,10 @@ SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
         src_locked = 1;
     }
 
-    /* Set up the data... */
-    pos = 0x10000;
-    inc = (srcrect->h << 16) / dstrect->h;
-    src_row = srcrect->y;
-    dst_row = dstrect->y;
-
-#ifdef USE_ASM_STRETCH
-    /* Write the opcodes for this stretch */
-    if ((bpp == 3) || (generate_rowbytes(srcrect->w, dstrect->w, bpp) < 0)) {
-        use_asm = SDL_FALSE;
-    }
-#endif
-
-    /* Perform the stretch blit */
-    for (dst_maxrow = dst_row + dstrect->h; dst_row < dst_maxrow; ++dst_row) {
-        dstp = (Uint8 *) dst->pixels + (dst_row * dst->pitch)
-            + (dstrect->x * bpp);
-        while (pos >= 0x10000L) {
-            srcp = (Uint8 *) src->pixels + (src_row * src->pitch)
-                + (srcrect->x * bpp);
-            ++src_row;
-            pos -= 0x10000L;
-        }
-#ifdef USE_ASM_STRETCH
-        if (use_asm) {
-#ifdef __GNUC__
-            __asm__ __volatile__("call *%4":"=&D"(u1), "=&S"(u2)
-                                 :"0"(dstp), "1"(srcp), "r"(copy_row)
-                                 :"memory");
-#elif defined(_MSC_VER) || defined(__WATCOMC__)
-            /* *INDENT-OFF* */
-            {
-                void *code = copy_row;
-                __asm {
-                    push edi
-                    push esi
-                    mov edi, dstp
-                    mov esi, srcp
-                    call dword ptr code
-                    pop esi
-                    pop edi
-                }
-            }
-            /* *INDENT-ON* */
-#else
-#error Need inline assembly for this compiler
-#endif
-        } else
-#endif
-            switch (bpp) {
-            case 1:
-                copy_row1(srcp, srcrect->w, dstp, dstrect->w);
-                break;
-            case 2:
-                copy_row2((Uint16 *) srcp, srcrect->w,
-                          (Uint16 *) dstp, dstrect->w);
-                break;
-            case 3:
-                copy_row3(srcp, srcrect->w, dstp, dstrect->w);
-                break;
-            case 4:
-                copy_row4((Uint32 *) srcp, srcrect->w,
-                          (Uint32 *) dstp, dstrect->w);
-                break;
-            }
-        pos += inc;
+    if (scaleMode == SDL_ScaleModeNearest) {
+        ret = SDL_LowerSoftStretchNearest(src, srcrect, dst, dstrect);
+    } else {
+        ret = SDL_LowerSoftStretchLinear(src, srcrect, dst, dstrect);
     }
 
     /* We need to unlock the surfaces if they're locked */
@@ -347,7 +780,24 @@ SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
     if (src_locked) {
         SDL_UnlockSurface(src);
     }
-    return (0);
+    return ret;
+}
+
+/* Perform a stretch blit between two surfaces of the same format.
+   NOTE:  This function is not safe to call from multiple threads!
+*/
+int
+SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
+                SDL_Surface * dst, const SDL_Rect * dstrect)
+{
+    return SDL_UpperSoftStretch(src, srcrect, dst, dstrect, SDL_ScaleModeNearest);
+}
+
+int
+SDL_SoftStretchLinear(SDL_Surface * src, const SDL_Rect * srcrect,
+                      SDL_Surface * dst, const SDL_Rect * dstrect)
+{
+    return SDL_UpperSoftStretch(src, srcrect, dst, dstrect, SDL_ScaleModeLinear);
 }
 
 /* vi: set ts=4 sw=4 expandtab: */
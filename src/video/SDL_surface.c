@@ -598,9 +598,8 @@ SDL_GetClipRect(SDL_Surface * surface, SDL_Rect * rect)
  * you know exactly what you are doing, you can optimize your code
  * by calling the one(s) you need.
  */
-int
-SDL_LowerBlit(SDL_Surface * src, SDL_Rect * srcrect,
-              SDL_Surface * dst, SDL_Rect * dstrect)
+static int
+SDL_ValidateBlitMap(SDL_Surface * src, SDL_Surface * dst)
 {
     /* Check to make sure the blit mapping is valid */
     if ((src->map->dst != dst) ||
@@ -617,9 +616,31 @@ SDL_LowerBlit(SDL_Surface * src, SDL_Rect * srcrect,
 /*              src, dst->flags, src->map->info.flags, dst, dst->flags, */
 /*              dst->map->info.flags, src->map->blit); */
     }
+    return 0;
+}
+
+int
+SDL_LowerBlit(SDL_Surface * src, SDL_Rect * srcrect,
+              SDL_Surface * dst, SDL_Rect * dstrect)
+{
+    if (SDL_ValidateBlitMap(src, dst) < 0) {
+        return -1;
+    }
     return (src->map->blit(src, srcrect, dst, dstrect));
 }
 
+/* SDL_LowerBlit() for whole image conversions, split across threads if
+   SDL_HINT_VIDEO_CONVERT_THREADS is set */
+static int
+SDL_LowerBlitConvert(SDL_Surface * src, SDL_Rect * srcrect,
+                     SDL_Surface * dst, SDL_Rect * dstrect)
+{
+    if (SDL_ValidateBlitMap(src, dst) < 0) {
+        return -1;
+    }
+    return SDL_ThreadedBlit(src, srcrect, dst, dstrect);
+}
+
 
 int
 SDL_UpperBlit(SDL_Surface * src, const SDL_Rect * srcrect,
@@ -723,6 +744,14 @@ SDL_UpperBlit(SDL_Surface * src, const SDL_Rect * srcrect,
 int
 SDL_UpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
               SDL_Surface * dst, SDL_Rect * dstrect)
+{
+    return SDL_PrivateUpperBlitScaled(src, srcrect, dst, dstrect, SDL_ScaleModeNearest, NULL);
+}
+
+int
+SDL_PrivateUpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
+                           SDL_Surface * dst, SDL_Rect * dstrect, SDL_ScaleMode scaleMode,
+                           SDL_BlitScaledScratch * scratch)
 {
     double src_x0, src_y0, src_x1, src_y1;
     double dst_x0, dst_y0, dst_x1, dst_y1;
@@ -867,7 +896,7 @@ SDL_UpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
         return 0;
     }
 
-    return SDL_LowerBlitScaled(src, &final_src, dst, &final_dst);
+    return SDL_PrivateLowerBlitScaled(src, &final_src, dst, &final_dst, scaleMode, scratch);
 }
 
 /**
@@ -877,6 +906,122 @@ SDL_UpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
 int
 SDL_LowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
                 SDL_Surface * dst, SDL_Rect * dstrect)
+{
+    return SDL_PrivateLowerBlitScaled(src, srcrect, dst, dstrect, SDL_ScaleModeNearest, NULL);
+}
+
+/* Returns a surface of at least w x h pixels in the given format, reusing
+   the one in *cache when it is big enough, or NULL on failure. */
+static SDL_Surface *
+SDL_GetBlitScratchSurface(SDL_Surface ** cache, int w, int h, Uint32 format)
+{
+    SDL_Surface *surface = *cache;
+
+    if (surface && surface->format->format == format &&
+        surface->w >= w && surface->h >= h) {
+        return surface;
+    }
+    if (surface) {
+        if (surface->format->format == format) {
+            /* Grow in both directions, so alternating shapes don't keep reallocating */
+            w = SDL_max(w, surface->w);
+            h = SDL_max(h, surface->h);
+        }
+        SDL_FreeSurface(surface);
+    }
+    *cache = SDL_CreateRGBSurfaceWithFormat(0, w, h, 0, format);
+    return *cache;
+}
+
+void
+SDL_FreeBlitScaledScratch(SDL_BlitScaledScratch * scratch)
+{
+    SDL_FreeSurface(scratch->filtered);
+    SDL_FreeSurface(scratch->scaled);
+    scratch->filtered = NULL;
+    scratch->scaled = NULL;
+}
+
+/* Filters the source into a scratch surface of the destination size,
+   then blits that with the source's color key, modulation and blending. */
+static int
+SDL_LowerBlitScaledLinear(SDL_Surface * src, SDL_Rect * srcrect,
+                          SDL_Surface * dst, SDL_Rect * dstrect,
+                          SDL_BlitScaledScratch * scratch)
+{
+    SDL_BlitScaledScratch temporary = { NULL, NULL };
+    SDL_Surface *filtered = src;
+    SDL_Surface *scaled;
+    SDL_Rect filtered_rect = *srcrect;
+    SDL_Rect scaled_rect, rect;
+    SDL_BlendMode blendMode;
+    Uint8 alphaMod, r, g, b;
+    SDL_bool colorkey = SDL_HasColorKey(src);
+    int retval = -1;
+
+    if (!scratch) {
+        scratch = &temporary;
+    }
+
+    SDL_GetSurfaceBlendMode(src, &blendMode);
+    SDL_GetSurfaceAlphaMod(src, &alphaMod);
+    SDL_GetSurfaceColorMod(src, &r, &g, &b);
+
+    if (colorkey || !SDL_SoftStretchLinearSupported(src->format->format)) {
+        /* Copy the pixels into ARGB8888, with color keyed ones left transparent */
+        filtered = SDL_GetBlitScratchSurface(&scratch->filtered, srcrect->w, srcrect->h, SDL_PIXELFORMAT_ARGB8888);
+        if (!filtered) {
+            goto done;
+        }
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+        SDL_SetSurfaceAlphaMod(src, 255);
+        SDL_SetSurfaceColorMod(src, 255, 255, 255);
+        rect.x = 0;
+        rect.y = 0;
+        rect.w = srcrect->w;
+        rect.h = srcrect->h;
+        retval = SDL_LowerBlit(src, &filtered_rect, filtered, &rect);
+        SDL_SetSurfaceBlendMode(src, blendMode);
+        SDL_SetSurfaceAlphaMod(src, alphaMod);
+        SDL_SetSurfaceColorMod(src, r, g, b);
+        if (retval < 0) {
+            goto done;
+        }
+        filtered_rect.x = 0;
+        filtered_rect.y = 0;
+        if (colorkey && blendMode == SDL_BLENDMODE_NONE) {
+            blendMode = SDL_BLENDMODE_BLEND;
+        }
+    }
+
+    scaled = SDL_GetBlitScratchSurface(&scratch->scaled, dstrect->w, dstrect->h, filtered->format->format);
+    if (!scaled) {
+        retval = -1;
+        goto done;
+    }
+    scaled_rect.x = 0;
+    scaled_rect.y = 0;
+    scaled_rect.w = dstrect->w;
+    scaled_rect.h = dstrect->h;
+    retval = SDL_SoftStretchLinear(filtered, &filtered_rect, scaled, &scaled_rect);
+    if (retval < 0) {
+        goto done;
+    }
+
+    SDL_SetSurfaceBlendMode(scaled, blendMode);
+    SDL_SetSurfaceAlphaMod(scaled, alphaMod);
+    SDL_SetSurfaceColorMod(scaled, r, g, b);
+    retval = SDL_LowerBlit(scaled, &scaled_rect, dst, dstrect);
+
+done:
+    SDL_FreeBlitScaledScratch(&temporary);
+    return retval;
+}
+
+int
+SDL_PrivateLowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
+                           SDL_Surface * dst, SDL_Rect * dstrect, SDL_ScaleMode scaleMode,
+                           SDL_BlitScaledScratch * scratch)
 {
     static const Uint32 complex_copy_flags = (
         SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA |
@@ -884,6 +1029,16 @@ SDL_LowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
         SDL_COPY_COLORKEY
     );
 
+    if (scaleMode != SDL_ScaleModeNearest) {
+        if ( !(src->map->info.flags & complex_copy_flags) &&
+             src->format->format == dst->format->format &&
+             SDL_SoftStretchLinearSupported(src->format->format) ) {
+            return SDL_SoftStretchLinear( src, srcrect, dst, dstrect );
+        } else {
+            return SDL_LowerBlitScaledLinear( src, srcrect, dst, dstrect, scratch );
+        }
+    }
+
     if (!(src->map->info.flags & SDL_COPY_NEAREST)) {
         src->map->info.flags |= SDL_COPY_NEAREST;
         SDL_InvalidateMap(src->map);
@@ -1065,7 +1220,7 @@ SDL_ConvertSurface(SDL_Surface * surface, const SDL_PixelFormat * format,
         }
     }
 
-    ret = SDL_LowerBlit(surface, &bounds, convert, &bounds);
+    ret = SDL_LowerBlitConvert(surface, &bounds, convert, &bounds);
 
     /* Restore colorkey alpha value */
     if (palette_ck_transform) {
@@ -1303,7 +1458,7 @@ int SDL_ConvertPixels(int width, int height,
     rect.y = 0;
     rect.w = width;
     rect.h = height;
-    return SDL_LowerBlit(&src_surface, &rect, &dst_surface, &rect);
+    return SDL_LowerBlitConvert(&src_surface, &rect, &dst_surface, &rect);
 }
 
 /*
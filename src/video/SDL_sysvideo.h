@@ -290,6 +290,14 @@ struct SDL_VideoDevice
      */
     void (*PumpEvents) (_THIS);
 
+    /* Optional: block until the system has events for PumpEvents() to pick up,
+       SendWakeupEvent() is called, or the timeout (in ms, -1 to wait forever)
+       expires. Returns 1 if woken up, 0 on timeout. */
+    int (*WaitEventTimeout) (_THIS, int timeout);
+
+    /* Interrupt a WaitEventTimeout() in progress, called from any thread */
+    void (*SendWakeupEvent) (_THIS, SDL_Window *window);
+
     /* Suspend the screensaver */
     void (*SuspendScreenSaver) (_THIS);
 
@@ -329,6 +337,8 @@ struct SDL_VideoDevice
     Uint8 window_magic;
     Uint32 next_object_id;
     char *clipboard_text;
+    SDL_mutex *wakeup_lock;     /* Protects wakeup_window */
+    SDL_Window *wakeup_window;  /* Set while waiting in WaitEventTimeout() */
 
     /* * * */
     /* Data used by the GL drivers */
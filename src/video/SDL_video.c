@@ -531,6 +531,11 @@ SDL_VideoInit(const char *driver_name)
     _this->current_glwin_tls = SDL_TLSCreate();
     _this->current_glctx_tls = SDL_TLSCreate();
 
+    /* Without the lock we can't safely wake a waiting thread, so don't wait */
+    if (_this->WaitEventTimeout && _this->SendWakeupEvent) {
+        _this->wakeup_lock = SDL_CreateMutex();
+    }
+
     /* Initialize the video subsystem */
     if (_this->VideoInit(_this) < 0) {
         SDL_VideoQuit();
@@ -2823,6 +2828,14 @@ SDL_DestroyWindow(SDL_Window * window)
         display->fullscreen_window = NULL;
     }
 
+    if (_this->wakeup_lock) {
+        SDL_LockMutex(_this->wakeup_lock);
+        if (_this->wakeup_window == window) {
+            _this->wakeup_window = NULL;
+        }
+        SDL_UnlockMutex(_this->wakeup_lock);
+    }
+
     /* Now invalidate magic */
     window->magic = NULL;
 
@@ -2936,6 +2949,10 @@ SDL_VideoQuit(void)
     }
     SDL_free(_this->clipboard_text);
     _this->clipboard_text = NULL;
+    if (_this->wakeup_lock) {
+        SDL_DestroyMutex(_this->wakeup_lock);
+        _this->wakeup_lock = NULL;
+    }
     _this->free(_this);
     _this = NULL;
 }
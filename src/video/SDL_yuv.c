@@ -24,9 +24,15 @@
 #include "SDL_video.h"
 #include "SDL_pixels_c.h"
 #include "SDL_yuv_c.h"
+#include "SDL_blit.h"
 
 #include "yuv2rgb/yuv_rgb.h"
 
+/* The NEON code stores pixels byte by byte, in little endian order */
+#if defined(__ARM_NEON) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+#define HAVE_NEON_INTRINSICS 1
+#endif
+
 #define SDL_YUV_SD_THRESHOLD    576
 
 
@@ -181,6 +187,224 @@ static int GetYUVPlanes(int width, int height, Uint32 format, const void *yuv, i
     return 0;
 }
 
+static SDL_bool yuv_rgb_avx2(
+    Uint32 src_format, Uint32 dst_format,
+    Uint32 width, Uint32 height, 
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride, 
+    Uint8 *rgb, Uint32 rgb_stride, 
+    YCbCrType yuv_type)
+{
+#if SDL_AVX2_INTRINSICS
+    if (!SDL_HasAVX2()) {
+        return SDL_FALSE;
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YV12 ||
+        src_format == SDL_PIXELFORMAT_IYUV) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuv420_rgb565_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuv420_rgb24_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv420_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv420_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv420_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGR888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv420_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YUY2 ||
+        src_format == SDL_PIXELFORMAT_UYVY ||
+        src_format == SDL_PIXELFORMAT_YVYU) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuv422_rgb565_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuv422_rgb24_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv422_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv422_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv422_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGR888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv422_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_NV12 ||
+        src_format == SDL_PIXELFORMAT_NV21) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuvnv12_rgb565_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuvnv12_rgb24_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuvnv12_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuvnv12_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuvnv12_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGR888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuvnv12_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+#endif
+    return SDL_FALSE;
+}
+
+static SDL_bool yuv_rgb_neon(
+    Uint32 src_format, Uint32 dst_format,
+    Uint32 width, Uint32 height, 
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride, 
+    Uint8 *rgb, Uint32 rgb_stride, 
+    YCbCrType yuv_type)
+{
+#if HAVE_NEON_INTRINSICS
+    if (!SDL_HasNEON()) {
+        return SDL_FALSE;
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YV12 ||
+        src_format == SDL_PIXELFORMAT_IYUV) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuv420_rgb565_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuv420_rgb24_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv420_rgba_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv420_bgra_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv420_argb_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGR888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv420_abgr_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YUY2 ||
+        src_format == SDL_PIXELFORMAT_UYVY ||
+        src_format == SDL_PIXELFORMAT_YVYU) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuv422_rgb565_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuv422_rgb24_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv422_rgba_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv422_bgra_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv422_argb_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGR888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv422_abgr_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_NV12 ||
+        src_format == SDL_PIXELFORMAT_NV21) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuvnv12_rgb565_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuvnv12_rgb24_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuvnv12_rgba_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuvnv12_bgra_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuvnv12_argb_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGR888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuvnv12_abgr_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+#endif
+    return SDL_FALSE;
+}
+
 static SDL_bool yuv_rgb_sse(
     Uint32 src_format, Uint32 dst_format,
     Uint32 width, Uint32 height, 
@@ -393,6 +617,66 @@ static SDL_bool yuv_rgb_std(
     return SDL_FALSE;
 }
 
+/* The RGB formats the yuv_rgb_*() functions convert to */
+static SDL_bool yuv_rgb_supported(Uint32 dst_format)
+{
+    switch (dst_format) {
+    case SDL_PIXELFORMAT_RGB565:
+    case SDL_PIXELFORMAT_RGB24:
+    case SDL_PIXELFORMAT_RGBX8888:
+    case SDL_PIXELFORMAT_RGBA8888:
+    case SDL_PIXELFORMAT_BGRX8888:
+    case SDL_PIXELFORMAT_BGRA8888:
+    case SDL_PIXELFORMAT_RGB888:
+    case SDL_PIXELFORMAT_ARGB8888:
+    case SDL_PIXELFORMAT_BGR888:
+    case SDL_PIXELFORMAT_ABGR8888:
+        return SDL_TRUE;
+    default:
+        return SDL_FALSE;
+    }
+}
+
+/* A conversion split into row bands, see SDL_RunRowBands() */
+typedef struct
+{
+    int width;
+    int height;
+    Uint32 src_format;
+    const void *src;
+    int src_pitch;
+    Uint32 dst_format;
+    void *dst;
+    int dst_pitch;
+} YUVRowBands;
+
+/* Bands start on an even row, so they begin on a chroma row of 4:2:0 data */
+static void yuv_rgb_rows(void *userdata, int row, int rows)
+{
+    const YUVRowBands *bands = (const YUVRowBands *) userdata;
+    const Uint8 *y = NULL;
+    const Uint8 *u = NULL;
+    const Uint8 *v = NULL;
+    Uint32 y_stride = 0;
+    Uint32 uv_stride = 0;
+    YCbCrType yuv_type = YCBCR_601;
+    Uint8 *rgb = (Uint8 *) bands->dst + row * bands->dst_pitch;
+    const int uv_row = IsPlanar2x2Format(bands->src_format) ? (row / 2) : row;
+
+    /* These were checked before the conversion started */
+    GetYUVPlanes(bands->width, bands->height, bands->src_format, bands->src, bands->src_pitch, &y, &u, &v, &y_stride, &uv_stride);
+    GetYUVConversionType(bands->width, bands->height, &yuv_type);
+    y += row * y_stride;
+    u += uv_row * uv_stride;
+    v += uv_row * uv_stride;
+
+    if (!yuv_rgb_avx2(bands->src_format, bands->dst_format, bands->width, rows, y, u, v, y_stride, uv_stride, rgb, bands->dst_pitch, yuv_type) &&
+        !yuv_rgb_neon(bands->src_format, bands->dst_format, bands->width, rows, y, u, v, y_stride, uv_stride, rgb, bands->dst_pitch, yuv_type) &&
+        !yuv_rgb_sse(bands->src_format, bands->dst_format, bands->width, rows, y, u, v, y_stride, uv_stride, rgb, bands->dst_pitch, yuv_type)) {
+        yuv_rgb_std(bands->src_format, bands->dst_format, bands->width, rows, y, u, v, y_stride, uv_stride, rgb, bands->dst_pitch, yuv_type);
+    }
+}
+
 int
 SDL_ConvertPixels_YUV_to_RGB(int width, int height,
          Uint32 src_format, const void *src, int src_pitch,
@@ -413,11 +697,17 @@ SDL_ConvertPixels_YUV_to_RGB(int width, int height,
         return -1;
     }
 
-    if (yuv_rgb_sse(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8*)dst, dst_pitch, yuv_type)) {
-        return 0;
-    }
-
-    if (yuv_rgb_std(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8*)dst, dst_pitch, yuv_type)) {
+    if (yuv_rgb_supported(dst_format)) {
+        YUVRowBands bands;
+        bands.width = width;
+        bands.height = height;
+        bands.src_format = src_format;
+        bands.src = src;
+        bands.src_pitch = src_pitch;
+        bands.dst_format = dst_format;
+        bands.dst = dst;
+        bands.dst_pitch = dst_pitch;
+        SDL_RunRowBands(width, height, 2, yuv_rgb_rows, &bands);
         return 0;
     }
 
@@ -456,12 +746,323 @@ struct RGB2YUVFactors
     float v[3]; /* Rfactor, Gfactor, Bfactor */
 };
 
+#if SDL_AVX2_INTRINSICS
+/* Eight values of MAKE_Y/MAKE_U/MAKE_V below, with the same float operations in the same order */
+SDL_TARGETING("avx2")
+SDL_FORCE_INLINE __m256i
+RGB_to_YUV8_AVX2(__m256i r, __m256i g, __m256i b, const float *factors, int offset)
+{
+    __m256 yuv = _mm256_mul_ps(_mm256_set1_ps(factors[0]), _mm256_cvtepi32_ps(r));
+    yuv = _mm256_add_ps(yuv, _mm256_mul_ps(_mm256_set1_ps(factors[1]), _mm256_cvtepi32_ps(g)));
+    yuv = _mm256_add_ps(yuv, _mm256_mul_ps(_mm256_set1_ps(factors[2]), _mm256_cvtepi32_ps(b)));
+    yuv = _mm256_add_ps(yuv, _mm256_set1_ps(0.5f));
+    return _mm256_and_si256(_mm256_add_epi32(_mm256_cvttps_epi32(yuv), _mm256_set1_epi32(offset)), _mm256_set1_epi32(0xFF));
+}
+
+/* Packs sixteen 32-bit values below 256 to bytes, keeping their order */
+SDL_TARGETING("avx2")
+SDL_FORCE_INLINE __m128i
+Pack16_AVX2(__m256i lo, __m256i hi)
+{
+    const __m256i words = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xD8);
+    return _mm_packus_epi16(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1));
+}
+
+SDL_TARGETING("avx2")
+SDL_FORCE_INLINE __m128i
+ARGB8888_to_Y16_AVX2(__m256i p1, __m256i p2, const struct RGB2YUVFactors *cvt)
+{
+    const __m256i mask = _mm256_set1_epi32(0xFF);
+    const __m256i y1 = RGB_to_YUV8_AVX2(_mm256_and_si256(_mm256_srli_epi32(p1, 16), mask),
+                                        _mm256_and_si256(_mm256_srli_epi32(p1, 8), mask),
+                                        _mm256_and_si256(p1, mask), cvt->y, cvt->y_offset);
+    const __m256i y2 = RGB_to_YUV8_AVX2(_mm256_and_si256(_mm256_srli_epi32(p2, 16), mask),
+                                        _mm256_and_si256(_mm256_srli_epi32(p2, 8), mask),
+                                        _mm256_and_si256(p2, mask), cvt->y, cvt->y_offset);
+    return Pack16_AVX2(y1, y2);
+}
+
+SDL_TARGETING("avx2")
 static int
-SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int src_pitch, Uint32 dst_format, void *dst, int dst_pitch)
+ARGB8888_to_Y_AVX2(const Uint8 *src, Uint8 *dst, int width, const struct RGB2YUVFactors *cvt)
+{
+    int i;
+
+    for (i = 0; i + 16 <= width; i += 16) {
+        const __m256i p1 = _mm256_loadu_si256((const __m256i *)(src + i * 4));
+        const __m256i p2 = _mm256_loadu_si256((const __m256i *)(src + i * 4 + 32));
+        _mm_storeu_si128((__m128i *)(dst + i), ARGB8888_to_Y16_AVX2(p1, p2, cvt));
+    }
+    return i;
+}
+
+SDL_TARGETING("avx2")
+static int
+ARGB8888_to_UV_AVX2(const Uint8 *curr_row, const Uint8 *next_row, Uint8 *plane_u, Uint8 *plane_v,
+                    int count, Uint32 dst_format, const struct RGB2YUVFactors *cvt)
+{
+    const __m256i mask = _mm256_set1_epi32(0x00FF00FF);
+    const __m256i low_mask = _mm256_set1_epi32(0xFFFF);
+    int i;
+
+    for (i = 0; i + 8 <= count; i += 8) {
+        const __m256i p1 = _mm256_loadu_si256((const __m256i *)(curr_row + i * 8));
+        const __m256i p2 = _mm256_loadu_si256((const __m256i *)(curr_row + i * 8 + 32));
+        const __m256i p3 = _mm256_loadu_si256((const __m256i *)(next_row + i * 8));
+        const __m256i p4 = _mm256_loadu_si256((const __m256i *)(next_row + i * 8 + 32));
+        /* Sum red and blue, and alpha and green, of each 2x2 block in 16-bit halves */
+        __m256i rb = _mm256_hadd_epi32(
+            _mm256_add_epi32(_mm256_and_si256(p1, mask), _mm256_and_si256(p3, mask)),
+            _mm256_add_epi32(_mm256_and_si256(p2, mask), _mm256_and_si256(p4, mask)));
+        __m256i ag = _mm256_hadd_epi32(
+            _mm256_add_epi32(_mm256_and_si256(_mm256_srli_epi32(p1, 8), mask), _mm256_and_si256(_mm256_srli_epi32(p3, 8), mask)),
+            _mm256_add_epi32(_mm256_and_si256(_mm256_srli_epi32(p2, 8), mask), _mm256_and_si256(_mm256_srli_epi32(p4, 8), mask)));
+        __m256i r, g, b;
+        __m128i uv;
+
+        rb = _mm256_permute4x64_epi64(rb, 0xD8);
+        ag = _mm256_permute4x64_epi64(ag, 0xD8);
+        r = _mm256_srli_epi32(rb, 18);
+        g = _mm256_srli_epi32(_mm256_and_si256(ag, low_mask), 2);
+        b = _mm256_srli_epi32(_mm256_and_si256(rb, low_mask), 2);
+        uv = Pack16_AVX2(RGB_to_YUV8_AVX2(r, g, b, cvt->u, 128), RGB_to_YUV8_AVX2(r, g, b, cvt->v, 128));
+
+        if (dst_format == SDL_PIXELFORMAT_NV12) {
+            _mm_storeu_si128((__m128i *)plane_u, _mm_unpacklo_epi8(uv, _mm_srli_si128(uv, 8)));
+            plane_u += 16;
+        } else if (dst_format == SDL_PIXELFORMAT_NV21) {
+            _mm_storeu_si128((__m128i *)plane_u, _mm_unpacklo_epi8(_mm_srli_si128(uv, 8), uv));
+            plane_u += 16;
+        } else {
+            _mm_storel_epi64((__m128i *)plane_u, uv);
+            _mm_storel_epi64((__m128i *)plane_v, _mm_srli_si128(uv, 8));
+            plane_u += 8;
+            plane_v += 8;
+        }
+    }
+    return i;
+}
+
+SDL_TARGETING("avx2")
+static int
+ARGB8888_to_Packed_AVX2(const Uint8 *src, Uint8 *dst, int count, Uint32 dst_format, const struct RGB2YUVFactors *cvt)
+{
+    const __m256i mask = _mm256_set1_epi32(0x00FF00FF);
+    const __m256i low_mask = _mm256_set1_epi32(0xFFFF);
+    int i;
+
+    for (i = 0; i + 8 <= count; i += 8) {
+        const __m256i p1 = _mm256_loadu_si256((const __m256i *)(src + i * 8));
+        const __m256i p2 = _mm256_loadu_si256((const __m256i *)(src + i * 8 + 32));
+        const __m128i y = ARGB8888_to_Y16_AVX2(p1, p2, cvt);
+        /* Sum red and blue, and alpha and green, of each pixel pair in 16-bit halves */
+        const __m256i rb = _mm256_permute4x64_epi64(_mm256_hadd_epi32(_mm256_and_si256(p1, mask), _mm256_and_si256(p2, mask)), 0xD8);
+        const __m256i ag = _mm256_permute4x64_epi64(_mm256_hadd_epi32(_mm256_and_si256(_mm256_srli_epi32(p1, 8), mask),
+                                                                      _mm256_and_si256(_mm256_srli_epi32(p2, 8), mask)), 0xD8);
+        const __m256i r = _mm256_srli_epi32(rb, 17);
+        const __m256i g = _mm256_srli_epi32(_mm256_and_si256(ag, low_mask), 1);
+        const __m256i b = _mm256_srli_epi32(_mm256_and_si256(rb, low_mask), 1);
+        const __m128i uv = Pack16_AVX2(RGB_to_YUV8_AVX2(r, g, b, cvt->u, 128), RGB_to_YUV8_AVX2(r, g, b, cvt->v, 128));
+        const __m128i u = uv;
+        const __m128i v = _mm_srli_si128(uv, 8);
+        __m128i lo, hi;
+
+        if (dst_format == SDL_PIXELFORMAT_YUY2) {
+            const __m128i chroma = _mm_unpacklo_epi8(u, v);
+            lo = _mm_unpacklo_epi8(y, chroma);
+            hi = _mm_unpackhi_epi8(y, chroma);
+        } else if (dst_format == SDL_PIXELFORMAT_UYVY) {
+            const __m128i chroma = _mm_unpacklo_epi8(u, v);
+            lo = _mm_unpacklo_epi8(chroma, y);
+            hi = _mm_unpackhi_epi8(chroma, y);
+        } else { /* SDL_PIXELFORMAT_YVYU */
+            const __m128i chroma = _mm_unpacklo_epi8(v, u);
+            lo = _mm_unpacklo_epi8(y, chroma);
+            hi = _mm_unpackhi_epi8(y, chroma);
+        }
+        _mm_storeu_si128((__m128i *)(dst + i * 4), lo);
+        _mm_storeu_si128((__m128i *)(dst + i * 4 + 16), hi);
+    }
+    return i;
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+/* Eight values of MAKE_Y/MAKE_U/MAKE_V below, from 16-bit channels */
+static SDL_INLINE uint8x8_t
+RGB_to_YUV8_NEON(uint16x8_t r, uint16x8_t g, uint16x8_t b, const float *factors, int offset)
+{
+    float32x4_t lo, hi;
+
+    lo = vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(r))), factors[0]);
+    lo = vaddq_f32(lo, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(g))), factors[1]));
+    lo = vaddq_f32(lo, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(b))), factors[2]));
+    lo = vaddq_f32(lo, vdupq_n_f32(0.5f));
+    hi = vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(r))), factors[0]);
+    hi = vaddq_f32(hi, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(g))), factors[1]));
+    hi = vaddq_f32(hi, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(b))), factors[2]));
+    hi = vaddq_f32(hi, vdupq_n_f32(0.5f));
+
+    /* The narrowing keeps the low bits, like the (Uint8) cast */
+    return vmovn_u16(vreinterpretq_u16_s16(vcombine_s16(
+        vmovn_s32(vaddq_s32(vcvtq_s32_f32(lo), vdupq_n_s32(offset))),
+        vmovn_s32(vaddq_s32(vcvtq_s32_f32(hi), vdupq_n_s32(offset))))));
+}
+
+/* Y of 16 pixels, ARGB8888 is B, G, R, A in memory */
+static SDL_INLINE uint8x16_t
+ARGB8888_to_Y16_NEON(uint8x16x4_t p, const struct RGB2YUVFactors *cvt)
+{
+    return vcombine_u8(
+        RGB_to_YUV8_NEON(vmovl_u8(vget_low_u8(p.val[2])), vmovl_u8(vget_low_u8(p.val[1])), vmovl_u8(vget_low_u8(p.val[0])), cvt->y, cvt->y_offset),
+        RGB_to_YUV8_NEON(vmovl_u8(vget_high_u8(p.val[2])), vmovl_u8(vget_high_u8(p.val[1])), vmovl_u8(vget_high_u8(p.val[0])), cvt->y, cvt->y_offset));
+}
+
+static int
+ARGB8888_to_Y_NEON(const Uint8 *src, Uint8 *dst, int width, const struct RGB2YUVFactors *cvt)
+{
+    int i;
+
+    for (i = 0; i + 16 <= width; i += 16) {
+        vst1q_u8(dst + i, ARGB8888_to_Y16_NEON(vld4q_u8(src + i * 4), cvt));
+    }
+    return i;
+}
+
+static int
+ARGB8888_to_UV_NEON(const Uint8 *curr_row, const Uint8 *next_row, Uint8 *plane_u, Uint8 *plane_v,
+                    int count, Uint32 dst_format, const struct RGB2YUVFactors *cvt)
 {
+    int i;
+
+    for (i = 0; i + 8 <= count; i += 8) {
+        const uint8x16x4_t p1 = vld4q_u8(curr_row + i * 8);
+        const uint8x16x4_t p2 = vld4q_u8(next_row + i * 8);
+        /* Sum each 2x2 block: pairwise within the row, then add the next row */
+        const uint16x8_t r = vshrq_n_u16(vpadalq_u8(vpaddlq_u8(p1.val[2]), p2.val[2]), 2);
+        const uint16x8_t g = vshrq_n_u16(vpadalq_u8(vpaddlq_u8(p1.val[1]), p2.val[1]), 2);
+        const uint16x8_t b = vshrq_n_u16(vpadalq_u8(vpaddlq_u8(p1.val[0]), p2.val[0]), 2);
+        const uint8x8_t u = RGB_to_YUV8_NEON(r, g, b, cvt->u, 128);
+        const uint8x8_t v = RGB_to_YUV8_NEON(r, g, b, cvt->v, 128);
+
+        if (dst_format == SDL_PIXELFORMAT_NV12 || dst_format == SDL_PIXELFORMAT_NV21) {
+            uint8x8x2_t uv;
+            uv.val[0] = (dst_format == SDL_PIXELFORMAT_NV12) ? u : v;
+            uv.val[1] = (dst_format == SDL_PIXELFORMAT_NV12) ? v : u;
+            vst2_u8(plane_u, uv);
+            plane_u += 16;
+        } else {
+            vst1_u8(plane_u, u);
+            vst1_u8(plane_v, v);
+            plane_u += 8;
+            plane_v += 8;
+        }
+    }
+    return i;
+}
+
+static int
+ARGB8888_to_Packed_NEON(const Uint8 *src, Uint8 *dst, int count, Uint32 dst_format, const struct RGB2YUVFactors *cvt)
+{
+    int i;
+
+    for (i = 0; i + 8 <= count; i += 8) {
+        const uint8x16x4_t p = vld4q_u8(src + i * 8);
+        const uint8x16_t y = ARGB8888_to_Y16_NEON(p, cvt);
+        /* Even and odd pixels of each pair */
+        const uint8x8x2_t y01 = vuzp_u8(vget_low_u8(y), vget_high_u8(y));
+        const uint16x8_t r = vshrq_n_u16(vpaddlq_u8(p.val[2]), 1);
+        const uint16x8_t g = vshrq_n_u16(vpaddlq_u8(p.val[1]), 1);
+        const uint16x8_t b = vshrq_n_u16(vpaddlq_u8(p.val[0]), 1);
+        const uint8x8_t u = RGB_to_YUV8_NEON(r, g, b, cvt->u, 128);
+        const uint8x8_t v = RGB_to_YUV8_NEON(r, g, b, cvt->v, 128);
+        uint8x8x4_t yuv;
+
+        if (dst_format == SDL_PIXELFORMAT_YUY2) {
+            yuv.val[0] = y01.val[0];
+            yuv.val[1] = u;
+            yuv.val[2] = y01.val[1];
+            yuv.val[3] = v;
+        } else if (dst_format == SDL_PIXELFORMAT_UYVY) {
+            yuv.val[0] = u;
+            yuv.val[1] = y01.val[0];
+            yuv.val[2] = v;
+            yuv.val[3] = y01.val[1];
+        } else { /* SDL_PIXELFORMAT_YVYU */
+            yuv.val[0] = y01.val[0];
+            yuv.val[1] = v;
+            yuv.val[2] = y01.val[1];
+            yuv.val[3] = u;
+        }
+        vst4_u8(dst + i * 4, yuv);
+    }
+    return i;
+}
+#endif /* HAVE_NEON_INTRINSICS */
+
+/* These convert the leading part of a row the SIMD code can handle, and return how much of it was done */
+static int
+ARGB8888_to_Y_SIMD(const Uint8 *src, Uint8 *dst, int width, const struct RGB2YUVFactors *cvt)
+{
+#if SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        return ARGB8888_to_Y_AVX2(src, dst, width, cvt);
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return ARGB8888_to_Y_NEON(src, dst, width, cvt);
+    }
+#endif
+    return 0;
+}
+
+static int
+ARGB8888_to_UV_SIMD(const Uint8 *curr_row, const Uint8 *next_row, Uint8 *plane_u, Uint8 *plane_v,
+                    int count, Uint32 dst_format, const struct RGB2YUVFactors *cvt)
+{
+#if SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        return ARGB8888_to_UV_AVX2(curr_row, next_row, plane_u, plane_v, count, dst_format, cvt);
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return ARGB8888_to_UV_NEON(curr_row, next_row, plane_u, plane_v, count, dst_format, cvt);
+    }
+#endif
+    return 0;
+}
+
+static int
+ARGB8888_to_Packed_SIMD(const Uint8 *src, Uint8 *dst, int count, Uint32 dst_format, const struct RGB2YUVFactors *cvt)
+{
+#if SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        return ARGB8888_to_Packed_AVX2(src, dst, count, dst_format, cvt);
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return ARGB8888_to_Packed_NEON(src, dst, count, dst_format, cvt);
+    }
+#endif
+    return 0;
+}
+
+/* Converts rows [row, row + rows) of the image, row has to be even */
+static void
+SDL_ConvertPixels_ARGB8888_to_YUV_Rows(void *userdata, int row, int rows)
+{
+    const YUVRowBands *bands = (const YUVRowBands *) userdata;
+    const int width            = bands->width;
+    const int height           = bands->height;
+    const int src_pitch        = bands->src_pitch;
+    const Uint32 dst_format    = bands->dst_format;
     const int src_pitch_x_2    = src_pitch * 2;
-    const int height_half      = height / 2;
-    const int height_remainder = (height & 0x1);
+    const int height_half      = rows / 2;
+    const int height_remainder = (rows & 0x1);
+    const Uint8 *src           = (const Uint8 *) bands->src + row * src_pitch;
     const int width_half       = width / 2;
     const int width_remainder  = (width & 0x1);
     int i, j;
@@ -555,17 +1156,24 @@ SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int sr
             Uint8 *plane_interleaved_uv;
             Uint32 y_stride, uv_stride, y_skip, uv_skip;
 
-            GetYUVPlanes(width, height, dst_format, dst, dst_pitch,
+            GetYUVPlanes(width, height, dst_format, bands->dst, bands->dst_pitch,
                          (const Uint8 **)&plane_y, (const Uint8 **)&plane_u, (const Uint8 **)&plane_v,
                          &y_stride, &uv_stride);
             plane_interleaved_uv = (plane_y + height * y_stride);
             y_skip = (y_stride - width);
 
+            plane_y += row * y_stride;
+            plane_u += (row / 2) * uv_stride;
+            plane_v += (row / 2) * uv_stride;
+            plane_interleaved_uv += (row / 2) * uv_stride;
+
             curr_row = (const Uint8*)src;
 
             /* Write Y plane */
-            for (j = 0; j < height; j++) {
-                for (i = 0; i < width; i++) {
+            for (j = 0; j < rows; j++) {
+                i = ARGB8888_to_Y_SIMD(curr_row, plane_y, width, cvt);
+                plane_y += i;
+                for (; i < width; i++) {
                     const Uint32 p1 = ((const Uint32 *)curr_row)[i];
                     const Uint32 r = (p1 & 0x00ff0000) >> 16;
                     const Uint32 g = (p1 & 0x0000ff00) >> 8;
@@ -585,7 +1193,10 @@ SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int sr
                 /* Write UV planes, not interleaved */
                 uv_skip = (uv_stride - (width + 1)/2);
                 for (j = 0; j < height_half; j++) {
-                    for (i = 0; i < width_half; i++) {
+                    i = ARGB8888_to_UV_SIMD(curr_row, next_row, plane_u, plane_v, width_half, dst_format, cvt);
+                    plane_u += i;
+                    plane_v += i;
+                    for (; i < width_half; i++) {
                         READ_2x2_PIXELS;
                         *plane_u++ = MAKE_U(r, g, b);
                         *plane_v++ = MAKE_V(r, g, b);
@@ -619,7 +1230,9 @@ SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int sr
             {
                 uv_skip = (uv_stride - ((width + 1)/2)*2);
                 for (j = 0; j < height_half; j++) {
-                    for (i = 0; i < width_half; i++) {
+                    i = ARGB8888_to_UV_SIMD(curr_row, next_row, plane_interleaved_uv, NULL, width_half, dst_format, cvt);
+                    plane_interleaved_uv += 2 * i;
+                    for (; i < width_half; i++) {
                         READ_2x2_PIXELS;
                         *plane_interleaved_uv++ = MAKE_U(r, g, b);
                         *plane_interleaved_uv++ = MAKE_V(r, g, b);
@@ -650,7 +1263,9 @@ SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int sr
             {
                 uv_skip = (uv_stride - ((width + 1)/2)*2);
                 for (j = 0; j < height_half; j++) {
-                    for (i = 0; i < width_half; i++) {
+                    i = ARGB8888_to_UV_SIMD(curr_row, next_row, plane_interleaved_uv, NULL, width_half, dst_format, cvt);
+                    plane_interleaved_uv += 2 * i;
+                    for (; i < width_half; i++) {
                         READ_2x2_PIXELS;
                         *plane_interleaved_uv++ = MAKE_V(r, g, b);
                         *plane_interleaved_uv++ = MAKE_U(r, g, b);
@@ -685,20 +1300,17 @@ SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int sr
     case SDL_PIXELFORMAT_YVYU:
         {
             const Uint8 *curr_row = (const Uint8*) src;
-            Uint8 *plane           = (Uint8*) dst;
+            Uint8 *plane           = (Uint8*) bands->dst + row * bands->dst_pitch;
             const int row_size = (4 * ((width + 1) / 2));
-            int plane_skip;
-
-            if (dst_pitch < row_size) {
-                return SDL_SetError("Destination pitch is too small, expected at least %d\n", row_size);
-            }
-            plane_skip = (dst_pitch - row_size);
+            const int plane_skip = (bands->dst_pitch - row_size);
 
             /* Write YUV plane, packed */
             if (dst_format == SDL_PIXELFORMAT_YUY2) 
             {
-                for (j = 0; j < height; j++) {
-                    for (i = 0; i < width_half; i++) {
+                for (j = 0; j < rows; j++) {
+                    i = ARGB8888_to_Packed_SIMD(curr_row, plane, width_half, dst_format, cvt);
+                    plane += 4 * i;
+                    for (; i < width_half; i++) {
                         READ_TWO_RGB_PIXELS;
                         /* Y U Y1 V */
                         *plane++ = MAKE_Y(r, g, b);
@@ -720,8 +1332,10 @@ SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int sr
             } 
             else if (dst_format == SDL_PIXELFORMAT_UYVY)
             {
-                for (j = 0; j < height; j++) {
-                    for (i = 0; i < width_half; i++) {
+                for (j = 0; j < rows; j++) {
+                    i = ARGB8888_to_Packed_SIMD(curr_row, plane, width_half, dst_format, cvt);
+                    plane += 4 * i;
+                    for (; i < width_half; i++) {
                         READ_TWO_RGB_PIXELS;
                         /* U Y V Y1 */
                         *plane++ = MAKE_U(R, G, B);
@@ -743,8 +1357,10 @@ SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int sr
             }
             else if (dst_format == SDL_PIXELFORMAT_YVYU)
             {
-                for (j = 0; j < height; j++) {
-                    for (i = 0; i < width_half; i++) {
+                for (j = 0; j < rows; j++) {
+                    i = ARGB8888_to_Packed_SIMD(curr_row, plane, width_half, dst_format, cvt);
+                    plane += 4 * i;
+                    for (; i < width_half; i++) {
                         READ_TWO_RGB_PIXELS;
                         /* Y V Y1 U */
                         *plane++ = MAKE_Y(r, g, b);
@@ -768,7 +1384,7 @@ SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int sr
         break;
 
     default:
-        return SDL_SetError("Unsupported YUV destination format: %s", SDL_GetPixelFormatName(dst_format));
+        break;
     }
 #undef MAKE_Y
 #undef MAKE_U
@@ -779,6 +1395,42 @@ SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int sr
 #undef READ_1x1_PIXEL
 #undef READ_TWO_RGB_PIXELS
 #undef READ_ONE_RGB_PIXEL
+}
+
+static int
+SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int src_pitch, Uint32 dst_format, void *dst, int dst_pitch)
+{
+    YUVRowBands bands;
+
+    switch (dst_format) {
+    case SDL_PIXELFORMAT_YV12:
+    case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        break;
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_UYVY:
+    case SDL_PIXELFORMAT_YVYU:
+        {
+            const int row_size = (4 * ((width + 1) / 2));
+            if (dst_pitch < row_size) {
+                return SDL_SetError("Destination pitch is too small, expected at least %d\n", row_size);
+            }
+        }
+        break;
+    default:
+        return SDL_SetError("Unsupported YUV destination format: %s", SDL_GetPixelFormatName(dst_format));
+    }
+
+    bands.width = width;
+    bands.height = height;
+    bands.src_format = SDL_PIXELFORMAT_ARGB8888;
+    bands.src = src;
+    bands.src_pitch = src_pitch;
+    bands.dst_format = dst_format;
+    bands.dst = dst;
+    bands.dst_pitch = dst_pitch;
+    SDL_RunRowBands(width, height, 2, SDL_ConvertPixels_ARGB8888_to_YUV_Rows, &bands);
     return 0;
 }
 
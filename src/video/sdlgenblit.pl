@@ -85,6 +85,40 @@ my %set_rgba_string = (
     "BGRA8888" => "_pixel = (_B << 24) | (_G << 16) | (_R << 8) | _A;",
 );
 
+# Byte offset of each channel within the 32-bit pixel, used by the SIMD blitters
+my %format_bytes = (
+    "RGB888" => { "R" => 2, "G" => 1, "B" => 0 },
+    "BGR888" => { "R" => 0, "G" => 1, "B" => 2 },
+    "ARGB8888" => { "R" => 2, "G" => 1, "B" => 0, "A" => 3 },
+    "RGBA8888" => { "R" => 3, "G" => 2, "B" => 1, "A" => 0 },
+    "ABGR8888" => { "R" => 0, "G" => 1, "B" => 2, "A" => 3 },
+    "BGRA8888" => { "R" => 1, "G" => 2, "B" => 3, "A" => 0 },
+);
+
+# The SIMD blitters we're creating, chosen at runtime through SDL_CPU_* flags
+my @simd_isas = (
+    {
+        "name" => "AVX2",
+        "guard" => "SDL_AVX2_INTRINSICS",
+        "target" => "avx2",
+        "cpu" => "SDL_CPU_AVX2",
+        "type" => "__m256i",
+        "prefix" => "_mm256",
+        "suffix" => "si256",
+        "pixels" => 8,
+    },
+    {
+        "name" => "SSE41",
+        "guard" => "SDL_SSE4_1_INTRINSICS",
+        "target" => "sse4.1",
+        "cpu" => "SDL_CPU_SSE41",
+        "type" => "__m128i",
+        "prefix" => "_mm",
+        "suffix" => "si128",
+        "pixels" => 4,
+    },
+);
+
 sub open_file {
     my $name = shift;
     open(FILE, ">$name.new") || die "Cant' open $name.new: $!";
@@ -153,6 +187,7 @@ sub output_copyfuncname
     my $scale = shift;
     my $args = shift;
     my $suffix = shift;
+    my $isa = shift;
 
     print FILE "$prefix SDL_Blit_${src}_${dst}";
     if ( $modulate ) {
@@ -164,6 +199,9 @@ sub output_copyfuncname
     if ( $scale ) {
         print FILE "_Scale";
     }
+    if ( $isa ) {
+        print FILE "_$isa->{name}";
+    }
     if ( $args ) {
         print FILE "(SDL_BlitInfo *info)";
     }
@@ -518,6 +556,221 @@ __EOF__
 __EOF__
 }
 
+sub output_simdhelpers
+{
+    my $isa = shift;
+    my $name = $isa->{name};
+    my $type = $isa->{type};
+    my $mm = $isa->{prefix};
+    my $si = $isa->{suffix};
+
+    print FILE <<__EOF__;
+#if $isa->{guard}
+
+/* x / 255, rounded down, for 0 <= x <= 255 * 255 in each 16-bit lane */
+SDL_TARGETING("$isa->{target}")
+SDL_FORCE_INLINE $type SDL_Blit_Div255_$name($type x)
+{
+    x = ${mm}_add_epi16(x, ${mm}_set1_epi16(1));
+    return ${mm}_srli_epi16(${mm}_add_epi16(x, ${mm}_srli_epi16(x, 8)), 8);
+}
+
+/* Modulates pixels in destination channel order, with alpha in the top byte */
+SDL_TARGETING("$isa->{target}")
+SDL_FORCE_INLINE $type SDL_Blit_ModulatePixels_$name($type s, $type modulate)
+{
+    const $type zero = ${mm}_setzero_$si();
+    $type lo = ${mm}_unpacklo_epi8(s, zero);
+    $type hi = ${mm}_unpackhi_epi8(s, zero);
+    lo = SDL_Blit_Div255_$name(${mm}_mullo_epi16(lo, modulate));
+    hi = SDL_Blit_Div255_$name(${mm}_mullo_epi16(hi, modulate));
+    return ${mm}_packus_epi16(lo, hi);
+}
+
+/* Same math as the scalar blitters, for pixels in destination channel order */
+SDL_TARGETING("$isa->{target}")
+SDL_FORCE_INLINE $type SDL_Blit_BlendPixels_$name($type s, $type d, int mode)
+{
+    const $type zero = ${mm}_setzero_$si();
+    const $type full = ${mm}_set1_epi16(255);
+    const $type alpha = ${mm}_slli_epi32(${mm}_set1_epi32(0xFF), 24);
+    $type slo = ${mm}_unpacklo_epi8(s, zero);
+    $type shi = ${mm}_unpackhi_epi8(s, zero);
+    $type dlo = ${mm}_unpacklo_epi8(d, zero);
+    $type dhi = ${mm}_unpackhi_epi8(d, zero);
+    $type alo = ${mm}_shufflehi_epi16(${mm}_shufflelo_epi16(slo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    $type ahi = ${mm}_shufflehi_epi16(${mm}_shufflelo_epi16(shi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+    if (mode == SDL_COPY_MOD) {
+        dlo = SDL_Blit_Div255_$name(${mm}_mullo_epi16(slo, dlo));
+        dhi = SDL_Blit_Div255_$name(${mm}_mullo_epi16(shi, dhi));
+        return ${mm}_blendv_epi8(${mm}_packus_epi16(dlo, dhi), d, alpha);
+    }
+
+    /* This goes away if we ever use premultiplied alpha */
+    slo = SDL_Blit_Div255_$name(${mm}_mullo_epi16(slo, ${mm}_blend_epi16(alo, full, 0x88)));
+    shi = SDL_Blit_Div255_$name(${mm}_mullo_epi16(shi, ${mm}_blend_epi16(ahi, full, 0x88)));
+
+    if (mode == SDL_COPY_ADD) {
+        return ${mm}_blendv_epi8(${mm}_adds_epu8(${mm}_packus_epi16(slo, shi), d), d, alpha);
+    }
+
+    /* SDL_COPY_BLEND */
+    dlo = ${mm}_add_epi16(slo, SDL_Blit_Div255_$name(${mm}_mullo_epi16(${mm}_sub_epi16(full, alo), dlo)));
+    dhi = ${mm}_add_epi16(shi, SDL_Blit_Div255_$name(${mm}_mullo_epi16(${mm}_sub_epi16(full, ahi), dhi)));
+    return ${mm}_packus_epi16(dlo, dhi);
+}
+
+#endif /* $isa->{guard} */
+
+__EOF__
+}
+
+sub output_simdfunc
+{
+    my $isa = shift;
+    my $src = shift;
+    my $dst = shift;
+    my $modulate = shift;
+    my $blend = shift;
+    my $name = $isa->{name};
+    my $type = $isa->{type};
+    my $mm = $isa->{prefix};
+    my $si = $isa->{suffix};
+    my $pixels = $isa->{pixels};
+    my $pixels_mask = $pixels - 1;
+    my $src_has_alpha = ($src =~ /A/) ? 1 : 0;
+    my $dst_has_alpha = ($dst =~ /A/) ? 1 : 0;
+    my @dst_channels = ( "", "", "", "A" );
+    my @shuffle = ();
+    my @modulate = ();
+
+    foreach my $channel ("R", "G", "B") {
+        $dst_channels[$format_bytes{$dst}{$channel}] = $channel;
+    }
+    for (my $lane = 0; $lane < $pixels / 4; ++$lane) {
+        for (my $i = 0; $i < 4; ++$i) {
+            for (my $j = 0; $j < 4; ++$j) {
+                my $channel = $dst_channels[$j];
+                if ( defined($format_bytes{$src}{$channel}) ) {
+                    push(@shuffle, $i * 4 + $format_bytes{$src}{$channel});
+                } else {
+                    push(@shuffle, -1);
+                }
+            }
+        }
+    }
+    for (my $i = 0; $i < $pixels / 2; ++$i) {
+        foreach my $channel (@dst_channels) {
+            push(@modulate, "modulate$channel");
+        }
+    }
+    my $shuffle = join(", ", @shuffle);
+    my $modulate_args = join(", ", @modulate);
+
+    print FILE "#if $isa->{guard}\n";
+    print FILE "SDL_TARGETING(\"$isa->{target}\")\n";
+    output_copyfuncname("static void", $src, $dst, $modulate, $blend, 0, 1, "\n", $isa);
+    print FILE <<__EOF__;
+{
+    const int width = info->dst_w & ~$pixels_mask;
+    const $type shuffle = ${mm}_setr_epi8($shuffle);
+__EOF__
+    if ( $modulate ) {
+        print FILE <<__EOF__;
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const $type modulate = ${mm}_setr_epi16($modulate_args);
+__EOF__
+    }
+    if ( $blend ) {
+        print FILE <<__EOF__;
+    const int mode = info->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+__EOF__
+    }
+    if ( !$src_has_alpha ) {
+        print FILE <<__EOF__;
+    const $type srcalpha = ${mm}_slli_epi32(${mm}_set1_epi32(0xFF), 24);
+__EOF__
+    }
+    if ( !$dst_has_alpha ) {
+        print FILE <<__EOF__;
+    const $type dstmask = ${mm}_set1_epi32(0x00FFFFFF);
+__EOF__
+    }
+    print FILE <<__EOF__;
+    Uint8 *srcrow = info->src;
+    Uint8 *dstrow = info->dst;
+    int height = info->dst_h;
+
+    while (height--) {
+        const $type *src = (const $type *)srcrow;
+        $type *dst = ($type *)dstrow;
+        int n;
+        for (n = width; n; n -= $pixels) {
+            $type pixels = ${mm}_shuffle_epi8(${mm}_loadu_$si(src++), shuffle);
+__EOF__
+    if ( !$src_has_alpha ) {
+        print FILE <<__EOF__;
+            pixels = ${mm}_or_$si(pixels, srcalpha);
+__EOF__
+    }
+    if ( $modulate ) {
+        print FILE <<__EOF__;
+            pixels = SDL_Blit_ModulatePixels_$name(pixels, modulate);
+__EOF__
+    }
+    if ( $blend ) {
+        print FILE <<__EOF__;
+            pixels = SDL_Blit_BlendPixels_$name(pixels, ${mm}_loadu_$si(dst), mode);
+__EOF__
+    }
+    if ( !$dst_has_alpha ) {
+        print FILE <<__EOF__;
+            pixels = ${mm}_and_$si(pixels, dstmask);
+__EOF__
+    }
+    print FILE <<__EOF__;
+            ${mm}_storeu_$si(dst++, pixels);
+        }
+        srcrow += info->src_pitch;
+        dstrow += info->dst_pitch;
+    }
+
+    /* The scalar blitter finishes off the columns that don't fill a register */
+    if (width < info->dst_w) {
+        info->src += width * $format_size{$src};
+        info->dst += width * $format_size{$dst};
+        info->dst_w -= width;
+__EOF__
+    output_copyfuncname("       ", $src, $dst, $modulate, $blend, 0, 0, "(info);\n");
+    print FILE <<__EOF__;
+    }
+}
+#endif /* $isa->{guard} */
+
+__EOF__
+}
+
+sub output_simdfunc_c
+{
+    my $src = shift;
+    my $dst = shift;
+
+    foreach my $isa (@simd_isas) {
+        for (my $modulate = 0; $modulate <= 1; ++$modulate) {
+            for (my $blend = 0; $blend <= 1; ++$blend) {
+                if ( $modulate || $blend ) {
+                    output_simdfunc($isa, $src, $dst, $modulate, $blend);
+                }
+            }
+        }
+    }
+}
+
 sub output_copyfunc_h
 {
 }
@@ -537,6 +790,34 @@ sub output_copyfunctable
     print FILE <<__EOF__;
 SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
 __EOF__
+    foreach my $isa (@simd_isas) {
+        print FILE "#if $isa->{guard}\n";
+        for (my $i = 0; $i <= $#src_formats; ++$i) {
+            my $src = $src_formats[$i];
+            for (my $j = 0; $j <= $#dst_formats; ++$j) {
+                my $dst = $dst_formats[$j];
+                for (my $modulate = 0; $modulate <= 1; ++$modulate) {
+                    for (my $blend = 0; $blend <= 1; ++$blend) {
+                        if ( $modulate || $blend ) {
+                            my $flags;
+                            if ( $modulate && $blend ) {
+                                $flags = "SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD";
+                            } elsif ( $modulate ) {
+                                $flags = "SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA";
+                            } else {
+                                $flags = "SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD";
+                            }
+                            # The SIMD kernels only implement modulation and blending,
+                            # so require one of their flags to keep plain copies away
+                            print FILE "    { SDL_PIXELFORMAT_$src, SDL_PIXELFORMAT_$dst, ($flags), ($flags), $isa->{cpu},";
+                            output_copyfuncname("", $src, $dst, $modulate, $blend, 0, 0, " },\n", $isa);
+                        }
+                    }
+                }
+            }
+        }
+        print FILE "#endif\n";
+    }
     for (my $i = 0; $i <= $#src_formats; ++$i) {
         my $src = $src_formats[$i];
         for (my $j = 0; $j <= $#dst_formats; ++$j) {
@@ -575,7 +856,7 @@ __EOF__
                             if ( $flags eq "" ) {
                                 $flags = "0";
                             }
-                            print FILE "($flags), SDL_CPU_ANY,";
+                            print FILE "($flags), 0, SDL_CPU_ANY,";
                             output_copyfuncname("", $src_formats[$i], $dst_formats[$j], $modulate, $blend, $scale, 0, " },\n");
                         }
                     }
@@ -584,7 +865,7 @@ __EOF__
         }
     }
     print FILE <<__EOF__;
-    { 0, 0, 0, 0, NULL }
+    { 0, 0, 0, 0, 0, NULL }
 };
 
 __EOF__
@@ -623,5 +904,13 @@ for (my $i = 0; $i <= $#src_formats; ++$i) {
         output_copyfunc_c($src_formats[$i], $dst_formats[$j]);
     }
 }
+foreach my $isa (@simd_isas) {
+    output_simdhelpers($isa);
+}
+for (my $i = 0; $i <= $#src_formats; ++$i) {
+    for (my $j = 0; $j <= $#dst_formats; ++$j) {
+        output_simdfunc_c($src_formats[$i], $dst_formats[$j]);
+    }
+}
 output_copyfunctable();
 close_file("SDL_blit_auto.c");
@@ -705,6 +705,12 @@ X11_DispatchEvent(_THIS)
     }
 #endif
 
+    /* Wakeup events only exist to interrupt X11_WaitEventTimeout() */
+    if (xevent.type == ClientMessage &&
+        xevent.xclient.message_type == videodata->_SDL_WAKEUP) {
+        return;
+    }
+
     /* Send a SDL_SYSWMEVENT if the application wants them */
     if (SDL_GetEventState(SDL_SYSWMEVENT) == SDL_ENABLE) {
         SDL_SysWMmsg wmmsg;
@@ -1432,6 +1438,39 @@ X11_Pending(Display * display)
     return (0);
 }
 
+int
+X11_WaitEventTimeout(_THIS, int timeout)
+{
+    SDL_VideoData *data = (SDL_VideoData *) _this->driverdata;
+    Display *display = data->display;
+
+    /* Anything already read off the connection won't show up on the socket */
+    X11_XFlush(display);
+    if (X11_XEventsQueued(display, QueuedAlready)) {
+        return 1;
+    }
+    return SDL_IOReady(ConnectionNumber(display), SDL_FALSE, timeout) > 0 ? 1 : 0;
+}
+
+void
+X11_SendWakeupEvent(_THIS, SDL_Window *window)
+{
+    SDL_VideoData *data = (SDL_VideoData *) _this->driverdata;
+    Display *req_display = data->request_display;
+    Window xwindow = ((SDL_WindowData *) window->driverdata)->xwindow;
+    XClientMessageEvent event;
+
+    SDL_zero(event);
+    event.type = ClientMessage;
+    event.display = req_display;
+    event.send_event = True;
+    event.message_type = data->_SDL_WAKEUP;
+    event.format = 8;
+
+    X11_XSendEvent(req_display, xwindow, False, NoEventMask, (XEvent *) &event);
+    X11_XFlush(req_display);
+}
+
 void
 X11_PumpEvents(_THIS)
 {
@@ -116,6 +116,9 @@ X11_DeleteDevice(SDL_VideoDevice * device)
     if (data->display) {
         X11_XCloseDisplay(data->display);
     }
+    if (data->request_display) {
+        X11_XCloseDisplay(data->request_display);
+    }
     SDL_free(data->windowlist);
     SDL_free(device->driverdata);
     SDL_free(device);
@@ -216,6 +219,9 @@ X11_CreateDevice(int devindex)
     X11_XSynchronize(data->display, True);
 #endif
 
+    /* A second connection lets other threads wake us without XInitThreads() */
+    data->request_display = X11_XOpenDisplay(display);
+
     /* Hook up an X11 error handler to recover the desktop resolution. */
     safety_net_triggered = SDL_FALSE;
     orig_x11_errhandler = X11_XSetErrorHandler(X11_SafetyNetErrHandler);
@@ -231,6 +237,10 @@ X11_CreateDevice(int devindex)
     device->SetDisplayMode = X11_SetDisplayMode;
     device->SuspendScreenSaver = X11_SuspendScreenSaver;
     device->PumpEvents = X11_PumpEvents;
+    if (data->request_display) {
+        device->WaitEventTimeout = X11_WaitEventTimeout;
+        device->SendWakeupEvent = X11_SendWakeupEvent;
+    }
 
     device->CreateSDLWindow = X11_CreateWindow;
     device->CreateSDLWindowFrom = X11_CreateWindowFrom;
@@ -441,6 +451,7 @@ X11_VideoInit(_THIS)
     GET_ATOM(XdndDrop);
     GET_ATOM(XdndFinished);
     GET_ATOM(XdndSelection);
+    GET_ATOM(_SDL_WAKEUP);
     GET_ATOM(XKLAVIER_STATE);
 
     /* Detect the window manager */
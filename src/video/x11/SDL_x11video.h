@@ -75,6 +75,7 @@
 typedef struct SDL_VideoData
 {
     Display *display;
+    Display *request_display;   /* Used to send wakeup events from other threads */
     char *classname;
     pid_t pid;
     XIM im;
@@ -122,6 +123,7 @@ typedef struct SDL_VideoData
     Atom XdndFinished;
     Atom XdndSelection;
     Atom XKLAVIER_STATE;
+    Atom _SDL_WAKEUP;
 
     SDL_Scancode key_layout[256];
     SDL_bool selection_waiting;
@@ -7,6 +7,7 @@
 #include "yuv_rgb.h"
 
 #include "SDL_cpuinfo.h"
+#include "../SDL_blit.h"
 /*#include <x86intrin.h>*/
 
 #define PRECISION 6
@@ -687,4 +688,385 @@ void rgb24_yuv420_sseu(uint32_t width, uint32_t height,
 
 #endif //__SSE2__
 
+#if SDL_AVX2_INTRINSICS
+
+// chroma part of the conversion for 32 pixels, from 16 U and V values with 128 already subtracted
+SDL_TARGETING("avx2")
+SDL_FORCE_INLINE void uv2rgb_avx2(const YUV2RGBParam *param, __m256i u, __m256i v,
+	__m256i *r1, __m256i *g1, __m256i *b1, __m256i *r2, __m256i *g2, __m256i *b2)
+{
+	__m256i r_tmp, g_tmp, b_tmp;
+
+	r_tmp = _mm256_mullo_epi16(v, _mm256_set1_epi16(param->v_r_factor));
+	g_tmp = _mm256_add_epi16(
+		_mm256_mullo_epi16(u, _mm256_set1_epi16(param->u_g_factor)),
+		_mm256_mullo_epi16(v, _mm256_set1_epi16(param->v_g_factor)));
+	b_tmp = _mm256_mullo_epi16(u, _mm256_set1_epi16(param->u_b_factor));
+
+	// the unpacks work within 128 bit lanes, so order the values as 0-3 8-11 | 4-7 12-15
+	// to get pixels 0-15 in the first and pixels 16-31 in the second result
+	r_tmp = _mm256_permute4x64_epi64(r_tmp, 0xD8);
+	g_tmp = _mm256_permute4x64_epi64(g_tmp, 0xD8);
+	b_tmp = _mm256_permute4x64_epi64(b_tmp, 0xD8);
+	*r1 = _mm256_unpacklo_epi16(r_tmp, r_tmp);
+	*g1 = _mm256_unpacklo_epi16(g_tmp, g_tmp);
+	*b1 = _mm256_unpacklo_epi16(b_tmp, b_tmp);
+	*r2 = _mm256_unpackhi_epi16(r_tmp, r_tmp);
+	*g2 = _mm256_unpackhi_epi16(g_tmp, g_tmp);
+	*b2 = _mm256_unpackhi_epi16(b_tmp, b_tmp);
+}
+
+SDL_TARGETING("avx2")
+SDL_FORCE_INLINE __m256i scale_y_avx2(const YUV2RGBParam *param, __m256i y)
+{
+	return _mm256_mullo_epi16(_mm256_sub_epi16(y, _mm256_set1_epi16(param->y_shift)), _mm256_set1_epi16(param->y_factor));
+}
+
+// add luma to the chroma part of 32 pixels, and pack the result to bytes in pixel order
+SDL_TARGETING("avx2")
+SDL_FORCE_INLINE __m256i add_y_avx2(__m256i c1, __m256i c2, __m256i y1, __m256i y2)
+{
+	c1 = _mm256_srai_epi16(_mm256_add_epi16(c1, y1), PRECISION);
+	c2 = _mm256_srai_epi16(_mm256_add_epi16(c2, y2), PRECISION);
+	return _mm256_permute4x64_epi64(_mm256_packus_epi16(c1, c2), 0xD8);
+}
+
+// save 32 pixels of 4 bytes, c0 to c3 give the bytes in memory order
+SDL_TARGETING("avx2")
+SDL_FORCE_INLINE void save_32bit_avx2(uint8_t *rgb_ptr, __m256i c0, __m256i c1, __m256i c2, __m256i c3)
+{
+	const __m256i lo_01 = _mm256_unpacklo_epi8(c0, c1), hi_01 = _mm256_unpackhi_epi8(c0, c1);
+	const __m256i lo_23 = _mm256_unpacklo_epi8(c2, c3), hi_23 = _mm256_unpackhi_epi8(c2, c3);
+	// pixels 0-3 | 16-19, 4-7 | 20-23, 8-11 | 24-27 and 12-15 | 28-31
+	const __m256i rgb_1 = _mm256_unpacklo_epi16(lo_01, lo_23), rgb_2 = _mm256_unpackhi_epi16(lo_01, lo_23);
+	const __m256i rgb_3 = _mm256_unpacklo_epi16(hi_01, hi_23), rgb_4 = _mm256_unpackhi_epi16(hi_01, hi_23);
+
+	_mm256_storeu_si256((__m256i*)(rgb_ptr), _mm256_permute2x128_si256(rgb_1, rgb_2, 0x20));
+	_mm256_storeu_si256((__m256i*)(rgb_ptr+32), _mm256_permute2x128_si256(rgb_3, rgb_4, 0x20));
+	_mm256_storeu_si256((__m256i*)(rgb_ptr+64), _mm256_permute2x128_si256(rgb_1, rgb_2, 0x31));
+	_mm256_storeu_si256((__m256i*)(rgb_ptr+96), _mm256_permute2x128_si256(rgb_3, rgb_4, 0x31));
+}
+
+SDL_TARGETING("avx2")
+SDL_FORCE_INLINE void save_rgb24_avx2(uint8_t *rgb_ptr, __m256i r, __m256i g, __m256i b)
+{
+	// build 4 byte pixels as for save_32bit_avx2, then squeeze each group of 4 pixels to 12 bytes
+	const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+		0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+	const __m256i lo_rg = _mm256_unpacklo_epi8(r, g), hi_rg = _mm256_unpackhi_epi8(r, g);
+	const __m256i lo_b = _mm256_unpacklo_epi8(b, b), hi_b = _mm256_unpackhi_epi8(b, b);
+	const __m256i rgb_1 = _mm256_shuffle_epi8(_mm256_unpacklo_epi16(lo_rg, lo_b), shuffle);
+	const __m256i rgb_2 = _mm256_shuffle_epi8(_mm256_unpackhi_epi16(lo_rg, lo_b), shuffle);
+	const __m256i rgb_3 = _mm256_shuffle_epi8(_mm256_unpacklo_epi16(hi_rg, hi_b), shuffle);
+	const __m256i rgb_4 = _mm256_shuffle_epi8(_mm256_unpackhi_epi16(hi_rg, hi_b), shuffle);
+
+	// each store overwrites the 4 unused bytes of the previous one
+	_mm_storeu_si128((__m128i*)(rgb_ptr), _mm256_castsi256_si128(rgb_1));
+	_mm_storeu_si128((__m128i*)(rgb_ptr+12), _mm256_castsi256_si128(rgb_2));
+	_mm_storeu_si128((__m128i*)(rgb_ptr+24), _mm256_castsi256_si128(rgb_3));
+	_mm_storeu_si128((__m128i*)(rgb_ptr+36), _mm256_castsi256_si128(rgb_4));
+	_mm_storeu_si128((__m128i*)(rgb_ptr+48), _mm256_extracti128_si256(rgb_1, 1));
+	_mm_storeu_si128((__m128i*)(rgb_ptr+60), _mm256_extracti128_si256(rgb_2, 1));
+	_mm_storeu_si128((__m128i*)(rgb_ptr+72), _mm256_extracti128_si256(rgb_3, 1));
+	// the last group must not write past the 96 bytes
+	_mm_storeu_si128((__m128i*)(rgb_ptr+80), _mm_alignr_epi8(_mm256_extracti128_si256(rgb_4, 1),
+		_mm_slli_si128(_mm256_extracti128_si256(rgb_3, 1), 4), 12));
+}
+
+SDL_TARGETING("avx2")
+SDL_FORCE_INLINE __m256i pack_rgb565_avx2(__m128i r, __m128i g, __m128i b)
+{
+	__m256i rgb;
+	rgb = _mm256_and_si256(_mm256_slli_epi16(_mm256_cvtepu8_epi16(r), 8), _mm256_set1_epi16((short)0xF800));
+	rgb = _mm256_or_si256(rgb, _mm256_slli_epi16(_mm256_srli_epi16(_mm256_cvtepu8_epi16(g), 2), 5));
+	rgb = _mm256_or_si256(rgb, _mm256_srli_epi16(_mm256_cvtepu8_epi16(b), 3));
+	return rgb;
+}
+
+SDL_TARGETING("avx2")
+SDL_FORCE_INLINE void save_rgb565_avx2(uint8_t *rgb_ptr, __m256i r, __m256i g, __m256i b)
+{
+	_mm256_storeu_si256((__m256i*)(rgb_ptr), pack_rgb565_avx2(
+		_mm256_castsi256_si128(r), _mm256_castsi256_si128(g), _mm256_castsi256_si128(b)));
+	_mm256_storeu_si256((__m256i*)(rgb_ptr+32), pack_rgb565_avx2(
+		_mm256_extracti128_si256(r, 1), _mm256_extracti128_si256(g, 1), _mm256_extracti128_si256(b, 1)));
+}
+
+#define AVX2_FUNCTION_NAME	yuv420_rgb565_avx2
+#define STD_FUNCTION_NAME	yuv420_rgb565_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_RGB565
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuv420_rgb24_avx2
+#define STD_FUNCTION_NAME	yuv420_rgb24_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_RGB24
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuv420_rgba_avx2
+#define STD_FUNCTION_NAME	yuv420_rgba_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_RGBA
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuv420_bgra_avx2
+#define STD_FUNCTION_NAME	yuv420_bgra_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_BGRA
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuv420_argb_avx2
+#define STD_FUNCTION_NAME	yuv420_argb_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_ARGB
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuv420_abgr_avx2
+#define STD_FUNCTION_NAME	yuv420_abgr_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_ABGR
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuv422_rgb565_avx2
+#define STD_FUNCTION_NAME	yuv422_rgb565_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_RGB565
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuv422_rgb24_avx2
+#define STD_FUNCTION_NAME	yuv422_rgb24_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_RGB24
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuv422_rgba_avx2
+#define STD_FUNCTION_NAME	yuv422_rgba_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_RGBA
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuv422_bgra_avx2
+#define STD_FUNCTION_NAME	yuv422_bgra_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_BGRA
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuv422_argb_avx2
+#define STD_FUNCTION_NAME	yuv422_argb_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_ARGB
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuv422_abgr_avx2
+#define STD_FUNCTION_NAME	yuv422_abgr_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_ABGR
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuvnv12_rgb565_avx2
+#define STD_FUNCTION_NAME	yuvnv12_rgb565_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_RGB565
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuvnv12_rgb24_avx2
+#define STD_FUNCTION_NAME	yuvnv12_rgb24_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_RGB24
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuvnv12_rgba_avx2
+#define STD_FUNCTION_NAME	yuvnv12_rgba_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_RGBA
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuvnv12_bgra_avx2
+#define STD_FUNCTION_NAME	yuvnv12_bgra_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_BGRA
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuvnv12_argb_avx2
+#define STD_FUNCTION_NAME	yuvnv12_argb_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_ARGB
+#include "yuv_rgb_avx2_func.h"
+
+#define AVX2_FUNCTION_NAME	yuvnv12_abgr_avx2
+#define STD_FUNCTION_NAME	yuvnv12_abgr_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_ABGR
+#include "yuv_rgb_avx2_func.h"
+
+#endif //SDL_AVX2_INTRINSICS
+
+// the neon functions store pixels byte by byte, in little endian order
+#if defined(__ARM_NEON) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+
+// chroma part of the conversion for 16 pixels, from 8 U and V values
+SDL_FORCE_INLINE void uv2rgb_neon(const YUV2RGBParam *param, uint8x8_t u, uint8x8_t v,
+	int16x8x2_t *r, int16x8x2_t *g, int16x8x2_t *b)
+{
+	const int16x8_t u_16 = vreinterpretq_s16_u16(vsubl_u8(u, vdup_n_u8(128)));
+	const int16x8_t v_16 = vreinterpretq_s16_u16(vsubl_u8(v, vdup_n_u8(128)));
+	const int16x8_t r_tmp = vmulq_n_s16(v_16, param->v_r_factor);
+	const int16x8_t g_tmp = vaddq_s16(vmulq_n_s16(u_16, param->u_g_factor), vmulq_n_s16(v_16, param->v_g_factor));
+	const int16x8_t b_tmp = vmulq_n_s16(u_16, param->u_b_factor);
+
+	*r = vzipq_s16(r_tmp, r_tmp);
+	*g = vzipq_s16(g_tmp, g_tmp);
+	*b = vzipq_s16(b_tmp, b_tmp);
+}
+
+SDL_FORCE_INLINE int16x8_t scale_y_neon(const YUV2RGBParam *param, uint8x8_t y)
+{
+	return vmulq_n_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(y)), vdupq_n_s16(param->y_shift)), param->y_factor);
+}
+
+// add luma to the chroma part of 16 pixels, and pack the result to bytes
+SDL_FORCE_INLINE uint8x16_t add_y_neon(int16x8x2_t c, int16x8_t y1, int16x8_t y2)
+{
+	return vcombine_u8(
+		vqmovun_s16(vshrq_n_s16(vaddq_s16(c.val[0], y1), PRECISION)),
+		vqmovun_s16(vshrq_n_s16(vaddq_s16(c.val[1], y2), PRECISION)));
+}
+
+// save 16 pixels of 4 bytes, c0 to c3 give the bytes in memory order
+SDL_FORCE_INLINE void save_32bit_neon(uint8_t *rgb_ptr, uint8x16_t c0, uint8x16_t c1, uint8x16_t c2, uint8x16_t c3)
+{
+	uint8x16x4_t rgb;
+	rgb.val[0] = c0;
+	rgb.val[1] = c1;
+	rgb.val[2] = c2;
+	rgb.val[3] = c3;
+	vst4q_u8(rgb_ptr, rgb);
+}
+
+SDL_FORCE_INLINE uint16x8_t pack_rgb565_neon(uint8x8_t r, uint8x8_t g, uint8x8_t b)
+{
+	uint16x8_t rgb;
+	rgb = vandq_u16(vshll_n_u8(r, 8), vdupq_n_u16(0xF800));
+	rgb = vorrq_u16(rgb, vshlq_n_u16(vshrq_n_u16(vmovl_u8(g), 2), 5));
+	rgb = vorrq_u16(rgb, vshrq_n_u16(vmovl_u8(b), 3));
+	return rgb;
+}
+
+SDL_FORCE_INLINE void save_rgb565_neon(uint8_t *rgb_ptr, uint8x16_t r, uint8x16_t g, uint8x16_t b)
+{
+	vst1q_u16((uint16_t*)(rgb_ptr), pack_rgb565_neon(vget_low_u8(r), vget_low_u8(g), vget_low_u8(b)));
+	vst1q_u16((uint16_t*)(rgb_ptr+16), pack_rgb565_neon(vget_high_u8(r), vget_high_u8(g), vget_high_u8(b)));
+}
+
+#define NEON_FUNCTION_NAME	yuv420_rgb565_neon
+#define STD_FUNCTION_NAME	yuv420_rgb565_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_RGB565
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv420_rgb24_neon
+#define STD_FUNCTION_NAME	yuv420_rgb24_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_RGB24
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv420_rgba_neon
+#define STD_FUNCTION_NAME	yuv420_rgba_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_RGBA
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv420_bgra_neon
+#define STD_FUNCTION_NAME	yuv420_bgra_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_BGRA
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv420_argb_neon
+#define STD_FUNCTION_NAME	yuv420_argb_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_ARGB
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv420_abgr_neon
+#define STD_FUNCTION_NAME	yuv420_abgr_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_ABGR
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv422_rgb565_neon
+#define STD_FUNCTION_NAME	yuv422_rgb565_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_RGB565
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv422_rgb24_neon
+#define STD_FUNCTION_NAME	yuv422_rgb24_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_RGB24
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv422_rgba_neon
+#define STD_FUNCTION_NAME	yuv422_rgba_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_RGBA
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv422_bgra_neon
+#define STD_FUNCTION_NAME	yuv422_bgra_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_BGRA
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv422_argb_neon
+#define STD_FUNCTION_NAME	yuv422_argb_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_ARGB
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv422_abgr_neon
+#define STD_FUNCTION_NAME	yuv422_abgr_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_ABGR
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuvnv12_rgb565_neon
+#define STD_FUNCTION_NAME	yuvnv12_rgb565_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_RGB565
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuvnv12_rgb24_neon
+#define STD_FUNCTION_NAME	yuvnv12_rgb24_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_RGB24
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuvnv12_rgba_neon
+#define STD_FUNCTION_NAME	yuvnv12_rgba_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_RGBA
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuvnv12_bgra_neon
+#define STD_FUNCTION_NAME	yuvnv12_bgra_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_BGRA
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuvnv12_argb_neon
+#define STD_FUNCTION_NAME	yuvnv12_argb_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_ARGB
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuvnv12_abgr_neon
+#define STD_FUNCTION_NAME	yuvnv12_abgr_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_ABGR
+#include "yuv_rgb_neon_func.h"
+
+#endif //__ARM_NEON
+
 #endif /* SDL_HAVE_YUV */
@@ -0,0 +1,214 @@
+// Copyright 2016 Adrien Descamps
+// Distributed under BSD 3-Clause License
+
+// AVX2 variant of yuv_rgb_sse_func.h, converting 32 pixels of two lines per iteration.
+// The arithmetic is the same as the SSE version, so both give identical results.
+
+/* You need to define the following macros before including this file:
+	AVX2_FUNCTION_NAME
+	STD_FUNCTION_NAME
+	YUV_FORMAT
+	RGB_FORMAT
+*/
+
+#if RGB_FORMAT == RGB_FORMAT_RGB565
+
+#define SAVE_LINE(rgb_ptr, r, g, b) \
+	save_rgb565_avx2(rgb_ptr, r, g, b);
+
+#elif RGB_FORMAT == RGB_FORMAT_RGB24
+
+#define SAVE_LINE(rgb_ptr, r, g, b) \
+	save_rgb24_avx2(rgb_ptr, r, g, b);
+
+#elif RGB_FORMAT == RGB_FORMAT_RGBA
+
+#define SAVE_LINE(rgb_ptr, r, g, b) \
+	save_32bit_avx2(rgb_ptr, _mm256_set1_epi8((char)0xFF), b, g, r);
+
+#elif RGB_FORMAT == RGB_FORMAT_BGRA
+
+#define SAVE_LINE(rgb_ptr, r, g, b) \
+	save_32bit_avx2(rgb_ptr, _mm256_set1_epi8((char)0xFF), r, g, b);
+
+#elif RGB_FORMAT == RGB_FORMAT_ARGB
+
+#define SAVE_LINE(rgb_ptr, r, g, b) \
+	save_32bit_avx2(rgb_ptr, b, g, r, _mm256_set1_epi8((char)0xFF));
+
+#elif RGB_FORMAT == RGB_FORMAT_ABGR
+
+#define SAVE_LINE(rgb_ptr, r, g, b) \
+	save_32bit_avx2(rgb_ptr, r, g, b, _mm256_set1_epi8((char)0xFF));
+
+#else
+#error SAVE_LINE unimplemented
+#endif
+
+#if YUV_FORMAT == YUV_FORMAT_420
+
+#define READ_Y(y_ptr, Y1, Y2) \
+{ \
+	__m256i y = _mm256_loadu_si256((const __m256i*)(y_ptr)); \
+	Y1 = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(y)); \
+	Y2 = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(y, 1)); \
+}
+
+#define READ_UV \
+	u = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(u_ptr))); \
+	v = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(v_ptr))); \
+
+#elif YUV_FORMAT == YUV_FORMAT_422
+
+#define READ_Y(y_ptr, Y1, Y2) \
+	Y1 = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(y_ptr)), _mm256_set1_epi16(0xFF)); \
+	Y2 = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(y_ptr+32)), _mm256_set1_epi16(0xFF)); \
+
+#define READ_UV \
+{ \
+	__m256i u1, u2, v1, v2; \
+	u1 = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(u_ptr)), _mm256_set1_epi32(0xFF)); \
+	u2 = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(u_ptr+32)), _mm256_set1_epi32(0xFF)); \
+	u = _mm256_permute4x64_epi64(_mm256_packus_epi32(u1, u2), 0xD8); \
+	v1 = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(v_ptr)), _mm256_set1_epi32(0xFF)); \
+	v2 = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(v_ptr+32)), _mm256_set1_epi32(0xFF)); \
+	v = _mm256_permute4x64_epi64(_mm256_packus_epi32(v1, v2), 0xD8); \
+}
+
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+
+#define READ_Y(y_ptr, Y1, Y2) \
+{ \
+	__m256i y = _mm256_loadu_si256((const __m256i*)(y_ptr)); \
+	Y1 = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(y)); \
+	Y2 = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(y, 1)); \
+}
+
+#define READ_UV \
+	u = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(u_ptr)), _mm256_set1_epi16(0xFF)); \
+	v = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(v_ptr)), _mm256_set1_epi16(0xFF)); \
+
+#else
+#error READ_UV unimplemented
+#endif
+
+SDL_TARGETING("avx2")
+void AVX2_FUNCTION_NAME(uint32_t width, uint32_t height,
+	const uint8_t *Y, const uint8_t *U, const uint8_t *V, uint32_t Y_stride, uint32_t UV_stride,
+	uint8_t *RGB, uint32_t RGB_stride,
+	YCbCrType yuv_type)
+{
+	const YUV2RGBParam *const param = &(YUV2RGB[yuv_type]);
+#if YUV_FORMAT == YUV_FORMAT_420
+	const int y_pixel_stride = 1;
+	const int uv_pixel_stride = 1;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 2;
+#elif YUV_FORMAT == YUV_FORMAT_422
+	const int y_pixel_stride = 2;
+	const int uv_pixel_stride = 4;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 1;
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+	const int y_pixel_stride = 1;
+	const int uv_pixel_stride = 2;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 2;
+#endif
+#if RGB_FORMAT == RGB_FORMAT_RGB565
+	const int rgb_pixel_stride = 2;
+#elif RGB_FORMAT == RGB_FORMAT_RGB24
+	const int rgb_pixel_stride = 3;
+#elif RGB_FORMAT == RGB_FORMAT_RGBA || RGB_FORMAT == RGB_FORMAT_BGRA || \
+      RGB_FORMAT == RGB_FORMAT_ARGB || RGB_FORMAT == RGB_FORMAT_ABGR
+	const int rgb_pixel_stride = 4;
+#else
+#error Unknown RGB pixel size
+#endif
+
+	if (width >= 32) {
+		uint32_t xpos, ypos;
+		for(ypos=0; ypos<(height-(uv_y_sample_interval-1)); ypos+=uv_y_sample_interval)
+		{
+			const uint8_t *y_ptr1=Y+ypos*Y_stride,
+				*y_ptr2=Y+(ypos+1)*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+
+			uint8_t *rgb_ptr1=RGB+ypos*RGB_stride,
+				*rgb_ptr2=RGB+(ypos+1)*RGB_stride;
+
+			for(xpos=0; xpos<(width-31); xpos+=32)
+			{
+				__m256i u, v, y1, y2;
+				__m256i r_uv1, g_uv1, b_uv1, r_uv2, g_uv2, b_uv2;
+
+				READ_UV
+				u = _mm256_sub_epi16(u, _mm256_set1_epi16(128));
+				v = _mm256_sub_epi16(v, _mm256_set1_epi16(128));
+				uv2rgb_avx2(param, u, v, &r_uv1, &g_uv1, &b_uv1, &r_uv2, &g_uv2, &b_uv2);
+
+				READ_Y(y_ptr1, y1, y2)
+				y1 = scale_y_avx2(param, y1);
+				y2 = scale_y_avx2(param, y2);
+				SAVE_LINE(rgb_ptr1,
+					add_y_avx2(r_uv1, r_uv2, y1, y2),
+					add_y_avx2(g_uv1, g_uv2, y1, y2),
+					add_y_avx2(b_uv1, b_uv2, y1, y2))
+
+				if (uv_y_sample_interval > 1)
+				{
+					READ_Y(y_ptr2, y1, y2)
+					y1 = scale_y_avx2(param, y1);
+					y2 = scale_y_avx2(param, y2);
+					SAVE_LINE(rgb_ptr2,
+						add_y_avx2(r_uv1, r_uv2, y1, y2),
+						add_y_avx2(g_uv1, g_uv2, y1, y2),
+						add_y_avx2(b_uv1, b_uv2, y1, y2))
+				}
+
+				y_ptr1+=32*y_pixel_stride;
+				y_ptr2+=32*y_pixel_stride;
+				u_ptr+=32*uv_pixel_stride/uv_x_sample_interval;
+				v_ptr+=32*uv_pixel_stride/uv_x_sample_interval;
+				rgb_ptr1+=32*rgb_pixel_stride;
+				rgb_ptr2+=32*rgb_pixel_stride;
+			}
+		}
+
+		/* Catch the last line, if needed */
+		if (uv_y_sample_interval == 2 && ypos == (height-1))
+		{
+			const uint8_t *y_ptr=Y+ypos*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+
+			uint8_t *rgb_ptr=RGB+ypos*RGB_stride;
+
+			STD_FUNCTION_NAME(width, 1, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+		}
+	}
+
+	/* Catch the right column, if needed */
+	{
+		int converted = (width & ~31);
+		if (converted != width)
+		{
+			const uint8_t *y_ptr=Y+converted*y_pixel_stride,
+				*u_ptr=U+converted*uv_pixel_stride/uv_x_sample_interval,
+				*v_ptr=V+converted*uv_pixel_stride/uv_x_sample_interval;
+
+			uint8_t *rgb_ptr=RGB+converted*rgb_pixel_stride;
+
+			STD_FUNCTION_NAME(width-converted, height, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+		}
+	}
+}
+
+#undef AVX2_FUNCTION_NAME
+#undef STD_FUNCTION_NAME
+#undef YUV_FORMAT
+#undef RGB_FORMAT
+#undef SAVE_LINE
+#undef READ_Y
+#undef READ_UV
@@ -0,0 +1,203 @@
+// Copyright 2016 Adrien Descamps
+// Distributed under BSD 3-Clause License
+
+// NEON variant of yuv_rgb_sse_func.h, converting 16 pixels of two lines per iteration.
+// The arithmetic is the same as the SSE version, so both give identical results.
+
+/* You need to define the following macros before including this file:
+	NEON_FUNCTION_NAME
+	STD_FUNCTION_NAME
+	YUV_FORMAT
+	RGB_FORMAT
+*/
+
+#if RGB_FORMAT == RGB_FORMAT_RGB565
+
+#define SAVE_LINE(rgb_ptr, r, g, b) \
+	save_rgb565_neon(rgb_ptr, r, g, b);
+
+#elif RGB_FORMAT == RGB_FORMAT_RGB24
+
+#define SAVE_LINE(rgb_ptr, r, g, b) \
+{ \
+	uint8x16x3_t rgb; \
+	rgb.val[0] = r; \
+	rgb.val[1] = g; \
+	rgb.val[2] = b; \
+	vst3q_u8(rgb_ptr, rgb); \
+}
+
+#elif RGB_FORMAT == RGB_FORMAT_RGBA
+
+#define SAVE_LINE(rgb_ptr, r, g, b) \
+	save_32bit_neon(rgb_ptr, vdupq_n_u8(0xFF), b, g, r);
+
+#elif RGB_FORMAT == RGB_FORMAT_BGRA
+
+#define SAVE_LINE(rgb_ptr, r, g, b) \
+	save_32bit_neon(rgb_ptr, vdupq_n_u8(0xFF), r, g, b);
+
+#elif RGB_FORMAT == RGB_FORMAT_ARGB
+
+#define SAVE_LINE(rgb_ptr, r, g, b) \
+	save_32bit_neon(rgb_ptr, b, g, r, vdupq_n_u8(0xFF));
+
+#elif RGB_FORMAT == RGB_FORMAT_ABGR
+
+#define SAVE_LINE(rgb_ptr, r, g, b) \
+	save_32bit_neon(rgb_ptr, r, g, b, vdupq_n_u8(0xFF));
+
+#else
+#error SAVE_LINE unimplemented
+#endif
+
+#if YUV_FORMAT == YUV_FORMAT_420
+
+#define READ_Y(y_ptr) \
+	y = vld1q_u8(y_ptr); \
+
+#define READ_UV \
+	u = vld1_u8(u_ptr); \
+	v = vld1_u8(v_ptr); \
+
+#elif YUV_FORMAT == YUV_FORMAT_422
+
+#define READ_Y(y_ptr) \
+	y = vld2q_u8(y_ptr).val[0]; \
+
+#define READ_UV \
+	u = vld4_u8(u_ptr).val[0]; \
+	v = vld4_u8(v_ptr).val[0]; \
+
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+
+#define READ_Y(y_ptr) \
+	y = vld1q_u8(y_ptr); \
+
+#define READ_UV \
+	u = vld2_u8(u_ptr).val[0]; \
+	v = vld2_u8(v_ptr).val[0]; \
+
+#else
+#error READ_UV unimplemented
+#endif
+
+void NEON_FUNCTION_NAME(uint32_t width, uint32_t height,
+	const uint8_t *Y, const uint8_t *U, const uint8_t *V, uint32_t Y_stride, uint32_t UV_stride,
+	uint8_t *RGB, uint32_t RGB_stride,
+	YCbCrType yuv_type)
+{
+	const YUV2RGBParam *const param = &(YUV2RGB[yuv_type]);
+#if YUV_FORMAT == YUV_FORMAT_420
+	const int y_pixel_stride = 1;
+	const int uv_pixel_stride = 1;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 2;
+#elif YUV_FORMAT == YUV_FORMAT_422
+	const int y_pixel_stride = 2;
+	const int uv_pixel_stride = 4;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 1;
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+	const int y_pixel_stride = 1;
+	const int uv_pixel_stride = 2;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 2;
+#endif
+#if RGB_FORMAT == RGB_FORMAT_RGB565
+	const int rgb_pixel_stride = 2;
+#elif RGB_FORMAT == RGB_FORMAT_RGB24
+	const int rgb_pixel_stride = 3;
+#elif RGB_FORMAT == RGB_FORMAT_RGBA || RGB_FORMAT == RGB_FORMAT_BGRA || \
+      RGB_FORMAT == RGB_FORMAT_ARGB || RGB_FORMAT == RGB_FORMAT_ABGR
+	const int rgb_pixel_stride = 4;
+#else
+#error Unknown RGB pixel size
+#endif
+
+	if (width >= 16) {
+		uint32_t xpos, ypos;
+		for(ypos=0; ypos<(height-(uv_y_sample_interval-1)); ypos+=uv_y_sample_interval)
+		{
+			const uint8_t *y_ptr1=Y+ypos*Y_stride,
+				*y_ptr2=Y+(ypos+1)*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+
+			uint8_t *rgb_ptr1=RGB+ypos*RGB_stride,
+				*rgb_ptr2=RGB+(ypos+1)*RGB_stride;
+
+			for(xpos=0; xpos<(width-15); xpos+=16)
+			{
+				uint8x8_t u, v;
+				uint8x16_t y;
+				int16x8_t y1, y2;
+				int16x8x2_t r_uv, g_uv, b_uv;
+
+				READ_UV
+				uv2rgb_neon(param, u, v, &r_uv, &g_uv, &b_uv);
+
+				READ_Y(y_ptr1)
+				y1 = scale_y_neon(param, vget_low_u8(y));
+				y2 = scale_y_neon(param, vget_high_u8(y));
+				SAVE_LINE(rgb_ptr1,
+					add_y_neon(r_uv, y1, y2),
+					add_y_neon(g_uv, y1, y2),
+					add_y_neon(b_uv, y1, y2))
+
+				if (uv_y_sample_interval > 1)
+				{
+					READ_Y(y_ptr2)
+					y1 = scale_y_neon(param, vget_low_u8(y));
+					y2 = scale_y_neon(param, vget_high_u8(y));
+					SAVE_LINE(rgb_ptr2,
+						add_y_neon(r_uv, y1, y2),
+						add_y_neon(g_uv, y1, y2),
+						add_y_neon(b_uv, y1, y2))
+				}
+
+				y_ptr1+=16*y_pixel_stride;
+				y_ptr2+=16*y_pixel_stride;
+				u_ptr+=16*uv_pixel_stride/uv_x_sample_interval;
+				v_ptr+=16*uv_pixel_stride/uv_x_sample_interval;
+				rgb_ptr1+=16*rgb_pixel_stride;
+				rgb_ptr2+=16*rgb_pixel_stride;
+			}
+		}
+
+		/* Catch the last line, if needed */
+		if (uv_y_sample_interval == 2 && ypos == (height-1))
+		{
+			const uint8_t *y_ptr=Y+ypos*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+
+			uint8_t *rgb_ptr=RGB+ypos*RGB_stride;
+
+			STD_FUNCTION_NAME(width, 1, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+		}
+	}
+
+	/* Catch the right column, if needed */
+	{
+		int converted = (width & ~15);
+		if (converted != width)
+		{
+			const uint8_t *y_ptr=Y+converted*y_pixel_stride,
+				*u_ptr=U+converted*uv_pixel_stride/uv_x_sample_interval,
+				*v_ptr=V+converted*uv_pixel_stride/uv_x_sample_interval;
+
+			uint8_t *rgb_ptr=RGB+converted*rgb_pixel_stride;
+
+			STD_FUNCTION_NAME(width-converted, height, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+		}
+	}
+}
+
+#undef NEON_FUNCTION_NAME
+#undef STD_FUNCTION_NAME
+#undef YUV_FORMAT
+#undef RGB_FORMAT
+#undef SAVE_LINE
+#undef READ_Y
+#undef READ_UV
@@ -0,0 +1,142 @@
+/*
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures how fast SDL_MixAudioFormat() mixes a set of voices into one
+   buffer, the way a game's audio callback would, for each sample format,
+   and how SDL_MixAudioSources() compares when given all the voices at once. */
+
+#include "SDL.h"
+
+#define VOICES 32
+#define FRAMES 1024
+#define CHANNELS 2
+#define ITERATIONS 2000
+
+static const struct
+{
+    SDL_AudioFormat format;
+    const char *name;
+} formats[] = {
+    { AUDIO_U8, "U8" },
+    { AUDIO_S16LSB, "S16LSB" },
+    { AUDIO_S16MSB, "S16MSB" },
+    { AUDIO_S32LSB, "S32LSB" },
+    { AUDIO_S32MSB, "S32MSB" },
+    { AUDIO_F32LSB, "F32LSB" },
+    { AUDIO_F32MSB, "F32MSB" }
+};
+
+static void
+fill_voice(Uint8 *buf, const SDL_AudioFormat format, const Uint32 len, Uint32 seed)
+{
+    Uint32 i;
+
+    /* something noise-like but loud enough that some sums saturate. */
+    if (SDL_AUDIO_ISFLOAT(format)) {
+        float *samples = (float *) buf;
+        for (i = 0; i < len / sizeof (float); i++) {
+            float sample;
+            seed = seed * 1103515245 + 12345;
+            sample = ((float) (seed >> 8) / (float) (1 << 24)) - 0.5f;
+            if (SDL_AUDIO_ISBIGENDIAN(format)) {
+                sample = SDL_SwapFloatBE(sample);
+            } else {
+                sample = SDL_SwapFloatLE(sample);
+            }
+            samples[i] = sample;
+        }
+    } else {
+        for (i = 0; i < len; i++) {
+            seed = seed * 1103515245 + 12345;
+            buf[i] = (Uint8) (seed >> 16);
+        }
+    }
+}
+
+int
+main(int argc, char *argv[])
+{
+    const Uint32 maxlen = FRAMES * CHANNELS * 4;
+    SDL_AudioMixSource sources[VOICES];
+    Uint8 *voices;
+    Uint8 *mixbuf;
+    int i, j, k;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    voices = (Uint8 *) SDL_malloc(maxlen * VOICES);
+    mixbuf = (Uint8 *) SDL_malloc(maxlen);
+    if (!voices || !mixbuf) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory!\n");
+        SDL_free(voices);
+        SDL_free(mixbuf);
+        SDL_Quit();
+        return 1;
+    }
+
+    SDL_Log("Mixing %d voices of %d frames, %d channels, %d times:", VOICES, FRAMES, CHANNELS, ITERATIONS);
+
+    for (i = 0; i < SDL_arraysize(formats); i++) {
+        const SDL_AudioFormat format = formats[i].format;
+        const Uint32 len = FRAMES * CHANNELS * (SDL_AUDIO_BITSIZE(format) / 8);
+        Uint64 start, elapsed;
+        double seconds;
+
+        for (j = 0; j < VOICES; j++) {
+            fill_voice(voices + j * len, format, len, (Uint32) (j + 1));
+        }
+
+        start = SDL_GetPerformanceCounter();
+        for (k = 0; k < ITERATIONS; k++) {
+            SDL_memset(mixbuf, SDL_AUDIO_ISSIGNED(format) ? 0 : 0x80, len);
+            for (j = 0; j < VOICES; j++) {
+                SDL_MixAudioFormat(mixbuf, voices + j * len, format, len, SDL_MIX_MAXVOLUME / 2 + j);
+            }
+        }
+        elapsed = SDL_GetPerformanceCounter() - start;
+        seconds = (double) elapsed / (double) SDL_GetPerformanceFrequency();
+
+        SDL_Log("%-7s %8.1f Msamples/s  (%.3f ms per %d-voice callback)", formats[i].name,
+                ((double) FRAMES * CHANNELS * VOICES * ITERATIONS) / seconds / 1000000.0,
+                (seconds * 1000.0) / ITERATIONS, VOICES);
+
+        for (j = 0; j < VOICES; j++) {
+            sources[j].src = voices + j * len;
+            sources[j].volume = SDL_MIX_MAXVOLUME / 2 + j;
+            sources[j].pan = NULL;
+        }
+
+        start = SDL_GetPerformanceCounter();
+        for (k = 0; k < ITERATIONS; k++) {
+            SDL_MixAudioSources(mixbuf, sources, VOICES, format, CHANNELS, len);
+        }
+        elapsed = SDL_GetPerformanceCounter() - start;
+        seconds = (double) elapsed / (double) SDL_GetPerformanceFrequency();
+
+        SDL_Log("%-7s %8.1f Msamples/s  (%.3f ms per %d-voice callback, batched)", formats[i].name,
+                ((double) FRAMES * CHANNELS * VOICES * ITERATIONS) / seconds / 1000000.0,
+                (seconds * 1000.0) / ITERATIONS, VOICES);
+    }
+
+    SDL_free(voices);
+    SDL_free(mixbuf);
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
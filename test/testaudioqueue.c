@@ -0,0 +1,145 @@
+/*
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures how fast audio data moves through SDL's internal data queue,
+   both through an SDL_AudioStream that doesn't convert anything (so it's
+   nothing but the queue) and through SDL_QueueAudio() on a paused device. */
+
+
+#include "SDL.h"
+
+#define TOTAL_BYTES (256 * 1024 * 1024)
+#define BACKLOG_BYTES (256 * 1024)
+
+static double
+elapsed_seconds(const Uint64 start)
+{
+    return (double) (SDL_GetPerformanceCounter() - start) / (double) SDL_GetPerformanceFrequency();
+}
+
+static void
+report(const char *what, const int chunk, const Uint64 bytes, const double seconds)
+{
+    SDL_Log("%-14s %6d byte chunks: %9.1f MB/s", what, chunk, ((double) bytes / (1024.0 * 1024.0)) / seconds);
+}
+
+static int
+bench_stream(Uint8 *chunkbuf, const int chunk)
+{
+    SDL_AudioStream *stream = SDL_NewAudioStream(AUDIO_S16SYS, 2, 48000, AUDIO_S16SYS, 2, 48000);
+    Uint64 moved = 0;
+    Uint64 start;
+    int i;
+
+    if (!stream) {
+        SDL_Log("SDL_NewAudioStream failed: %s", SDL_GetError());
+        return -1;
+    }
+
+    /* keep a backlog so the reads and writes chase each other around the queue. */
+    for (i = 0; i < BACKLOG_BYTES / chunk; i++) {
+        SDL_AudioStreamPut(stream, chunkbuf, chunk);
+    }
+
+    start = SDL_GetPerformanceCounter();
+    while (moved < TOTAL_BYTES) {
+        if ((SDL_AudioStreamPut(stream, chunkbuf, chunk) < 0) ||
+            (SDL_AudioStreamGet(stream, chunkbuf, chunk) != chunk)) {
+            SDL_Log("Stream failed: %s", SDL_GetError());
+            SDL_FreeAudioStream(stream);
+            return -1;
+        }
+        moved += chunk;
+    }
+    report("AudioStream", chunk, moved, elapsed_seconds(start));
+
+    SDL_FreeAudioStream(stream);
+    return 0;
+}
+
+static int
+bench_device_queue(SDL_AudioDeviceID dev, Uint8 *chunkbuf, const int chunk)
+{
+    Uint64 moved = 0;
+    Uint64 start;
+    int i;
+
+    /* the device is paused, so nothing drains the queue but us. */
+    start = SDL_GetPerformanceCounter();
+    while (moved < TOTAL_BYTES) {
+        for (i = 0; i < BACKLOG_BYTES / chunk; i++) {
+            if (SDL_QueueAudio(dev, chunkbuf, chunk) < 0) {
+                SDL_Log("SDL_QueueAudio failed: %s", SDL_GetError());
+                return -1;
+            }
+        }
+        moved += BACKLOG_BYTES;
+        SDL_ClearQueuedAudio(dev);
+    }
+    report("SDL_QueueAudio", chunk, moved, elapsed_seconds(start));
+
+    return 0;
+}
+
+int
+main(int argc, char *argv[])
+{
+    static const int chunks[] = { 4 * 1024, 64 * 1024 };
+    SDL_AudioDeviceID dev;
+    SDL_AudioSpec spec;
+    Uint8 *chunkbuf;
+    int retval = 0;
+    int i;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(SDL_INIT_AUDIO) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    chunkbuf = (Uint8 *) SDL_calloc(1, 64 * 1024);
+    if (!chunkbuf) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory!\n");
+        SDL_Quit();
+        return 1;
+    }
+
+    SDL_zero(spec);
+    spec.freq = 48000;
+    spec.format = AUDIO_S16SYS;
+    spec.channels = 2;
+    spec.samples = 4096;
+    dev = SDL_OpenAudioDevice(NULL, 0, &spec, NULL, 0);
+    if (!dev) {
+        SDL_Log("Couldn't open audio device, skipping SDL_QueueAudio: %s", SDL_GetError());
+    }
+
+    for (i = 0; i < SDL_arraysize(chunks); i++) {
+        if (bench_stream(chunkbuf, chunks[i]) < 0) {
+            retval = 1;
+        }
+        if (dev && (bench_device_queue(dev, chunkbuf, chunks[i]) < 0)) {
+            retval = 1;
+        }
+    }
+
+    if (dev) {
+        SDL_CloseAudioDevice(dev);
+    }
+    SDL_free(chunkbuf);
+    SDL_Quit();
+    return retval;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
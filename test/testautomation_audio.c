@@ -968,6 +968,815 @@ int audio_openCloseAudioDeviceConnected()
 }
 
 
+/**
+ * \brief Check signal-to-noise ratio of a sine wave resampled through an audio stream
+ *
+ * \sa https://wiki.libsdl.org/SDL_NewAudioStream
+ * \sa https://wiki.libsdl.org/SDL_AudioStreamPut
+ */
+int audio_resampleLoss()
+{
+  /* Rate pairs with and without precomputed filter tables, in both directions */
+  static const struct {
+    int frequency;
+    int rate_in;
+    int rate_out;
+    double signal_to_noise;
+  } test_specs[] = {
+    { 1000, 44100, 48000, 79.0 },
+    { 5000, 44100, 48000, 70.0 },
+    { 440, 22050, 48000, 79.0 },
+    { 1000, 48000, 44100, 79.0 },
+    { 1000, 44100, 48001, 79.0 },
+    { 0 }
+  };
+
+  int spec_idx = 0;
+
+  for (spec_idx = 0; test_specs[spec_idx].frequency; spec_idx++) {
+    const int frequency = test_specs[spec_idx].frequency;
+    const int rate_in = test_specs[spec_idx].rate_in;
+    const int rate_out = test_specs[spec_idx].rate_out;
+    const int len_in = rate_in * sizeof(float);
+    SDL_AudioStream *stream;
+    float *buf_in, *buf_out;
+    int len_out, frames_out, i;
+    double sum_squared_error = 0.0, sum_squared_value = 0.0, signal_to_noise;
+
+    SDLTest_AssertPass("Test resampling of %i Hz sine from %i Hz to %i Hz", frequency, rate_in, rate_out);
+
+    stream = SDL_NewAudioStream(AUDIO_F32SYS, 1, rate_in, AUDIO_F32SYS, 1, rate_out);
+    SDLTest_AssertPass("Call to SDL_NewAudioStream(AUDIO_F32SYS, 1, %i, AUDIO_F32SYS, 1, %i)", rate_in, rate_out);
+    SDLTest_AssertCheck(stream != NULL, "Expected SDL_NewAudioStream to succeed.");
+    if (stream == NULL) {
+      return TEST_ABORTED;
+    }
+
+    /* One second of a full scale sine wave */
+    buf_in = (float *)SDL_malloc(len_in);
+    SDLTest_AssertCheck(buf_in != NULL, "Expected input buffer to be created.");
+    if (buf_in == NULL) {
+      SDL_FreeAudioStream(stream);
+      return TEST_ABORTED;
+    }
+    for (i = 0; i < rate_in; i++) {
+      buf_in[i] = (float)SDL_sin(i * 2.0 * M_PI * frequency / rate_in);
+    }
+
+    SDLTest_AssertCheck(SDL_AudioStreamPut(stream, buf_in, len_in) == 0, "Expected SDL_AudioStreamPut to succeed.");
+    SDLTest_AssertCheck(SDL_AudioStreamFlush(stream) == 0, "Expected SDL_AudioStreamFlush to succeed.");
+    SDL_free(buf_in);
+
+    len_out = SDL_AudioStreamAvailable(stream);
+    buf_out = (float *)SDL_malloc(len_out ? len_out : 1);
+    SDLTest_AssertCheck(buf_out != NULL, "Expected output buffer to be created.");
+    if (buf_out == NULL) {
+      SDL_FreeAudioStream(stream);
+      return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(SDL_AudioStreamGet(stream, buf_out, len_out) == len_out, "Expected SDL_AudioStreamGet to return %i bytes.", len_out);
+    SDL_FreeAudioStream(stream);
+
+    frames_out = len_out / sizeof(float);
+    SDLTest_AssertCheck(frames_out > rate_out / 2 && frames_out <= rate_out + 1,
+                        "Expected up to %i output frames, got %i.", rate_out, frames_out);
+
+    /* Skip the edges, where the input was padded with silence */
+    for (i = frames_out / 4; i < (frames_out * 3) / 4; i++) {
+      const double target = SDL_sin(i * 2.0 * M_PI * frequency / rate_out);
+      const double error = buf_out[i] - target;
+      sum_squared_value += target * target;
+      sum_squared_error += error * error;
+    }
+    SDL_free(buf_out);
+
+    signal_to_noise = 10 * SDL_log10(sum_squared_value / sum_squared_error);
+    SDLTest_AssertCheck(signal_to_noise >= test_specs[spec_idx].signal_to_noise,
+                        "Expected signal-to-noise ratio of at least %.1f dB, got %.2f dB.",
+                        test_specs[spec_idx].signal_to_noise, signal_to_noise);
+  }
+
+  return TEST_COMPLETED;
+}
+/**
+ * \brief Check that peek/commit gives the same output as put/get on an audio stream
+ *
+ * \sa https://wiki.libsdl.org/SDL_AudioStreamPeekPut
+ * \sa https://wiki.libsdl.org/SDL_AudioStreamCommitPut
+ * \sa https://wiki.libsdl.org/SDL_AudioStreamPeekGet
+ * \sa https://wiki.libsdl.org/SDL_AudioStreamCommitGet
+ */
+int audio_streamPeekCommit()
+{
+  /* Resampling with a staging buffer, conversion only, and no conversion at all */
+  static const struct {
+    SDL_AudioFormat src_format;
+    Uint8 src_channels;
+    int src_rate;
+    SDL_AudioFormat dst_format;
+    Uint8 dst_channels;
+    int dst_rate;
+  } test_specs[] = {
+    { AUDIO_S16SYS, 2, 44100, AUDIO_F32SYS, 2, 48000 },
+    { AUDIO_S16SYS, 6, 22050, AUDIO_S16SYS, 2, 22050 },
+    { AUDIO_S16SYS, 6, 22050, AUDIO_S16SYS, 6, 22050 },
+    { 0 }
+  };
+  const int total_frames = 20000;
+  int spec_idx;
+
+  for (spec_idx = 0; test_specs[spec_idx].src_format; spec_idx++) {
+    const int src_frame_size = (SDL_AUDIO_BITSIZE(test_specs[spec_idx].src_format) / 8) * test_specs[spec_idx].src_channels;
+    const int dst_frame_size = (SDL_AUDIO_BITSIZE(test_specs[spec_idx].dst_format) / 8) * test_specs[spec_idx].dst_channels;
+    SDL_AudioStream *stream, *reference;
+    Sint16 *buf_in;
+    Uint8 *buf_out, *buf_ref;
+    int i, offset, chunk, len, len_out, len_ref;
+
+    stream = SDL_NewAudioStream(test_specs[spec_idx].src_format, test_specs[spec_idx].src_channels, test_specs[spec_idx].src_rate,
+                                test_specs[spec_idx].dst_format, test_specs[spec_idx].dst_channels, test_specs[spec_idx].dst_rate);
+    reference = SDL_NewAudioStream(test_specs[spec_idx].src_format, test_specs[spec_idx].src_channels, test_specs[spec_idx].src_rate,
+                                   test_specs[spec_idx].dst_format, test_specs[spec_idx].dst_channels, test_specs[spec_idx].dst_rate);
+    SDLTest_AssertPass("Call to SDL_NewAudioStream(), spec %i", spec_idx);
+    SDLTest_AssertCheck(stream != NULL && reference != NULL, "Expected SDL_NewAudioStream to succeed.");
+    buf_in = (Sint16 *)SDL_malloc(total_frames * src_frame_size);
+    SDLTest_AssertCheck(buf_in != NULL, "Expected input buffer to be created.");
+    if (stream == NULL || reference == NULL || buf_in == NULL) {
+      SDL_FreeAudioStream(stream);
+      SDL_FreeAudioStream(reference);
+      SDL_free(buf_in);
+      return TEST_ABORTED;
+    }
+    for (i = 0; i < (total_frames * src_frame_size) / 2; i++) {
+      buf_in[i] = (Sint16)SDLTest_RandomSint16();
+    }
+
+    /* Feed both streams the same data in odd sized chunks */
+    offset = 0;
+    chunk = 1;
+    while (offset < total_frames * src_frame_size) {
+      void *put_buf = NULL;
+      len = SDL_min(chunk * src_frame_size, total_frames * src_frame_size - offset);
+      len = SDL_AudioStreamPeekPut(stream, &put_buf, len);
+      SDLTest_AssertCheck(len > 0 && put_buf != NULL && (len % src_frame_size) == 0, "Expected SDL_AudioStreamPeekPut to return whole frames, got %i bytes.", len);
+      if (len <= 0 || put_buf == NULL) {
+        break;
+      }
+      SDL_memcpy(put_buf, (Uint8 *)buf_in + offset, len);
+      if (SDL_AudioStreamCommitPut(stream, len) < 0 || SDL_AudioStreamPut(reference, (Uint8 *)buf_in + offset, len) < 0) {
+        SDLTest_AssertCheck(SDL_FALSE, "Expected SDL_AudioStreamCommitPut and SDL_AudioStreamPut to succeed: %s", SDL_GetError());
+        break;
+      }
+      offset += len;
+      chunk = (chunk * 7 + 3) % 1500 + 1;
+    }
+    SDLTest_AssertCheck(offset == total_frames * src_frame_size, "Expected all input to be added, got %i of %i bytes.", offset, total_frames * src_frame_size);
+    SDLTest_AssertCheck(SDL_AudioStreamCommitPut(stream, src_frame_size) < 0, "Expected SDL_AudioStreamCommitPut without SDL_AudioStreamPeekPut to fail.");
+    SDL_AudioStreamFlush(stream);
+    SDL_AudioStreamFlush(reference);
+    SDL_free(buf_in);
+
+    len_ref = SDL_AudioStreamAvailable(reference);
+    SDLTest_AssertCheck(SDL_AudioStreamAvailable(stream) == len_ref, "Expected %i bytes available, got %i.", len_ref, SDL_AudioStreamAvailable(stream));
+    buf_ref = (Uint8 *)SDL_malloc(len_ref + 1);
+    buf_out = (Uint8 *)SDL_malloc(len_ref + 1);
+    SDLTest_AssertCheck(buf_ref != NULL && buf_out != NULL, "Expected output buffers to be created.");
+    if (buf_ref == NULL || buf_out == NULL) {
+      SDL_FreeAudioStream(stream);
+      SDL_FreeAudioStream(reference);
+      SDL_free(buf_ref);
+      SDL_free(buf_out);
+      return TEST_ABORTED;
+    }
+    SDL_AudioStreamGet(reference, buf_ref, len_ref);
+
+    /* Read it back out without copying, region by region */
+    len_out = 0;
+    for ( ; ; ) {
+      const void *get_buf = NULL;
+      len = SDL_AudioStreamPeekGet(stream, &get_buf);
+      if (len <= 0 || len_out + len > len_ref) {
+        break;
+      }
+      SDLTest_AssertCheck((len % dst_frame_size) == 0, "Expected SDL_AudioStreamPeekGet to return whole frames, got %i bytes.", len);
+      SDL_memcpy(buf_out + len_out, get_buf, len);
+      len_out += len;
+      SDL_AudioStreamCommitGet(stream, len);
+    }
+    SDLTest_AssertCheck(len_out == len_ref, "Expected %i bytes from SDL_AudioStreamPeekGet, got %i.", len_ref, len_out);
+    SDLTest_AssertCheck(SDL_memcmp(buf_out, buf_ref, len_ref) == 0, "Expected the same output as SDL_AudioStreamPut and SDL_AudioStreamGet.");
+    SDLTest_AssertCheck(SDL_AudioStreamAvailable(stream) == 0, "Expected the stream to be empty.");
+
+    SDL_free(buf_ref);
+    SDL_free(buf_out);
+    SDL_FreeAudioStream(stream);
+    SDL_FreeAudioStream(reference);
+  }
+
+  return TEST_COMPLETED;
+}
+
+/**
+ * \brief Queue and dequeue audio with SDL_HINT_AUDIO_QUEUE_LOCKFREE set
+ *
+ * \sa https://wiki.libsdl.org/SDL_QueueAudio
+ * \sa https://wiki.libsdl.org/SDL_DequeueAudio
+ */
+int audio_queueLockFree()
+{
+  const Uint32 bufsize = 3 * 1024 * 1024;
+  SDL_AudioDeviceID id;
+  SDL_AudioSpec desired;
+  Uint8 *buf;
+  Uint32 queued;
+  Uint32 i;
+  int result;
+
+  buf = (Uint8 *) SDL_malloc(bufsize);
+  SDLTest_AssertCheck(buf != NULL, "Expected SDL_malloc to succeed.");
+  if (buf == NULL) {
+    return TEST_ABORTED;
+  }
+  for (i = 0; i < bufsize; i++) {
+    buf[i] = (Uint8) i;
+  }
+
+  /* Tests that call SDL_AudioQuit() directly can leave no driver running. */
+  if (SDL_GetCurrentAudioDriver() == NULL) {
+    result = SDL_AudioInit(NULL);
+    SDLTest_AssertPass("Call to SDL_AudioInit(NULL)");
+    SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0 got: %d", result);
+  }
+
+  SDL_SetHint(SDL_HINT_AUDIO_QUEUE_LOCKFREE, "1");
+
+  SDL_zero(desired);
+  desired.freq = 22050;
+  desired.format = AUDIO_S16SYS;
+  desired.channels = 2;
+  desired.samples = 4096;
+  desired.callback = NULL;
+
+  /* Playback: the device stays paused, so only we touch the queue. */
+  id = SDL_OpenAudioDevice(NULL, 0, &desired, NULL, 0);
+  SDLTest_AssertPass("Call to SDL_OpenAudioDevice(NULL, 0, ...)");
+  if (id > 0) {
+    /* Small writes first, then one that needs a bigger buffer chained on. */
+    for (i = 0; i < 16; i++) {
+      result = SDL_QueueAudio(id, buf, 4096);
+      SDLTest_AssertCheck(result == 0, "Validate SDL_QueueAudio result; expected: 0, got: %i", result);
+    }
+    result = SDL_QueueAudio(id, buf, bufsize);
+    SDLTest_AssertCheck(result == 0, "Validate SDL_QueueAudio result; expected: 0, got: %i", result);
+    queued = SDL_GetQueuedAudioSize(id);
+    SDLTest_AssertCheck(queued == 16 * 4096 + bufsize, "Validate queued size; expected: %u, got: %u", (unsigned) (16 * 4096 + bufsize), (unsigned) queued);
+
+    SDL_ClearQueuedAudio(id);
+    SDLTest_AssertPass("Call to SDL_ClearQueuedAudio()");
+    queued = SDL_GetQueuedAudioSize(id);
+    SDLTest_AssertCheck(queued == 0, "Validate queued size after clearing; expected: 0, got: %u", (unsigned) queued);
+
+    result = SDL_QueueAudio(id, buf, 4096);
+    SDLTest_AssertCheck(result == 0, "Validate SDL_QueueAudio result after clearing; expected: 0, got: %i", result);
+    queued = SDL_GetQueuedAudioSize(id);
+    SDLTest_AssertCheck(queued == 4096, "Validate queued size; expected: 4096, got: %u", (unsigned) queued);
+
+    SDL_CloseAudioDevice(id);
+    SDLTest_AssertPass("Call to SDL_CloseAudioDevice()");
+  } else {
+    SDLTest_Log("No playback device to test with: %s", SDL_GetError());
+  }
+
+  /* Capture: the audio thread fills the queue while we drain it. */
+  id = SDL_OpenAudioDevice(NULL, 1, &desired, NULL, 0);
+  SDLTest_AssertPass("Call to SDL_OpenAudioDevice(NULL, 1, ...)");
+  if (id > 0) {
+    Uint32 total = 0;
+    Uint32 start = SDL_GetTicks();
+
+    SDL_PauseAudioDevice(id, 0);
+    while ((total < 4 * 4096) && !SDL_TICKS_PASSED(SDL_GetTicks(), start + 5000)) {
+      total += SDL_DequeueAudio(id, buf, 4096);
+      SDL_Delay(10);
+    }
+    SDLTest_AssertCheck(total >= 4 * 4096, "Validate dequeued size; expected: >= %u, got: %u", 4 * 4096, (unsigned) total);
+
+    SDL_CloseAudioDevice(id);
+    SDLTest_AssertPass("Call to SDL_CloseAudioDevice()");
+  } else {
+    SDLTest_Log("No capture device to test with: %s", SDL_GetError());
+  }
+
+  SDL_SetHint(SDL_HINT_AUDIO_QUEUE_LOCKFREE, "0");
+  SDL_free(buf);
+
+  return TEST_COMPLETED;
+}
+
+/* Reads and writes one sample of the given format, as a double, in either byte order. */
+static double
+_audio_readSample(const Uint8 *buf, SDL_AudioFormat format)
+{
+  Uint32 bits;
+  float f;
+
+  if (SDL_AUDIO_BITSIZE(format) == 16) {
+    const Uint16 v = SDL_AUDIO_ISBIGENDIAN(format) ? (Uint16) ((buf[0] << 8) | buf[1]) : (Uint16) ((buf[1] << 8) | buf[0]);
+    return (double) (Sint16) v;
+  }
+
+  bits = SDL_AUDIO_ISBIGENDIAN(format) ?
+         (((Uint32) buf[0] << 24) | ((Uint32) buf[1] << 16) | ((Uint32) buf[2] << 8) | buf[3]) :
+         (((Uint32) buf[3] << 24) | ((Uint32) buf[2] << 16) | ((Uint32) buf[1] << 8) | buf[0]);
+  if (SDL_AUDIO_ISFLOAT(format)) {
+    SDL_memcpy(&f, &bits, sizeof (f));
+    return (double) f;
+  }
+  return (double) (Sint32) bits;
+}
+
+static void
+_audio_writeSample(Uint8 *buf, SDL_AudioFormat format, double value)
+{
+  const int size = SDL_AUDIO_BITSIZE(format) / 8;
+  Uint32 bits;
+  int i;
+
+  if (SDL_AUDIO_ISFLOAT(format)) {
+    const float f = (float) value;
+    SDL_memcpy(&bits, &f, sizeof (bits));
+  } else {
+    bits = (Uint32) (Sint32) value;
+  }
+
+  for (i = 0; i < size; i++) {
+    const int shift = SDL_AUDIO_ISBIGENDIAN(format) ? (8 * (size - 1 - i)) : (8 * i);
+    buf[i] = (Uint8) (bits >> shift);
+  }
+}
+
+/**
+ * \brief Check SDL_MixAudioFormat results sample by sample, including saturation
+ *
+ * \sa https://wiki.libsdl.org/SDL_MixAudioFormat
+ */
+int audio_mixAudioFormat()
+{
+  static const SDL_AudioFormat formats[] = { AUDIO_S16LSB, AUDIO_S16MSB, AUDIO_S32LSB, AUDIO_S32MSB, AUDIO_F32LSB, AUDIO_F32MSB };
+  static const int volumes[] = { 1, 37, 64, 127, SDL_MIX_MAXVOLUME };
+  /* not a multiple of any vector width, so the scalar tail gets used too */
+  const int samples = 131;
+  Uint8 src[131 * 4];
+  Uint8 dst[131 * 4];
+  double srcval[131];
+  double dstval[131];
+  int i, j, k;
+
+  for (i = 0; i < SDL_arraysize(formats); i++) {
+    const SDL_AudioFormat format = formats[i];
+    const int size = SDL_AUDIO_BITSIZE(format) / 8;
+    const double maxval = SDL_AUDIO_ISFLOAT(format) ? 3.402823466e+38F : (double) ((((Sint64) 1) << (SDL_AUDIO_BITSIZE(format) - 1)) - 1);
+    const double minval = SDL_AUDIO_ISFLOAT(format) ? -3.402823466e+38F : -maxval - 1.0;
+
+    for (j = 0; j < SDL_arraysize(volumes); j++) {
+      const int volume = volumes[j];
+      int mismatches = 0;
+
+      for (k = 0; k < samples; k++) {
+        switch (k % 4) {
+          case 0:  /* saturate upward */
+            srcval[k] = SDL_AUDIO_ISFLOAT(format) ? 3.0e+38F : maxval - SDLTest_RandomIntegerInRange(0, 200);
+            dstval[k] = SDL_AUDIO_ISFLOAT(format) ? 3.0e+38F : maxval - SDLTest_RandomIntegerInRange(0, 200);
+            break;
+          case 1:  /* saturate downward */
+            srcval[k] = SDL_AUDIO_ISFLOAT(format) ? -3.0e+38F : minval + SDLTest_RandomIntegerInRange(0, 200);
+            dstval[k] = SDL_AUDIO_ISFLOAT(format) ? -3.0e+38F : minval + SDLTest_RandomIntegerInRange(0, 200);
+            break;
+          default:
+            if (SDL_AUDIO_ISFLOAT(format)) {
+              srcval[k] = (float) SDLTest_RandomIntegerInRange(-1000000, 1000000) / 1000000.0f;
+              dstval[k] = (float) SDLTest_RandomIntegerInRange(-1000000, 1000000) / 1000000.0f;
+            } else if (size == 2) {
+              srcval[k] = (double) (Sint16) SDLTest_RandomUint16();
+              dstval[k] = (double) (Sint16) SDLTest_RandomUint16();
+            } else {
+              srcval[k] = (double) SDLTest_RandomSint32();
+              dstval[k] = (double) SDLTest_RandomSint32();
+            }
+            break;
+        }
+        _audio_writeSample(src + k * size, format, srcval[k]);
+        _audio_writeSample(dst + k * size, format, dstval[k]);
+      }
+
+      SDL_MixAudioFormat(dst, src, format, samples * size, volume);
+
+      for (k = 0; k < samples; k++) {
+        double expected;
+        if (SDL_AUDIO_ISFLOAT(format)) {
+          const float scaled = ((float) srcval[k] * (float) volume) * (1.0f / ((float) SDL_MIX_MAXVOLUME));
+          expected = (double) scaled + dstval[k];
+          expected = (double) (float) SDL_max(minval, SDL_min(maxval, expected));
+        } else {
+          /* integer division rounds toward zero */
+          expected = (double) (((Sint64) srcval[k] * volume) / SDL_MIX_MAXVOLUME) + dstval[k];
+          expected = SDL_max(minval, SDL_min(maxval, expected));
+        }
+        if (_audio_readSample(dst + k * size, format) != expected) {
+          if (mismatches == 0) {
+            SDLTest_LogError("Format 0x%04x, volume %d, sample %d: expected %f, got %f", format, volume, k, expected, _audio_readSample(dst + k * size, format));
+          }
+          mismatches++;
+        }
+      }
+      SDLTest_AssertCheck(mismatches == 0, "Validate mixed samples for format 0x%04x, volume %d; expected: 0 mismatches, got: %d", format, volume, mismatches);
+    }
+  }
+
+  return TEST_COMPLETED;
+}
+
+/**
+ * \brief Check SDL_MixAudioSources against a float reference, with panning, volume and dst aliasing a source
+ *
+ * \sa https://wiki.libsdl.org/SDL_MixAudioSources
+ */
+int audio_mixAudioSources()
+{
+  static const SDL_AudioFormat formats[] = { AUDIO_S16LSB, AUDIO_S16MSB, AUDIO_F32LSB, AUDIO_F32MSB };
+  static const float pan[2] = { 0.25f, 1.0f };
+  /* more than one internal block, and not a multiple of any vector width */
+  const int frames = 300;
+  const int channels = 2;
+  const int samples = 300 * 2;
+  Uint8 srcs[3][300 * 2 * 4];
+  Uint8 dst[300 * 2 * 4];
+  double srcval[3][300 * 2];
+  SDL_AudioMixSource sources[4];
+  int i, j, k;
+  int result;
+
+  for (i = 0; i < SDL_arraysize(formats); i++) {
+    const SDL_AudioFormat format = formats[i];
+    const int size = SDL_AUDIO_BITSIZE(format) / 8;
+    const double scale = SDL_AUDIO_ISFLOAT(format) ? 1.0 : 32768.0;
+    int aliased;
+
+    for (aliased = 0; aliased <= 1; aliased++) {
+      int mismatches = 0;
+
+      for (j = 0; j < 3; j++) {
+        for (k = 0; k < samples; k++) {
+          if (SDL_AUDIO_ISFLOAT(format)) {
+            srcval[j][k] = (float) SDLTest_RandomIntegerInRange(-1000000, 1000000) / 1000000.0f;
+          } else {
+            srcval[j][k] = (double) (Sint16) SDLTest_RandomUint16();
+          }
+          _audio_writeSample(srcs[j] + k * size, format, srcval[j][k]);
+        }
+      }
+
+      sources[0].src = srcs[0];
+      sources[0].volume = SDL_MIX_MAXVOLUME;
+      sources[0].pan = NULL;
+      sources[1].src = srcs[1];
+      sources[1].volume = 37;
+      sources[1].pan = pan;
+      sources[2].src = srcs[2];
+      sources[2].volume = 0;  /* skipped */
+      sources[2].pan = NULL;
+      sources[3].src = NULL;  /* skipped */
+      sources[3].volume = SDL_MIX_MAXVOLUME;
+      sources[3].pan = NULL;
+
+      result = SDL_MixAudioSources(aliased ? srcs[0] : dst, sources, SDL_arraysize(sources), format, channels, samples * size);
+      SDLTest_AssertPass("Call to SDL_MixAudioSources(format=0x%04x, aliased=%d)", format, aliased);
+      SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0, got: %d", result);
+
+      for (k = 0; k < samples; k++) {
+        const double got = _audio_readSample((aliased ? srcs[0] : dst) + k * size, format);
+        double expected = (srcval[0][k] / scale) + ((srcval[1][k] / scale) * (37.0 / SDL_MIX_MAXVOLUME) * pan[k % channels]);
+        double tolerance;
+        /* the sum is clipped for every output format */
+        expected = SDL_max(-1.0, SDL_min(1.0, expected));
+        if (SDL_AUDIO_ISFLOAT(format)) {
+          tolerance = 0.00001;
+        } else {
+          /* the float-to-int converters may round or truncate */
+          expected *= 32767.0;
+          tolerance = 1.0;
+        }
+        if (SDL_fabs(got - expected) > tolerance) {
+          if (mismatches == 0) {
+            SDLTest_LogError("Format 0x%04x, aliased %d, sample %d: expected %f, got %f", format, aliased, k, expected, got);
+          }
+          mismatches++;
+        }
+      }
+      SDLTest_AssertCheck(mismatches == 0, "Validate mixed samples for format 0x%04x, aliased %d; expected: 0 mismatches, got: %d", format, aliased, mismatches);
+    }
+  }
+
+  /* no sources at all gives silence */
+  SDL_memset(dst, 0xAA, sizeof (dst));
+  result = SDL_MixAudioSources(dst, NULL, 0, AUDIO_S16SYS, channels, frames * channels * 2);
+  SDLTest_AssertCheck(result == 0, "Validate result value with no sources; expected: 0, got: %d", result);
+  for (k = 0; k < frames * channels * 2; k++) {
+    if (dst[k] != 0) {
+      break;
+    }
+  }
+  SDLTest_AssertCheck(k == frames * channels * 2, "Validate silence with no sources; expected: %d zero bytes, got: %d", frames * channels * 2, k);
+
+  /* invalid parameters */
+  SDL_ClearError();
+  result = SDL_MixAudioSources(NULL, sources, 1, AUDIO_S16SYS, channels, 4);
+  SDLTest_AssertCheck(result == -1, "Validate result value with NULL dst; expected: -1, got: %d", result);
+  result = SDL_MixAudioSources(dst, NULL, 1, AUDIO_S16SYS, channels, 4);
+  SDLTest_AssertCheck(result == -1, "Validate result value with NULL sources; expected: -1, got: %d", result);
+  result = SDL_MixAudioSources(dst, sources, 1, AUDIO_S16SYS, 0, 4);
+  SDLTest_AssertCheck(result == -1, "Validate result value with 0 channels; expected: -1, got: %d", result);
+  result = SDL_MixAudioSources(dst, sources, 1, AUDIO_S16SYS, 9, 36);
+  SDLTest_AssertCheck(result == -1, "Validate result value with 9 channels; expected: -1, got: %d", result);
+  result = SDL_MixAudioSources(dst, sources, 1, AUDIO_S16SYS, channels, 6);
+  SDLTest_AssertCheck(result == -1, "Validate result value with a partial frame; expected: -1, got: %d", result);
+  result = SDL_MixAudioSources(dst, sources, 1, 0x1234, channels, 4);
+  SDLTest_AssertCheck(result == -1, "Validate result value with an invalid format; expected: -1, got: %d", result);
+
+  return TEST_COMPLETED;
+}
+
+/**
+ * \brief Check channel conversions of whole buffers against the same data converted one frame at a time
+ *
+ * Whole buffers go through the SIMD paths where there are any; single frames never do.
+ * Also checks 7.1 to stereo, which is mixed in one pass, against the 7.1 -> 5.1 -> stereo math.
+ *
+ * \sa https://wiki.libsdl.org/SDL_ConvertAudio
+ */
+int audio_convertChannels()
+{
+  static const Uint8 channels[] = { 1, 2, 4, 6, 8 };
+  /* odd, so no SIMD block size divides it */
+  const int frames = 37;
+  float bulk[37 * 8 * 4 + 1];
+  float single[8 * 4];
+  float src[37 * 8];
+  SDL_AudioCVT cvt;
+  int i, j, k, l, offset;
+  int result;
+
+  for (k = 0; k < frames * 8; k++) {
+    src[k] = (float) SDLTest_RandomIntegerInRange(-1000000, 1000000) / 1000000.0f;
+  }
+
+  for (i = 0; i < SDL_arraysize(channels); i++) {
+    for (j = 0; j < SDL_arraysize(channels); j++) {
+      const int srcchans = channels[i];
+      const int dstchans = channels[j];
+
+      result = SDL_BuildAudioCVT(&cvt, AUDIO_F32SYS, channels[i], 48000, AUDIO_F32SYS, channels[j], 48000);
+      SDLTest_AssertCheck(result == ((i == j) ? 0 : 1), "Validate result of SDL_BuildAudioCVT(%d->%d channels); expected: %d, got: %d", srcchans, dstchans, (i == j) ? 0 : 1, result);
+      if (result != 1) {
+        continue;
+      }
+      SDLTest_AssertCheck(cvt.len_mult * srcchans >= dstchans, "Validate len_mult; expected: >= %d, got: %d", dstchans / srcchans, cvt.len_mult);
+
+      /* start off 16-byte alignment too, so the SIMD paths have a head to do */
+      for (offset = 0; offset <= 1; offset++) {
+        int mismatches = 0;
+
+        cvt.buf = (Uint8 *) (bulk + offset);
+        cvt.len = frames * srcchans * sizeof (float);
+        SDL_memcpy(cvt.buf, src, cvt.len);
+        result = SDL_ConvertAudio(&cvt);
+        SDLTest_AssertCheck(result == 0, "Validate result of SDL_ConvertAudio(%d->%d channels); expected: 0, got: %d", srcchans, dstchans, result);
+        SDLTest_AssertCheck(cvt.len_cvt == (int) (frames * dstchans * sizeof (float)), "Validate converted length; expected: %d, got: %d", (int) (frames * dstchans * sizeof (float)), cvt.len_cvt);
+
+        for (k = 0; k < frames; k++) {
+          cvt.buf = (Uint8 *) single;
+          cvt.len = srcchans * sizeof (float);
+          SDL_memcpy(single, src + (k * srcchans), cvt.len);
+          SDL_ConvertAudio(&cvt);
+          for (l = 0; l < dstchans; l++) {
+            /* channel filters give identical results; one-pass mixes may sum in another order */
+            if (SDL_fabs(single[l] - bulk[offset + (k * dstchans) + l]) > 0.000001) {
+              if (mismatches == 0) {
+                SDLTest_LogError("%d->%d channels, frame %d, channel %d: expected %f, got %f", srcchans, dstchans, k, l, single[l], bulk[offset + (k * dstchans) + l]);
+              }
+              mismatches++;
+            }
+          }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Validate %d->%d channels, buffer offset %d; expected: 0 mismatches, got: %d", srcchans, dstchans, offset, mismatches);
+      }
+    }
+  }
+
+  /* 7.1 -> stereo against the two steps it replaces */
+  SDL_BuildAudioCVT(&cvt, AUDIO_F32SYS, 8, 48000, AUDIO_F32SYS, 2, 48000);
+  cvt.buf = (Uint8 *) bulk;
+  cvt.len = frames * 8 * sizeof (float);
+  SDL_memcpy(bulk, src, cvt.len);
+  SDL_ConvertAudio(&cvt);
+  for (k = 0; k < frames; k++) {
+    const float *in = src + (k * 8);
+    const float fl = (in[0] + (in[6] * 0.5f)) / 1.5f;
+    const float fr = (in[1] + (in[7] * 0.5f)) / 1.5f;
+    const float fc = in[2] / 1.5f;
+    const float bl = (in[4] + (in[6] * 0.5f)) / 1.5f;
+    const float br = (in[5] + (in[7] * 0.5f)) / 1.5f;
+    const float left = (fl + (fc * 0.5f) + bl) / 2.5f;
+    const float right = (fr + (fc * 0.5f) + br) / 2.5f;
+    if ((SDL_fabs(bulk[k * 2] - left) > 0.000001) || (SDL_fabs(bulk[(k * 2) + 1] - right) > 0.000001)) {
+      break;
+    }
+  }
+  SDLTest_AssertCheck(k == frames, "Validate 7.1 to stereo mix; expected: %d matching frames, got: %d", frames, k);
+
+  return TEST_COMPLETED;
+}
+
+/**
+ * \brief Check that long buffers, which get converted a block at a time, match the same data converted in short pieces
+ *
+ * Also checks that conversion stays inside len * len_mult bytes.
+ *
+ * \sa https://wiki.libsdl.org/SDL_BuildAudioCVT
+ * \sa https://wiki.libsdl.org/SDL_ConvertAudio
+ */
+int audio_convertAudioBlocks()
+{
+  static const struct {
+    SDL_AudioFormat srcfmt; Uint8 srcchans;
+    SDL_AudioFormat dstfmt; Uint8 dstchans;
+  } chains[] = {
+    { AUDIO_S16SYS, 1, AUDIO_S16SYS, 2 },  /* grows */
+    { AUDIO_S16SYS, 6, AUDIO_S16SYS, 2 },  /* grows, then shrinks */
+    { AUDIO_S32SYS, 8, AUDIO_S16SYS, 2 },  /* never grows */
+    { AUDIO_U8, 1, AUDIO_S16SYS, 8 },      /* grows a lot */
+    { AUDIO_S16MSB, 2, AUDIO_S16SYS, 4 }
+  };
+  /* not a multiple of any block size, and short enough pieces always fit in one block */
+  const int frames = 5003;
+  const int piece = 41;
+  Uint8 *bulk, *pieces, *src;
+  SDL_AudioCVT cvt;
+  int i, k, mismatches;
+  int result;
+
+  src = (Uint8 *) SDL_malloc(frames * 8 * 4);
+  SDLTest_AssertCheck(src != NULL, "Validate source buffer allocation");
+  if (src == NULL) {
+    return TEST_ABORTED;
+  }
+  for (k = 0; k < frames * 8 * 4; k++) {
+    src[k] = (Uint8) SDLTest_RandomIntegerInRange(0, 255);
+  }
+
+  for (i = 0; i < SDL_arraysize(chains); i++) {
+    const int srcframesize = (SDL_AUDIO_BITSIZE(chains[i].srcfmt) / 8) * chains[i].srcchans;
+    const int dstframesize = 2 * chains[i].dstchans;
+    const int guard = 16;
+
+    result = SDL_BuildAudioCVT(&cvt, chains[i].srcfmt, chains[i].srcchans, 48000, chains[i].dstfmt, chains[i].dstchans, 48000);
+    SDLTest_AssertCheck(result == 1, "Validate result of SDL_BuildAudioCVT(chain %d); expected: 1, got: %d", i, result);
+    if (result != 1) {
+      continue;
+    }
+
+    bulk = (Uint8 *) SDL_malloc((frames * srcframesize * cvt.len_mult) + guard);
+    pieces = (Uint8 *) SDL_malloc(frames * dstframesize);
+    SDLTest_AssertCheck(bulk != NULL && pieces != NULL, "Validate conversion buffer allocation");
+    if (bulk == NULL || pieces == NULL) {
+      SDL_free(bulk);
+      SDL_free(pieces);
+      continue;
+    }
+
+    cvt.buf = bulk;
+    cvt.len = frames * srcframesize;
+    SDL_memcpy(bulk, src, cvt.len);
+    SDL_memset(bulk + (cvt.len * cvt.len_mult), 0xAA, guard);
+    result = SDL_ConvertAudio(&cvt);
+    SDLTest_AssertCheck(result == 0, "Validate result of SDL_ConvertAudio(chain %d); expected: 0, got: %d", i, result);
+    SDLTest_AssertCheck(cvt.len_cvt == frames * dstframesize, "Validate converted length; expected: %d, got: %d", frames * dstframesize, cvt.len_cvt);
+    for (k = 0; k < guard; k++) {
+      if (bulk[(cvt.len * cvt.len_mult) + k] != 0xAA) {
+        break;
+      }
+    }
+    SDLTest_AssertCheck(k == guard, "Validate conversion stayed within len * len_mult (%d bytes)", cvt.len * cvt.len_mult);
+
+    for (k = 0; k < frames; k += piece) {
+      const int n = SDL_min(piece, frames - k);
+      Uint8 buf[41 * 8 * 4 * 4];
+      cvt.buf = buf;
+      cvt.len = n * srcframesize;
+      SDL_memcpy(buf, src + (k * srcframesize), cvt.len);
+      SDL_ConvertAudio(&cvt);
+      SDL_memcpy(pieces + (k * dstframesize), buf, cvt.len_cvt);
+    }
+
+    /* SIMD and scalar paths may round the last bit differently */
+    mismatches = 0;
+    for (k = 0; k < frames * chains[i].dstchans; k++) {
+      const int diff = ((Sint16 *) bulk)[k] - ((Sint16 *) pieces)[k];
+      if (diff < -1 || diff > 1) {
+        if (mismatches == 0) {
+          SDLTest_LogError("chain %d, sample %d: expected %d, got %d", i, k, ((Sint16 *) pieces)[k], ((Sint16 *) bulk)[k]);
+        }
+        mismatches++;
+      }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Validate chain %d against piecewise conversion; expected: 0 mismatches, got: %d", i, mismatches);
+
+    SDL_free(bulk);
+    SDL_free(pieces);
+  }
+
+  SDL_free(src);
+  return TEST_COMPLETED;
+}
+
+/**
+ * \brief Check that a chain using every filter slot converts the same as the chain it was built from
+ *
+ * Pads a growing conversion with byteswap pairs, which cancel out, so the list
+ * ends in the last slot and nothing is left past its NULL terminator.
+ *
+ * \sa https://wiki.libsdl.org/SDL_BuildAudioCVT
+ * \sa https://wiki.libsdl.org/SDL_ConvertAudio
+ */
+int audio_convertAudioMaxFilters()
+{
+  const int frames = 5003;
+  const int srclen = frames * 2;
+  const int guard = 16;
+  SDL_AudioFilter byteswap;
+  SDL_AudioCVT cvt;
+  Uint8 *expected, *padded;
+  int i, pad, result;
+
+  result = SDL_BuildAudioCVT(&cvt, AUDIO_S16LSB, 1, 48000, AUDIO_S16MSB, 1, 48000);
+  SDLTest_AssertCheck(result == 1 && cvt.filter_index == 1, "Validate byteswap-only SDL_BuildAudioCVT; expected: 1 filter, got: %d", cvt.filter_index);
+  if (result != 1 || cvt.filter_index != 1) {
+    return TEST_ABORTED;
+  }
+  byteswap = cvt.filters[0];
+
+  result = SDL_BuildAudioCVT(&cvt, AUDIO_S16SYS, 1, 48000, AUDIO_S16SYS, 8, 48000);
+  SDLTest_AssertCheck(result == 1, "Validate result of SDL_BuildAudioCVT; expected: 1, got: %d", result);
+  pad = SDL_AUDIOCVT_MAX_FILTERS - cvt.filter_index;
+  if (result != 1 || (pad % 2) != 0) {
+    return TEST_ABORTED;
+  }
+
+  expected = (Uint8 *) SDL_malloc(srclen * cvt.len_mult);
+  padded = (Uint8 *) SDL_malloc((srclen * cvt.len_mult) + guard);
+  SDLTest_AssertCheck(expected != NULL && padded != NULL, "Validate conversion buffer allocation");
+  if (expected == NULL || padded == NULL) {
+    SDL_free(expected);
+    SDL_free(padded);
+    return TEST_ABORTED;
+  }
+  for (i = 0; i < srclen; i++) {
+    expected[i] = padded[i] = (Uint8) SDLTest_RandomIntegerInRange(0, 255);
+  }
+  SDL_memset(padded + (srclen * cvt.len_mult), 0xAA, guard);
+
+  cvt.buf = expected;
+  cvt.len = srclen;
+  result = SDL_ConvertAudio(&cvt);
+  SDLTest_AssertCheck(result == 0, "Validate result of SDL_ConvertAudio; expected: 0, got: %d", result);
+
+  /* The source is S16, so swapping it and back before anything else is a no-op. */
+  for (i = SDL_AUDIOCVT_MAX_FILTERS - 1; i >= pad; i--) {
+    cvt.filters[i] = cvt.filters[i - pad];
+  }
+  for (i = 0; i < pad; i++) {
+    cvt.filters[i] = byteswap;
+  }
+  cvt.filters[SDL_AUDIOCVT_MAX_FILTERS] = NULL;
+  cvt.filter_index = SDL_AUDIOCVT_MAX_FILTERS;
+
+  cvt.buf = padded;
+  cvt.len = srclen;
+  result = SDL_ConvertAudio(&cvt);
+  SDLTest_AssertCheck(result == 0, "Validate result of SDL_ConvertAudio with %d filters; expected: 0, got: %d", SDL_AUDIOCVT_MAX_FILTERS, result);
+  SDLTest_AssertCheck(cvt.len_cvt == frames * 2 * 8, "Validate converted length; expected: %d, got: %d", frames * 2 * 8, cvt.len_cvt);
+  SDLTest_AssertCheck(SDL_memcmp(expected, padded, frames * 2 * 8) == 0, "Validate padded chain against the chain it was built from");
+  for (i = 0; i < guard; i++) {
+    if (padded[(srclen * cvt.len_mult) + i] != 0xAA) {
+      break;
+    }
+  }
+  SDLTest_AssertCheck(i == guard, "Validate conversion stayed within len * len_mult (%d bytes)", srclen * cvt.len_mult);
+
+  SDL_free(expected);
+  SDL_free(padded);
+  return TEST_COMPLETED;
+}
 
 /* ================= Test Case References ================== */
 
@@ -1022,11 +1831,35 @@ static const SDLTest_TestCaseReference audioTest14 =
 static const SDLTest_TestCaseReference audioTest15 =
         { (SDLTest_TestCaseFp)audio_pauseUnpauseAudio, "audio_pauseUnpauseAudio", "Pause and Unpause audio for various audio specs while testing callback.", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference audioTest16 =
+        { (SDLTest_TestCaseFp)audio_resampleLoss, "audio_resampleLoss", "Check signal-to-noise ratio of resampled audio.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest17 =
+        { (SDLTest_TestCaseFp)audio_streamPeekCommit, "audio_streamPeekCommit", "Add and remove audio stream data without copying.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest18 =
+        { (SDLTest_TestCaseFp)audio_queueLockFree, "audio_queueLockFree", "Queue and dequeue audio through the lock-free queue.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest19 =
+        { (SDLTest_TestCaseFp)audio_mixAudioFormat, "audio_mixAudioFormat", "Mix audio in various formats and check the results.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest20 =
+        { (SDLTest_TestCaseFp)audio_mixAudioSources, "audio_mixAudioSources", "Mix several panned sources in one call and check the results.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest21 =
+        { (SDLTest_TestCaseFp)audio_convertChannels, "audio_convertChannels", "Convert between all channel counts and check the results.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest22 =
+        { (SDLTest_TestCaseFp)audio_convertAudioBlocks, "audio_convertAudioBlocks", "Convert long buffers and check them against short pieces.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest23 =
+        { (SDLTest_TestCaseFp)audio_convertAudioMaxFilters, "audio_convertAudioMaxFilters", "Convert with every filter slot in use.", TEST_ENABLED };
+
 /* Sequence of Audio test cases */
 static const SDLTest_TestCaseReference *audioTests[] =  {
     &audioTest1, &audioTest2, &audioTest3, &audioTest4, &audioTest5, &audioTest6,
     &audioTest7, &audioTest8, &audioTest9, &audioTest10, &audioTest11,
-    &audioTest12, &audioTest13, &audioTest14, &audioTest15, NULL
+    &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16, &audioTest17, &audioTest18, &audioTest19, &audioTest20, &audioTest21, &audioTest22, &audioTest23, NULL
 };
 
 /* Audio test suite (global) */
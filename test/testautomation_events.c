@@ -174,6 +174,193 @@ events_addDelEventWatchWithUserdata(void *arg)
    return TEST_COMPLETED;
 }
 
+/**
+ * @brief Pushes enough events to overflow the lock-free ring and checks order and filtering
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PushEvent
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PeepEvents
+ */
+int
+events_pushManyAndPeepFiltered(void *arg)
+{
+   SDL_Event event;
+   const int numEvents = 1000;
+   int i, result, mismatches;
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertPass("Call to SDL_FlushEvents()");
+
+   /* Alternate between two user event types */
+   SDL_zero(event);
+   for (i = 0; i < numEvents; ++i) {
+      event.type = SDL_USEREVENT + (i & 1);
+      event.user.code = i;
+      result = SDL_PushEvent(&event);
+      if (result != 1) {
+         SDLTest_AssertCheck(result == 1, "Check result from SDL_PushEvent, expected: 1, got: %d", result);
+         break;
+      }
+   }
+   SDLTest_AssertPass("Call to SDL_PushEvent() %d times", numEvents);
+
+   result = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(result == numEvents, "Check queued events, expected: %d, got: %d", numEvents, result);
+
+   /* Take out the odd ones first, then the even ones, both in order */
+   mismatches = 0;
+   for (i = 1; i < numEvents; i += 2) {
+      result = SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_USEREVENT + 1, SDL_USEREVENT + 1);
+      if (result != 1 || event.user.code != i) {
+         ++mismatches;
+      }
+   }
+   for (i = 0; i < numEvents; i += 2) {
+      result = SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_USEREVENT, SDL_USEREVENT);
+      if (result != 1 || event.user.code != i) {
+         ++mismatches;
+      }
+   }
+   SDLTest_AssertPass("Call to SDL_PeepEvents() %d times", numEvents);
+   SDLTest_AssertCheck(mismatches == 0, "Check events came out filtered and in order, expected: 0 mismatches, got: %d", mismatches);
+
+   result = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(result == 0, "Check queued events, expected: 0, got: %d", result);
+
+   return TEST_COMPLETED;
+}
+
+/* Timer callback that pushes a user event */
+static Uint32 SDLCALL _events_pushUsereventTimer(Uint32 interval, void *param)
+{
+   SDL_Event event;
+
+   SDL_zero(event);
+   event.type = SDL_USEREVENT;
+   event.user.code = *(int *)param;
+   SDL_PushEvent(&event);
+   return 0;
+}
+
+/**
+ * @brief Waits for events with and without a timeout
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_WaitEventTimeout
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_WaitEvent
+ */
+int
+events_waitEventTimeout(void *arg)
+{
+   SDL_Event event;
+   SDL_TimerID id;
+   Uint32 start, elapsed;
+   int result;
+   int code = SDLTest_RandomSint32();
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertPass("Call to SDL_FlushEvents()");
+
+   /* Nothing arrives, so we should time out */
+   start = SDL_GetTicks();
+   result = SDL_WaitEventTimeout(&event, 50);
+   elapsed = SDL_GetTicks() - start;
+   SDLTest_AssertPass("Call to SDL_WaitEventTimeout(50)");
+   SDLTest_AssertCheck(result == 0, "Check result from SDL_WaitEventTimeout, expected: 0, got: %d", result);
+   SDLTest_AssertCheck(elapsed >= 50, "Check elapsed time, expected: >= 50, got: %d", (int)elapsed);
+
+   /* An event pushed from the timer thread should wake us up */
+   id = SDL_AddTimer(20, _events_pushUsereventTimer, &code);
+   SDLTest_AssertPass("Call to SDL_AddTimer()");
+   SDLTest_AssertCheck(id > 0, "Check result from SDL_AddTimer, expected: >0, got: %d", id);
+   result = SDL_WaitEventTimeout(&event, 5000);
+   SDLTest_AssertPass("Call to SDL_WaitEventTimeout(5000)");
+   SDLTest_AssertCheck(result == 1, "Check result from SDL_WaitEventTimeout, expected: 1, got: %d", result);
+   if (result == 1) {
+      SDLTest_AssertCheck(event.type == SDL_USEREVENT, "Check event type, expected: %d, got: %d", SDL_USEREVENT, event.type);
+      SDLTest_AssertCheck(event.user.code == code, "Check event code, expected: %d, got: %d", code, event.user.code);
+   }
+
+   return TEST_COMPLETED;
+}
+
+/* Filter that pushes another event while SDL_FilterEvents() holds the queue lock */
+static int SDLCALL _events_pushingEventFilter(void *userdata, SDL_Event *event)
+{
+   if (event->type == SDL_USEREVENT) {
+      SDL_Event pushed;
+
+      SDL_zero(pushed);
+      pushed.type = SDL_USEREVENT + 1;
+      if (SDL_PushEvent(&pushed) == 1) {
+         SDL_AtomicIncRef((SDL_atomic_t *)userdata);
+      }
+   }
+   return 1;
+}
+
+typedef struct
+{
+   SDL_atomic_t pushed;
+   SDL_atomic_t done;
+} _events_filterPushData;
+
+static int SDLCALL _events_filterPushThread(void *arg)
+{
+   _events_filterPushData *data = (_events_filterPushData *)arg;
+   SDL_Event event;
+   int i;
+
+   SDL_zero(event);
+   event.type = SDL_USEREVENT;
+   for (i = 0; i < 200; ++i) {
+      if (SDL_PushEvent(&event) == 1) {
+         SDL_AtomicIncRef(&data->pushed);
+      }
+      SDL_FilterEvents(_events_pushingEventFilter, &data->pushed);
+      SDL_Delay(i % 2);
+   }
+   SDL_AtomicSet(&data->done, 1);
+   return 0;
+}
+
+/**
+ * @brief Waits for events while another thread pushes them from inside SDL_FilterEvents()
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_WaitEventTimeout
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_FilterEvents
+ */
+int
+events_waitEventWithFilterPush(void *arg)
+{
+   _events_filterPushData data;
+   SDL_Thread *thread;
+   SDL_Event event;
+   int received = 0;
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertPass("Call to SDL_FlushEvents()");
+
+   SDL_AtomicSet(&data.pushed, 0);
+   SDL_AtomicSet(&data.done, 0);
+   thread = SDL_CreateThread(_events_filterPushThread, "FilterPush", &data);
+   SDLTest_AssertCheck(thread != NULL, "Check result from SDL_CreateThread, expected: non-NULL");
+   if (thread == NULL) {
+      return TEST_ABORTED;
+   }
+
+   /* This mustn't deadlock against the filter pushing with the queue locked */
+   while (!SDL_AtomicGet(&data.done) || SDL_HasEvents(SDL_USEREVENT, SDL_USEREVENT + 1)) {
+      if (SDL_WaitEventTimeout(&event, 100) == 1 &&
+          (event.type == SDL_USEREVENT || event.type == SDL_USEREVENT + 1)) {
+         ++received;
+      }
+   }
+   SDL_WaitThread(thread, NULL);
+   SDLTest_AssertPass("Call to SDL_WaitEventTimeout() until the other thread is done");
+   SDLTest_AssertCheck(received == SDL_AtomicGet(&data.pushed), "Check received events, expected: %d, got: %d", SDL_AtomicGet(&data.pushed), received);
+
+   return TEST_COMPLETED;
+}
+
 
 /* ================= Test References ================== */
 
@@ -187,9 +374,18 @@ static const SDLTest_TestCaseReference eventsTest2 =
 static const SDLTest_TestCaseReference eventsTest3 =
         { (SDLTest_TestCaseFp)events_addDelEventWatchWithUserdata, "events_addDelEventWatchWithUserdata", "Adds and deletes an event watch function with userdata", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference eventsTest4 =
+        { (SDLTest_TestCaseFp)events_pushManyAndPeepFiltered, "events_pushManyAndPeepFiltered", "Pushes many events and peeps them back filtered by type", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest5 =
+        { (SDLTest_TestCaseFp)events_waitEventTimeout, "events_waitEventTimeout", "Waits for events with and without a timeout", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest6 =
+        { (SDLTest_TestCaseFp)events_waitEventWithFilterPush, "events_waitEventWithFilterPush", "Waits for events pushed from inside SDL_FilterEvents", TEST_ENABLED };
+
 /* Sequence of Events test cases */
 static const SDLTest_TestCaseReference *eventsTests[] =  {
-    &eventsTest1, &eventsTest2, &eventsTest3, NULL
+    &eventsTest1, &eventsTest2, &eventsTest3, &eventsTest4, &eventsTest5, &eventsTest6, NULL
 };
 
 /* Events test suite (global) */
@@ -125,6 +125,53 @@ static int main_testImpliedJoystickQuit (void *arg)
 #endif
 }
 
+static int SDLCALL main_pushEventsThread (void *arg)
+{
+    SDL_atomic_t *done = (SDL_atomic_t *) arg;
+    SDL_Event event;
+
+    SDL_zero(event);
+    event.type = SDL_USEREVENT;
+    while (!SDL_AtomicGet(done)) {
+        SDL_PushEvent(&event);
+    }
+    return 0;
+}
+
+/* !
+ * \brief Tests SDL_QuitSubSystem(SDL_INIT_EVENTS) while another thread is pushing events
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_QuitSubSystem
+ * http://wiki.libsdl.org/moin.cgi/SDL_PushEvent
+ */
+static int main_testQuitEventsWhilePushing (void *arg)
+{
+    int i;
+
+    /* Nothing else may keep the event loop running */
+    SDL_Quit();
+
+    for (i = 0; i < 20; ++i) {
+        SDL_atomic_t done;
+        SDL_Thread *thread;
+
+        SDLTest_AssertCheck( SDL_InitSubSystem(SDL_INIT_EVENTS) == 0, "SDL_InitSubSystem(SDL_INIT_EVENTS)" );
+
+        SDL_AtomicSet(&done, 0);
+        thread = SDL_CreateThread(main_pushEventsThread, "PushEvents", &done);
+        SDLTest_AssertCheck( thread != NULL, "SDL_CreateThread()" );
+        SDL_Delay(i % 3);
+
+        SDL_QuitSubSystem(SDL_INIT_EVENTS);
+        SDLTest_AssertCheck( (SDL_WasInit(SDL_INIT_EVENTS) & SDL_INIT_EVENTS) == 0, "SDL_WasInit(SDL_INIT_EVENTS) after shutdown should be false" );
+
+        SDL_AtomicSet(&done, 1);
+        SDL_WaitThread(thread, NULL);
+    }
+
+    return TEST_COMPLETED;
+}
+
 static const SDLTest_TestCaseReference mainTest1 =
         { (SDLTest_TestCaseFp)main_testInitQuitJoystickHaptic, "main_testInitQuitJoystickHaptic", "Tests SDL_Init/Quit of Joystick and Haptic subsystem", TEST_ENABLED};
 
@@ -137,12 +184,16 @@ static const SDLTest_TestCaseReference mainTest3 =
 static const SDLTest_TestCaseReference mainTest4 =
         { (SDLTest_TestCaseFp)main_testImpliedJoystickQuit, "main_testImpliedJoystickQuit", "Tests that quit for gamecontroller doesn't quit joystick if you inited it explicitly", TEST_ENABLED};
 
+static const SDLTest_TestCaseReference mainTest5 =
+        { (SDLTest_TestCaseFp)main_testQuitEventsWhilePushing, "main_testQuitEventsWhilePushing", "Tests SDL_QuitSubSystem(SDL_INIT_EVENTS) while another thread pushes events", TEST_ENABLED};
+
 /* Sequence of Main test cases */
 static const SDLTest_TestCaseReference *mainTests[] =  {
     &mainTest1,
     &mainTest2,
     &mainTest3,
     &mainTest4,
+    &mainTest5,
     NULL
 };
 
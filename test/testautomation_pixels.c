@@ -502,6 +502,186 @@ pixels_calcGammaRamp(void *arg)
   return TEST_COMPLETED;
 }
 
+/**
+ * @brief Compares SDL_ConvertPixels output with and without SDL_HINT_VIDEO_CONVERT_THREADS
+ */
+int
+pixels_convertPixelsThreaded(void *arg)
+{
+  const Uint32 formats[][2] = {
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB24 },
+    { SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ABGR8888 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_NV12 },
+    { SDL_PIXELFORMAT_NV12, SDL_PIXELFORMAT_ARGB8888 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_YUY2 },
+    { SDL_PIXELFORMAT_IYUV, SDL_PIXELFORMAT_RGB565 },
+  };
+  /* big enough to be split, with an odd number of rows */
+  const int width = 640;
+  const int height = 383;
+  const int size = width * 4 * height;
+  Uint8 *src, *single, *threaded;
+  int i, ret1, ret2;
+
+  src = (Uint8 *)SDL_malloc(size);
+  single = (Uint8 *)SDL_calloc(1, size);
+  threaded = (Uint8 *)SDL_calloc(1, size);
+  SDLTest_AssertCheck(src != NULL && single != NULL && threaded != NULL, "Validate buffers could be allocated");
+  if (src == NULL || single == NULL || threaded == NULL) {
+    SDL_free(src);
+    SDL_free(single);
+    SDL_free(threaded);
+    return TEST_ABORTED;
+  }
+  for (i = 0; i < size; i++) {
+    src[i] = (Uint8)SDLTest_RandomUint8();
+  }
+
+  for (i = 0; i < SDL_arraysize(formats); i++) {
+    const Uint32 src_format = formats[i][0];
+    const Uint32 dst_format = formats[i][1];
+    const int src_pitch = SDL_ISPIXELFORMAT_FOURCC(src_format) ? width : width * SDL_BYTESPERPIXEL(src_format);
+    const int dst_pitch = SDL_ISPIXELFORMAT_FOURCC(dst_format) ? width * 2 : width * SDL_BYTESPERPIXEL(dst_format);
+
+    SDL_SetHint(SDL_HINT_VIDEO_CONVERT_THREADS, "1");
+    ret1 = SDL_ConvertPixels(width, height, src_format, src, src_pitch, dst_format, single, dst_pitch);
+    SDL_SetHint(SDL_HINT_VIDEO_CONVERT_THREADS, "4");
+    ret2 = SDL_ConvertPixels(width, height, src_format, src, src_pitch, dst_format, threaded, dst_pitch);
+    SDLTest_AssertPass("Call to SDL_ConvertPixels(%s -> %s)", SDL_GetPixelFormatName(src_format), SDL_GetPixelFormatName(dst_format));
+    SDLTest_AssertCheck(ret1 == 0 && ret2 == 0, "Validate results, expected: 0 and 0, got: %d and %d", ret1, ret2);
+    SDLTest_AssertCheck(SDL_memcmp(single, threaded, size) == 0, "Validate that the output is the same with threads");
+  }
+
+  SDL_SetHint(SDL_HINT_VIDEO_CONVERT_THREADS, NULL);
+  SDL_free(src);
+  SDL_free(single);
+  SDL_free(threaded);
+
+  return TEST_COMPLETED;
+}
+
+/**
+ * @brief Compares SDL_MapRGBA on an 8-bit palette against a full scan of the palette
+ */
+int
+pixels_mapRGBPalette(void *arg)
+{
+  SDL_PixelFormat *format;
+  SDL_Palette *palette;
+  SDL_Palette userPalette;
+  SDL_Color colors[256];
+  int variation, i, j, mismatches;
+
+  format = SDL_AllocFormat(SDL_PIXELFORMAT_INDEX8);
+  SDLTest_AssertPass("Call to SDL_AllocFormat(SDL_PIXELFORMAT_INDEX8)");
+  palette = SDL_AllocPalette(256);
+  SDLTest_AssertPass("Call to SDL_AllocPalette(256)");
+  SDLTest_AssertCheck(format != NULL && palette != NULL, "Verify results are not NULL");
+  if (format == NULL || palette == NULL) {
+    if (format != NULL) {
+      SDL_FreeFormat(format);
+    }
+    if (palette != NULL) {
+      SDL_FreePalette(palette);
+    }
+    return TEST_ABORTED;
+  }
+  SDL_SetPixelFormatPalette(format, palette);
+  SDLTest_AssertPass("Call to SDL_SetPixelFormatPalette()");
+
+  for (variation = 0; variation < 3; variation++) {
+    for (i = 0; i < 256; i++) {
+      colors[i].r = SDLTest_RandomUint8();
+      colors[i].g = SDLTest_RandomUint8();
+      colors[i].b = SDLTest_RandomUint8();
+      colors[i].a = (variation == 2) ? SDLTest_RandomUint8() : SDL_ALPHA_OPAQUE;
+      /* duplicate entries have to resolve to the lowest index */
+      if (variation == 1 && i >= 16) {
+        colors[i] = colors[i % 16];
+      }
+    }
+    SDL_SetPaletteColors(palette, colors, 0, 256);
+    SDLTest_AssertPass("Call to SDL_SetPaletteColors()");
+
+    /* enough lookups of the same palette to go through the cached search */
+    mismatches = 0;
+    for (i = 0; i < 8192; i++) {
+      const Uint8 r = SDLTest_RandomUint8();
+      const Uint8 g = SDLTest_RandomUint8();
+      const Uint8 b = SDLTest_RandomUint8();
+      const Uint8 a = (i & 1) ? SDL_ALPHA_OPAQUE : SDLTest_RandomUint8();
+      unsigned int smallest = ~0u;
+      Uint32 expected = 0;
+
+      for (j = 0; j < 256; j++) {
+        const int rd = colors[j].r - r;
+        const int gd = colors[j].g - g;
+        const int bd = colors[j].b - b;
+        const int ad = colors[j].a - a;
+        const unsigned int distance = (rd * rd) + (gd * gd) + (bd * bd) + (ad * ad);
+        if (distance < smallest) {
+          smallest = distance;
+          expected = j;
+        }
+      }
+      if (SDL_MapRGBA(format, r, g, b, a) != expected) {
+        mismatches++;
+      }
+
+      /* the cached search must follow palette updates */
+      if (i == 4096) {
+        colors[0].r ^= 0x80;
+        SDL_SetPaletteColors(palette, colors, 0, 1);
+      }
+    }
+    SDLTest_AssertPass("Call to SDL_MapRGBA() 8192 times");
+    SDLTest_AssertCheck(mismatches == 0, "Validate results match a full palette scan, expected: 0 mismatches, got: %d", mismatches);
+  }
+
+  /* a palette the caller owns is searched in full, without SDL's data behind it */
+  userPalette.ncolors = 256;
+  userPalette.colors = colors;
+  userPalette.version = 1;
+  userPalette.refcount = 1;
+  SDL_SetPixelFormatPalette(format, &userPalette);
+  SDLTest_AssertPass("Call to SDL_SetPixelFormatPalette() with a caller owned palette");
+  SDL_SetPaletteColors(&userPalette, colors, 0, 256);
+  SDLTest_AssertPass("Call to SDL_SetPaletteColors() with a caller owned palette");
+  mismatches = 0;
+  for (i = 0; i < 2048; i++) {
+    const Uint8 r = SDLTest_RandomUint8();
+    const Uint8 g = SDLTest_RandomUint8();
+    const Uint8 b = SDLTest_RandomUint8();
+    unsigned int smallest = ~0u;
+    Uint32 expected = 0;
+
+    for (j = 0; j < 256; j++) {
+      const int rd = colors[j].r - r;
+      const int gd = colors[j].g - g;
+      const int bd = colors[j].b - b;
+      const int ad = colors[j].a - SDL_ALPHA_OPAQUE;
+      const unsigned int distance = (rd * rd) + (gd * gd) + (bd * bd) + (ad * ad);
+      if (distance < smallest) {
+        smallest = distance;
+        expected = j;
+      }
+    }
+    if (SDL_MapRGB(format, r, g, b) != expected) {
+      mismatches++;
+    }
+  }
+  SDLTest_AssertPass("Call to SDL_MapRGB() 2048 times");
+  SDLTest_AssertCheck(mismatches == 0, "Validate results match a full palette scan, expected: 0 mismatches, got: %d", mismatches);
+
+  SDL_FreeFormat(format);
+  SDLTest_AssertPass("Call to SDL_FreeFormat()");
+  SDLTest_AssertCheck(userPalette.refcount == 1, "Validate caller owned palette refcount, expected: 1, got: %d", userPalette.refcount);
+  SDL_FreePalette(palette);
+  SDLTest_AssertPass("Call to SDL_FreePalette()");
+
+  return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Pixels test cases */
@@ -517,9 +697,15 @@ static const SDLTest_TestCaseReference pixelsTest3 =
 static const SDLTest_TestCaseReference pixelsTest4 =
         { (SDLTest_TestCaseFp)pixels_getPixelFormatName, "pixels_getPixelFormatName", "Call to SDL_GetPixelFormatName", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference pixelsTest5 =
+        { (SDLTest_TestCaseFp)pixels_convertPixelsThreaded, "pixels_convertPixelsThreaded", "Call to SDL_ConvertPixels with SDL_HINT_VIDEO_CONVERT_THREADS", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference pixelsTest6 =
+        { (SDLTest_TestCaseFp)pixels_mapRGBPalette, "pixels_mapRGBPalette", "Call to SDL_MapRGBA with a palettized format", TEST_ENABLED };
+
 /* Sequence of Pixels test cases */
 static const SDLTest_TestCaseReference *pixelsTests[] =  {
-    &pixelsTest1, &pixelsTest2, &pixelsTest3, &pixelsTest4, NULL
+    &pixelsTest1, &pixelsTest2, &pixelsTest3, &pixelsTest4, &pixelsTest5, &pixelsTest6, NULL
 };
 
 /* Pixels test suite (global) */
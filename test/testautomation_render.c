@@ -60,6 +60,15 @@ void InitCreateRenderer(void *arg)
   }
 }
 
+/*
+ * Put back the hints the RenderSoftware tests change
+ */
+void ResetSoftwareRenderHints(void *arg)
+{
+  SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, "0");
+  SDL_SetHint(SDL_HINT_RENDER_ATLAS, "0");
+}
+
 /*
  * Destroy renderer for tests
  */
@@ -870,6 +879,662 @@ _hasBlendModes (void)
 }
 
 
+/* Draws a scene for _renderSceneWithHints(). */
+typedef void (*_renderSceneFunc)(SDL_Renderer *swrenderer, void *arg);
+
+/**
+ * @brief Draws a scene with a software renderer and reads back what was drawn. Helper function.
+ *
+ * (hints) are name/value pairs ending in NULL, set before the renderer is made.
+ * The renderer is made for a hidden window, so it batches like other renderers,
+ * and the window doesn't need an accelerated renderer or a real display.
+ */
+static SDL_Surface *
+_renderSceneWithHints(const char *const *hints, int w, int h, _renderSceneFunc scene, void *arg)
+{
+   SDL_Window *swwindow;
+   SDL_Renderer *swrenderer = NULL;
+   SDL_Surface *surface = NULL;
+   int i, ret;
+
+   for (i = 0; hints != NULL && hints[i] != NULL; i += 2) {
+      SDL_SetHint(hints[i], hints[i + 1]);
+   }
+
+   swwindow = SDL_CreateWindow("render_testScene", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, w, h, SDL_WINDOW_HIDDEN);
+   SDLTest_AssertCheck(swwindow != NULL, "Verify result from SDL_CreateWindow is not NULL");
+   if (swwindow != NULL) {
+      swrenderer = SDL_CreateRenderer(swwindow, -1, SDL_RENDERER_SOFTWARE);
+      SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateRenderer(SDL_RENDERER_SOFTWARE) is not NULL");
+   }
+   if (swrenderer != NULL) {
+      surface = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, RENDER_COMPARE_FORMAT);
+      SDLTest_AssertCheck(surface != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+   }
+
+   if (surface != NULL) {
+      scene(swrenderer, arg);
+      SDL_RenderSetViewport(swrenderer, NULL);
+      ret = SDL_RenderReadPixels(swrenderer, NULL, RENDER_COMPARE_FORMAT, surface->pixels, surface->pitch);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+   }
+
+   if (swrenderer != NULL) {
+      SDL_DestroyRenderer(swrenderer);
+   }
+   if (swwindow != NULL) {
+      SDL_DestroyWindow(swwindow);
+   }
+   return surface;
+}
+
+/**
+ * @brief Checks that two scenes drew the same thing, and frees them. Helper function.
+ */
+static int
+_compareScenes(SDL_Surface *referenceSurface, SDL_Surface *testSurface)
+{
+   int result;
+
+   if (referenceSurface == NULL || testSurface == NULL) {
+      SDL_FreeSurface(referenceSurface);
+      SDL_FreeSurface(testSurface);
+      return TEST_ABORTED;
+   }
+
+   result = SDLTest_CompareSurfaces(testSurface, referenceSurface, 0);
+   SDLTest_AssertCheck(result == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", result);
+
+   SDL_FreeSurface(referenceSurface);
+   SDL_FreeSurface(testSurface);
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Draws rects, lines and copies with changing state and clipping. Helper function.
+ */
+static void
+_drawMixedScene(SDL_Renderer *swrenderer, void *arg)
+{
+   SDL_Surface *face;
+   SDL_Texture *tface;
+   SDL_Rect rect, clip;
+   int i, j;
+
+   face = SDLTest_ImageFace();
+   tface = SDL_CreateTextureFromSurface(swrenderer, face);
+   SDL_FreeSurface(face);
+   SDLTest_AssertCheck(tface != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+
+   SDL_SetRenderDrawColor(swrenderer, 20, 40, 60, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(swrenderer);
+   for (j = 0; j < 40; j++) {
+      for (i = 0; i < 40; i++) {
+         rect.x = i * 17 - 20;
+         rect.y = j * 13 - 20;
+         rect.w = 42;
+         rect.h = 42;
+         switch ((i + j) % 5) {
+         case 0:
+            SDL_SetRenderDrawBlendMode(swrenderer, (i & 1) ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_ADD);
+            SDL_SetRenderDrawColor(swrenderer, i * 6, j * 6, 128, 100);
+            SDL_RenderFillRect(swrenderer, &rect);
+            break;
+         case 1:
+            SDL_SetRenderDrawColor(swrenderer, 255, i * 6, j * 6, SDL_ALPHA_OPAQUE);
+            SDL_RenderDrawLine(swrenderer, rect.x, rect.y, rect.x + 60, rect.y + 25);
+            break;
+         case 2:
+            clip.x = i * 3;
+            clip.y = j * 2;
+            clip.w = 300;
+            clip.h = 200;
+            SDL_RenderSetClipRect(swrenderer, (j & 1) ? &clip : NULL);
+            break;
+         case 3:
+            SDL_SetTextureBlendMode(tface, SDL_BLENDMODE_BLEND);
+            SDL_SetTextureColorMod(tface, i * 6, 255, j * 6);
+            SDL_SetTextureAlphaMod(tface, 128 + i);
+            SDL_RenderCopy(swrenderer, tface, NULL, &rect);
+            break;
+         default:
+            SDL_SetTextureBlendMode(tface, SDL_BLENDMODE_NONE);
+            SDL_RenderCopyEx(swrenderer, tface, NULL, &rect, i * 9, NULL, SDL_FLIP_NONE);
+            break;
+         }
+      }
+   }
+   SDL_RenderFlush(swrenderer);
+
+   SDL_DestroyTexture(tface);
+}
+
+/**
+ * @brief Tests that the threaded software renderer matches the single threaded one.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateSoftwareRenderer
+ */
+int
+render_testSoftwareThreads (void *arg)
+{
+   const char *const single[] = { SDL_HINT_RENDER_SOFTWARE_THREADS, "1", NULL };
+   const char *const threaded[] = { SDL_HINT_RENDER_SOFTWARE_THREADS, "4", NULL };
+
+   return _compareScenes(_renderSceneWithHints(single, 640, 480, _drawMixedScene, NULL),
+                         _renderSceneWithHints(threaded, 640, 480, _drawMixedScene, NULL));
+}
+
+
+/**
+ * @brief Draws a scene made of many small textures. Helper function.
+ */
+static void
+_drawAtlasScene(SDL_Renderer *swrenderer, void *arg)
+{
+   SDL_Surface *face, *piece;
+   SDL_Texture *textures[24];
+   SDL_Texture *big;
+   SDL_Rect rect, srcrect;
+   Uint32 pixels[4 * 4];
+   int i, j, n;
+
+   /* Pieces of the face in different sizes, with and without alpha */
+   face = SDLTest_ImageFace();
+   for (n = 0; n < SDL_arraysize(textures); n++) {
+      srcrect.x = n % 7;
+      srcrect.y = n % 5;
+      srcrect.w = 9 + n;
+      srcrect.h = 31 - n;
+      piece = SDL_CreateRGBSurfaceWithFormat(0, srcrect.w, srcrect.h, 32,
+                 (n % 3) ? SDL_PIXELFORMAT_ARGB8888 : SDL_PIXELFORMAT_RGB888);
+      SDL_SetSurfaceBlendMode(face, SDL_BLENDMODE_NONE);
+      SDL_BlitSurface(face, &srcrect, piece, NULL);
+      textures[n] = SDL_CreateTextureFromSurface(swrenderer, piece);
+      SDL_FreeSurface(piece);
+      SDLTest_AssertCheck(textures[n] != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+      if ((n % 4) == 1) {
+         SDL_SetTextureScaleMode(textures[n], SDL_ScaleModeLinear);
+      }
+   }
+   piece = SDL_CreateRGBSurfaceWithFormat(0, 300, 300, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDL_BlitScaled(face, NULL, piece, NULL);
+   big = SDL_CreateTextureFromSurface(swrenderer, piece);
+   SDL_FreeSurface(piece);
+   SDL_FreeSurface(face);
+   SDLTest_AssertCheck(big != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+
+   SDL_SetRenderDrawColor(swrenderer, 20, 40, 60, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(swrenderer);
+   SDL_RenderCopy(swrenderer, big, NULL, NULL);
+   for (j = 0; j < 30; j++) {
+      for (i = 0; i < 40; i++) {
+         SDL_Texture *texture = textures[(i + j * 3) % SDL_arraysize(textures)];
+         if (texture == NULL) {
+            continue;
+         }
+         rect.x = i * 17 - 10;
+         rect.y = j * 17 - 10;
+         SDL_QueryTexture(texture, NULL, NULL, &rect.w, &rect.h);
+         switch ((i / 5 + j) % 4) {
+         case 0:
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+            SDL_SetTextureColorMod(texture, 255, 255, 255);
+            SDL_SetTextureAlphaMod(texture, 255);
+            SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+            break;
+         case 1:
+            SDL_SetTextureBlendMode(texture, (j & 1) ? SDL_BLENDMODE_ADD : SDL_BLENDMODE_MOD);
+            SDL_SetTextureColorMod(texture, i * 6, 255, j * 8);
+            SDL_SetTextureAlphaMod(texture, 100 + i);
+            srcrect.x = 2;
+            srcrect.y = 1;
+            srcrect.w = rect.w - 4;
+            srcrect.h = rect.h - 2;
+            SDL_RenderCopy(swrenderer, texture, &srcrect, &rect);
+            break;
+         case 2:
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+            rect.w = rect.w * 3 / 2;
+            rect.h = rect.h * 2 / 3;
+            SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+            break;
+         default:
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+            SDL_RenderCopyEx(swrenderer, texture, NULL, &rect, i * 9, NULL, (SDL_RendererFlip) (i % 3));
+            break;
+         }
+      }
+
+      /* Textures changing and going away while their copies are queued */
+      if (j == 10) {
+         for (n = 0; n < SDL_arraysize(pixels); n++) {
+            pixels[n] = 0xFF00FF00 | (n * 16);
+         }
+         rect.x = 3;
+         rect.y = 2;
+         rect.w = 4;
+         rect.h = 4;
+         SDL_UpdateTexture(textures[0], &rect, pixels, 4 * sizeof(Uint32));
+         rect.x = 0;
+         rect.y = 0;
+         SDL_UpdateTexture(textures[5], &rect, pixels, 4 * sizeof(Uint32));
+         SDL_SetTextureScaleMode(textures[2], SDL_ScaleModeBest);
+      } else if (j == 20) {
+         SDL_DestroyTexture(textures[7]);
+         textures[7] = NULL;
+      }
+   }
+   SDL_RenderFlush(swrenderer);
+
+   for (n = 0; n < SDL_arraysize(textures); n++) {
+      if (textures[n] != NULL) {
+         SDL_DestroyTexture(textures[n]);
+      }
+   }
+   SDL_DestroyTexture(big);
+}
+
+/**
+ * @brief Tests that packing small textures into an atlas doesn't change what is drawn.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_HINT_RENDER_ATLAS
+ */
+int
+render_testAtlas (void *arg)
+{
+   const char *const reference[] = { SDL_HINT_RENDER_ATLAS, "0", SDL_HINT_RENDER_SOFTWARE_THREADS, "1", NULL };
+   const char *const atlas[] = { SDL_HINT_RENDER_ATLAS, "1", SDL_HINT_RENDER_SOFTWARE_THREADS, "1", NULL };
+   const char *const threaded[] = { SDL_HINT_RENDER_ATLAS, "1", SDL_HINT_RENDER_SOFTWARE_THREADS, "4", NULL };
+   int result;
+
+   result = _compareScenes(_renderSceneWithHints(reference, 640, 480, _drawAtlasScene, NULL),
+                           _renderSceneWithHints(atlas, 640, 480, _drawAtlasScene, NULL));
+   if (result != TEST_COMPLETED) {
+      return result;
+   }
+
+   /* The tiled renderer runs merged copies itself */
+   return _compareScenes(_renderSceneWithHints(reference, 640, 480, _drawAtlasScene, NULL),
+                         _renderSceneWithHints(threaded, 640, 480, _drawAtlasScene, NULL));
+}
+
+
+/**
+ * @brief Draws a scene of sprites, all at once if (arg) points to SDL_TRUE, otherwise one call each. Helper function.
+ */
+static void
+_drawSpriteScene(SDL_Renderer *swrenderer, void *arg)
+{
+   const SDL_bool batch = *(const SDL_bool *) arg;
+   SDL_Surface *face;
+   SDL_Texture *tface;
+   SDL_RenderSprite sprites[600];
+   int i;
+
+   face = SDLTest_ImageFace();
+   tface = SDL_CreateTextureFromSurface(swrenderer, face);
+   SDL_FreeSurface(face);
+   SDLTest_AssertCheck(tface != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+   SDL_SetTextureBlendMode(tface, SDL_BLENDMODE_BLEND);
+
+   SDL_zero(sprites);
+   for (i = 0; i < SDL_arraysize(sprites); i++) {
+      SDL_RenderSprite *sprite = &sprites[i];
+      sprite->srcrect.x = i % 5;
+      sprite->srcrect.y = i % 7;
+      sprite->srcrect.w = (i % 3) ? 20 + i % 11 : 0;
+      sprite->srcrect.h = (i % 3) ? 18 + i % 13 : 0;
+      sprite->dstrect.x = (float) ((i * 37) % 360) - 20.0f;
+      sprite->dstrect.y = (float) ((i * 23) % 280) - 20.0f;
+      sprite->dstrect.w = (float) (16 + (i % 4) * 8);
+      sprite->dstrect.h = (float) (16 + (i % 6) * 6);
+      if ((i % 17) == 0) {
+         sprite->angle = i * 3.0;
+      }
+      if ((i % 23) == 0) {
+         sprite->flip = SDL_FLIP_HORIZONTAL;
+      }
+      /* Runs of sprites with the same color */
+      sprite->color.r = (Uint8) (255 - (i / 40) * 10);
+      sprite->color.g = (Uint8) ((i / 40) * 16);
+      sprite->color.b = 200;
+      sprite->color.a = (Uint8) (128 + (i / 60) * 12);
+   }
+
+   SDL_SetRenderDrawColor(swrenderer, 20, 40, 60, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(swrenderer);
+   if (batch) {
+      int ret = SDL_RenderCopySprites(swrenderer, tface, sprites, SDL_arraysize(sprites));
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopySprites, expected: 0, got: %i", ret);
+   } else {
+      for (i = 0; i < SDL_arraysize(sprites); i++) {
+         const SDL_RenderSprite *sprite = &sprites[i];
+         SDL_SetTextureColorMod(tface, sprite->color.r, sprite->color.g, sprite->color.b);
+         SDL_SetTextureAlphaMod(tface, sprite->color.a);
+         SDL_RenderCopyExF(swrenderer, tface, SDL_RectEmpty(&sprite->srcrect) ? NULL : &sprite->srcrect,
+                           &sprite->dstrect, sprite->angle, NULL, sprite->flip);
+      }
+   }
+   SDL_RenderFlush(swrenderer);
+
+   SDL_DestroyTexture(tface);
+}
+
+/**
+ * @brief Tests that copying sprites in one call draws the same as copying them one by one.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderCopySprites
+ */
+int
+render_testCopySprites (void *arg)
+{
+   SDL_bool one_by_one = SDL_FALSE;
+   SDL_bool batch = SDL_TRUE;
+
+   return _compareScenes(_renderSceneWithHints(NULL, 320, 240, _drawSpriteScene, &one_by_one),
+                         _renderSceneWithHints(NULL, 320, 240, _drawSpriteScene, &batch));
+}
+
+
+/**
+ * @brief Draws rects and points, with state changes nothing is drawn with in between if (arg) points to SDL_TRUE. Helper function.
+ */
+static void
+_drawStateScene(SDL_Renderer *swrenderer, void *arg)
+{
+   const SDL_bool redundant = *(const SDL_bool *) arg;
+   SDL_Rect viewport = { 10, 10, 50, 30 };
+   SDL_Rect cliprect = { 5, 5, 20, 15 };
+   SDL_Rect rect;
+   int i;
+
+   SDL_SetRenderDrawColor(swrenderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(swrenderer);
+   for (i = 0; i < 40; i++) {
+      rect.x = (i * 7) % 70;
+      rect.y = (i * 5) % 50;
+      rect.w = 6;
+      rect.h = 4;
+      SDL_SetRenderDrawColor(swrenderer, (Uint8) ((i < 20) ? 255 : 0), 128, 64, SDL_ALPHA_OPAQUE);
+      SDL_RenderFillRect(swrenderer, &rect);
+      if (redundant) {
+         SDL_RenderSetViewport(swrenderer, &viewport);
+         SDL_RenderSetClipRect(swrenderer, &cliprect);
+         SDL_RenderSetClipRect(swrenderer, NULL);
+         SDL_RenderSetViewport(swrenderer, NULL);
+         SDL_SetRenderDrawColor(swrenderer, 0, 0, 255, SDL_ALPHA_OPAQUE);
+         SDL_SetRenderDrawColor(swrenderer, (Uint8) ((i < 20) ? 255 : 0), 128, 64, SDL_ALPHA_OPAQUE);
+      }
+      SDL_RenderDrawPoint(swrenderer, (i * 11) % TESTRENDER_SCREEN_W, (i * 3) % TESTRENDER_SCREEN_H);
+
+      /* Some draws that do use the other state */
+      if ((i % 10) == 0) {
+         SDL_RenderSetViewport(swrenderer, &viewport);
+         SDL_RenderSetClipRect(swrenderer, &cliprect);
+         rect.x = 0;
+         rect.y = 0;
+         rect.w = 40;
+         rect.h = 40;
+         SDL_RenderFillRect(swrenderer, &rect);
+         SDL_RenderSetClipRect(swrenderer, NULL);
+         SDL_RenderSetViewport(swrenderer, NULL);
+      }
+   }
+}
+
+/**
+ * @brief Tests that state changes nothing is drawn with don't change what gets drawn.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderSetViewport
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderSetClipRect
+ */
+int
+render_testRedundantState (void *arg)
+{
+   SDL_bool plain = SDL_FALSE;
+   SDL_bool redundant = SDL_TRUE;
+
+   return _compareScenes(_renderSceneWithHints(NULL, TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, _drawStateScene, &plain),
+                         _renderSceneWithHints(NULL, TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, _drawStateScene, &redundant));
+}
+
+/**
+ * @brief Tests the statistics kept for the last presented frame.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_GetRenderStats
+ */
+int
+render_testStats (void *arg)
+{
+   SDL_Surface *target, *face;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *tface;
+   SDL_RenderStats stats;
+   SDL_Rect rect;
+   int i, ret;
+
+   target = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(target != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+   if (target == NULL) {
+      return TEST_ABORTED;
+   }
+   swrenderer = SDL_CreateSoftwareRenderer(target);
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(target);
+      return TEST_ABORTED;
+   }
+
+   /* Invalid parameters */
+   ret = SDL_GetRenderStats(swrenderer, NULL);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_GetRenderStats(renderer, NULL), expected: -1, got: %i", ret);
+
+   /* Nothing presented yet */
+   ret = SDL_GetRenderStats(swrenderer, &stats);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRenderStats, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(stats.flushes == 0, "Verify flushes, expected: 0, got: %u", stats.flushes);
+
+   face = SDLTest_ImageFace();
+   tface = SDL_CreateTextureFromSurface(swrenderer, face);
+   SDL_FreeSurface(face);
+   SDLTest_AssertCheck(tface != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+
+   /* The software renderer doesn't batch, so each draw is flushed on its own */
+   SDL_SetRenderDrawColor(swrenderer, 255, 0, 0, SDL_ALPHA_OPAQUE);
+   for (i = 0; i < 3; i++) {
+      rect.x = i * 20;
+      rect.y = 10;
+      rect.w = 10;
+      rect.h = 10;
+      SDL_RenderFillRect(swrenderer, &rect);
+   }
+   SDL_RenderCopy(swrenderer, tface, NULL, NULL);
+   SDL_RenderPresent(swrenderer);
+
+   ret = SDL_GetRenderStats(swrenderer, &stats);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRenderStats, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(stats.fill_rects == 3, "Verify fill_rects, expected: 3, got: %u", stats.fill_rects);
+   SDLTest_AssertCheck(stats.copies == 1, "Verify copies, expected: 1, got: %u", stats.copies);
+   SDLTest_AssertCheck(stats.commands >= 4, "Verify commands, expected: >= 4, got: %u", stats.commands);
+   SDLTest_AssertCheck(stats.flushes >= 4, "Verify flushes, expected: >= 4, got: %u", stats.flushes);
+   SDLTest_AssertCheck(stats.flush_reasons[SDL_RENDER_FLUSH_NOT_BATCHING] == stats.flushes,
+                       "Verify flushes when not batching, expected: %u, got: %u",
+                       stats.flushes, stats.flush_reasons[SDL_RENDER_FLUSH_NOT_BATCHING]);
+   SDLTest_AssertCheck(stats.vertex_bytes > 0, "Verify vertex_bytes is not 0");
+   SDLTest_AssertCheck(stats.texture_uploads == 1, "Verify texture_uploads, expected: 1, got: %u", stats.texture_uploads);
+   SDLTest_AssertCheck(stats.texture_upload_bytes > 0, "Verify texture_upload_bytes is not 0");
+
+   /* The next frame starts over */
+   SDL_RenderPresent(swrenderer);
+   ret = SDL_GetRenderStats(swrenderer, &stats);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRenderStats, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(stats.commands == 0, "Verify commands, expected: 0, got: %u", stats.commands);
+   SDLTest_AssertCheck(stats.flushes == 0, "Verify flushes, expected: 0, got: %u", stats.flushes);
+   SDLTest_AssertCheck(stats.texture_uploads == 0, "Verify texture_uploads, expected: 0, got: %u", stats.texture_uploads);
+
+   SDL_DestroyTexture(tface);
+   SDL_DestroyRenderer(swrenderer);
+   SDL_FreeSurface(target);
+
+   return TEST_COMPLETED;
+}
+
+typedef struct
+{
+   int calls;
+   int status;
+} _uploadState;
+
+static void SDLCALL
+_uploadCallback(void *userdata, SDL_Texture *texture, int status)
+{
+   _uploadState *state = (_uploadState *) userdata;
+   state->calls++;
+   state->status = status;
+}
+
+/* Draws the texture at the top left and reads it back. Helper function. */
+static SDL_Surface *
+_readBackTexture(SDL_Renderer *swrenderer, SDL_Texture *texture, int w, int h)
+{
+   SDL_Surface *surface;
+   SDL_Rect rect;
+   int ret;
+
+   surface = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, RENDER_COMPARE_FORMAT);
+   SDLTest_AssertCheck(surface != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+   if (surface == NULL) {
+      return NULL;
+   }
+
+   SDL_SetRenderDrawColor(swrenderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(swrenderer);
+   rect.x = 0;
+   rect.y = 0;
+   rect.w = w;
+   rect.h = h;
+   ret = SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopy, expected: 0, got: %i", ret);
+   ret = SDL_RenderReadPixels(swrenderer, &rect, RENDER_COMPARE_FORMAT, surface->pixels, surface->pitch);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+   return surface;
+}
+
+/**
+ * @brief Tests queued texture updates against immediate ones.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_UpdateTexture
+ */
+int
+render_testUpdateTextureAsync (void *arg)
+{
+   SDL_Surface *target, *face, *referenceSurface, *testSurface;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *reference, *texture;
+   _uploadState state;
+   SDL_Rect rect;
+   int ret;
+
+   face = SDLTest_ImageFace();
+   SDLTest_AssertCheck(face != NULL, "Verify result from SDLTest_ImageFace is not NULL");
+   if (face == NULL) {
+      return TEST_ABORTED;
+   }
+   target = SDL_CreateRGBSurfaceWithFormat(0, face->w, face->h, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(target != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+   swrenderer = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(target);
+      SDL_FreeSurface(face);
+      return TEST_ABORTED;
+   }
+
+   reference = SDL_CreateTexture(swrenderer, face->format->format, SDL_TEXTUREACCESS_STATIC, face->w, face->h);
+   texture = SDL_CreateTexture(swrenderer, face->format->format, SDL_TEXTUREACCESS_STATIC, face->w, face->h);
+   SDLTest_AssertCheck(reference != NULL && texture != NULL, "Verify result from SDL_CreateTexture is not NULL");
+   if (reference == NULL || texture == NULL) {
+      SDL_DestroyTexture(reference);
+      SDL_DestroyTexture(texture);
+      SDL_DestroyRenderer(swrenderer);
+      SDL_FreeSurface(target);
+      SDL_FreeSurface(face);
+      return TEST_ABORTED;
+   }
+   ret = SDL_UpdateTexture(reference, NULL, face->pixels, face->pitch);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTexture, expected: 0, got: %i", ret);
+
+   /* Invalid parameters (a NULL texture would trip the texture magic assertion) */
+   ret = SDL_UpdateTextureAsync(texture, NULL, NULL, face->pitch, NULL, NULL);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_UpdateTextureAsync(texture, NULL, NULL, ...), expected: -1, got: %i", ret);
+
+   /* Nothing happens until the renderer flushes */
+   SDL_zero(state);
+   ret = SDL_UpdateTextureAsync(texture, NULL, face->pixels, face->pitch, _uploadCallback, &state);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTextureAsync, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(state.calls == 0, "Verify callback calls before flushing, expected: 0, got: %i", state.calls);
+
+   referenceSurface = _readBackTexture(swrenderer, reference, face->w, face->h);
+   testSurface = _readBackTexture(swrenderer, texture, face->w, face->h);
+   SDLTest_AssertCheck(state.calls == 1, "Verify callback calls after flushing, expected: 1, got: %i", state.calls);
+   SDLTest_AssertCheck(state.status == 0, "Verify callback status, expected: 0, got: %i", state.status);
+   if (referenceSurface != NULL && testSurface != NULL) {
+      ret = SDLTest_CompareSurfaces(testSurface, referenceSurface, 0);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+   }
+   SDL_FreeSurface(referenceSurface);
+   SDL_FreeSurface(testSurface);
+
+   /* Rects are clipped to the texture when they're queued, like SDL_UpdateTexture() */
+   rect.x = -7;
+   rect.y = -5;
+   rect.w = face->w;
+   rect.h = face->h;
+   ret = SDL_UpdateTexture(reference, &rect, face->pixels, face->pitch);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTexture with a clipped rect, expected: 0, got: %i", ret);
+   SDL_zero(state);
+   ret = SDL_UpdateTextureAsync(texture, &rect, face->pixels, face->pitch, _uploadCallback, &state);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTextureAsync with a clipped rect, expected: 0, got: %i", ret);
+   referenceSurface = _readBackTexture(swrenderer, reference, face->w, face->h);
+   testSurface = _readBackTexture(swrenderer, texture, face->w, face->h);
+   SDLTest_AssertCheck(state.calls == 1 && state.status == 0, "Verify callback after clipped update, expected: 1 call with status 0, got: %i calls with status %i", state.calls, state.status);
+   if (referenceSurface != NULL && testSurface != NULL) {
+      ret = SDLTest_CompareSurfaces(testSurface, referenceSurface, 0);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+   }
+   SDL_FreeSurface(referenceSurface);
+   SDL_FreeSurface(testSurface);
+
+   /* Nothing left after clipping: the pixels are released right away */
+   rect.x = face->w;
+   rect.y = 0;
+   SDL_zero(state);
+   ret = SDL_UpdateTextureAsync(texture, &rect, face->pixels, face->pitch, _uploadCallback, &state);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTextureAsync outside the texture, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(state.calls == 1 && state.status == 0, "Verify callback for an update outside the texture, expected: 1 call with status 0, got: %i calls with status %i", state.calls, state.status);
+
+   /* Destroying the texture cancels its pending updates */
+   SDL_zero(state);
+   ret = SDL_UpdateTextureAsync(texture, NULL, face->pixels, face->pitch, _uploadCallback, &state);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTextureAsync, expected: 0, got: %i", ret);
+   SDL_DestroyTexture(texture);
+   SDLTest_AssertCheck(state.calls == 1, "Verify callback calls after SDL_DestroyTexture, expected: 1, got: %i", state.calls);
+   SDLTest_AssertCheck(state.status == -1, "Verify callback status, expected: -1, got: %i", state.status);
+
+   SDL_DestroyTexture(reference);
+   SDL_DestroyRenderer(swrenderer);
+   SDL_FreeSurface(target);
+   SDL_FreeSurface(face);
+
+   return TEST_COMPLETED;
+}
+
 /**
  * @brief Loads the test image 'Face' as texture. Helper function.
  *
@@ -1085,6 +1750,24 @@ static const SDLTest_TestCaseReference renderTest6 =
 static const SDLTest_TestCaseReference renderTest7 =
         {  (SDLTest_TestCaseFp)render_testBlitBlend, "render_testBlitBlend", "Tests blitting with blending", TEST_DISABLED };
 
+static const SDLTest_TestCaseReference renderTest8 =
+        { (SDLTest_TestCaseFp)render_testSoftwareThreads, "render_testSoftwareThreads", "Tests the software renderer with several threads", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest9 =
+        { (SDLTest_TestCaseFp)render_testAtlas, "render_testAtlas", "Tests packing small textures into an atlas", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest10 =
+        { (SDLTest_TestCaseFp)render_testCopySprites, "render_testCopySprites", "Tests copying many sprites in one call", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest11 =
+        { (SDLTest_TestCaseFp)render_testRedundantState, "render_testRedundantState", "Tests drawing with redundant state changes", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest12 =
+        { (SDLTest_TestCaseFp)render_testStats, "render_testStats", "Tests the per-frame renderer statistics", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest13 =
+        { (SDLTest_TestCaseFp)render_testUpdateTextureAsync, "render_testUpdateTextureAsync", "Tests queued texture updates", TEST_ENABLED };
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] =  {
     &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, NULL
@@ -1097,3 +1780,17 @@ SDLTest_TestSuiteReference renderTestSuite = {
     renderTests,
     CleanupDestroyRenderer
 };
+
+/* Sequence of RenderSoftware test cases */
+static const SDLTest_TestCaseReference *renderSoftwareTests[] =  {
+    &renderTest8, &renderTest9, &renderTest10, &renderTest11, &renderTest12, &renderTest13, NULL
+};
+
+/* RenderSoftware test suite (global). These make their own software
+   renderers, so they don't need the accelerated one the Render suite sets up. */
+SDLTest_TestSuiteReference renderSoftwareTestSuite = {
+    "RenderSoftware",
+    NULL,
+    renderSoftwareTests,
+    ResetSoftwareRenderHints
+};
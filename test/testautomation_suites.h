@@ -19,6 +19,7 @@ extern SDLTest_TestSuiteReference pixelsTestSuite;
 extern SDLTest_TestSuiteReference platformTestSuite;
 extern SDLTest_TestSuiteReference rectTestSuite;
 extern SDLTest_TestSuiteReference renderTestSuite;
+extern SDLTest_TestSuiteReference renderSoftwareTestSuite;
 extern SDLTest_TestSuiteReference rwopsTestSuite;
 extern SDLTest_TestSuiteReference sdltestTestSuite;
 extern SDLTest_TestSuiteReference stdlibTestSuite;
@@ -40,6 +41,7 @@ SDLTest_TestSuiteReference *testSuites[] =  {
     &platformTestSuite,
     &rectTestSuite,
     &renderTestSuite,
+    &renderSoftwareTestSuite,
     &rwopsTestSuite,
     &sdltestTestSuite,
     &stdlibTestSuite,
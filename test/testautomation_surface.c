@@ -589,6 +589,327 @@ surface_testBlitBlendLoop(void *arg) {
 
 }
 
+/**
+ * @brief Tests filtered stretching.
+ */
+int
+surface_testSoftStretchLinear(void *arg)
+{
+   static const Uint8 expected[4] = { 0x00, 0x3F, 0xBF, 0xFF };
+   SDL_Surface *src, *dst;
+   Uint32 *pixels;
+   Uint16 *pixels16;
+   int ret, i;
+
+   src = SDL_CreateRGBSurfaceWithFormat(0, 2, 1, 32, SDL_PIXELFORMAT_ARGB8888);
+   dst = SDL_CreateRGBSurfaceWithFormat(0, 4, 1, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(src != NULL && dst != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+   if (src == NULL || dst == NULL) {
+      SDL_FreeSurface(src);
+      SDL_FreeSurface(dst);
+      return TEST_ABORTED;
+   }
+
+   /* Upscaling interpolates between pixel centers */
+   pixels = (Uint32 *) src->pixels;
+   pixels[0] = 0xFF000000;
+   pixels[1] = 0xFFFFFFFF;
+   ret = SDL_SoftStretchLinear(src, NULL, dst, NULL);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SoftStretchLinear, expected: 0, got: %i", ret);
+   pixels = (Uint32 *) dst->pixels;
+   for (i = 0; i < 4; i++) {
+      const Uint32 pixel = 0xFF000000 | (expected[i] << 16) | (expected[i] << 8) | expected[i];
+      SDLTest_AssertCheck(pixels[i] == pixel, "Verify pixel %d, expected: 0x%.8x, got: 0x%.8x", i, pixel, pixels[i]);
+   }
+   SDL_FreeSurface(src);
+   SDL_FreeSurface(dst);
+
+   /* Shrinking to half the size averages each 2x2 block */
+   src = SDL_CreateRGBSurfaceWithFormat(0, 4, 4, 32, SDL_PIXELFORMAT_ARGB8888);
+   dst = SDL_CreateRGBSurfaceWithFormat(0, 2, 2, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(src != NULL && dst != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+   if (src == NULL || dst == NULL) {
+      SDL_FreeSurface(src);
+      SDL_FreeSurface(dst);
+      return TEST_ABORTED;
+   }
+   pixels = (Uint32 *) src->pixels;
+   for (i = 0; i < 16; i++) {
+      pixels[i] = (((i % 4) + (i / 4)) % 2) ? 0xFFC8C8C8 : 0xFF000000;
+   }
+   ret = SDL_SoftStretchLinear(src, NULL, dst, NULL);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SoftStretchLinear, expected: 0, got: %i", ret);
+   pixels = (Uint32 *) dst->pixels;
+   for (i = 0; i < 4; i++) {
+      const Uint32 pixel = ((Uint32 *) ((Uint8 *) dst->pixels + (i / 2) * dst->pitch))[i % 2];
+      SDLTest_AssertCheck(pixel == 0xFF646464, "Verify pixel %d, expected: 0xff646464, got: 0x%.8x", i, pixel);
+   }
+   SDL_FreeSurface(src);
+   SDL_FreeSurface(dst);
+
+   /* Uneven boxes, 7 or 8 pixels wide, average every source pixel they cover */
+   src = SDL_CreateRGBSurfaceWithFormat(0, 37, 9, 32, SDL_PIXELFORMAT_ARGB8888);
+   dst = SDL_CreateRGBSurfaceWithFormat(0, 5, 3, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(src != NULL && dst != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+   if (src == NULL || dst == NULL) {
+      SDL_FreeSurface(src);
+      SDL_FreeSurface(dst);
+      return TEST_ABORTED;
+   }
+   for (i = 0; i < src->pitch * src->h; i++) {
+      ((Uint8 *) src->pixels)[i] = (Uint8) (i * 37 + i / 5);
+   }
+   ret = SDL_SoftStretchLinear(src, NULL, dst, NULL);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SoftStretchLinear, expected: 0, got: %i", ret);
+   for (i = 0; i < dst->w * dst->h; i++) {
+      const int x0 = (i % dst->w) * src->w / dst->w, x1 = ((i % dst->w) + 1) * src->w / dst->w;
+      const int y0 = (i / dst->w) * src->h / dst->h, y1 = ((i / dst->w) + 1) * src->h / dst->h;
+      const Uint32 count = (Uint32) ((x1 - x0) * (y1 - y0));
+      const Uint32 pixel = ((Uint32 *) ((Uint8 *) dst->pixels + (i / dst->w) * dst->pitch))[i % dst->w];
+      Uint32 expected_pixel = 0;
+      int c, x, y;
+      for (c = 0; c < 32; c += 8) {
+         Uint32 sum = 0;
+         for (y = y0; y < y1; y++) {
+            for (x = x0; x < x1; x++) {
+               sum += (((Uint32 *) ((Uint8 *) src->pixels + y * src->pitch))[x] >> c) & 0xFF;
+            }
+         }
+         expected_pixel |= ((sum + count / 2) / count) << c;
+      }
+      SDLTest_AssertCheck(pixel == expected_pixel, "Verify pixel %d, expected: 0x%.8x, got: 0x%.8x", i, expected_pixel, pixel);
+   }
+   SDL_FreeSurface(src);
+   SDL_FreeSurface(dst);
+
+   /* RGB565 */
+   src = SDL_CreateRGBSurfaceWithFormat(0, 2, 1, 16, SDL_PIXELFORMAT_RGB565);
+   dst = SDL_CreateRGBSurfaceWithFormat(0, 4, 1, 16, SDL_PIXELFORMAT_RGB565);
+   SDLTest_AssertCheck(src != NULL && dst != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+   if (src == NULL || dst == NULL) {
+      SDL_FreeSurface(src);
+      SDL_FreeSurface(dst);
+      return TEST_ABORTED;
+   }
+   pixels16 = (Uint16 *) src->pixels;
+   pixels16[0] = 0x0000;
+   pixels16[1] = 0xFFFF;
+   ret = SDL_SoftStretchLinear(src, NULL, dst, NULL);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SoftStretchLinear, expected: 0, got: %i", ret);
+   pixels16 = (Uint16 *) dst->pixels;
+   SDLTest_AssertCheck(pixels16[0] == 0x0000, "Verify pixel 0, expected: 0x0000, got: 0x%.4x", pixels16[0]);
+   SDLTest_AssertCheck(pixels16[1] > 0x0000 && pixels16[1] < pixels16[2] && pixels16[2] < 0xFFFF,
+                       "Verify pixels 1 and 2 are in between, got: 0x%.4x 0x%.4x", pixels16[1], pixels16[2]);
+   SDLTest_AssertCheck(pixels16[3] == 0xFFFF, "Verify pixel 3, expected: 0xffff, got: 0x%.4x", pixels16[3]);
+   SDL_FreeSurface(dst);
+
+   /* Mismatched and unsupported formats */
+   dst = SDL_CreateRGBSurfaceWithFormat(0, 4, 1, 32, SDL_PIXELFORMAT_ARGB8888);
+   ret = SDL_SoftStretchLinear(src, NULL, dst, NULL);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_SoftStretchLinear with different formats, expected: -1, got: %i", ret);
+   SDL_FreeSurface(src);
+   SDL_FreeSurface(dst);
+
+   src = SDL_CreateRGBSurfaceWithFormat(0, 2, 1, 24, SDL_PIXELFORMAT_RGB24);
+   dst = SDL_CreateRGBSurfaceWithFormat(0, 4, 1, 24, SDL_PIXELFORMAT_RGB24);
+   ret = SDL_SoftStretchLinear(src, NULL, dst, NULL);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_SoftStretchLinear with RGB24, expected: -1, got: %i", ret);
+   SDL_FreeSurface(src);
+   SDL_FreeSurface(dst);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests nearest neighbor stretching.
+ */
+int
+surface_testSoftStretchNearest(void *arg)
+{
+   static const Uint32 formats[] = { SDL_PIXELFORMAT_RGB332, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_ARGB8888 };
+   static const int sizes[][4] = {
+      { 37, 5, 74, 10 },    /* 2x */
+      { 37, 5, 111, 15 },   /* 3x */
+      { 37, 5, 148, 20 },   /* 4x */
+      { 37, 5, 61, 8 },     /* non-integer upscale */
+      { 37, 5, 20, 3 },     /* downscale */
+   };
+   SDL_Surface *src, *dst;
+   int f, s, x, y, ret, bpp, errors;
+
+   for (f = 0; f < SDL_arraysize(formats); f++) {
+      for (s = 0; s < SDL_arraysize(sizes); s++) {
+         src = SDL_CreateRGBSurfaceWithFormat(0, sizes[s][0], sizes[s][1], 0, formats[f]);
+         dst = SDL_CreateRGBSurfaceWithFormat(0, sizes[s][2], sizes[s][3], 0, formats[f]);
+         SDLTest_AssertCheck(src != NULL && dst != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+         if (src == NULL || dst == NULL) {
+            SDL_FreeSurface(src);
+            SDL_FreeSurface(dst);
+            return TEST_ABORTED;
+         }
+         bpp = src->format->BytesPerPixel;
+
+         for (x = 0; x < src->pitch * src->h; x++) {
+            ((Uint8 *) src->pixels)[x] = (Uint8) (x * 7 + x / 3);
+         }
+         ret = SDL_SoftStretch(src, NULL, dst, NULL);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SoftStretch, expected: 0, got: %i", ret);
+
+         /* Destination pixel x, y comes from source pixel x * src_w / dst_w, y * src_h / dst_h */
+         errors = 0;
+         for (y = 0; y < dst->h; y++) {
+            for (x = 0; x < dst->w; x++) {
+               const Uint8 *expected = (const Uint8 *) src->pixels + (y * src->h / dst->h) * src->pitch + (x * src->w / dst->w) * bpp;
+               const Uint8 *actual = (const Uint8 *) dst->pixels + y * dst->pitch + x * bpp;
+               if (SDL_memcmp(expected, actual, bpp) != 0) {
+                  errors++;
+               }
+            }
+         }
+         SDLTest_AssertCheck(errors == 0, "Verify %s %dx%d -> %dx%d, expected: 0 mismatched pixels, got: %d",
+                             SDL_GetPixelFormatName(formats[f]), src->w, src->h, dst->w, dst->h, errors);
+         SDL_FreeSurface(src);
+         SDL_FreeSurface(dst);
+      }
+   }
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Compares the SSE4.1 and AVX2 generated blitters against the scalar ones.
+ */
+int
+surface_testBlitSIMD(void *arg)
+{
+   static const Uint32 formats[] = {
+      SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888,
+      SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGRA8888
+   };
+   /* Odd widths and widths around the vector sizes, so the tail loops run */
+   static const int widths[] = { 1, 3, 4, 7, 8, 9, 15, 17, 33 };
+   static const struct {
+      SDL_BlendMode blendMode;
+      SDL_bool modulate;
+   } modes[] = {
+      { SDL_BLENDMODE_NONE, SDL_FALSE },
+      { SDL_BLENDMODE_NONE, SDL_TRUE },
+      { SDL_BLENDMODE_BLEND, SDL_FALSE },
+      { SDL_BLENDMODE_ADD, SDL_FALSE },
+      { SDL_BLENDMODE_MOD, SDL_FALSE },
+      { SDL_BLENDMODE_BLEND, SDL_TRUE },
+      { SDL_BLENDMODE_ADD, SDL_TRUE },
+      { SDL_BLENDMODE_MOD, SDL_TRUE },
+   };
+   /* SDL_CPU_* masks from SDL_blit.h: scalar only, SSE4.1, SSE4.1 and AVX2 */
+   const char *features[3];
+   SDL_Surface *src, *dst[3];
+   SDL_Rect dstrect;
+   int numFeatures = 0;
+   int sf, df, w, m, f, x, y, ret, errors;
+
+   features[numFeatures++] = "0";
+   if (SDL_HasSSE41()) {
+      features[numFeatures++] = "64";
+   }
+   if (SDL_HasSSE41() && SDL_HasAVX2()) {
+      features[numFeatures++] = "192";
+   }
+   if (numFeatures == 1) {
+      SDLTest_Log("No SSE4.1 or AVX2 support, skipping");
+      return TEST_SKIPPED;
+   }
+
+   for (sf = 0; sf < SDL_arraysize(formats); sf++) {
+      for (df = 0; df < SDL_arraysize(formats); df++) {
+         errors = 0;
+         for (w = 0; w < SDL_arraysize(widths); w++) {
+            for (m = 0; m < SDL_arraysize(modes); m++) {
+               /* A fresh source surface each time, so its blit map is recalculated under each override */
+               src = SDL_CreateRGBSurfaceWithFormat(0, widths[w], 3, 0, formats[sf]);
+               SDLTest_AssertCheck(src != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+               if (src == NULL) {
+                  SDL_SetHintWithPriority("SDL_BLIT_CPU_FEATURES", "", SDL_HINT_OVERRIDE);
+                  return TEST_ABORTED;
+               }
+               for (y = 0; y < src->h; y++) {
+                  Uint32 *row = (Uint32 *) ((Uint8 *) src->pixels + y * src->pitch);
+                  for (x = 0; x < src->w; x++) {
+                     row[x] = SDLTest_RandomUint32();
+                     /* Make sure fully opaque and fully transparent pixels show up */
+                     if ((x % 5) == 0) {
+                        row[x] |= src->format->Amask;
+                     } else if ((x % 5) == 1) {
+                        row[x] &= ~src->format->Amask;
+                     }
+                  }
+               }
+               SDL_SetSurfaceBlendMode(src, modes[m].blendMode);
+               if (modes[m].modulate) {
+                  SDL_SetSurfaceColorMod(src, 0x80, 0xC0, 0x3F);
+                  SDL_SetSurfaceAlphaMod(src, 0x9A);
+               }
+
+               /* Leave a column on either side of the blit to catch tail writes past the end of a row */
+               for (f = 0; f < numFeatures; f++) {
+                  dst[f] = SDL_CreateRGBSurfaceWithFormat(0, widths[w] + 2, 3, 0, formats[df]);
+                  SDLTest_AssertCheck(dst[f] != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+                  if (dst[f] == NULL) {
+                     while (f--) {
+                        SDL_FreeSurface(dst[f]);
+                     }
+                     SDL_FreeSurface(src);
+                     SDL_SetHintWithPriority("SDL_BLIT_CPU_FEATURES", "", SDL_HINT_OVERRIDE);
+                     return TEST_ABORTED;
+                  }
+                  if (f == 0) {
+                     for (x = 0; x < dst[0]->pitch * dst[0]->h; x++) {
+                        ((Uint8 *) dst[0]->pixels)[x] = SDLTest_RandomUint8();
+                     }
+                  } else {
+                     SDL_memcpy(dst[f]->pixels, dst[0]->pixels, dst[0]->pitch * dst[0]->h);
+                  }
+               }
+               for (f = 0; f < numFeatures; f++) {
+                  SDL_SetHintWithPriority("SDL_BLIT_CPU_FEATURES", features[f], SDL_HINT_OVERRIDE);
+                  dstrect.x = 1;
+                  dstrect.y = 0;
+                  dstrect.w = widths[w];
+                  dstrect.h = 3;
+                  ret = SDL_BlitSurface(src, NULL, dst[f], &dstrect);
+                  if (ret != 0) {
+                     errors++;
+                  }
+               }
+               for (f = 1; f < numFeatures; f++) {
+                  for (y = 0; y < dst[0]->h; y++) {
+                     const Uint8 *expected = (const Uint8 *) dst[0]->pixels + y * dst[0]->pitch;
+                     const Uint8 *actual = (const Uint8 *) dst[f]->pixels + y * dst[f]->pitch;
+                     if (SDL_memcmp(expected, actual, dst[0]->w * 4) != 0) {
+                        SDLTest_LogError("%s -> %s, width %d, blend mode %d%s, features %s: row %d differs from scalar",
+                                         SDL_GetPixelFormatName(formats[sf]), SDL_GetPixelFormatName(formats[df]),
+                                         widths[w], (int) modes[m].blendMode, modes[m].modulate ? " with modulation" : "",
+                                         features[f], y);
+                        errors++;
+                     }
+                  }
+               }
+               for (f = 0; f < numFeatures; f++) {
+                  SDL_FreeSurface(dst[f]);
+               }
+               SDL_FreeSurface(src);
+            }
+         }
+         SDLTest_AssertCheck(errors == 0, "Verify %s -> %s SIMD blits match scalar blits, expected: 0 errors, got: %d",
+                             SDL_GetPixelFormatName(formats[sf]), SDL_GetPixelFormatName(formats[df]), errors);
+      }
+   }
+
+   SDL_SetHintWithPriority("SDL_BLIT_CPU_FEATURES", "", SDL_HINT_OVERRIDE);
+
+   return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Surface test cases */
@@ -631,11 +952,20 @@ static const SDLTest_TestCaseReference surfaceTest11 =
 static const SDLTest_TestCaseReference surfaceTest12 =
         { (SDLTest_TestCaseFp)surface_testBlitBlendMod, "surface_testBlitBlendMod", "Tests blitting routines with mod blending mode.", TEST_ENABLED};
 
+static const SDLTest_TestCaseReference surfaceTest13 =
+        { (SDLTest_TestCaseFp)surface_testSoftStretchLinear, "surface_testSoftStretchLinear", "Tests filtered stretching.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest14 =
+        { (SDLTest_TestCaseFp)surface_testSoftStretchNearest, "surface_testSoftStretchNearest", "Tests nearest neighbor stretching.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest15 =
+        { (SDLTest_TestCaseFp)surface_testBlitSIMD, "surface_testBlitSIMD", "Compares SIMD blitters against scalar blitters.", TEST_ENABLED};
+
 /* Sequence of Surface test cases */
 static const SDLTest_TestCaseReference *surfaceTests[] =  {
     &surfaceTest1, &surfaceTest2, &surfaceTest3, &surfaceTest4, &surfaceTest5,
     &surfaceTest6, &surfaceTest7, &surfaceTest8, &surfaceTest9, &surfaceTest10,
-    &surfaceTest11, &surfaceTest12, NULL
+    &surfaceTest11, &surfaceTest12, &surfaceTest13, &surfaceTest14, &surfaceTest15, NULL
 };
 
 /* Surface test suite (global) */
@@ -172,6 +172,99 @@ timer_addRemoveTimer(void *arg)
   return TEST_COMPLETED;
 }
 
+/* High resolution test callback */
+Uint64 SDLCALL _timerTestCallbackNS(Uint64 interval, void *param)
+{
+   SDL_AtomicAdd((SDL_atomic_t *)param, 1);
+   return interval;
+}
+
+/**
+ * @brief Call to SDL_AddTimerNS and SDL_RemoveTimer
+ */
+int
+timer_addRemoveTimerNS(void *arg)
+{
+  const Uint64 interval = 500000;
+  SDL_atomic_t count;
+  SDL_TimerID id;
+  SDL_bool result;
+  Uint64 start, elapsed;
+  int calls, maxCalls;
+
+  SDL_AtomicSet(&count, 0);
+
+  /* Set a periodic timer with a sub-millisecond interval */
+  start = SDL_GetPerformanceCounter();
+  id = SDL_AddTimerNS(interval, _timerTestCallbackNS, &count);
+  SDLTest_AssertPass("Call to SDL_AddTimerNS(500000)");
+  SDLTest_AssertCheck(id > 0, "Check result value, expected: >0, got: %d", id);
+
+  /* Let it run for a while */
+  SDL_Delay(100);
+  SDLTest_AssertPass("Call to SDL_Delay(100)");
+
+  /* Remove timer, the callback shouldn't have run more often than scheduled */
+  result = SDL_RemoveTimer(id);
+  elapsed = ((SDL_GetPerformanceCounter() - start) * 1000000000) / SDL_GetPerformanceFrequency();
+  calls = SDL_AtomicGet(&count);
+  maxCalls = (int)(elapsed / interval);
+  SDLTest_AssertPass("Call to SDL_RemoveTimer()");
+  SDLTest_AssertCheck(result == SDL_TRUE, "Check result value, expected: %i, got: %i", SDL_TRUE, result);
+  SDLTest_AssertCheck(calls > 0, "Check callback was called, expected: >0, got: %i", calls);
+  SDLTest_AssertCheck(calls <= maxCalls, "Check callback count, expected: <=%i, got: %i", maxCalls, calls);
+
+  return TEST_COMPLETED;
+}
+
+/* Order in which the timers of timer_sameDeadlineOrder fired */
+static SDL_atomic_t _timerOrderCount;
+static int _timerOrder[16];
+
+/* Callback recording the order in which timers fire */
+Uint32 SDLCALL _timerOrderCallback(Uint32 interval, void *param)
+{
+  const int slot = SDL_AtomicIncRef(&_timerOrderCount);
+  if (slot < SDL_arraysize(_timerOrder)) {
+    _timerOrder[slot] = (int)(intptr_t)param;
+  }
+  return 0;
+}
+
+/**
+ * @brief Timers that are due at the same time run in the order they were added
+ */
+int
+timer_sameDeadlineOrder(void *arg)
+{
+  const int numTimers = SDL_arraysize(_timerOrder);
+  int i, fired, mismatches;
+
+  SDL_AtomicSet(&_timerOrderCount, 0);
+  SDL_memset(_timerOrder, 0xFF, sizeof(_timerOrder));
+
+  /* Queue them all before the timer thread gets to run them */
+  for (i = 0; i < numTimers; i++) {
+    SDL_AddTimer(50, _timerOrderCallback, (void *)(intptr_t)i);
+  }
+  SDLTest_AssertPass("Call to SDL_AddTimer(50) %d times", numTimers);
+
+  SDL_Delay(200);
+  SDLTest_AssertPass("Call to SDL_Delay(200)");
+
+  fired = SDL_AtomicGet(&_timerOrderCount);
+  SDLTest_AssertCheck(fired == numTimers, "Check callback count, expected: %d, got: %d", numTimers, fired);
+  mismatches = 0;
+  for (i = 0; i < numTimers; i++) {
+    if (_timerOrder[i] != i) {
+      mismatches++;
+    }
+  }
+  SDLTest_AssertCheck(mismatches == 0, "Check callbacks ran in the order the timers were added, expected: 0 mismatches, got: %d", mismatches);
+
+  return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Timer test cases */
@@ -187,9 +280,15 @@ static const SDLTest_TestCaseReference timerTest3 =
 static const SDLTest_TestCaseReference timerTest4 =
         { (SDLTest_TestCaseFp)timer_addRemoveTimer, "timer_addRemoveTimer", "Call to SDL_AddTimer and SDL_RemoveTimer", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference timerTest5 =
+        { (SDLTest_TestCaseFp)timer_addRemoveTimerNS, "timer_addRemoveTimerNS", "Call to SDL_AddTimerNS and SDL_RemoveTimer", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference timerTest6 =
+        { (SDLTest_TestCaseFp)timer_sameDeadlineOrder, "timer_sameDeadlineOrder", "Timers due at the same time run in the order they were added", TEST_ENABLED };
+
 /* Sequence of Timer test cases */
 static const SDLTest_TestCaseReference *timerTests[] =  {
-    &timerTest1, &timerTest2, &timerTest3, &timerTest4, NULL
+    &timerTest1, &timerTest2, &timerTest3, &timerTest4, &timerTest5, &timerTest6, NULL
 };
 
 /* Timer test suite (global) */
@@ -35,6 +35,8 @@ static int current_alpha = 0;
 static int current_color = 0;
 static SDL_Rect *positions;
 static SDL_Rect *velocities;
+static SDL_bool use_batch;
+static SDL_RenderSprite *batch;
 static int sprite_w, sprite_h;
 static SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
 static Uint32 next_fps_check, frames;
@@ -51,6 +53,7 @@ static void
 quit(int rc)
 {
     SDL_free(sprites);
+    SDL_free(batch);
     SDL_free(positions);
     SDL_free(velocities);
     SDLTest_CommonQuit(state);
@@ -232,11 +235,29 @@ MoveSprites(SDL_Renderer * renderer, SDL_Texture * sprite)
     }
 
     /* Draw sprites */
-    for (i = 0; i < num_sprites; ++i) {
-        position = &positions[i];
+    if (use_batch) {
+        SDL_Color color;
+
+        SDL_GetTextureColorMod(sprite, &color.r, &color.g, &color.b);
+        SDL_GetTextureAlphaMod(sprite, &color.a);
+        for (i = 0; i < num_sprites; ++i) {
+            position = &positions[i];
+            batch[i].dstrect.x = (float) position->x;
+            batch[i].dstrect.y = (float) position->y;
+            batch[i].dstrect.w = (float) position->w;
+            batch[i].dstrect.h = (float) position->h;
+            batch[i].color = color;
+        }
 
-        /* Blit the sprite onto the screen */
-        SDL_RenderCopy(renderer, sprite, NULL, position);
+        /* Blit all the sprites onto the screen at once */
+        SDL_RenderCopySprites(renderer, sprite, batch, num_sprites);
+    } else {
+        for (i = 0; i < num_sprites; ++i) {
+            position = &positions[i];
+
+            /* Blit the sprite onto the screen */
+            SDL_RenderCopy(renderer, sprite, NULL, position);
+        }
     }
 
     /* Update the screen! */
@@ -331,6 +352,9 @@ main(int argc, char *argv[])
             } else if (SDL_strcasecmp(argv[i], "--cyclealpha") == 0) {
                 cycle_alpha = SDL_TRUE;
                 consumed = 1;
+            } else if (SDL_strcasecmp(argv[i], "--batch") == 0) {
+                use_batch = SDL_TRUE;
+                consumed = 1;
             } else if (SDL_isdigit(*argv[i])) {
                 num_sprites = SDL_atoi(argv[i]);
                 consumed = 1;
@@ -340,7 +364,7 @@ main(int argc, char *argv[])
             }
         }
         if (consumed < 0) {
-            static const char *options[] = { "[--blend none|blend|add|mod]", "[--cyclecolor]", "[--cyclealpha]", "[--iterations N]", "[num_sprites]", "[icon.bmp]", NULL };
+            static const char *options[] = { "[--blend none|blend|add|mod]", "[--cyclecolor]", "[--cyclealpha]", "[--batch]", "[--iterations N]", "[num_sprites]", "[icon.bmp]", NULL };
             SDLTest_CommonLogUsage(state, argv[0], options);
             quit(1);
         }
@@ -369,7 +393,8 @@ main(int argc, char *argv[])
     /* Allocate memory for the sprite info */
     positions = (SDL_Rect *) SDL_malloc(num_sprites * sizeof(SDL_Rect));
     velocities = (SDL_Rect *) SDL_malloc(num_sprites * sizeof(SDL_Rect));
-    if (!positions || !velocities) {
+    batch = (SDL_RenderSprite *) SDL_calloc(num_sprites, sizeof(SDL_RenderSprite));
+    if (!positions || !velocities || !batch) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory!\n");
         quit(2);
     }
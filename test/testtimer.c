@@ -21,8 +21,22 @@
 
 #define DEFAULT_RESOLUTION  1
 
+/* The number of timers in the stress test */
+#define STRESS_TIMERS   10000
+
 static int ticks = 0;
 
+typedef struct
+{
+    SDL_TimerID id;
+    Uint64 deadline;
+} StressTimer;
+
+static StressTimer stress_timers[STRESS_TIMERS];
+static SDL_atomic_t stress_fired;
+static double stress_jitter_total;
+static double stress_jitter_max;
+
 static Uint32 SDLCALL
 ticktock(Uint32 interval, void *param)
 {
@@ -37,6 +51,67 @@ callback(Uint32 interval, void *param)
     return interval;
 }
 
+/* Only the timer thread runs this, so the totals don't need to be atomic */
+static Uint32 SDLCALL
+stress(Uint32 interval, void *param)
+{
+    StressTimer *timer = (StressTimer *)param;
+    const Uint64 now = SDL_GetPerformanceCounter();
+    double late = 0.0;
+
+    if (now > timer->deadline) {
+        late = (double)((now - timer->deadline)*1000) / SDL_GetPerformanceFrequency();
+    }
+    stress_jitter_total += late;
+    if (late > stress_jitter_max) {
+        stress_jitter_max = late;
+    }
+    SDL_AtomicIncRef(&stress_fired);
+    return 0;
+}
+
+static void
+stress_test(void)
+{
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+    Uint64 start, now;
+    int i, fired, removed = 0;
+
+    SDL_Log("Testing %d timers...\n", STRESS_TIMERS);
+
+    /* Spread the timers over the next second */
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < STRESS_TIMERS; ++i) {
+        const Uint32 interval = 10 + (Uint32)(rand() % 1000);
+        stress_timers[i].deadline = SDL_GetPerformanceCounter() + (interval * freq) / 1000;
+        stress_timers[i].id = SDL_AddTimer(interval, stress, &stress_timers[i]);
+        if (!stress_timers[i].id) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not create timer %d: %s\n", i, SDL_GetError());
+        }
+    }
+    now = SDL_GetPerformanceCounter();
+    SDL_Log("Adding %d timers took %f ms\n", STRESS_TIMERS, (double)((now - start)*1000) / freq);
+
+    /* Cancel every other timer before it gets a chance to run */
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < STRESS_TIMERS; i += 2) {
+        if (SDL_RemoveTimer(stress_timers[i].id)) {
+            ++removed;
+        }
+    }
+    now = SDL_GetPerformanceCounter();
+    SDL_Log("Removing %d timers took %f ms\n", removed, (double)((now - start)*1000) / freq);
+
+    SDL_Delay(2 * 1000);
+
+    fired = SDL_AtomicGet(&stress_fired);
+    SDL_Log("%d of %d timers fired, expected %d\n", fired, STRESS_TIMERS, STRESS_TIMERS - removed);
+    if (fired) {
+        SDL_Log("Dispatch jitter: average = %f ms, max = %f ms\n",
+                stress_jitter_total / fired, stress_jitter_max);
+    }
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -100,6 +175,8 @@ main(int argc, char *argv[])
     SDL_RemoveTimer(t2);
     SDL_RemoveTimer(t3);
 
+    stress_test();
+
     start = SDL_GetPerformanceCounter();
     for (i = 0; i < 1000000; ++i) {
         ticktock(0, NULL);